@@ -0,0 +1,143 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "BenchmarkUtils.h"
+
+#include "ModelUtils.h"
+
+#include <Urho3D/Graphics/ModelView.h>
+
+namespace Benchmarks
+{
+
+SharedPtr<Model> CreateBoxModel(Context* context)
+{
+    auto modelView = MakeShared<ModelView>(context);
+
+    auto& geometries = modelView->GetGeometries();
+    geometries.resize(1);
+    geometries[0].lods_.resize(1);
+    auto& geometry = geometries[0].lods_[0];
+    geometry.vertexFormat_ = Tests::GetVertexFormat();
+
+    const Quaternion faceRotations[] = {
+        {0.0f, Vector3::UP},
+        {90.0f, Vector3::UP},
+        {180.0f, Vector3::UP},
+        {270.0f, Vector3::UP},
+        {90.0f, Vector3::RIGHT},
+        {-90.0f, Vector3::RIGHT},
+    };
+    for (const Quaternion& rotation : faceRotations)
+        Tests::AppendQuad(geometry, rotation * Vector3{0.0f, 0.0f, -0.5f}, rotation, Vector2::ONE, Color::WHITE);
+
+    return modelView->ExportModel();
+}
+
+SharedPtr<Model> CreateCharacterModel(Context* context, unsigned numBones, unsigned numQuadsPerBone)
+{
+    static const float boneLength = 0.25f;
+    static const float radius = 0.3f;
+
+    auto modelView = MakeShared<ModelView>(context);
+
+    ModelVertexFormat format = Tests::GetVertexFormat();
+    format.blendIndices_ = TYPE_UBYTE4;
+    format.blendWeights_ = TYPE_UBYTE4_NORM;
+
+    auto& geometries = modelView->GetGeometries();
+    geometries.resize(1);
+    geometries[0].lods_.resize(1);
+    auto& geometry = geometries[0].lods_[0];
+    geometry.vertexFormat_ = format;
+
+    auto& bones = modelView->GetBones();
+    bones.resize(numBones);
+    for (unsigned boneIndex = 0; boneIndex < numBones; ++boneIndex)
+    {
+        BoneView& bone = bones[boneIndex];
+        bone.name_ = GetCharacterBoneName(boneIndex);
+        bone.parentIndex_ = boneIndex != 0 ? boneIndex - 1 : M_MAX_UNSIGNED;
+        bone.SetInitialTransform({0.0f, boneIndex != 0 ? boneLength : 0.0f, 0.0f});
+        bone.SetLocalBoundingBox({Vector3{-radius, 0.0f, -radius}, Vector3{radius, boneLength, radius}});
+        bone.offsetMatrix_ = Matrix3x4(Vector3::UP * (boneIndex * boneLength), Quaternion::IDENTITY, 1.0f).Inverse();
+    }
+
+    const float quadWidth = 2.0f * M_PI * radius / numQuadsPerBone;
+    for (unsigned boneIndex = 0; boneIndex < numBones; ++boneIndex)
+    {
+        const unsigned nextBoneIndex = ea::min(boneIndex + 1, numBones - 1);
+        const Vector4 blendIndices{static_cast<float>(boneIndex), static_cast<float>(nextBoneIndex), 0.0f, 0.0f};
+        const Vector4 blendWeights{0.75f, 0.25f, 0.0f, 0.0f};
+
+        for (unsigned quadIndex = 0; quadIndex < numQuadsPerBone; ++quadIndex)
+        {
+            const Quaternion rotation{360.0f * quadIndex / numQuadsPerBone, Vector3::UP};
+            const Vector3 position = rotation * Vector3{0.0f, 0.0f, -radius} + Vector3::UP * ((boneIndex + 0.5f) * boneLength);
+            Tests::AppendSkinnedQuad(geometry, blendIndices, blendWeights,
+                position, rotation, {quadWidth, boneLength}, Color::WHITE);
+        }
+    }
+
+    return modelView->ExportModel();
+}
+
+SharedPtr<Animation> CreateCharacterAnimation(Context* context, unsigned numBones, float duration)
+{
+    auto animation = MakeShared<Animation>(context);
+    animation->SetName("Character.ani");
+    animation->SetLength(duration);
+
+    static const unsigned numKeyFrames = 8;
+    for (unsigned boneIndex = 1; boneIndex < numBones; ++boneIndex)
+    {
+        AnimationTrack* track = animation->CreateTrack(GetCharacterBoneName(boneIndex));
+        track->channelMask_ = CHANNEL_ROTATION;
+
+        for (unsigned i = 0; i <= numKeyFrames; ++i)
+        {
+            const float angle = 15.0f * Sin(360.0f * i / numKeyFrames + 30.0f * boneIndex);
+            AnimationKeyFrame keyFrame;
+            keyFrame.time_ = duration * i / numKeyFrames;
+            keyFrame.rotation_ = Quaternion{angle, Vector3::FORWARD};
+            track->AddKeyFrame(keyFrame);
+        }
+    }
+
+    return animation;
+}
+
+ea::string GetCharacterBoneName(unsigned boneIndex)
+{
+    return Format("Bone {}", boneIndex);
+}
+
+FrameInfo CreateFrameInfo(Scene* scene, unsigned frameNumber, float timeStep)
+{
+    FrameInfo frameInfo;
+    frameInfo.frameNumber_ = frameNumber;
+    frameInfo.timeStep_ = timeStep;
+    frameInfo.scene_ = scene;
+    return frameInfo;
+}
+
+}
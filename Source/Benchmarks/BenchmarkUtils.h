@@ -0,0 +1,51 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include <Urho3D/Graphics/Animation.h>
+#include <Urho3D/Graphics/Drawable.h>
+#include <Urho3D/Graphics/Model.h>
+#include <Urho3D/Scene/Scene.h>
+
+using namespace Urho3D;
+
+namespace Benchmarks
+{
+
+/// Create unit cube model without skeleton.
+SharedPtr<Model> CreateBoxModel(Context* context);
+
+/// Create skinned "character" model: a vertical tube skinned to a chain of bones.
+/// Each bone affects numQuadsPerBone quads, each vertex is blended between two neighbor bones.
+SharedPtr<Model> CreateCharacterModel(Context* context, unsigned numBones, unsigned numQuadsPerBone);
+
+/// Create looped animation that bends every bone of the character model.
+SharedPtr<Animation> CreateCharacterAnimation(Context* context, unsigned numBones, float duration);
+
+/// Return name of the character bone.
+ea::string GetCharacterBoneName(unsigned boneIndex);
+
+/// Create frame info for manual Octree update.
+FrameInfo CreateFrameInfo(Scene* scene, unsigned frameNumber, float timeStep);
+
+}
@@ -0,0 +1,150 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "CommonUtils.h"
+
+#include <Urho3D/Core/Object.h>
+#include <Urho3D/Core/TypedEvent.h>
+
+namespace
+{
+
+URHO3D_EVENT(E_BENCHMARKBROADCAST, BenchmarkBroadcast)
+{
+    URHO3D_PARAM(P_TIMESTEP, TimeStep); // float
+}
+
+URHO3D_EVENT(E_BENCHMARKSPECIFIC, BenchmarkSpecific)
+{
+    URHO3D_PARAM(P_VALUE, Value); // int
+}
+
+URHO3D_EVENT(E_BENCHMARKUNHANDLED, BenchmarkUnhandled)
+{
+}
+
+struct BenchmarkBroadcastData
+{
+    float timeStep_{};
+
+    void ToEventData(VariantMap& eventData) const { eventData[BenchmarkBroadcast::P_TIMESTEP] = timeStep_; }
+    void FromEventData(VariantMap& eventData) { timeStep_ = eventData[BenchmarkBroadcast::P_TIMESTEP].GetFloat(); }
+};
+
+class BenchmarkObject : public Object
+{
+    URHO3D_OBJECT(BenchmarkObject, Object);
+
+public:
+    explicit BenchmarkObject(Context* context) : Object(context) {}
+
+    float accumulator_{};
+};
+
+}
+
+TEST_CASE("Object::SendEvent dispatch")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    static const unsigned numReceivers = 1000;
+
+    auto sender = MakeShared<BenchmarkObject>(context);
+    ea::vector<SharedPtr<BenchmarkObject>> receivers;
+    ea::vector<SharedPtr<BenchmarkObject>> senders;
+    for (unsigned i = 0; i < numReceivers; ++i)
+    {
+        auto receiver = MakeShared<BenchmarkObject>(context);
+        auto specificSender = MakeShared<BenchmarkObject>(context);
+
+        BenchmarkObject* self = receiver;
+        receiver->SubscribeToEvent(E_BENCHMARKBROADCAST,
+            [self](VariantMap& eventData) { self->accumulator_ += eventData[BenchmarkBroadcast::P_TIMESTEP].GetFloat(); });
+        receiver->SubscribeToEvent(specificSender, E_BENCHMARKSPECIFIC,
+            [self](VariantMap& eventData) { self->accumulator_ += eventData[BenchmarkSpecific::P_VALUE].GetInt(); });
+
+        receivers.push_back(receiver);
+        senders.push_back(specificSender);
+    }
+
+    BENCHMARK("Broadcast event to 1000 receivers")
+    {
+        VariantMap& eventData = sender->GetEventDataMap();
+        eventData[BenchmarkBroadcast::P_TIMESTEP] = 1.0f / 60.0f;
+        sender->SendEvent(E_BENCHMARKBROADCAST, eventData);
+        return receivers.back()->accumulator_;
+    };
+
+    BENCHMARK("Send specific event from 1000 senders")
+    {
+        for (BenchmarkObject* specificSender : senders)
+        {
+            VariantMap& eventData = specificSender->GetEventDataMap();
+            eventData[BenchmarkSpecific::P_VALUE] = 1;
+            specificSender->SendEvent(E_BENCHMARKSPECIFIC, eventData);
+        }
+        return receivers.back()->accumulator_;
+    };
+
+    BENCHMARK("Send unhandled event 1000 times")
+    {
+        for (unsigned i = 0; i < numReceivers; ++i)
+            sender->SendEvent(E_BENCHMARKUNHANDLED);
+        return sender->accumulator_;
+    };
+}
+
+TEST_CASE("TypedEvent dispatch")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    static const unsigned numReceivers = 1000;
+
+    auto sender = MakeShared<BenchmarkObject>(context);
+    TypedEvent<BenchmarkBroadcastData> event{sender, E_BENCHMARKBROADCAST};
+    ea::vector<SharedPtr<BenchmarkObject>> receivers;
+    for (unsigned i = 0; i < numReceivers; ++i)
+    {
+        auto receiver = MakeShared<BenchmarkObject>(context);
+        event.Subscribe(receiver.Get(),
+            [](BenchmarkObject* self, BenchmarkBroadcastData& eventData) { self->accumulator_ += eventData.timeStep_; });
+        receivers.push_back(receiver);
+    }
+
+    BENCHMARK("Broadcast typed event to 1000 receivers")
+    {
+        BenchmarkBroadcastData eventData{1.0f / 60.0f};
+        event.Send(eventData);
+        return receivers.back()->accumulator_;
+    };
+
+    auto legacyReceiver = MakeShared<BenchmarkObject>(context);
+    legacyReceiver->SubscribeToEvent(sender, E_BENCHMARKBROADCAST,
+        [&](VariantMap& eventData) { legacyReceiver->accumulator_ += eventData[BenchmarkBroadcast::P_TIMESTEP].GetFloat(); });
+
+    BENCHMARK("Broadcast typed event to 1000 receivers and 1 VariantMap receiver")
+    {
+        BenchmarkBroadcastData eventData{1.0f / 60.0f};
+        event.Send(eventData);
+        return receivers.back()->accumulator_;
+    };
+}
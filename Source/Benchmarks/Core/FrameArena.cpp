@@ -0,0 +1,64 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "CommonUtils.h"
+
+#include <Urho3D/Core/FrameArena.h>
+
+namespace
+{
+
+template <class Vector> unsigned FillTransientVectors(unsigned numVectors, unsigned numElements)
+{
+    unsigned result = 0;
+    for (unsigned i = 0; i < numVectors; ++i)
+    {
+        Vector values;
+        for (unsigned j = 0; j < numElements; ++j)
+            values.push_back(j);
+        result += values.back();
+    }
+    return result;
+}
+
+}
+
+TEST_CASE("FrameArena transient containers")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto frameArena = context->GetSubsystem<FrameArena>();
+
+    static const unsigned numVectors = 1000;
+    static const unsigned numElements = 64;
+
+    BENCHMARK("ea::vector")
+    {
+        return FillTransientVectors<ea::vector<unsigned>>(numVectors, numElements);
+    };
+
+    BENCHMARK("FrameVector")
+    {
+        const unsigned result = FillTransientVectors<FrameVector<unsigned>>(numVectors, numElements);
+        frameArena->Reset();
+        return result;
+    };
+}
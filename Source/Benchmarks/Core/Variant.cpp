@@ -0,0 +1,87 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "CommonUtils.h"
+
+#include <Urho3D/Core/Variant.h>
+
+namespace
+{
+
+VariantMap CreateTestVariantMap(unsigned size)
+{
+    VariantMap result;
+    for (unsigned i = 0; i < size; ++i)
+    {
+        const ea::string key = Format("Key {}", i);
+        switch (i % 4)
+        {
+        case 0: result[key] = static_cast<int>(i); break;
+        case 1: result[key] = static_cast<float>(i); break;
+        case 2: result[key] = Vector3::ONE * static_cast<float>(i); break;
+        default: result[key] = Format("Value {}", i); break;
+        }
+    }
+    return result;
+}
+
+}
+
+TEST_CASE("Variant and VariantMap copies")
+{
+    const Variant intVariant{10};
+    const Variant vectorVariant{Vector3{1.0f, 2.0f, 3.0f}};
+    const Variant matrixVariant{Matrix3x4::IDENTITY};
+    const Variant stringVariant{ea::string{"Some string that does not fit small string buffer"}};
+    const Variant resourceRefVariant{ResourceRef{StringHash{"Model"}, "Models/Box.mdl"}};
+    const Variant smallMapVariant{CreateTestVariantMap(4)};
+
+    const VariantMap smallMap = CreateTestVariantMap(4);
+    const VariantMap largeMap = CreateTestVariantMap(64);
+
+    BENCHMARK("Copy int Variant") { return Variant{intVariant}; };
+    BENCHMARK("Copy Vector3 Variant") { return Variant{vectorVariant}; };
+    BENCHMARK("Copy Matrix3x4 Variant") { return Variant{matrixVariant}; };
+    BENCHMARK("Copy string Variant") { return Variant{stringVariant}; };
+    BENCHMARK("Copy ResourceRef Variant") { return Variant{resourceRefVariant}; };
+    BENCHMARK("Copy VariantMap Variant") { return Variant{smallMapVariant}; };
+
+    BENCHMARK("Copy VariantMap with 4 elements") { return VariantMap{smallMap}; };
+    BENCHMARK("Copy VariantMap with 64 elements") { return VariantMap{largeMap}; };
+
+    BENCHMARK("Fill VariantMap with 4 elements")
+    {
+        VariantMap map;
+        map["Key 0"] = 0;
+        map["Key 1"] = 1.0f;
+        map["Key 2"] = Vector3::ONE;
+        map["Key 3"] = true;
+        return map;
+    };
+
+    const StringHash lookupKey{"Key 60"};
+    BENCHMARK("Lookup VariantMap with 64 elements")
+    {
+        const auto iter = largeMap.find(lookupKey);
+        return iter != largeMap.end() ? iter->second.GetInt() : 0;
+    };
+}
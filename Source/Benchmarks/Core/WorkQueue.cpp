@@ -0,0 +1,84 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "CommonUtils.h"
+
+#include <Urho3D/Core/TaskGraph.h>
+#include <Urho3D/Core/WorkQueue.h>
+
+namespace
+{
+
+void ProcessElements(ea::span<float> values, unsigned beginIndex, unsigned endIndex)
+{
+    for (unsigned i = beginIndex; i < endIndex; ++i)
+        values[i] = Sqrt(values[i] * values[i] + 1.0f);
+}
+
+}
+
+TEST_CASE("WorkQueue parallel loops")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto workQueue = context->GetSubsystem<WorkQueue>();
+
+    static const unsigned numElements = 100000;
+    ea::vector<float> values(numElements, 1.0f);
+
+    BENCHMARK("ForEachParallel, bucket 1")
+    {
+        ForEachParallel(workQueue, 1u, numElements,
+            [&](unsigned beginIndex, unsigned endIndex) { ProcessElements(values, beginIndex, endIndex); });
+        return values[0];
+    };
+
+    BENCHMARK("ForEachParallel, bucket 256")
+    {
+        ForEachParallel(workQueue, 256u, numElements,
+            [&](unsigned beginIndex, unsigned endIndex) { ProcessElements(values, beginIndex, endIndex); });
+        return values[0];
+    };
+
+    BENCHMARK("WorkQueue::ParallelFor, min range 256")
+    {
+        workQueue->ParallelFor(numElements, 256,
+            [&](unsigned beginIndex, unsigned endIndex, unsigned) { ProcessElements(values, beginIndex, endIndex); });
+        return values[0];
+    };
+
+    TaskGraph graph(workQueue);
+    const unsigned numStages = 4;
+    for (unsigned stage = 0; stage < numStages; ++stage)
+    {
+        const auto node = graph.AddParallelFor(numElements / numStages, 256,
+            [&, offset = stage * numElements / numStages](unsigned beginIndex, unsigned endIndex, unsigned)
+        { ProcessElements(values, offset + beginIndex, offset + endIndex); });
+        if (stage > 0)
+            graph.AddDependency(node, node - 1);
+    }
+
+    BENCHMARK("TaskGraph, chain of 4 parallel loops")
+    {
+        graph.Execute();
+        return values[0];
+    };
+}
@@ -0,0 +1,206 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "BenchmarkUtils.h"
+#include "CommonUtils.h"
+
+#include <Urho3D/Core/FrameArena.h>
+#include <Urho3D/Graphics/AnimatedModel.h>
+#include <Urho3D/Graphics/AnimationController.h>
+#include <Urho3D/Graphics/AnimationPoseCache.h>
+#include <Urho3D/Graphics/Camera.h>
+#include <Urho3D/Graphics/Octree.h>
+#include <Urho3D/Graphics/SoftwareModelAnimator.h>
+
+namespace
+{
+
+static const unsigned numCharacterBones = 32;
+static const unsigned numCharacterQuadsPerBone = 16;
+
+SharedPtr<Resource> CreateCharacterModel(Context* context)
+{
+    return Benchmarks::CreateCharacterModel(context, numCharacterBones, numCharacterQuadsPerBone);
+}
+
+SharedPtr<Resource> CreateCharacterAnimation(Context* context)
+{
+    return Benchmarks::CreateCharacterAnimation(context, numCharacterBones, 2.0f);
+}
+
+}
+
+TEST_CASE("AnimatedModel animation and skinning")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto frameArena = context->GetSubsystem<FrameArena>();
+    auto model = Tests::GetOrCreateResource<Model>(context, "@/Benchmarks/Character.mdl", CreateCharacterModel);
+    auto animation = Tests::GetOrCreateResource<Animation>(context, "@/Benchmarks/Character.ani", CreateCharacterAnimation);
+
+    static const unsigned numCharacters = 100;
+
+    auto scene = MakeShared<Scene>(context);
+    auto octree = scene->CreateComponent<Octree>();
+    for (unsigned i = 0; i < numCharacters; ++i)
+    {
+        Node* node = scene->CreateChild();
+        node->SetPosition({static_cast<float>(i % 10), 0.0f, static_cast<float>(i / 10)});
+
+        auto animatedModel = node->CreateComponent<AnimatedModel>();
+        animatedModel->SetModel(model);
+
+        auto animationController = node->CreateComponent<AnimationController>();
+        animationController->PlayNew(AnimationParameters{animation}.Looped().Time(0.01f * i));
+    }
+
+    const float timeStep = 1.0f / 60.0f;
+    unsigned frameNumber = 1;
+    scene->Update(timeStep);
+    octree->Update(Benchmarks::CreateFrameInfo(scene, frameNumber++, timeStep));
+
+    BENCHMARK("Animate 100 characters with 32 bones")
+    {
+        frameArena->BeginFrame();
+        scene->Update(timeStep);
+        octree->Update(Benchmarks::CreateFrameInfo(scene, frameNumber++, timeStep));
+        frameArena->EndFrame();
+        return frameNumber;
+    };
+
+    // Software skinning is evaluated directly because UpdateGeometry requires a renderer
+    ea::vector<SharedPtr<SoftwareModelAnimator>> animators;
+    for (unsigned i = 0; i < numCharacters; ++i)
+    {
+        auto animator = MakeShared<SoftwareModelAnimator>(context);
+        animator->Initialize(model, true, SoftwareModelAnimator::MaxBones);
+        animators.push_back(animator);
+    }
+
+    ea::vector<Matrix3x4> skinMatrices(numCharacterBones);
+    for (unsigned i = 0; i < numCharacterBones; ++i)
+        skinMatrices[i] = Matrix3x4{Vector3::UP * 0.01f * i, Quaternion{1.0f * i, Vector3::FORWARD}, 1.0f};
+
+    BENCHMARK("Software skinning of 100 characters with 2048 vertices")
+    {
+        for (SoftwareModelAnimator* animator : animators)
+        {
+            animator->ResetAnimation();
+            animator->ApplySkinning(skinMatrices);
+        }
+        return animators.size();
+    };
+}
+
+TEST_CASE("AnimatedModel crowd with shared poses")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto frameArena = context->GetSubsystem<FrameArena>();
+    auto model = Tests::GetOrCreateResource<Model>(context, "@/Benchmarks/Character.mdl", CreateCharacterModel);
+    auto animation = Tests::GetOrCreateResource<Animation>(context, "@/Benchmarks/Character.ani", CreateCharacterAnimation);
+    auto poseCache = context->GetSubsystem<AnimationPoseCache>();
+
+    static const unsigned numCharacters = 500;
+
+    auto scene = MakeShared<Scene>(context);
+    auto octree = scene->CreateComponent<Octree>();
+    auto camera = scene->CreateChild("Camera")->CreateComponent<Camera>();
+
+    ea::vector<AnimatedModel*> animatedModels;
+    for (unsigned i = 0; i < numCharacters; ++i)
+    {
+        Node* node = scene->CreateChild();
+        node->SetPosition({static_cast<float>(i % 25), 0.0f, 10.0f + static_cast<float>(i / 25)});
+
+        // Disable animation throttling to measure the cost of each update
+        auto animatedModel = node->CreateComponent<AnimatedModel>();
+        animatedModel->SetModel(model);
+        animatedModel->SetUpdateInvisible(true);
+        animatedModel->SetAnimationLodBias(0.0f);
+        animatedModels.push_back(animatedModel);
+
+        // All characters play the same clip in sync
+        auto animationController = node->CreateComponent<AnimationController>();
+        animationController->PlayNew(AnimationParameters{animation}.Looped());
+    }
+
+    const float timeStep = 1.0f / 60.0f;
+    unsigned frameNumber = 1;
+    const auto updateFrame = [&]
+    {
+        FrameInfo frameInfo = Benchmarks::CreateFrameInfo(scene, frameNumber++, timeStep);
+        frameInfo.camera_ = camera;
+        frameArena->BeginFrame();
+        scene->Update(timeStep);
+        octree->Update(frameInfo);
+        poseCache->Reset();
+        frameArena->EndFrame();
+        return frameNumber;
+    };
+    updateFrame();
+
+    BENCHMARK("Animate 500 characters")
+    {
+        return updateFrame();
+    };
+
+    poseCache->SetEnabled(true);
+    BENCHMARK("Animate 500 characters with pose cache")
+    {
+        return updateFrame();
+    };
+
+    for (AnimatedModel* animatedModel : animatedModels)
+        animatedModel->SetBoneLodDistance(0.5f);
+    BENCHMARK("Animate 500 characters with pose cache and bone LOD")
+    {
+        return updateFrame();
+    };
+
+    poseCache->SetEnabled(false);
+}
+
+TEST_CASE("Software skinning of crowd")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto model = Tests::GetOrCreateResource<Model>(context, "@/Benchmarks/Character.mdl", CreateCharacterModel);
+
+    static const unsigned numCharacters = 500;
+
+    ea::vector<SharedPtr<SoftwareModelAnimator>> animators;
+    for (unsigned i = 0; i < numCharacters; ++i)
+    {
+        auto animator = MakeShared<SoftwareModelAnimator>(context);
+        animator->Initialize(model, true, SoftwareModelAnimator::MaxBones);
+        animators.push_back(animator);
+    }
+
+    ea::vector<Matrix3x4> skinMatrices(numCharacterBones);
+    for (unsigned i = 0; i < numCharacterBones; ++i)
+        skinMatrices[i] = Matrix3x4{Vector3::UP * 0.01f * i, Quaternion{1.0f * i, Vector3::FORWARD}, 1.0f};
+
+    BENCHMARK("Software skinning of 500 characters with 2048 vertices")
+    {
+        for (SoftwareModelAnimator* animator : animators)
+            animator->ApplyAnimation({}, skinMatrices);
+        return animators.size();
+    };
+}
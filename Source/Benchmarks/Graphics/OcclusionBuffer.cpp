@@ -0,0 +1,119 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "CommonUtils.h"
+
+#include <Urho3D/Graphics/Camera.h>
+#include <Urho3D/Graphics/OcclusionBuffer.h>
+#include <Urho3D/Math/RandomEngine.h>
+#include <Urho3D/Scene/Scene.h>
+
+namespace
+{
+
+const Vector3 boxVertices[8] = {{-0.5f, -0.5f, -0.5f}, {0.5f, -0.5f, -0.5f}, {-0.5f, 0.5f, -0.5f}, {0.5f, 0.5f, -0.5f},
+    {-0.5f, -0.5f, 0.5f}, {0.5f, -0.5f, 0.5f}, {-0.5f, 0.5f, 0.5f}, {0.5f, 0.5f, 0.5f}};
+const unsigned short boxIndices[36] = {0, 2, 3, 0, 3, 1, 4, 5, 7, 4, 7, 6, 0, 4, 6, 0, 6, 2, 1, 3, 7, 1, 7, 5, 0, 1, 5,
+    0, 5, 4, 2, 6, 7, 2, 7, 3};
+
+unsigned DrawOccluders(OcclusionBuffer* buffer, Camera* camera, const ea::vector<Matrix3x4>& buildings)
+{
+    buffer->SetView(camera);
+    buffer->Clear();
+    for (const Matrix3x4& transform : buildings)
+        buffer->AddTriangles(transform, boxVertices, sizeof(Vector3), boxIndices, sizeof(unsigned short), 0, 36);
+    buffer->DrawTriangles();
+    buffer->BuildDepthHierarchy();
+    return buffer->GetNumTriangles();
+}
+
+}
+
+TEST_CASE("OcclusionBuffer in dense city")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    static const unsigned gridSize = 20;
+    static const unsigned numOccludees = 10000;
+
+    // City blocks on a grid with camera at street level
+    RandomEngine random{0};
+    ea::vector<Matrix3x4> buildings;
+    for (unsigned x = 0; x < gridSize; ++x)
+    {
+        for (unsigned z = 0; z < gridSize; ++z)
+        {
+            const Vector3 size{random.GetFloat(8.0f, 16.0f), random.GetFloat(10.0f, 60.0f), random.GetFloat(8.0f, 16.0f)};
+            const Vector3 position{(x - gridSize * 0.5f) * 20.0f, size.y_ * 0.5f, z * 20.0f + 10.0f};
+            buildings.emplace_back(position, Quaternion::IDENTITY, size);
+        }
+    }
+
+    ea::vector<BoundingBox> occludees;
+    for (unsigned i = 0; i < numOccludees; ++i)
+    {
+        const Vector3 position{random.GetFloat(-200.0f, 200.0f), random.GetFloat(0.0f, 20.0f), random.GetFloat(5.0f, 400.0f)};
+        occludees.emplace_back(position - Vector3::ONE, position + Vector3::ONE);
+    }
+
+    auto scene = MakeShared<Scene>(context);
+    Node* cameraNode = scene->CreateChild("Camera");
+    cameraNode->SetPosition({0.0f, 2.0f, 0.0f});
+    auto camera = cameraNode->CreateComponent<Camera>();
+    camera->SetAspectRatio(16.0f / 9.0f);
+    camera->SetFarClip(500.0f);
+
+    auto serialBuffer = MakeShared<OcclusionBuffer>(context);
+    serialBuffer->SetSize(256, 144, false);
+    serialBuffer->SetMaxTriangles(M_MAX_UNSIGNED);
+
+    auto threadedBuffer = MakeShared<OcclusionBuffer>(context);
+    threadedBuffer->SetSize(256, 144, true);
+    threadedBuffer->SetMaxTriangles(M_MAX_UNSIGNED);
+
+    BENCHMARK("Draw 400 buildings")
+    {
+        return DrawOccluders(serialBuffer, camera, buildings);
+    };
+
+    BENCHMARK("Draw 400 buildings in tiles")
+    {
+        return DrawOccluders(threadedBuffer, camera, buildings);
+    };
+
+    DrawOccluders(serialBuffer, camera, buildings);
+
+    BENCHMARK("Test 10000 boxes one by one")
+    {
+        unsigned numVisible = 0;
+        for (const BoundingBox& box : occludees)
+            numVisible += serialBuffer->IsVisible(box);
+        return numVisible;
+    };
+
+    ea::unique_ptr<bool[]> isVisible(new bool[numOccludees]);
+    BENCHMARK("Test 10000 boxes in batch")
+    {
+        serialBuffer->IsVisible(occludees.data(), isVisible.get(), numOccludees);
+        return isVisible[0];
+    };
+}
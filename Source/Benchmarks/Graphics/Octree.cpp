@@ -0,0 +1,117 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "BenchmarkUtils.h"
+#include "CommonUtils.h"
+
+#include <Urho3D/Graphics/Camera.h>
+#include <Urho3D/Graphics/Octree.h>
+#include <Urho3D/Graphics/StaticModel.h>
+#include <Urho3D/Math/RandomEngine.h>
+
+TEST_CASE("Octree update and queries")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto model = Tests::GetOrCreateResource<Model>(context, "@/Benchmarks/Box.mdl",
+        [](Context* context) -> SharedPtr<Resource> { return Benchmarks::CreateBoxModel(context); });
+
+    static const unsigned numDrawables = 10000;
+    static const unsigned numMovedDrawables = 1000;
+    const BoundingBox sceneBox{-Vector3::ONE * 500.0f, Vector3::ONE * 500.0f};
+
+    auto scene = MakeShared<Scene>(context);
+    auto octree = scene->CreateComponent<Octree>();
+    octree->SetSize(sceneBox, 8);
+
+    RandomEngine random{0};
+    ea::vector<Node*> nodes;
+    for (unsigned i = 0; i < numDrawables; ++i)
+    {
+        Node* node = scene->CreateChild();
+        node->SetPosition(random.GetVector3(sceneBox));
+        node->SetScale(random.GetFloat(0.5f, 4.0f));
+        auto staticModel = node->CreateComponent<StaticModel>();
+        staticModel->SetModel(model);
+        nodes.push_back(node);
+    }
+
+    Node* cameraNode = scene->CreateChild("Camera");
+    cameraNode->SetPosition({0.0f, 0.0f, -500.0f});
+    auto camera = cameraNode->CreateComponent<Camera>();
+    camera->SetFarClip(600.0f);
+
+    unsigned frameNumber = 1;
+    octree->Update(Benchmarks::CreateFrameInfo(scene, frameNumber++, 0.0f));
+
+    BENCHMARK("Octree::Update with 1000 of 10000 drawables moved")
+    {
+        for (unsigned i = 0; i < numMovedDrawables; ++i)
+        {
+            Node* node = nodes[random.GetUInt(numDrawables)];
+            node->SetPosition(random.GetVector3(sceneBox));
+        }
+        octree->Update(Benchmarks::CreateFrameInfo(scene, frameNumber++, 1.0f / 60.0f));
+        return octree->GetRootOctant()->GetNumDrawables();
+    };
+
+    BENCHMARK("Octree::Update with all 10000 drawables moved")
+    {
+        for (Node* node : nodes)
+            node->SetPosition(random.GetVector3(sceneBox));
+        octree->Update(Benchmarks::CreateFrameInfo(scene, frameNumber++, 1.0f / 60.0f));
+        return octree->GetRootOctant()->GetNumDrawables();
+    };
+
+    ea::vector<Drawable*> result;
+    BENCHMARK("Octree::GetDrawables in frustum")
+    {
+        result.clear();
+        FrustumOctreeQuery query(result, camera->GetFrustum(), DRAWABLE_GEOMETRY);
+        octree->GetDrawables(query);
+        return result.size();
+    };
+
+    BENCHMARK("Octree::GetDrawables in small box")
+    {
+        result.clear();
+        BoxOctreeQuery query(result, BoundingBox{-Vector3::ONE * 50.0f, Vector3::ONE * 50.0f}, DRAWABLE_GEOMETRY);
+        octree->GetDrawables(query);
+        return result.size();
+    };
+
+    BENCHMARK("Octree::GetDrawables in sphere")
+    {
+        result.clear();
+        SphereOctreeQuery query(result, Sphere{Vector3::ZERO, 100.0f}, DRAWABLE_GEOMETRY);
+        octree->GetDrawables(query);
+        return result.size();
+    };
+
+    ea::vector<RayQueryResult> rayResult;
+    BENCHMARK("Octree::Raycast through the scene")
+    {
+        rayResult.clear();
+        RayOctreeQuery query(rayResult, Ray{cameraNode->GetPosition(), Vector3::FORWARD}, RAY_AABB);
+        octree->Raycast(query);
+        return rayResult.size();
+    };
+}
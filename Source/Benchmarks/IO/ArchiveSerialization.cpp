@@ -0,0 +1,103 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "BenchmarkUtils.h"
+#include "CommonUtils.h"
+
+#include <Urho3D/Graphics/Light.h>
+#include <Urho3D/Graphics/Octree.h>
+#include <Urho3D/Graphics/StaticModel.h>
+#include <Urho3D/Resource/BinaryFile.h>
+#include <Urho3D/Resource/JSONFile.h>
+
+namespace
+{
+
+void PopulateScene(Scene* scene, Model* model, unsigned numNodes)
+{
+    scene->CreateComponent<Octree>();
+    for (unsigned i = 0; i < numNodes; ++i)
+    {
+        Node* node = scene->CreateChild(Format("Node {}", i));
+        node->SetPosition({static_cast<float>(i), 0.0f, 0.0f});
+        node->SetRotation({i * 10.0f, Vector3::UP});
+        node->SetVar("Index", static_cast<int>(i));
+
+        auto staticModel = node->CreateComponent<StaticModel>();
+        staticModel->SetModel(model);
+        staticModel->SetCastShadows(true);
+
+        if (i % 10 == 0)
+        {
+            Node* child = node->CreateChild("Light");
+            auto light = child->CreateComponent<Light>();
+            light->SetColor(Color::RED);
+            light->SetRange(5.0f);
+        }
+    }
+}
+
+}
+
+TEST_CASE("Scene archive serialization")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto model = Tests::GetOrCreateResource<Model>(context, "@/Benchmarks/Box.mdl",
+        [](Context* context) -> SharedPtr<Resource> { return Benchmarks::CreateBoxModel(context); });
+
+    auto sourceScene = MakeShared<Scene>(context);
+    PopulateScene(sourceScene, model, 1000);
+
+    auto destinationScene = MakeShared<Scene>(context);
+
+    BinaryFile binaryFile(context);
+    REQUIRE(binaryFile.SaveObject("scene", *sourceScene));
+
+    JSONFile jsonFile(context);
+    REQUIRE(jsonFile.SaveObject("scene", *sourceScene));
+
+    BENCHMARK("Save scene with 1000 nodes to BinaryArchive")
+    {
+        BinaryFile file(context);
+        file.SaveObject("scene", *sourceScene);
+        return file.GetData().size();
+    };
+
+    BENCHMARK("Load scene with 1000 nodes from BinaryArchive")
+    {
+        binaryFile.LoadObject("scene", *destinationScene);
+        return destinationScene->GetNumChildren();
+    };
+
+    BENCHMARK("Save scene with 1000 nodes to JSONArchive")
+    {
+        JSONFile file(context);
+        file.SaveObject("scene", *sourceScene);
+        return file.GetRoot().Size();
+    };
+
+    BENCHMARK("Load scene with 1000 nodes from JSONArchive")
+    {
+        jsonFile.LoadObject("scene", *destinationScene);
+        return destinationScene->GetNumChildren();
+    };
+}
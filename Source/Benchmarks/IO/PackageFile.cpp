@@ -0,0 +1,160 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "CommonUtils.h"
+
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/IO/PackageBuilder.h>
+#include <Urho3D/IO/PackageFile.h>
+#include <Urho3D/Math/RandomEngine.h>
+#include <Urho3D/Resource/XMLFile.h>
+
+TEST_CASE("PackageFile reads")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto fileSystem = context->GetSubsystem<FileSystem>();
+
+    static const unsigned numFiles = 64;
+    static const unsigned numElements = 1000;
+
+    ea::string xmlText = "<root>";
+    for (unsigned i = 0; i < numElements; ++i)
+        xmlText += Format("<element index=\"{}\" position=\"{} {} {}\" />", i, i, i * 2, i * 3);
+    xmlText += "</root>";
+
+    // Write uncompressed package with identical XML files
+    const ea::string packageName = fileSystem->GetTemporaryDir() + "PackageFileBenchmark.pak";
+    ea::vector<ea::string> fileNames;
+    {
+        unsigned headerSize = 3 * sizeof(unsigned);
+        for (unsigned i = 0; i < numFiles; ++i)
+        {
+            fileNames.push_back(Format("Data/File{}.xml", i));
+            headerSize += fileNames.back().size() + 1 + 3 * sizeof(unsigned);
+        }
+
+        File file(context, packageName, FILE_WRITE);
+        file.WriteFileID("UPAK");
+        file.WriteUInt(numFiles);
+        file.WriteUInt(0);
+        for (unsigned i = 0; i < numFiles; ++i)
+        {
+            file.WriteString(fileNames[i]);
+            file.WriteUInt(headerSize + i * xmlText.size());
+            file.WriteUInt(xmlText.size());
+            file.WriteUInt(1);
+        }
+        for (unsigned i = 0; i < numFiles; ++i)
+            file.Write(xmlText.data(), xmlText.size());
+    }
+
+    auto regularPackage = MakeShared<PackageFile>(context, packageName);
+    auto mappedPackage = MakeShared<PackageFile>(context, packageName);
+    mappedPackage->SetMemoryMapped(true);
+
+    const auto loadFiles = [&](PackageFile* package)
+    {
+        unsigned numLoaded = 0;
+        for (const ea::string& fileName : fileNames)
+        {
+            AbstractFilePtr file = package->OpenFile(FileIdentifier{"", fileName}, FILE_READ);
+            auto xmlFile = MakeShared<XMLFile>(context);
+            numLoaded += xmlFile->Load(*file);
+        }
+        return numLoaded;
+    };
+
+    BENCHMARK("Load 64 XML files from package")
+    {
+        return loadFiles(regularPackage);
+    };
+
+    BENCHMARK("Load 64 XML files from memory mapped package")
+    {
+        return loadFiles(mappedPackage);
+    };
+
+    regularPackage = nullptr;
+    mappedPackage = nullptr;
+    fileSystem->Delete(packageName);
+}
+
+TEST_CASE("PackageFile compressed reads")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto fileSystem = context->GetSubsystem<FileSystem>();
+
+    static const unsigned dataSize = 8 * 1024 * 1024;
+
+    ByteVector data(dataSize);
+    for (unsigned i = 0; i < dataSize; ++i)
+        data[i] = static_cast<unsigned char>((i / 7) % 13 + (i % 1021) / 97);
+
+    const ea::string packageName = fileSystem->GetTemporaryDir() + "PackageFileCompressedBenchmark.pak";
+    {
+        File file(context, packageName, FILE_WRITE);
+        PackageBuilder builder;
+        builder.Create(&file);
+        builder.Append("Data.bin", data, CompressionCodec::LZ4HC);
+        builder.Build();
+    }
+
+    auto package = MakeShared<PackageFile>(context, packageName);
+    package->SetMemoryMapped(true);
+
+    ByteVector buffer(dataSize);
+    BENCHMARK("Stream 8 MB compressed entry")
+    {
+        File file(context, package, "Data.bin");
+        return file.Read(buffer.data(), dataSize);
+    };
+
+    BENCHMARK("Decompress 8 MB compressed entry in blocks")
+    {
+        package->ReadEntry("Data.bin", buffer);
+        return buffer.size();
+    };
+
+    static const unsigned numRandomReads = 64;
+    static const unsigned randomReadSize = 4096;
+
+    RandomEngine random{0};
+    ea::vector<unsigned> randomPositions;
+    for (unsigned i = 0; i < numRandomReads; ++i)
+        randomPositions.push_back(random.GetUInt(0, dataSize - randomReadSize));
+
+    BENCHMARK("Read 64 random 4 KB chunks of 8 MB compressed entry")
+    {
+        File file(context, package, "Data.bin");
+        unsigned numRead = 0;
+        for (unsigned position : randomPositions)
+        {
+            file.Seek(position);
+            numRead += file.Read(buffer.data(), randomReadSize);
+        }
+        return numRead;
+    };
+
+    package = nullptr;
+    fileSystem->Delete(packageName);
+}
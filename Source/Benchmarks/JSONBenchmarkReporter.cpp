@@ -0,0 +1,161 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "JSONBenchmarkReporter.h"
+
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+
+namespace Benchmarks
+{
+
+namespace
+{
+
+std::string EscapeJSONString(const std::string& value)
+{
+    std::string result;
+    result.reserve(value.size() + 2);
+    result += '"';
+    for (const char ch : value)
+    {
+        switch (ch)
+        {
+        case '"': result += "\\\""; break;
+        case '\\': result += "\\\\"; break;
+        case '\n': result += "\\n"; break;
+        case '\r': result += "\\r"; break;
+        case '\t': result += "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(ch) < 0x20)
+            {
+                char buffer[8];
+                std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned>(ch));
+                result += buffer;
+            }
+            else
+                result += ch;
+            break;
+        }
+    }
+    result += '"';
+    return result;
+}
+
+}
+
+JSONBenchmarkReporter::JSONBenchmarkReporter(Catch::ReporterConfig&& config)
+    : StreamingReporterBase(CATCH_MOVE(config))
+{
+    m_preferences.shouldRedirectStdOut = false;
+    m_preferences.shouldReportAllAssertions = false;
+}
+
+std::string JSONBenchmarkReporter::getDescription()
+{
+    return "Reports benchmark results as JSON document";
+}
+
+JSONBenchmarkReporter::BenchmarkResult& JSONBenchmarkReporter::CreateResult()
+{
+    BenchmarkResult& result = results_.emplace_back();
+    result.testCase_ = currentTestCaseInfo ? currentTestCaseInfo->name : std::string{};
+    result.name_ = currentBenchmarkName_;
+    return result;
+}
+
+void JSONBenchmarkReporter::benchmarkPreparing(Catch::StringRef name)
+{
+    currentBenchmarkName_ = static_cast<std::string>(name);
+}
+
+void JSONBenchmarkReporter::benchmarkEnded(const Catch::BenchmarkStats<>& stats)
+{
+    BenchmarkResult& result = CreateResult();
+    result.name_ = stats.info.name;
+    result.samples_ = stats.info.samples;
+    result.iterations_ = stats.info.iterations;
+    result.meanNanoseconds_ = stats.mean.point.count();
+    result.meanLowerBoundNanoseconds_ = stats.mean.lower_bound.count();
+    result.meanUpperBoundNanoseconds_ = stats.mean.upper_bound.count();
+    result.standardDeviationNanoseconds_ = stats.standardDeviation.point.count();
+    result.outlierVariance_ = stats.outlierVariance;
+}
+
+void JSONBenchmarkReporter::benchmarkFailed(Catch::StringRef error)
+{
+    BenchmarkResult& result = CreateResult();
+    result.failed_ = true;
+    result.error_ = static_cast<std::string>(error);
+}
+
+void JSONBenchmarkReporter::testRunEnded(const Catch::TestRunStats& testRunStats)
+{
+    StreamingReporterBase::testRunEnded(testRunStats);
+
+    const auto timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    m_stream << std::setprecision(12);
+    m_stream << "{\n";
+    m_stream << "  \"name\": " << EscapeJSONString(std::string(testRunStats.runInfo.name)) << ",\n";
+    m_stream << "  \"timestamp\": " << timestamp << ",\n";
+    m_stream << "  \"unit\": \"ns\",\n";
+    m_stream << "  \"benchmarks\": [";
+
+    bool first = true;
+    for (const BenchmarkResult& result : results_)
+    {
+        m_stream << (first ? "\n" : ",\n");
+        first = false;
+
+        m_stream << "    {\n";
+        m_stream << "      \"testCase\": " << EscapeJSONString(result.testCase_) << ",\n";
+        m_stream << "      \"name\": " << EscapeJSONString(result.name_) << ",\n";
+        if (result.failed_)
+        {
+            m_stream << "      \"failed\": true,\n";
+            m_stream << "      \"error\": " << EscapeJSONString(result.error_) << "\n";
+        }
+        else
+        {
+            m_stream << "      \"failed\": false,\n";
+            m_stream << "      \"samples\": " << result.samples_ << ",\n";
+            m_stream << "      \"iterations\": " << result.iterations_ << ",\n";
+            m_stream << "      \"mean\": " << result.meanNanoseconds_ << ",\n";
+            m_stream << "      \"meanLowerBound\": " << result.meanLowerBoundNanoseconds_ << ",\n";
+            m_stream << "      \"meanUpperBound\": " << result.meanUpperBoundNanoseconds_ << ",\n";
+            m_stream << "      \"standardDeviation\": " << result.standardDeviationNanoseconds_ << ",\n";
+            m_stream << "      \"outlierVariance\": " << result.outlierVariance_ << "\n";
+        }
+        m_stream << "    }";
+    }
+
+    m_stream << (results_.empty() ? "]\n" : "\n  ]\n");
+    m_stream << "}\n";
+    m_stream.flush();
+}
+
+}
+
+CATCH_REGISTER_REPORTER("json", Benchmarks::JSONBenchmarkReporter)
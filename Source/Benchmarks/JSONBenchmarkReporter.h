@@ -0,0 +1,73 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include <catch2/catch_amalgamated.hpp>
+
+#include <string>
+#include <vector>
+
+namespace Benchmarks
+{
+
+/// Catch2 reporter that writes benchmark results as a single JSON document.
+/// Use "--reporter json::out=<file>" to store results for comparison between engine revisions.
+class JSONBenchmarkReporter : public Catch::StreamingReporterBase
+{
+public:
+    explicit JSONBenchmarkReporter(Catch::ReporterConfig&& config);
+
+    static std::string getDescription();
+
+    /// Implement StreamingReporterBase.
+    /// @{
+    void benchmarkPreparing(Catch::StringRef name) override;
+    void benchmarkEnded(const Catch::BenchmarkStats<>& stats) override;
+    void benchmarkFailed(Catch::StringRef error) override;
+    void testRunEnded(const Catch::TestRunStats& testRunStats) override;
+    /// @}
+
+private:
+    struct BenchmarkResult
+    {
+        std::string testCase_;
+        std::string name_;
+        bool failed_{};
+        std::string error_;
+
+        unsigned samples_{};
+        int iterations_{};
+        double meanNanoseconds_{};
+        double meanLowerBoundNanoseconds_{};
+        double meanUpperBoundNanoseconds_{};
+        double standardDeviationNanoseconds_{};
+        double outlierVariance_{};
+    };
+
+    BenchmarkResult& CreateResult();
+
+    std::vector<BenchmarkResult> results_;
+    std::string currentBenchmarkName_;
+};
+
+}
@@ -0,0 +1,111 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "CommonUtils.h"
+
+#include <Urho3D/Math/BatchMath.h>
+#include <Urho3D/Math/RandomEngine.h>
+
+namespace
+{
+
+const char* GetSIMDLevelName(SIMDLevel level)
+{
+    switch (level)
+    {
+    case SIMDLevel::SSE: return "SSE";
+    case SIMDLevel::AVX2: return "AVX2";
+    default: return "Scalar";
+    }
+}
+
+}
+
+TEST_CASE("Batch math kernels")
+{
+    static const unsigned count = 10000;
+    RandomEngine random(0);
+
+    ea::vector<Matrix3x4> transforms(count);
+    ea::vector<Matrix3x4> otherTransforms(count);
+    ea::vector<Vector3> points(count);
+    ea::vector<BoundingBox> boxes(count);
+    for (unsigned i = 0; i < count; ++i)
+    {
+        const Vector3 position{random.GetFloat(-50.0f, 50.0f), random.GetFloat(-50.0f, 50.0f), random.GetFloat(0.0f, 100.0f)};
+        const Quaternion rotation{random.GetFloat(0.0f, 360.0f), Vector3::UP};
+        transforms[i] = Matrix3x4{position, rotation, Vector3::ONE};
+        otherTransforms[i] = Matrix3x4{-position, rotation, Vector3::ONE * 2.0f};
+        points[i] = position;
+        boxes[i] = BoundingBox{position - Vector3::ONE, position + Vector3::ONE};
+    }
+
+    Frustum frustum;
+    frustum.Define(Vector3{1.0f, 1.0f, 1.0f}, Vector3{50.0f, 50.0f, 100.0f});
+
+    ea::vector<Vector3> transformedPoints(count);
+    ea::vector<BoundingBox> transformedBoxes(count);
+    ea::vector<Matrix3x4> products(count);
+    ea::unique_ptr<bool[]> isInside(new bool[count]);
+    ea::vector<int> depthValues(count, M_MAX_INT);
+
+    const SIMDLevel previousLevel = GetSIMDLevel();
+    for (SIMDLevel level : {SIMDLevel::Scalar, SIMDLevel::SSE, SIMDLevel::AVX2})
+    {
+        if (level > GetSupportedSIMDLevel())
+            continue;
+
+        SetSIMDLevel(level);
+        const ea::string suffix = Format(" ({})", GetSIMDLevelName(level));
+
+        BENCHMARK(("TransformPoints" + suffix).c_str())
+        {
+            TransformPoints(transforms[0], points.data(), transformedPoints.data(), count);
+            return transformedPoints.back();
+        };
+
+        BENCHMARK(("TransformBoundingBoxes" + suffix).c_str())
+        {
+            TransformBoundingBoxes(transforms.data(), boxes.data(), transformedBoxes.data(), count);
+            return transformedBoxes.back();
+        };
+
+        BENCHMARK(("TestBoundingBoxes" + suffix).c_str())
+        {
+            TestBoundingBoxes(frustum, boxes.data(), isInside.get(), count);
+            return isInside[count - 1];
+        };
+
+        BENCHMARK(("MultiplyMatrices" + suffix).c_str())
+        {
+            MultiplyMatrices(transforms.data(), otherTransforms.data(), products.data(), count);
+            return products.back();
+        };
+
+        BENCHMARK(("MinLinearSpan" + suffix).c_str())
+        {
+            MinLinearSpan(depthValues.data(), count, 0, 1);
+            return depthValues.back();
+        };
+    }
+    SetSIMDLevel(previousLevel);
+}
@@ -0,0 +1,113 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "CommonUtils.h"
+
+#if URHO3D_NAVIGATION
+
+#include <Urho3D/Graphics/Octree.h>
+#include <Urho3D/Graphics/Terrain.h>
+#include <Urho3D/Math/RandomEngine.h>
+#include <Urho3D/Navigation/CrowdAgent.h>
+#include <Urho3D/Navigation/CrowdManager.h>
+#include <Urho3D/Navigation/Navigable.h>
+#include <Urho3D/Navigation/NavigationMesh.h>
+#include <Urho3D/Resource/Image.h>
+#include <Urho3D/Scene/Scene.h>
+
+namespace
+{
+
+SharedPtr<Scene> CreateCrowdScene(Context* context, int heightMapSize)
+{
+    auto scene = MakeShared<Scene>(context);
+    scene->CreateComponent<Octree>();
+    scene->CreateComponent<Navigable>();
+
+    auto heightMap = MakeShared<Image>(context);
+    heightMap->SetSize(heightMapSize, heightMapSize, 1);
+    heightMap->Clear(Color::BLACK);
+
+    auto terrain = scene->CreateChild("Terrain")->CreateComponent<Terrain>();
+    terrain->SetSpacing(Vector3::ONE);
+    terrain->SetHeightMap(heightMap);
+
+    auto navMesh = scene->CreateComponent<NavigationMesh>();
+    navMesh->SetTileSize(64);
+    navMesh->Rebuild();
+    return scene;
+}
+
+void SpawnCrowd(Scene* scene, unsigned numAgents, float halfSize)
+{
+    auto crowdManager = scene->GetOrCreateComponent<CrowdManager>();
+    crowdManager->SetMaxAgents(numAgents);
+
+    RandomEngine random{0};
+    Node* agentsNode = scene->CreateChild("Agents");
+    for (unsigned i = 0; i < numAgents; ++i)
+    {
+        Node* agentNode = agentsNode->CreateChild("Agent");
+        agentNode->SetWorldPosition({random.GetFloat(-halfSize, halfSize), 0.0f, random.GetFloat(-halfSize, halfSize)});
+
+        auto agent = agentNode->CreateComponent<CrowdAgent>();
+        agent->SetMaxSpeed(3.0f);
+        agent->SetMaxAccel(5.0f);
+        agent->SetTargetPosition({random.GetFloat(-halfSize, halfSize), 0.0f, random.GetFloat(-halfSize, halfSize)});
+    }
+}
+
+}
+
+TEST_CASE("CrowdManager update of large crowds")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    static const int heightMapSize = 257;
+    static const float halfSize = 120.0f;
+    static const float timeStep = 1.0f / 60.0f;
+
+    for (unsigned numAgents : {100u, 1000u, 10000u})
+    {
+        auto scene = CreateCrowdScene(context, heightMapSize);
+        SpawnCrowd(scene, numAgents, halfSize);
+
+        // Let agents find their paths before measuring
+        for (unsigned i = 0; i < 10; ++i)
+            scene->Update(timeStep);
+
+        BENCHMARK(Format("Update crowd of {} agents", numAgents).c_str())
+        {
+            scene->Update(timeStep);
+        };
+
+        auto crowdManager = scene->GetComponent<CrowdManager>();
+        crowdManager->SetLodDistance(halfSize * 0.25f);
+        crowdManager->SetLodUpdateInterval(4);
+        BENCHMARK(Format("Update crowd of {} agents with LOD", numAgents).c_str())
+        {
+            scene->Update(timeStep);
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,159 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "CommonUtils.h"
+
+#if URHO3D_NAVIGATION
+
+#include <Urho3D/Graphics/Octree.h>
+#include <Urho3D/Graphics/Terrain.h>
+#include <Urho3D/Math/RandomEngine.h>
+#include <Urho3D/Navigation/DynamicNavigationMesh.h>
+#include <Urho3D/Navigation/Navigable.h>
+#include <Urho3D/Resource/Image.h>
+#include <Urho3D/Scene/Scene.h>
+
+namespace
+{
+
+SharedPtr<Scene> CreateTerrainScene(Context* context, int heightMapSize)
+{
+    auto scene = MakeShared<Scene>(context);
+    scene->CreateComponent<Octree>();
+    scene->CreateComponent<Navigable>();
+
+    // Rolling hills with ridges make tiles non-trivial for Recast
+    auto heightMap = MakeShared<Image>(context);
+    heightMap->SetSize(heightMapSize, heightMapSize, 1);
+    for (int y = 0; y < heightMapSize; ++y)
+    {
+        for (int x = 0; x < heightMapSize; ++x)
+        {
+            const float hills = Sin(x * 4.0f) * Cos(y * 3.0f) * 0.3f + 0.5f;
+            const float ridges = (x + y) % 37 < 2 ? 0.2f : 0.0f;
+            heightMap->SetPixel(x, y, Color(hills + ridges, 0.0f, 0.0f));
+        }
+    }
+
+    auto terrain = scene->CreateChild("Terrain")->CreateComponent<Terrain>();
+    terrain->SetSpacing(Vector3(1.0f, 0.05f, 1.0f));
+    terrain->SetHeightMap(heightMap);
+    return scene;
+}
+
+}
+
+TEST_CASE("NavigationMesh build on large terrain")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    static const int heightMapSize = 257;
+    auto scene = CreateTerrainScene(context, heightMapSize);
+
+    auto navMesh = scene->CreateComponent<NavigationMesh>();
+    navMesh->SetCellSize(0.5f);
+    navMesh->SetTileSize(32);
+
+    auto dynamicNavMesh = scene->CreateComponent<DynamicNavigationMesh>();
+    dynamicNavMesh->SetCellSize(0.5f);
+    dynamicNavMesh->SetTileSize(32);
+
+    BENCHMARK("Build NavigationMesh on 256x256 terrain")
+    {
+        return navMesh->Rebuild();
+    };
+
+    BENCHMARK("Build DynamicNavigationMesh on 256x256 terrain")
+    {
+        return dynamicNavMesh->Rebuild();
+    };
+}
+
+TEST_CASE("NavigationMesh path queries on large terrain")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    static const int heightMapSize = 257;
+    static const unsigned numPaths = 256;
+    auto scene = CreateTerrainScene(context, heightMapSize);
+
+    auto navMesh = scene->CreateComponent<NavigationMesh>();
+    navMesh->SetCellSize(0.5f);
+    navMesh->SetTileSize(32);
+    navMesh->SetMaxPathIterations(M_MAX_INT);
+    REQUIRE(navMesh->Rebuild());
+
+    RandomEngine random{0};
+    ea::vector<ea::pair<Vector3, Vector3>> endpoints;
+    for (unsigned i = 0; i < numPaths; ++i)
+    {
+        const Vector3 start{random.GetFloat(-120.0f, 120.0f), 5.0f, random.GetFloat(-120.0f, 120.0f)};
+        const Vector3 end{random.GetFloat(-120.0f, 120.0f), 5.0f, random.GetFloat(-120.0f, 120.0f)};
+        endpoints.emplace_back(start, end);
+    }
+
+    const Vector3 extents{1.0f, 10.0f, 1.0f};
+    ea::vector<NavigationPathPoint> path;
+    unsigned numPathPoints = 0;
+    const auto onPathFound = [&](unsigned requestId, const ea::vector<NavigationPathPoint>& path)
+    {
+        numPathPoints += path.size();
+    };
+    const auto requestPaths = [&]
+    {
+        numPathPoints = 0;
+        for (const auto& [start, end] : endpoints)
+            navMesh->RequestPath(start, end, onPathFound, extents);
+        while (navMesh->GetNumPathRequests() != 0)
+            navMesh->ProcessPathRequests();
+        return numPathPoints;
+    };
+
+    // Each path has at least start and end points
+    REQUIRE(requestPaths() >= 2 * numPaths);
+
+    BENCHMARK("Find 256 paths")
+    {
+        numPathPoints = 0;
+        for (const auto& [start, end] : endpoints)
+        {
+            navMesh->FindPath(path, start, end, extents);
+            numPathPoints += path.size();
+        }
+        return numPathPoints;
+    };
+
+    navMesh->SetMaxPathCacheSize(0);
+    BENCHMARK("Find 256 requested paths")
+    {
+        return requestPaths();
+    };
+
+    navMesh->SetMaxPathCacheSize(numPaths);
+    requestPaths();
+    BENCHMARK("Find 256 requested paths with cached corridors")
+    {
+        return requestPaths();
+    };
+}
+
+#endif
@@ -0,0 +1,199 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "CommonUtils.h"
+
+#include <Urho3D/IO/MemoryBuffer.h>
+#include <Urho3D/Math/BatchMath.h>
+#include <Urho3D/Particles/ParticleGraphEffect.h>
+#include <Urho3D/Particles/ParticleGraphEmitter.h>
+#include <Urho3D/Particles/ParticleGraphLayerInstance.h>
+#include <Urho3D/Scene/Scene.h>
+
+namespace
+{
+
+const char* GetSIMDLevelName(SIMDLevel level)
+{
+    switch (level)
+    {
+    case SIMDLevel::SSE: return "SSE";
+    case SIMDLevel::AVX2: return "AVX2";
+    default: return "Scalar";
+    }
+}
+
+/// Integrate velocity and position and fade size of each particle.
+const char* effectXml = R"(<particleGraphEffect>
+    <layers>
+        <layer type="ParticleGraphLayer" capacity="100000">
+            <emit>
+                <nodes>
+                </nodes>
+            </emit>
+            <init>
+                <nodes>
+                </nodes>
+            </init>
+            <update>
+                <nodes>
+                    <node id="1" name="GetAttribute">
+                        <out>
+                            <pin name="pos" type="Vector3" />
+                        </out>
+                    </node>
+                    <node id="2" name="GetAttribute">
+                        <out>
+                            <pin name="vel" type="Vector3" />
+                        </out>
+                    </node>
+                    <node id="3" name="ApplyForce">
+                        <in>
+                            <pin name="velocity" type="Vector3" node="2" pin="vel" />
+                            <pin name="force" type="Vector3" value="0 -9.81 0" />
+                        </in>
+                        <out>
+                            <pin name="out" type="Vector3" />
+                        </out>
+                    </node>
+                    <node id="4" name="SetAttribute">
+                        <in>
+                            <pin name="" type="Vector3" node="3" pin="out" />
+                        </in>
+                        <out>
+                            <pin name="vel" type="Vector3" />
+                        </out>
+                    </node>
+                    <node id="5" name="Move">
+                        <in>
+                            <pin name="position" type="Vector3" node="1" pin="pos" />
+                            <pin name="velocity" type="Vector3" node="3" pin="out" />
+                        </in>
+                        <out>
+                            <pin name="newPosition" type="Vector3" />
+                        </out>
+                    </node>
+                    <node id="6" name="SetAttribute">
+                        <in>
+                            <pin name="" type="Vector3" node="5" pin="newPosition" />
+                        </in>
+                        <out>
+                            <pin name="pos" type="Vector3" />
+                        </out>
+                    </node>
+                    <node id="7" name="GetAttribute">
+                        <out>
+                            <pin name="size" type="float" />
+                        </out>
+                    </node>
+                    <node id="8" name="Multiply">
+                        <in>
+                            <pin name="x" type="float" node="7" pin="size" />
+                            <pin name="y" type="float" value="0.99" />
+                        </in>
+                        <out>
+                            <pin name="out" type="float" />
+                        </out>
+                    </node>
+                    <node id="9" name="Add">
+                        <in>
+                            <pin name="x" type="float" node="8" pin="out" />
+                            <pin name="y" type="float" value="0.01" />
+                        </in>
+                        <out>
+                            <pin name="out" type="float" />
+                        </out>
+                    </node>
+                    <node id="10" name="SetAttribute">
+                        <in>
+                            <pin name="" type="float" node="9" pin="out" />
+                        </in>
+                        <out>
+                            <pin name="size" type="float" />
+                        </out>
+                    </node>
+                </nodes>
+            </update>
+        </layer>
+    </layers>
+</particleGraphEffect>)";
+
+}
+
+TEST_CASE("ParticleGraph update of 100k particles")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    static const unsigned numParticles = 100000;
+    const auto effect = MakeShared<ParticleGraphEffect>(context);
+    MemoryBuffer buffer(effectXml);
+    REQUIRE(effect->Load(buffer));
+
+    const auto scene = MakeShared<Scene>(context);
+    auto emitter = scene->CreateChild()->CreateComponent<ParticleGraphEmitter>();
+    emitter->SetEffect(effect);
+
+    ParticleGraphLayerInstance* layer = emitter->GetLayer(0);
+    REQUIRE(layer->EmitNewParticles(static_cast<float>(numParticles)));
+    REQUIRE(layer->GetNumActiveParticles() == numParticles);
+
+    const SIMDLevel previousLevel = GetSIMDLevel();
+    for (SIMDLevel level : {SIMDLevel::Scalar, SIMDLevel::SSE, SIMDLevel::AVX2})
+    {
+        if (level > GetSupportedSIMDLevel())
+            continue;
+
+        SetSIMDLevel(level);
+        BENCHMARK(Format("Update 100k particles ({})", GetSIMDLevelName(level)).c_str())
+        {
+            layer->Update(1.0f / 60.0f, false);
+            return layer->GetNumActiveParticles();
+        };
+    }
+    SetSIMDLevel(previousLevel);
+}
+
+TEST_CASE("ParticleGraph update of many emitters")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    const auto effect = MakeShared<ParticleGraphEffect>(context);
+    MemoryBuffer buffer(effectXml);
+    REQUIRE(effect->Load(buffer));
+
+    for (unsigned numEmitters : {10u, 100u, 500u})
+    {
+        static const unsigned numParticles = 1000;
+        const auto scene = MakeShared<Scene>(context);
+        for (unsigned i = 0; i < numEmitters; ++i)
+        {
+            auto emitter = scene->CreateChild()->CreateComponent<ParticleGraphEmitter>();
+            emitter->SetEffect(effect);
+            REQUIRE(emitter->GetLayer(0)->EmitNewParticles(static_cast<float>(numParticles)));
+        }
+
+        BENCHMARK(Format("Update {} emitters of 1k particles", numEmitters).c_str())
+        {
+            scene->Update(1.0f / 60.0f);
+        };
+    }
+}
@@ -0,0 +1,181 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "CommonUtils.h"
+
+#if URHO3D_PHYSICS
+
+#include <Urho3D/Math/RandomEngine.h>
+#include <Urho3D/Physics/CollisionShape.h>
+#include <Urho3D/Physics/PhysicsWorld.h>
+#include <Urho3D/Physics/RigidBody.h>
+#include <Urho3D/Scene/Scene.h>
+
+namespace
+{
+
+SharedPtr<Scene> CreateBoxPileScene(Context* context, unsigned numBoxes, bool multithreaded)
+{
+    const PhysicsWorldConfig previousConfig = PhysicsWorld::config;
+    PhysicsWorld::config.multithreaded_ = multithreaded;
+
+    auto scene = MakeShared<Scene>(context);
+    scene->CreateComponent<PhysicsWorld>();
+    PhysicsWorld::config = previousConfig;
+
+    Node* groundNode = scene->CreateChild("Ground");
+    groundNode->SetPosition({0.0f, -0.5f, 0.0f});
+    groundNode->SetScale({200.0f, 1.0f, 200.0f});
+    groundNode->CreateComponent<RigidBody>();
+    groundNode->CreateComponent<CollisionShape>()->SetBox(Vector3::ONE);
+
+    // Separate piles of boxes form independent simulation islands
+    static const unsigned pileHeight = 10;
+    const auto pilesPerRow = static_cast<unsigned>(Ceil(Sqrt(static_cast<float>(numBoxes / pileHeight))));
+    for (unsigned i = 0; i < numBoxes; ++i)
+    {
+        const unsigned pileIndex = i / pileHeight;
+        const float x = (pileIndex % pilesPerRow) * 3.0f - pilesPerRow * 1.5f;
+        const float z = (pileIndex / pilesPerRow) * 3.0f - pilesPerRow * 1.5f;
+        const float y = (i % pileHeight) * 1.1f + 0.5f;
+
+        Node* boxNode = scene->CreateChild("Box");
+        boxNode->SetPosition({x, y, z});
+        boxNode->CreateComponent<RigidBody>()->SetMass(1.0f);
+        boxNode->CreateComponent<CollisionShape>()->SetBox(Vector3::ONE);
+    }
+
+    return scene;
+}
+
+} // namespace
+
+TEST_CASE("PhysicsWorld update of box piles")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    for (unsigned numBoxes : {1000u, 4000u})
+    {
+        for (bool multithreaded : {false, true})
+        {
+            const auto scene = CreateBoxPileScene(context, numBoxes, multithreaded);
+            auto physicsWorld = scene->GetComponent<PhysicsWorld>();
+
+            // Let boxes collide so benchmark measures settled contacts
+            for (unsigned i = 0; i < 10; ++i)
+                physicsWorld->Update(1.0f / 60.0f);
+
+            BENCHMARK(Format("Update {} boxes ({})", numBoxes, multithreaded ? "MT" : "ST").c_str())
+            {
+                physicsWorld->Update(1.0f / 60.0f);
+            };
+        }
+    }
+}
+
+TEST_CASE("PhysicsWorld raycasts")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    const auto scene = CreateBoxPileScene(context, 4000, false);
+    auto physicsWorld = scene->GetComponent<PhysicsWorld>();
+    physicsWorld->UpdateCollisions();
+
+    static const unsigned numRays = 10000;
+    RandomEngine random(0);
+    ea::vector<PhysicsRaycastQuery> queries(numRays);
+    for (PhysicsRaycastQuery& query : queries)
+    {
+        const Vector3 origin = random.GetVector3({-100.0f, 0.0f, -100.0f}, {100.0f, 10.0f, 100.0f});
+        query.ray_ = Ray{origin, random.GetDirectionVector3()};
+        query.maxDistance_ = 50.0f;
+    }
+    ea::vector<PhysicsRaycastResult> results(numRays);
+
+    BENCHMARK("RaycastSingle of 10k rays")
+    {
+        for (unsigned i = 0; i < numRays; ++i)
+            physicsWorld->RaycastSingle(results[i], queries[i].ray_, queries[i].maxDistance_, queries[i].collisionMask_);
+        return results.back().distance_;
+    };
+
+    BENCHMARK("RaycastSingleBatch of 10k rays")
+    {
+        physicsWorld->RaycastSingleBatch(results, queries);
+        return results.back().distance_;
+    };
+}
+
+TEST_CASE("PhysicsWorld collision reporting")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    for (bool collisionEvents : {true, false})
+    {
+        const auto scene = CreateBoxPileScene(context, 4000, false);
+        auto physicsWorld = scene->GetComponent<PhysicsWorld>();
+        physicsWorld->SetCollisionEventsEnabled(collisionEvents);
+
+        // Keep all boxes active so contacts are reported on every step
+        for (Node* node : scene->GetChildren(false))
+            node->GetComponent<RigidBody>()->SetCollisionEventMode(COLLISION_ALWAYS);
+
+        for (unsigned i = 0; i < 10; ++i)
+            physicsWorld->Update(1.0f / 60.0f);
+
+        BENCHMARK(Format("Update 4000 boxes ({})", collisionEvents ? "events" : "contact stream only").c_str())
+        {
+            physicsWorld->Update(1.0f / 60.0f);
+            return physicsWorld->GetContactPairs().size();
+        };
+    }
+}
+
+TEST_CASE("PhysicsWorld transform sync")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    // Put most piles to sleep so only a fraction of boxes is moving on each update
+    const auto scene = CreateBoxPileScene(context, 10000, false);
+    auto physicsWorld = scene->GetComponent<PhysicsWorld>();
+    for (unsigned i = 0; i < 300; ++i)
+        physicsWorld->Update(1.0f / 60.0f);
+
+    ea::vector<RigidBody*> bodies;
+    for (Node* node : scene->GetChildren(false))
+    {
+        if (node->GetName() == "Box")
+            bodies.push_back(node->GetComponent<RigidBody>());
+    }
+
+    // Keep every 10th pile of 10 boxes awake
+    BENCHMARK("Update 10000 boxes with 10% awake")
+    {
+        for (unsigned i = 9; i < bodies.size(); i += 100)
+            bodies[i]->ApplyImpulse({0.0f, 0.1f, 0.0f});
+
+        physicsWorld->Update(1.0f / 60.0f);
+        return bodies.front()->GetPosition().y_;
+    };
+}
+
+#endif
@@ -0,0 +1,166 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "CommonUtils.h"
+#include "NetworkUtils.h"
+#include "SceneUtils.h"
+
+#if URHO3D_NETWORK
+#include <Urho3D/Network/Network.h>
+#include <Urho3D/Replica/BehaviorNetworkObject.h>
+#include <Urho3D/Replica/FilteredByDistance.h>
+#include <Urho3D/Replica/NetworkSettingsConsts.h>
+#include <Urho3D/Replica/ReplicatedTransform.h>
+#include <Urho3D/Replica/ReplicationManager.h>
+#include <Urho3D/Scene/PrefabResource.h>
+
+namespace
+{
+
+SharedPtr<Resource> CreateReplicatedPrefab(Context* context)
+{
+    auto node = MakeShared<Node>(context);
+    node->CreateComponent<ReplicatedTransform>();
+    return Tests::ConvertNodeToPrefab(node);
+}
+
+SharedPtr<Resource> CreateFilteredPrefab(Context* context)
+{
+    auto node = MakeShared<Node>(context);
+    node->CreateComponent<ReplicatedTransform>();
+    auto filter = node->CreateComponent<FilteredByDistance>();
+    filter->SetRelevant(false);
+    filter->SetDistance(15.0f);
+    return Tests::ConvertNodeToPrefab(node);
+}
+
+}
+
+TEST_CASE("ServerReplicator scene update")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    context->GetSubsystem<Network>()->SetUpdateFps(Tests::NetworkSimulator::FramesInSecond);
+
+    auto prefab = Tests::GetOrCreateResource<PrefabResource>(
+        context, "@/Benchmarks/ServerReplicator/Replicated.prefab", CreateReplicatedPrefab);
+
+    static const unsigned numObjects = 1000;
+    static const unsigned numClients = 4;
+    const auto quality = Tests::ConnectionQuality{0.08f, 0.12f, 0.20f, 0, 0};
+
+    auto serverScene = MakeShared<Scene>(context);
+    ea::vector<Node*> serverNodes;
+    for (unsigned i = 0; i < numObjects; ++i)
+    {
+        const Vector3 position{static_cast<float>(i % 32), 0.0f, static_cast<float>(i / 32)};
+        serverNodes.push_back(Tests::SpawnOnServer<BehaviorNetworkObject>(
+            serverScene, prefab, Format("Object {}", i), position));
+    }
+
+    ea::vector<SharedPtr<Scene>> clientScenes;
+    for (unsigned i = 0; i < numClients; ++i)
+        clientScenes.push_back(MakeShared<Scene>(context));
+
+    Tests::NetworkSimulator sim(serverScene);
+    for (Scene* clientScene : clientScenes)
+        sim.AddClient(clientScene, quality);
+
+    // Let clients synchronize
+    sim.SimulateTime(2.0f);
+
+    const float networkFrameTime = 1.0f / Tests::NetworkSimulator::FramesInSecond;
+    BENCHMARK("Network frame with 1000 moving objects and 4 clients")
+    {
+        for (Node* node : serverNodes)
+            node->Translate(Vector3::UP * 0.01f);
+        sim.SimulateTime(networkFrameTime);
+        return serverNodes.size();
+    };
+
+    for (Scene* clientScene : clientScenes)
+        sim.RemoveClient(clientScene);
+
+    BENCHMARK("Network frame with 1000 moving objects and no clients")
+    {
+        for (Node* node : serverNodes)
+            node->Translate(Vector3::UP * 0.01f);
+        sim.SimulateTime(networkFrameTime);
+        return serverNodes.size();
+    };
+}
+
+TEST_CASE("ServerReplicator relevance of many objects for many clients")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    context->GetSubsystem<Network>()->SetUpdateFps(Tests::NetworkSimulator::FramesInSecond);
+
+    auto prefab = Tests::GetOrCreateResource<PrefabResource>(
+        context, "@/Benchmarks/ServerReplicator/Filtered.prefab", CreateFilteredPrefab);
+
+    static const unsigned numObjects = 5000;
+    static const unsigned numClients = 32;
+    const auto quality = Tests::ConnectionQuality{0.08f, 0.12f, 0.20f, 0, 0};
+
+    for (float cellSize : {0.0f, 16.0f})
+    {
+        auto serverScene = MakeShared<Scene>(context);
+        Tests::NetworkSimulator sim(serverScene);
+        serverScene->GetComponent<ReplicationManager>()->GetServerReplicator()->SetSetting(
+            NetworkSettings::InterestGridCellSize, cellSize);
+
+        ea::vector<Node*> serverNodes;
+        for (unsigned i = 0; i < numObjects; ++i)
+        {
+            const Vector3 position{static_cast<float>(i % 100) * 2.0f, 0.0f, static_cast<float>(i / 100) * 2.0f};
+            serverNodes.push_back(Tests::SpawnOnServer<BehaviorNetworkObject>(
+                serverScene, prefab, Format("Object {}", i), position));
+        }
+
+        ea::vector<SharedPtr<Scene>> clientScenes;
+        for (unsigned i = 0; i < numClients; ++i)
+        {
+            clientScenes.push_back(MakeShared<Scene>(context));
+            sim.AddClient(clientScenes.back(), quality);
+
+            const Vector3 position{static_cast<float>(i % 8) * 25.0f, 0.0f, static_cast<float>(i / 8) * 25.0f};
+            Node* playerNode = Tests::SpawnOnServer<BehaviorNetworkObject>(
+                serverScene, prefab, Format("Player {}", i), position);
+            playerNode->GetComponent<BehaviorNetworkObject>()->SetOwner(
+                sim.GetServerToClientConnection(clientScenes.back()));
+        }
+
+        // Let clients synchronize
+        sim.SimulateTime(2.0f);
+
+        // Move some objects on each frame so there are dirty cells
+        const float networkFrameTime = 1.0f / Tests::NetworkSimulator::FramesInSecond;
+        BENCHMARK(Format("Network frame with {} objects and {} clients ({})", numObjects, numClients,
+            cellSize > 0.0f ? "interest grid" : "callbacks").c_str())
+        {
+            for (unsigned i = 0; i < numObjects; i += 100)
+                serverNodes[i]->Translate(Vector3::UP * 0.01f);
+            sim.SimulateTime(networkFrameTime);
+            return serverNodes.size();
+        };
+    }
+}
+#endif
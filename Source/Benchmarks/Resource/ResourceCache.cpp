@@ -0,0 +1,76 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "CommonUtils.h"
+
+#include <Urho3D/Resource/BinaryFile.h>
+#include <Urho3D/Resource/ResourceCache.h>
+
+TEST_CASE("ResourceCache lookups")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto cache = context->GetSubsystem<ResourceCache>();
+
+    static const unsigned numResources = 1000;
+
+    ea::vector<ea::string> resourceNames;
+    for (unsigned i = 0; i < numResources; ++i)
+    {
+        const ea::string name = Format("@/Benchmarks/ResourceCache/Resource{}.bin", i);
+        Tests::GetOrCreateResource<BinaryFile>(context, name, [](Context* context) -> SharedPtr<Resource>
+        {
+            auto binaryFile = MakeShared<BinaryFile>(context);
+            binaryFile->SetText("Test");
+            return binaryFile;
+        });
+        resourceNames.push_back(name);
+    }
+
+    const ea::vector<ea::string> missingNames{
+        "@/Benchmarks/ResourceCache/Missing0.bin",
+        "@/Benchmarks/ResourceCache/Missing1.bin",
+    };
+
+    BENCHMARK("ResourceCache::GetResource for 1000 loaded resources")
+    {
+        unsigned numFound = 0;
+        for (const ea::string& name : resourceNames)
+            numFound += cache->GetResource<BinaryFile>(name) != nullptr;
+        return numFound;
+    };
+
+    BENCHMARK("ResourceCache::GetExistingResource for 1000 loaded resources")
+    {
+        unsigned numFound = 0;
+        for (const ea::string& name : resourceNames)
+            numFound += cache->GetExistingResource<BinaryFile>(name) != nullptr;
+        return numFound;
+    };
+
+    BENCHMARK("ResourceCache::GetExistingResource for missing resources")
+    {
+        unsigned numFound = 0;
+        for (const ea::string& name : missingNames)
+            numFound += cache->GetExistingResource<BinaryFile>(name) != nullptr;
+        return numFound;
+    };
+}
@@ -0,0 +1,66 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "CommonUtils.h"
+
+#include <Urho3D/Scene/LogicComponent.h>
+#include <Urho3D/Scene/Scene.h>
+
+namespace
+{
+
+class BenchmarkLogicComponent : public LogicComponent
+{
+    URHO3D_OBJECT(BenchmarkLogicComponent, LogicComponent);
+
+public:
+    explicit BenchmarkLogicComponent(Context* context) : LogicComponent(context) {}
+
+    void Update(float timeStep) override { accumulator_ += timeStep; }
+    void PostUpdate(float timeStep) override { accumulator_ -= timeStep * 0.5f; }
+
+    float accumulator_{};
+};
+
+}
+
+TEST_CASE("LogicComponent update dispatch")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto guard = Tests::MakeScopedReflection<BenchmarkLogicComponent>(context);
+
+    static const unsigned numComponents = 5000;
+
+    auto scene = MakeShared<Scene>(context);
+    ea::vector<BenchmarkLogicComponent*> components;
+    for (unsigned i = 0; i < numComponents; ++i)
+        components.push_back(scene->CreateChild()->CreateComponent<BenchmarkLogicComponent>());
+
+    // Invoke DelayedStart outside of benchmark
+    scene->Update(1.0f / 60.0f);
+
+    BENCHMARK("Update scene with 5000 LogicComponents")
+    {
+        scene->Update(1.0f / 60.0f);
+        return components.back()->accumulator_;
+    };
+}
@@ -0,0 +1,173 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "CommonUtils.h"
+
+#include <Urho3D/Scene/Scene.h>
+
+namespace
+{
+
+void CreateWideHierarchy(Node* parent, unsigned numChildren, unsigned depth, ea::vector<Node*>& leaves)
+{
+    if (depth == 0)
+    {
+        leaves.push_back(parent);
+        return;
+    }
+
+    for (unsigned i = 0; i < numChildren; ++i)
+    {
+        Node* child = parent->CreateChild();
+        child->SetPosition({static_cast<float>(i), 1.0f, 0.0f});
+        child->SetRotation({10.0f, Vector3::UP});
+        CreateWideHierarchy(child, numChildren, depth - 1, leaves);
+    }
+}
+
+}
+
+TEST_CASE("Node transform propagation")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto scene = MakeShared<Scene>(context);
+
+    // 10x10x10 tree: 1110 nodes, 1000 leaves
+    Node* wideRoot = scene->CreateChild("Wide");
+    ea::vector<Node*> wideLeaves;
+    CreateWideHierarchy(wideRoot, 10, 3, wideLeaves);
+
+    // 10 chains of 100 nodes each
+    Node* deepRoot = scene->CreateChild("Deep");
+    ea::vector<Node*> deepLeaves;
+    for (unsigned chainIndex = 0; chainIndex < 10; ++chainIndex)
+    {
+        Node* node = deepRoot;
+        for (unsigned depth = 0; depth < 100; ++depth)
+        {
+            node = node->CreateChild();
+            node->SetPosition({0.0f, 1.0f, 0.0f});
+        }
+        deepLeaves.push_back(node);
+    }
+
+    // 10000 independent nodes
+    Node* flatRoot = scene->CreateChild("Flat");
+    ea::vector<Node*> flatNodes;
+    for (unsigned i = 0; i < 10000; ++i)
+        flatNodes.push_back(flatRoot->CreateChild());
+
+    float offset = 0.0f;
+    BENCHMARK("Move root of 10x10x10 tree and read 1000 leaves")
+    {
+        offset += 1.0f;
+        wideRoot->SetPosition({offset, 0.0f, 0.0f});
+        Vector3 sum;
+        for (Node* leaf : wideLeaves)
+            sum += leaf->GetWorldPosition();
+        return sum;
+    };
+
+    BENCHMARK("Move root of 10x10x10 tree")
+    {
+        offset += 1.0f;
+        wideRoot->SetPosition({offset, 0.0f, 0.0f});
+        return wideRoot->GetWorldPosition();
+    };
+
+    BENCHMARK("Move root of 10 chains of 100 nodes and read leaves")
+    {
+        offset += 1.0f;
+        deepRoot->SetPosition({offset, 0.0f, 0.0f});
+        Vector3 sum;
+        for (Node* leaf : deepLeaves)
+            sum += leaf->GetWorldPosition();
+        return sum;
+    };
+
+    BENCHMARK("Move 10000 independent nodes")
+    {
+        offset += 1.0f;
+        Vector3 sum;
+        for (Node* node : flatNodes)
+        {
+            node->SetPosition({offset, 0.0f, 0.0f});
+            sum += node->GetWorldPosition();
+        }
+        return sum;
+    };
+}
+
+TEST_CASE("Node transform batch update")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    const auto createScene = [&](ea::vector<Node*>& roots, ea::vector<Node*>& leaves)
+    {
+        auto scene = MakeShared<Scene>(context);
+        // 10000 moving objects with 2 child nodes each
+        for (unsigned i = 0; i < 10000; ++i)
+        {
+            Node* root = scene->CreateChild();
+            root->SetPosition({static_cast<float>(i), 0.0f, 0.0f});
+            Node* child = root->CreateChild();
+            child->SetPosition({0.0f, 1.0f, 0.0f});
+            Node* leaf = child->CreateChild();
+            leaf->SetPosition({0.0f, 1.0f, 0.0f});
+            roots.push_back(root);
+            leaves.push_back(leaf);
+        }
+        return scene;
+    };
+
+    ea::vector<Node*> lazyRoots, lazyLeaves;
+    auto lazyScene = createScene(lazyRoots, lazyLeaves);
+
+    ea::vector<Node*> batchRoots, batchLeaves;
+    auto batchScene = createScene(batchRoots, batchLeaves);
+    batchScene->SetTransformStoreEnabled(true);
+    batchScene->UpdateWorldTransforms();
+
+    float angle = 0.0f;
+    BENCHMARK("Rotate 10000 objects and read leaves")
+    {
+        angle += 1.0f;
+        for (Node* root : lazyRoots)
+            root->SetRotation({angle, Vector3::UP});
+        Vector3 sum;
+        for (Node* leaf : lazyLeaves)
+            sum += leaf->GetWorldPosition();
+        return sum;
+    };
+
+    BENCHMARK("Rotate 10000 objects and read leaves with TransformStore")
+    {
+        angle += 1.0f;
+        for (Node* root : batchRoots)
+            root->SetRotation({angle, Vector3::UP});
+        batchScene->UpdateWorldTransforms();
+        Vector3 sum;
+        for (Node* leaf : batchLeaves)
+            sum += leaf->GetWorldPosition();
+        return sum;
+    };
+}
@@ -75,7 +75,11 @@ void HugeObjectCount::CreateScene()
     auto* cache = GetSubsystem<ResourceCache>();
 
     if (!scene_)
+    {
         scene_ = new Scene(context_);
+        // Recalculate world transforms of moving boxes in batch
+        scene_->SetTransformStoreEnabled(true);
+    }
     else
     {
         scene_->Clear();
@@ -0,0 +1,115 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Container/LinearArena.h>
+#include <Urho3D/Core/CoreEvents.h>
+#include <Urho3D/Core/FrameArena.h>
+#include <Urho3D/Scene/Scene.h>
+
+TEST_CASE("LinearArena allocates aligned memory and merges blocks on reset")
+{
+    LinearArena arena(256);
+
+    auto first = static_cast<unsigned char*>(arena.Allocate(3, 1));
+    auto second = static_cast<unsigned char*>(arena.Allocate(16, 16));
+    REQUIRE(first != nullptr);
+    REQUIRE(reinterpret_cast<uintptr_t>(second) % 16 == 0);
+    REQUIRE(second >= first + 3);
+    REQUIRE(arena.GetNumBlocks() == 1);
+
+    // Overflow the first block
+    for (unsigned i = 0; i < 10; ++i)
+    {
+        auto values = arena.AllocateArray<double>(16);
+        REQUIRE(reinterpret_cast<uintptr_t>(values) % alignof(double) == 0);
+        for (unsigned j = 0; j < 16; ++j)
+            values[j] = j;
+    }
+    REQUIRE(arena.GetNumBlocks() > 1);
+    const unsigned capacity = arena.GetCapacity();
+    REQUIRE(arena.GetUsedMemory() <= capacity);
+    REQUIRE(arena.GetHighWaterMark() == arena.GetUsedMemory());
+
+    arena.Reset();
+    REQUIRE(arena.GetNumBlocks() == 1);
+    REQUIRE(arena.GetCapacity() == capacity);
+    REQUIRE(arena.GetUsedMemory() == 0);
+    REQUIRE(arena.GetHighWaterMark() > 0);
+
+    // Same workload fits into merged block
+    for (unsigned i = 0; i < 10; ++i)
+        arena.AllocateArray<double>(16);
+    REQUIRE(arena.GetNumBlocks() == 1);
+}
+
+TEST_CASE("FrameArena is reset at the end of the frame")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto frameArena = context->GetSubsystem<FrameArena>();
+    REQUIRE(frameArena);
+    REQUIRE(FrameArena::GetInstance() == frameArena);
+
+    frameArena->SendEvent(E_ENDFRAME);
+    REQUIRE(frameArena->GetUsedMemory() == 0);
+
+    {
+        FrameVector<int> values;
+        for (int i = 0; i < 1000; ++i)
+            values.push_back(i);
+
+        REQUIRE(values.size() == 1000);
+        REQUIRE(values[999] == 999);
+        REQUIRE(frameArena->GetUsedMemory() >= 1000 * sizeof(int));
+    }
+
+    frameArena->SendEvent(E_ENDFRAME);
+    REQUIRE(frameArena->GetUsedMemory() == 0);
+    REQUIRE(frameArena->GetHighWaterMark() >= 1000 * sizeof(int));
+}
+
+TEST_CASE("FrameArena frame is driven manually outside of the engine loop")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto frameArena = context->GetSubsystem<FrameArena>();
+    auto scene = MakeShared<Scene>(context);
+
+    frameArena->EndFrame();
+    REQUIRE_FALSE(frameArena->IsInFrame());
+
+    // Memory should stay valid across scene updates within the frame
+    frameArena->BeginFrame();
+    REQUIRE(frameArena->IsInFrame());
+
+    {
+        FrameVector<int> values(1000, 42);
+        scene->Update(0.1f);
+        scene->Update(0.1f);
+        REQUIRE(frameArena->GetUsedMemory() >= 1000 * sizeof(int));
+        REQUIRE(values[999] == 42);
+    }
+
+    frameArena->EndFrame();
+    REQUIRE_FALSE(frameArena->IsInFrame());
+    REQUIRE(frameArena->GetUsedMemory() == 0);
+}
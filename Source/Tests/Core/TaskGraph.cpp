@@ -0,0 +1,129 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Core/TaskGraph.h>
+
+#include <atomic>
+
+TEST_CASE("WorkQueue::ParallelFor processes every element exactly once")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto workQueue = context->GetSubsystem<WorkQueue>();
+
+    for (const unsigned size : {0u, 1u, 7u, 1000u, 100000u})
+    {
+        ea::vector<std::atomic<unsigned>> counters(size);
+        std::atomic<bool> invalidRange{};
+        workQueue->ParallelFor(size, 16, [&](unsigned beginIndex, unsigned endIndex, unsigned threadIndex)
+        {
+            if (beginIndex >= endIndex || endIndex > size || threadIndex >= WorkQueue::GetThreadIndexCount())
+                invalidRange = true;
+            for (unsigned i = beginIndex; i < endIndex; ++i)
+                counters[i].fetch_add(1, std::memory_order_relaxed);
+        });
+
+        REQUIRE_FALSE(invalidRange.load());
+        for (const auto& counter : counters)
+            REQUIRE(counter.load() == 1);
+    }
+}
+
+TEST_CASE("TaskGraph executes nodes after their dependencies")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto workQueue = context->GetSubsystem<WorkQueue>();
+
+    static constexpr unsigned numElements = 10000;
+    ea::vector<unsigned> values(numElements);
+    std::atomic<unsigned> sum{};
+    std::atomic<unsigned> order{};
+    unsigned fillOrder{};
+    unsigned sumOrder{};
+    unsigned finalOrder{};
+
+    TaskGraph graph(workQueue);
+    const auto fill = graph.AddParallelFor(numElements, 64,
+        [&](unsigned beginIndex, unsigned endIndex, unsigned)
+    {
+        for (unsigned i = beginIndex; i < endIndex; ++i)
+            values[i] = i % 10;
+    });
+    const auto fillDone = graph.Then(fill, [&] { fillOrder = order++; });
+    const auto accumulate = graph.AddParallelFor(numElements, 64,
+        [&](unsigned beginIndex, unsigned endIndex, unsigned)
+    {
+        unsigned localSum = 0;
+        for (unsigned i = beginIndex; i < endIndex; ++i)
+            localSum += values[i];
+        sum += localSum;
+    });
+    graph.AddDependency(accumulate, fillDone);
+    const auto accumulateDone = graph.Then(accumulate, [&] { sumOrder = order++; });
+    std::atomic<bool> invalidThreadIndex{};
+    const auto independent = graph.AddTask([&](unsigned threadIndex)
+    {
+        if (threadIndex >= WorkQueue::GetThreadIndexCount())
+            invalidThreadIndex = true;
+    });
+    const auto finalize = graph.Then(accumulateDone, [&] { finalOrder = order++; });
+    graph.AddDependency(finalize, independent);
+
+    REQUIRE(graph.GetNumNodes() == 6);
+
+    for (unsigned iteration = 0; iteration < 3; ++iteration)
+    {
+        sum = 0;
+        order = 0;
+
+        graph.Execute();
+
+        REQUIRE_FALSE(graph.IsRunning());
+        REQUIRE_FALSE(invalidThreadIndex.load());
+        REQUIRE(sum.load() == 45 * (numElements / 10));
+        REQUIRE(fillOrder == 0);
+        REQUIRE(sumOrder == 1);
+        REQUIRE(finalOrder == 2);
+    }
+}
+
+TEST_CASE("TaskGraph can be launched and joined later")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto workQueue = context->GetSubsystem<WorkQueue>();
+
+    std::atomic<unsigned> counter{};
+
+    TaskGraph graph(workQueue);
+    for (unsigned i = 0; i < 16; ++i)
+        graph.AddTask([&] { ++counter; });
+    graph.AddParallelFor(0, 1, [&](unsigned, unsigned, unsigned) { ++counter; });
+
+    graph.Launch();
+    graph.Wait();
+    REQUIRE(counter.load() == 16);
+
+    graph.Clear();
+    REQUIRE(graph.GetNumNodes() == 0);
+    graph.Execute();
+}
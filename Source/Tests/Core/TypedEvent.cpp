@@ -0,0 +1,253 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Core/TypedEvent.h>
+#include <Urho3D/Scene/LogicComponent.h>
+#include <Urho3D/Scene/Scene.h>
+#include <Urho3D/Scene/SceneEvents.h>
+
+namespace
+{
+
+URHO3D_EVENT(E_TESTTYPEDEVENT, TestTypedEvent)
+{
+    URHO3D_PARAM(P_VALUE, Value); // int
+}
+
+struct TestTypedEventData
+{
+    int value_{};
+
+    void ToEventData(VariantMap& eventData) const { eventData[TestTypedEvent::P_VALUE] = value_; }
+    void FromEventData(VariantMap& eventData) { value_ = eventData[TestTypedEvent::P_VALUE].GetInt(); }
+};
+
+class TestReceiver : public Object
+{
+    URHO3D_OBJECT(TestReceiver, Object);
+
+public:
+    explicit TestReceiver(Context* context) : Object(context) {}
+
+    void OnEvent(TestTypedEventData& eventData) { values_.push_back(eventData.value_); }
+
+    ea::vector<int> values_;
+};
+
+class TestLogicComponent : public LogicComponent
+{
+    URHO3D_OBJECT(TestLogicComponent, LogicComponent);
+
+public:
+    explicit TestLogicComponent(Context* context) : LogicComponent(context) {}
+
+    void DelayedStart() override { ++numDelayedStarts_; }
+    void Update(float timeStep) override { updateTime_ += timeStep; }
+    void PostUpdate(float timeStep) override { postUpdateTime_ += timeStep; }
+
+    unsigned numDelayedStarts_{};
+    float updateTime_{};
+    float postUpdateTime_{};
+};
+
+}
+
+TEST_CASE("TypedEvent is delivered to typed and VariantMap receivers")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto sender = MakeShared<TestReceiver>(context);
+    auto receiver1 = MakeShared<TestReceiver>(context);
+    auto receiver2 = MakeShared<TestReceiver>(context);
+    auto legacyReceiver = MakeShared<TestReceiver>(context);
+
+    TypedEvent<TestTypedEventData> event{sender, E_TESTTYPEDEVENT};
+    bool isFirstSend = true;
+    event.Subscribe(receiver1.Get(), &TestReceiver::OnEvent);
+    event.Subscribe(receiver2.Get(),
+        [&](TestReceiver* self, TestTypedEventData& eventData)
+    {
+        self->values_.push_back(eventData.value_ * 10);
+        // Subscription during send is deferred
+        if (isFirstSend)
+        {
+            event.Subscribe(legacyReceiver.Get(), &TestReceiver::OnEvent);
+            REQUIRE(event.IsSubscribed(legacyReceiver));
+            isFirstSend = false;
+        }
+        // Unsubscription during send is immediate
+        event.Unsubscribe(receiver1);
+    });
+
+    TestTypedEventData eventData{1};
+    event.Send(eventData);
+    REQUIRE(receiver1->values_ == ea::vector<int>{1});
+    REQUIRE(receiver2->values_ == ea::vector<int>{10});
+    REQUIRE(legacyReceiver->values_.empty());
+    REQUIRE(event.GetNumReceivers() == 2);
+
+    event.Unsubscribe(legacyReceiver);
+    legacyReceiver->SubscribeToEvent(sender, E_TESTTYPEDEVENT,
+        [&](VariantMap& eventData) { legacyReceiver->values_.push_back(eventData[TestTypedEvent::P_VALUE].GetInt()); });
+
+    eventData.value_ = 2;
+    event.Send(eventData);
+    REQUIRE(receiver1->values_ == ea::vector<int>{1});
+    REQUIRE(receiver2->values_ == ea::vector<int>{10, 20});
+    REQUIRE(legacyReceiver->values_ == ea::vector<int>{2});
+
+    // Expired receivers are removed
+    receiver2 = nullptr;
+    legacyReceiver->UnsubscribeFromAllEvents();
+    eventData.value_ = 3;
+    event.Send(eventData);
+    REQUIRE(legacyReceiver->values_ == ea::vector<int>{2});
+    REQUIRE(event.GetNumReceivers() == 0);
+}
+
+TEST_CASE("TypedEvent keeps order of subscription and event sender of VariantMap receivers")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto sender = MakeShared<TestReceiver>(context);
+    auto typedReceiver1 = MakeShared<TestReceiver>(context);
+    auto legacyReceiver1 = MakeShared<TestReceiver>(context);
+    auto typedReceiver2 = MakeShared<TestReceiver>(context);
+    auto legacyReceiver2 = MakeShared<TestReceiver>(context);
+
+    TypedEvent<TestTypedEventData> event{sender, E_TESTTYPEDEVENT};
+
+    ea::vector<int> order;
+    const auto onTypedEvent = [&](TestReceiver* self, TestTypedEventData& eventData)
+    {
+        REQUIRE(self->GetEventSender() == sender);
+        order.push_back(self->values_.front());
+    };
+    const auto onLegacyEvent = [&](TestReceiver* self)
+    {
+        REQUIRE(self->GetEventSender() == sender);
+        order.push_back(self->values_.front());
+    };
+
+    typedReceiver1->values_ = {1};
+    legacyReceiver1->values_ = {2};
+    typedReceiver2->values_ = {3};
+    legacyReceiver2->values_ = {4};
+
+    // Receivers of any sender go after the receivers of this sender, same as in Object::SendEvent
+    legacyReceiver2->SubscribeToEvent(E_TESTTYPEDEVENT, [&] { onLegacyEvent(legacyReceiver2); });
+    event.Subscribe(typedReceiver1.Get(), onTypedEvent);
+    legacyReceiver1->SubscribeToEvent(sender, E_TESTTYPEDEVENT, [&] { onLegacyEvent(legacyReceiver1); });
+    event.Subscribe(typedReceiver2.Get(), onTypedEvent);
+
+    TestTypedEventData eventData{0};
+    event.Send(eventData);
+    REQUIRE(order == ea::vector<int>{1, 2, 3, 4});
+    REQUIRE(sender->GetEventSender() == nullptr);
+
+    // Typed subscriptions are regular subscriptions
+    typedReceiver1->UnsubscribeFromAllEvents();
+    REQUIRE_FALSE(event.IsSubscribed(typedReceiver1));
+    REQUIRE(event.IsSubscribed(typedReceiver2));
+
+    order.clear();
+    event.Send(eventData);
+    REQUIRE(order == ea::vector<int>{2, 3, 4});
+
+    // Typed receivers get the event sent via Object::SendEvent
+    typedReceiver2->UnsubscribeFromAllEvents();
+    event.Subscribe(typedReceiver2.Get(), &TestReceiver::OnEvent);
+
+    VariantMap& legacyEventData = sender->GetEventDataMap();
+    legacyEventData[TestTypedEvent::P_VALUE] = 5;
+    sender->SendEvent(E_TESTTYPEDEVENT, legacyEventData);
+    REQUIRE(typedReceiver2->values_ == ea::vector<int>{3, 5});
+}
+
+TEST_CASE("LogicComponent receives typed scene update events")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto guard = Tests::MakeScopedReflection<TestLogicComponent>(context);
+
+    auto scene = MakeShared<Scene>(context);
+    auto component = scene->CreateChild()->CreateComponent<TestLogicComponent>();
+
+    float legacyTimeStep = 0.0f;
+    auto legacyReceiver = MakeShared<TestReceiver>(context);
+    legacyReceiver->SubscribeToEvent(scene, E_SCENEUPDATE,
+        [&](VariantMap& eventData) { legacyTimeStep += eventData[SceneUpdate::P_TIMESTEP].GetFloat(); });
+
+    scene->Update(0.5f);
+    scene->Update(0.25f);
+    REQUIRE(component->numDelayedStarts_ == 1);
+    REQUIRE(component->updateTime_ == 0.75f);
+    REQUIRE(component->postUpdateTime_ == 0.75f);
+    REQUIRE(legacyTimeStep == 0.75f);
+
+    component->SetEnabled(false);
+    scene->Update(1.0f);
+    REQUIRE(component->updateTime_ == 0.75f);
+
+    component->SetEnabled(true);
+    component->SetUpdateEventMask(USE_POSTUPDATE);
+    scene->Update(1.0f);
+    REQUIRE(component->updateTime_ == 0.75f);
+    REQUIRE(component->postUpdateTime_ == 1.75f);
+
+    // Moving component to another scene drops subscriptions to the old one
+    auto otherScene = MakeShared<Scene>(context);
+    SharedPtr<Node> node{component->GetNode()};
+    otherScene->AddChild(node);
+    scene->Update(1.0f);
+    REQUIRE(component->postUpdateTime_ == 1.75f);
+    otherScene->Update(1.0f);
+    REQUIRE(component->postUpdateTime_ == 2.75f);
+}
+
+TEST_CASE("LogicComponent and VariantMap receivers get scene update in order of subscription")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto guard = Tests::MakeScopedReflection<TestLogicComponent>(context);
+
+    auto scene = MakeShared<Scene>(context);
+    TestLogicComponent* component = nullptr;
+
+    ea::vector<ea::string> order;
+    const auto onPostUpdate = [&](float expectedTime)
+    { order.push_back(component->postUpdateTime_ == expectedTime ? "After" : "Before"); };
+
+    auto legacyReceiver = MakeShared<TestReceiver>(context);
+    legacyReceiver->SubscribeToEvent(scene, E_SCENEPOSTUPDATE, [&] { onPostUpdate(0.5f); });
+
+    component = scene->CreateChild()->CreateComponent<TestLogicComponent>();
+    component->SetUpdateEventMask(USE_POSTUPDATE);
+    scene->Update(0.5f);
+    REQUIRE(component->postUpdateTime_ == 0.5f);
+    REQUIRE(order == ea::vector<ea::string>{"Before"});
+
+    // Resubscribed receiver goes last
+    legacyReceiver->UnsubscribeFromAllEvents();
+    legacyReceiver->SubscribeToEvent(scene, E_SCENEPOSTUPDATE, [&] { onPostUpdate(1.0f); });
+    order.clear();
+    scene->Update(0.5f);
+    REQUIRE(order == ea::vector<ea::string>{"After"});
+}
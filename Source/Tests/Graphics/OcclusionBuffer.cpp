@@ -0,0 +1,137 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Graphics/Camera.h>
+#include <Urho3D/Graphics/OcclusionBuffer.h>
+#include <Urho3D/Math/BatchMath.h>
+#include <Urho3D/Math/RandomEngine.h>
+#include <Urho3D/Scene/Scene.h>
+
+namespace
+{
+
+/// Return triangle list of a box, both windings to be independent from culling.
+ea::vector<Vector3> CreateBoxTriangles(const BoundingBox& box)
+{
+    const Vector3& a = box.min_;
+    const Vector3& b = box.max_;
+    const Vector3 corners[8] = {{a.x_, a.y_, a.z_}, {b.x_, a.y_, a.z_}, {a.x_, b.y_, a.z_}, {b.x_, b.y_, a.z_},
+        {a.x_, a.y_, b.z_}, {b.x_, a.y_, b.z_}, {a.x_, b.y_, b.z_}, {b.x_, b.y_, b.z_}};
+    const unsigned faces[6][4] = {{0, 1, 3, 2}, {4, 6, 7, 5}, {0, 2, 6, 4}, {1, 5, 7, 3}, {0, 4, 5, 1}, {2, 3, 7, 6}};
+
+    ea::vector<Vector3> result;
+    for (const auto& face : faces)
+    {
+        for (unsigned index : {face[0], face[1], face[2], face[0], face[2], face[3]})
+            result.push_back(corners[index]);
+    }
+    return result;
+}
+
+ea::vector<int> RenderOccluders(OcclusionBuffer* buffer, Camera* camera, const ea::vector<ea::vector<Vector3>>& occluders)
+{
+    buffer->SetView(camera);
+    buffer->Clear();
+    for (const auto& vertices : occluders)
+        buffer->AddTriangles(Matrix3x4::IDENTITY, vertices.data(), sizeof(Vector3), 0, vertices.size());
+    buffer->DrawTriangles();
+    buffer->BuildDepthHierarchy();
+
+    const int* data = buffer->GetBuffer();
+    return ea::vector<int>(data, data + buffer->GetWidth() * buffer->GetHeight());
+}
+
+}
+
+TEST_CASE("OcclusionBuffer rasterizes tiles in threads and tests boxes in batches")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto scene = MakeShared<Scene>(context);
+    auto camera = scene->CreateChild("Camera")->CreateComponent<Camera>();
+    camera->SetAspectRatio(2.0f);
+    camera->SetFarClip(200.0f);
+
+    // Wall in front of the camera and random boxes, some of them crossing the screen edges and near plane
+    RandomEngine random{0};
+    ea::vector<ea::vector<Vector3>> occluders;
+    occluders.push_back(CreateBoxTriangles(BoundingBox{Vector3{-5.0f, -3.0f, 20.0f}, Vector3{5.0f, 3.0f, 21.0f}}));
+    for (unsigned i = 0; i < 50; ++i)
+    {
+        const Vector3 position{random.GetFloat(-60.0f, 60.0f), random.GetFloat(-30.0f, 30.0f), random.GetFloat(0.0f, 100.0f)};
+        const Vector3 halfSize{random.GetFloat(0.5f, 8.0f), random.GetFloat(0.5f, 8.0f), random.GetFloat(0.5f, 8.0f)};
+        occluders.push_back(CreateBoxTriangles(BoundingBox{position - halfSize, position + halfSize}));
+    }
+
+    auto serialBuffer = MakeShared<OcclusionBuffer>(context);
+    REQUIRE(serialBuffer->SetSize(256, 128, false));
+    serialBuffer->SetMaxTriangles(M_MAX_UNSIGNED);
+    const ea::vector<int> serialData = RenderOccluders(serialBuffer, camera, occluders);
+
+    auto threadedBuffer = MakeShared<OcclusionBuffer>(context);
+    REQUIRE(threadedBuffer->SetSize(256, 128, true));
+    threadedBuffer->SetMaxTriangles(M_MAX_UNSIGNED);
+    REQUIRE(threadedBuffer->IsThreaded());
+
+    // Rasterization is exact, so all SIMD levels and tiled rendering should produce the same buffer
+    const SIMDLevel previousLevel = GetSIMDLevel();
+    for (SIMDLevel level : {SIMDLevel::Scalar, SIMDLevel::SSE, SIMDLevel::AVX2})
+    {
+        if (level > GetSupportedSIMDLevel())
+            continue;
+
+        SetSIMDLevel(level);
+        REQUIRE(RenderOccluders(serialBuffer, camera, occluders) == serialData);
+        REQUIRE(RenderOccluders(threadedBuffer, camera, occluders) == serialData);
+    }
+    SetSIMDLevel(previousLevel);
+
+    // Box right behind the wall is occluded, boxes in front of the wall and outside of the screen are visible
+    REQUIRE_FALSE(threadedBuffer->IsVisible(BoundingBox{Vector3{-1.0f, -1.0f, 30.0f}, Vector3{1.0f, 1.0f, 32.0f}}));
+    REQUIRE(threadedBuffer->IsVisible(BoundingBox{Vector3{-1.0f, -1.0f, 10.0f}, Vector3{1.0f, 1.0f, 12.0f}}));
+    REQUIRE(threadedBuffer->IsVisible(BoundingBox{Vector3{-500.0f, -1.0f, 30.0f}, Vector3{-498.0f, 1.0f, 32.0f}}));
+
+    // Batch test should match individual tests
+    static const unsigned numBoxes = 1000;
+    ea::vector<BoundingBox> boxes;
+    for (unsigned i = 0; i < numBoxes; ++i)
+    {
+        const Vector3 position{random.GetFloat(-80.0f, 80.0f), random.GetFloat(-40.0f, 40.0f), random.GetFloat(-5.0f, 150.0f)};
+        const Vector3 halfSize = Vector3::ONE * random.GetFloat(0.1f, 3.0f);
+        boxes.push_back(BoundingBox{position - halfSize, position + halfSize});
+    }
+
+    bool isVisible[numBoxes];
+    threadedBuffer->IsVisible(boxes.data(), isVisible, numBoxes);
+
+    unsigned numVisible = 0;
+    for (unsigned i = 0; i < numBoxes; ++i)
+    {
+        REQUIRE(isVisible[i] == threadedBuffer->IsVisible(boxes[i]));
+        REQUIRE(isVisible[i] == serialBuffer->IsVisible(boxes[i]));
+        numVisible += isVisible[i];
+    }
+    REQUIRE(numVisible > 0);
+    REQUIRE(numVisible < numBoxes);
+}
@@ -0,0 +1,132 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+#include "../ModelUtils.h"
+
+#include <Urho3D/Graphics/Model.h>
+#include <Urho3D/Graphics/Octree.h>
+#include <Urho3D/Graphics/StaticModel.h>
+#include <Urho3D/Math/RandomEngine.h>
+#include <Urho3D/Scene/Scene.h>
+
+namespace
+{
+
+FrameInfo MakeFrameInfo(unsigned frameNumber)
+{
+    FrameInfo frameInfo;
+    frameInfo.frameNumber_ = frameNumber;
+    frameInfo.timeStep_ = 1.0f / 60.0f;
+    return frameInfo;
+}
+
+}
+
+TEST_CASE("Octree reinserts moved drawables in batch")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto model = Tests::CreateSkinnedQuad_Model(context)->ExportModel();
+
+    static const unsigned numDrawables = 2000;
+    const BoundingBox sceneBox{-Vector3::ONE * 100.0f, Vector3::ONE * 100.0f};
+
+    auto scene = MakeShared<Scene>(context);
+    auto octree = scene->CreateComponent<Octree>();
+    octree->SetSize(sceneBox, 6);
+
+    RandomEngine random{0};
+    ea::vector<Node*> nodes;
+    ea::vector<StaticModel*> staticModels;
+    for (unsigned i = 0; i < numDrawables; ++i)
+    {
+        Node* node = scene->CreateChild();
+        node->SetPosition(random.GetVector3(sceneBox));
+        node->SetScale(random.GetFloat(0.1f, 20.0f));
+        auto staticModel = node->CreateComponent<StaticModel>();
+        staticModel->SetModel(model);
+        staticModel->SetOccludee(i % 7 != 0);
+        nodes.push_back(node);
+        staticModels.push_back(staticModel);
+    }
+
+    unsigned frameNumber = 1;
+    octree->Update(MakeFrameInfo(frameNumber++));
+
+    for (unsigned iteration = 0; iteration < 3; ++iteration)
+    {
+        // Move some drawables far away and some outside of the octree
+        ea::vector<Octant*> oldOctants;
+        for (StaticModel* staticModel : staticModels)
+            oldOctants.push_back(staticModel->GetOctant());
+
+        for (unsigned i = iteration; i < numDrawables; i += 3)
+        {
+            const float scale = i % 11 == 0 ? 2.0f : 1.0f;
+            nodes[i]->SetPosition(random.GetVector3(sceneBox) * scale);
+        }
+        octree->Update(MakeFrameInfo(frameNumber++));
+
+        // Reinserted drawables should end up in the same octants as if they were inserted one by one
+        for (unsigned i = 0; i < numDrawables; ++i)
+        {
+            StaticModel* staticModel = staticModels[i];
+            Octant* octant = staticModel->GetOctant();
+            REQUIRE(octant);
+            if (octant == oldOctants[i])
+                continue;
+
+            octree->GetRootOctant()->InsertDrawable(staticModel);
+            REQUIRE(staticModel->GetOctant() == octant);
+            if (octant != octree->GetRootOctant())
+                REQUIRE(octant->GetCullingBox().IsInside(staticModel->GetWorldBoundingBox()) == INSIDE);
+        }
+        REQUIRE(octree->GetRootOctant()->GetNumDrawables() == numDrawables);
+
+        // Queries should return the same drawables as brute force test
+        ea::vector<Drawable*> result;
+        const BoundingBox queryBox{-Vector3::ONE * 30.0f, Vector3::ONE * 30.0f};
+        BoxOctreeQuery query(result, queryBox, DRAWABLE_GEOMETRY);
+        octree->GetDrawables(query);
+
+        unsigned numExpected = 0;
+        for (StaticModel* staticModel : staticModels)
+        {
+            if (queryBox.IsInsideFast(staticModel->GetWorldBoundingBox()) != OUTSIDE)
+            {
+                ++numExpected;
+                REQUIRE(result.contains(staticModel));
+            }
+        }
+        REQUIRE(result.size() == numExpected);
+    }
+
+    // Remove drawables to release octants and add them back
+    for (StaticModel* staticModel : staticModels)
+        staticModel->SetEnabled(false);
+    REQUIRE(octree->GetRootOctant()->GetNumDrawables() == 0);
+
+    for (StaticModel* staticModel : staticModels)
+        staticModel->SetEnabled(true);
+    octree->Update(MakeFrameInfo(frameNumber++));
+    REQUIRE(octree->GetRootOctant()->GetNumDrawables() == numDrawables);
+}
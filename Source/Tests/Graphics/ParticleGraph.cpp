@@ -492,3 +492,237 @@ TEST_CASE("Test Make IntVector2")
     auto attributeSpan = emitter->GetLayer(0)->GetAttributeValues<IntVector2>(0);
     CHECK(attributeSpan[0] == IntVector2(2, 3));
 }
+
+TEST_CASE("Test particle graph update in blocks")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    const auto effect = MakeShared<ParticleGraphEffect>(context);
+    auto xml = R"(<particleGraphEffect>
+    <layers>
+	    <layer type="ParticleGraphLayer" capacity="10000">
+		    <emit>
+			    <nodes>
+			    </nodes>
+		    </emit>
+		    <init>
+			    <nodes>
+			    </nodes>
+		    </init>
+		    <update>
+			    <nodes>
+				    <node id="1" name="GetAttribute">
+					    <out>
+						    <pin name="pos" type="Vector3" />
+					    </out>
+				    </node>
+				    <node id="2" name="GetAttribute">
+					    <out>
+						    <pin name="vel" type="Vector3" />
+					    </out>
+				    </node>
+				    <node id="3" name="ApplyForce">
+					    <in>
+						    <pin name="velocity" type="Vector3" node="2" pin="vel" />
+						    <pin name="force" type="Vector3" value="0 -5 0" />
+					    </in>
+					    <out>
+						    <pin name="out" type="Vector3" />
+					    </out>
+				    </node>
+				    <node id="4" name="SetAttribute">
+					    <in>
+						    <pin name="" type="Vector3" node="3" pin="out" />
+					    </in>
+					    <out>
+						    <pin name="vel" type="Vector3" />
+					    </out>
+				    </node>
+				    <node id="5" name="Move">
+					    <in>
+						    <pin name="position" type="Vector3" node="1" pin="pos" />
+						    <pin name="velocity" type="Vector3" node="3" pin="out" />
+					    </in>
+					    <out>
+						    <pin name="newPosition" type="Vector3" />
+					    </out>
+				    </node>
+				    <node id="6" name="SetAttribute">
+					    <in>
+						    <pin name="" type="Vector3" node="5" pin="newPosition" />
+					    </in>
+					    <out>
+						    <pin name="pos" type="Vector3" />
+					    </out>
+				    </node>
+				    <node id="7" name="GetAttribute">
+					    <out>
+						    <pin name="lifetime" type="float" />
+					    </out>
+				    </node>
+				    <node id="8" name="Expire">
+					    <in>
+						    <pin name="time" type="float" value="0.1" />
+						    <pin name="lifetime" type="float" node="7" pin="lifetime" />
+					    </in>
+				    </node>
+			    </nodes>
+		    </update>
+	    </layer>
+    </layers>
+</particleGraphEffect>)";
+    MemoryBuffer buffer(xml);
+    REQUIRE(effect->Load(buffer));
+
+    const auto scene = MakeShared<Scene>(context);
+    const auto node = scene->CreateChild();
+    auto emitter = node->CreateComponent<ParticleGraphEmitter>();
+    emitter->SetEffect(effect);
+
+    // Use enough particles to update the graph in several blocks, possibly from several threads
+    static const unsigned numParticles = 10000;
+    REQUIRE(numParticles > ParticleGraphLayerInstance::UpdateBlockSize * ParticleGraphLayerInstance::MinBlocksPerTask * 2);
+    for (unsigned i = 0; i < numParticles; ++i)
+        REQUIRE(emitter->EmitNewParticle(0));
+
+    ParticleGraphLayerInstance* layer = emitter->GetLayer(0);
+    const ParticleGraphAttributeLayout& attributes = layer->GetLayer()->GetAttributeLayout();
+    const auto findAttribute = [&](const ea::string& name)
+    {
+        for (unsigned i = 0; i < attributes.GetNumAttributes(); ++i)
+        {
+            if (attributes.GetName(i) == name)
+                return i;
+        }
+        return M_MAX_UNSIGNED;
+    };
+    const unsigned posIndex = findAttribute("pos");
+    const unsigned velIndex = findAttribute("vel");
+    const unsigned lifetimeIndex = findAttribute("lifetime");
+    REQUIRE(posIndex != M_MAX_UNSIGNED);
+    REQUIRE(velIndex != M_MAX_UNSIGNED);
+    REQUIRE(lifetimeIndex != M_MAX_UNSIGNED);
+
+    // Every third particle expires, the rest are moved to fill the gaps
+    auto pos = layer->GetAttributeValues<Vector3>(posIndex);
+    auto vel = layer->GetAttributeValues<Vector3>(velIndex);
+    auto lifetime = layer->GetAttributeValues<float>(lifetimeIndex);
+    for (unsigned i = 0; i < numParticles; ++i)
+    {
+        pos[i] = Vector3(static_cast<float>(i), 0.0f, 0.0f);
+        vel[i] = Vector3::UP;
+        lifetime[i] = i % 3 == 0 ? 0.05f : 10.0f;
+    }
+
+    Tests::RunFrame(context, 0.1f, 0.1f);
+
+    const unsigned numAlive = numParticles - (numParticles + 2) / 3;
+    REQUIRE(layer->GetNumActiveParticles() == numAlive);
+
+    pos = layer->GetAttributeValues<Vector3>(posIndex);
+    vel = layer->GetAttributeValues<Vector3>(velIndex);
+    lifetime = layer->GetAttributeValues<float>(lifetimeIndex);
+    ea::vector<bool> isAlive(numParticles);
+    for (unsigned i = 0; i < numAlive; ++i)
+    {
+        const unsigned particle = static_cast<unsigned>(pos[i].x_);
+        REQUIRE(particle < numParticles);
+        REQUIRE(particle % 3 != 0);
+        REQUIRE(!isAlive[particle]);
+        isAlive[particle] = true;
+
+        REQUIRE(vel[i].Equals(Vector3(0.0f, 0.5f, 0.0f)));
+        REQUIRE(pos[i].Equals(Vector3(static_cast<float>(particle), 0.05f, 0.0f)));
+        REQUIRE(lifetime[i] == 10.0f);
+    }
+}
+
+TEST_CASE("Test particle graph emitters updated by ParticleGraphSystem")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    const auto effect = MakeShared<ParticleGraphEffect>(context);
+    auto xml = R"(<particleGraphEffect>
+    <layers>
+        <layer type="ParticleGraphLayer" capacity="10">
+            <emit>
+                <nodes>
+                </nodes>
+            </emit>
+            <init>
+                <nodes>
+                </nodes>
+            </init>
+            <update>
+                <nodes>
+                    <node id="1" name="GetAttribute">
+                        <out>
+                            <pin name="counter" type="float" />
+                        </out>
+                    </node>
+                    <node id="2" name="Add">
+                        <in>
+                            <pin name="x" type="float" node="1" pin="counter" />
+                            <pin name="y" type="float" value="1" />
+                        </in>
+                        <out>
+                            <pin name="out" type="float" />
+                        </out>
+                    </node>
+                    <node id="3" name="SetAttribute">
+                        <in>
+                            <pin name="" type="float" node="2" pin="out" />
+                        </in>
+                        <out>
+                            <pin name="counter" type="float" />
+                        </out>
+                    </node>
+                </nodes>
+            </update>
+        </layer>
+    </layers>
+</particleGraphEffect>)";
+    MemoryBuffer buffer(xml);
+    REQUIRE(effect->Load(buffer));
+
+    const auto createEmitter = [&](Scene* scene)
+    {
+        auto emitter = scene->CreateChild()->CreateComponent<ParticleGraphEmitter>();
+        emitter->SetEffect(effect);
+        REQUIRE(emitter->GetLayer(0)->EmitNewParticles(4.0f));
+        REQUIRE(emitter->IsThreadSafe());
+        return WeakPtr<ParticleGraphEmitter>(emitter);
+    };
+    const auto getCounter = [](ParticleGraphEmitter* emitter)
+    {
+        return emitter->GetLayer(0)->GetAttributeValues<float>(0)[0];
+    };
+
+    const auto scene = MakeShared<Scene>(context);
+    const auto otherScene = MakeShared<Scene>(context);
+    ea::vector<WeakPtr<ParticleGraphEmitter>> emitters;
+    for (unsigned i = 0; i < 8; ++i)
+        emitters.push_back(createEmitter(scene));
+    const auto disabledEmitter = createEmitter(scene);
+    disabledEmitter->SetEnabled(false);
+    const auto otherEmitter = createEmitter(otherScene);
+    const auto removedEmitter = createEmitter(scene);
+    removedEmitter->Remove();
+    REQUIRE(!removedEmitter);
+
+    scene->Update(0.1f);
+    scene->Update(0.1f);
+
+    for (ParticleGraphEmitter* emitter : emitters)
+    {
+        const auto values = emitter->GetLayer(0)->GetAttributeValues<float>(0);
+        for (unsigned i = 0; i < emitter->GetLayer(0)->GetNumActiveParticles(); ++i)
+            CHECK(values[i] == 2.0f);
+    }
+    CHECK(getCounter(disabledEmitter) == 0.0f);
+    CHECK(getCounter(otherEmitter) == 0.0f);
+
+    otherScene->Update(0.1f);
+    CHECK(getCounter(otherEmitter) == 1.0f);
+    CHECK(getCounter(emitters[0]) == 2.0f);
+}
@@ -0,0 +1,153 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+#include "../ModelUtils.h"
+
+#include <Urho3D/Graphics/Model.h>
+#include <Urho3D/Graphics/ModelView.h>
+#include <Urho3D/Graphics/SoftwareModelAnimator.h>
+#include <Urho3D/Graphics/VertexBuffer.h>
+
+namespace
+{
+
+Vector3 GetVertexPosition(VertexBuffer* vertexBuffer, unsigned index)
+{
+    Vector3 position;
+    memcpy(&position, vertexBuffer->GetShadowData() + index * vertexBuffer->GetVertexSize(), sizeof(Vector3));
+    return position;
+}
+
+Vector3 GetVertexNormal(VertexBuffer* vertexBuffer, unsigned index)
+{
+    const unsigned offset = vertexBuffer->GetElementOffset(SEM_NORMAL);
+    Vector3 normal;
+    memcpy(&normal, vertexBuffer->GetShadowData() + index * vertexBuffer->GetVertexSize() + offset, sizeof(Vector3));
+    return normal;
+}
+
+}
+
+TEST_CASE("SoftwareModelAnimator skins large vertex buffers in parallel")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    // Enough vertices to be split between several threads, 4 vertices per quad
+    static const unsigned numQuads = SoftwareModelAnimator::MinVerticesPerTask + 3;
+    static const unsigned numSkinMatrices = 4;
+
+    auto modelView = MakeShared<ModelView>(context);
+    auto& geometries = modelView->GetGeometries();
+    geometries.resize(1);
+    geometries[0].lods_.resize(1);
+    GeometryLODView& geometry = geometries[0].lods_[0];
+    geometry.vertexFormat_ = Tests::GetVertexFormat();
+    geometry.vertexFormat_.blendIndices_ = TYPE_UBYTE4;
+    geometry.vertexFormat_.blendWeights_ = TYPE_VECTOR4;
+    for (unsigned i = 0; i < numQuads; ++i)
+    {
+        const Vector4 blendIndices{static_cast<float>(i % 4), static_cast<float>((i + 1) % 4), 2.0f, 3.0f};
+        const Vector4 blendWeights{0.4f, 0.3f, 0.2f, 0.1f};
+        Tests::AppendSkinnedQuad(geometry, blendIndices, blendWeights,
+            {0.0f, 0.01f * i, 0.0f}, {3.0f * i, Vector3::UP}, {1.0f, 1.0f}, Color::WHITE);
+    }
+    auto model = modelView->ExportModel();
+
+    ea::vector<Matrix3x4> skinMatrices(numSkinMatrices);
+    for (unsigned i = 0; i < numSkinMatrices; ++i)
+        skinMatrices[i] = Matrix3x4{Vector3::UP * i, Quaternion{15.0f * i, Vector3::FORWARD}, 1.0f + 0.1f * i};
+
+    auto animator = MakeShared<SoftwareModelAnimator>(context);
+    animator->Initialize(model, true, SoftwareModelAnimator::MaxBones);
+    REQUIRE(animator->ApplyAnimation({}, skinMatrices));
+
+    VertexBuffer* originalBuffer = model->GetVertexBuffers()[0];
+    VertexBuffer* skinnedBuffer = animator->GetVertexBuffers()[0];
+    REQUIRE(skinnedBuffer->GetVertexCount() == numQuads * 4);
+    for (unsigned vertexIndex = 0; vertexIndex < skinnedBuffer->GetVertexCount(); ++vertexIndex)
+    {
+        const ModelVertex& vertex = geometry.vertices_[vertexIndex];
+        Matrix3x4 matrix = Matrix3x4::ZERO;
+        for (unsigned i = 0; i < SoftwareModelAnimator::MaxBones; ++i)
+            matrix = matrix + skinMatrices[static_cast<unsigned>(vertex.blendIndices_.Data()[i])] * vertex.blendWeights_.Data()[i];
+
+        const Vector3 expectedPosition = matrix * GetVertexPosition(originalBuffer, vertexIndex);
+        const Vector3 expectedNormal = matrix.ToMatrix3() * GetVertexNormal(originalBuffer, vertexIndex);
+        REQUIRE(GetVertexPosition(skinnedBuffer, vertexIndex).Equals(expectedPosition, 0.0001f));
+        REQUIRE(GetVertexNormal(skinnedBuffer, vertexIndex).Equals(expectedNormal, 0.0001f));
+    }
+}
+
+TEST_CASE("SoftwareModelAnimator skips vertex buffers with unchanged morphs")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    // Geometries have different formats and are stored in different vertex buffers
+    auto modelView = MakeShared<ModelView>(context);
+    auto& geometries = modelView->GetGeometries();
+    geometries.resize(2);
+    geometries[0].lods_.resize(1);
+    geometries[1].lods_.resize(1);
+    Tests::AppendQuad(geometries[0].lods_[0], {0.0f, 0.5f, 0.0f}, {0.0f, Vector3::UP}, {1.0f, 1.0f}, Color::WHITE);
+    Tests::AppendQuad(geometries[1].lods_[0], {0.0f, 0.5f, 0.0f}, {90.0f, Vector3::UP}, {1.0f, 1.0f}, Color::WHITE);
+    geometries[0].lods_[0].morphs_[0].push_back(ModelVertexMorph{1, {0.0f, 1.0f, 0.0f}});
+    geometries[1].lods_[0].morphs_[1].push_back(ModelVertexMorph{2, {0.0f, 2.0f, 0.0f}});
+    geometries[0].lods_[0].vertexFormat_ = Tests::GetVertexFormat();
+    geometries[1].lods_[0].vertexFormat_.position_ = TYPE_VECTOR3;
+    auto model = modelView->ExportModel();
+    REQUIRE(model->GetVertexBuffers().size() == 2);
+
+    auto animator = MakeShared<SoftwareModelAnimator>(context);
+    animator->Initialize(model, false, 0);
+    VertexBuffer* firstBuffer = animator->GetVertexBuffers()[0];
+    VertexBuffer* secondBuffer = animator->GetVertexBuffers()[1];
+    const Vector3 firstPosition = GetVertexPosition(firstBuffer, 1);
+    const Vector3 secondPosition = GetVertexPosition(secondBuffer, 2);
+
+    // Nothing to update if morphs are not changed
+    ea::vector<ModelMorph> morphs = model->GetMorphs();
+    REQUIRE(morphs.size() == 2);
+    REQUIRE_FALSE(animator->ApplyAnimation(morphs, {}));
+
+    // Only the first buffer is affected by the first morph
+    morphs[0].weight_ = 0.5f;
+    REQUIRE(animator->ApplyAnimation(morphs, {}));
+    REQUIRE(GetVertexPosition(firstBuffer, 1).Equals(firstPosition + Vector3{0.0f, 0.5f, 0.0f}));
+    REQUIRE(GetVertexPosition(secondBuffer, 2).Equals(secondPosition));
+
+    // Break morphed vertex in the second buffer to make sure it's not touched
+    unsigned char* secondVertexData = secondBuffer->GetShadowData() + 2 * secondBuffer->GetVertexSize();
+    memset(secondVertexData, 0, sizeof(Vector3));
+    morphs[0].weight_ = 1.0f;
+    REQUIRE(animator->ApplyAnimation(morphs, {}));
+    REQUIRE(GetVertexPosition(firstBuffer, 1).Equals(firstPosition + Vector3{0.0f, 1.0f, 0.0f}));
+    REQUIRE(GetVertexPosition(secondBuffer, 2) == Vector3::ZERO);
+
+    REQUIRE_FALSE(animator->ApplyAnimation(morphs, {}));
+
+    // Second buffer is restored when its morph is changed
+    morphs[1].weight_ = 0.25f;
+    REQUIRE(animator->ApplyAnimation(morphs, {}));
+    REQUIRE(GetVertexPosition(firstBuffer, 1).Equals(firstPosition + Vector3{0.0f, 1.0f, 0.0f}));
+    REQUIRE(GetVertexPosition(secondBuffer, 2).Equals(secondPosition + Vector3{0.0f, 0.5f, 0.0f}));
+}
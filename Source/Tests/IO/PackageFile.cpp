@@ -0,0 +1,369 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/IO/MemoryMappedFile.h>
+#include <Urho3D/IO/MountedDirectory.h>
+#include <Urho3D/IO/PackageBuilder.h>
+#include <Urho3D/IO/PackageFile.h>
+#include <Urho3D/IO/VectorBuffer.h>
+#include <Urho3D/Math/RandomEngine.h>
+#include <Urho3D/Resource/Image.h>
+#include <Urho3D/Resource/XMLFile.h>
+
+namespace
+{
+
+/// Write uncompressed package file in UPAK format.
+bool WritePackage(Context* context, const ea::string& fileName, const ea::vector<ea::pair<ea::string, ByteVector>>& files)
+{
+    unsigned headerSize = 3 * sizeof(unsigned);
+    for (const auto& [name, data] : files)
+        headerSize += name.size() + 1 + 3 * sizeof(unsigned);
+
+    File file(context, fileName, FILE_WRITE);
+    if (!file.IsOpen())
+        return false;
+
+    file.WriteFileID("UPAK");
+    file.WriteUInt(files.size());
+    file.WriteUInt(0);
+
+    unsigned offset = headerSize;
+    for (const auto& [name, data] : files)
+    {
+        unsigned checksum = 0;
+        for (unsigned char value : data)
+            checksum = SDBMHash(checksum, value);
+
+        file.WriteString(name);
+        file.WriteUInt(offset);
+        file.WriteUInt(data.size());
+        file.WriteUInt(checksum);
+        offset += data.size();
+    }
+
+    for (const auto& [name, data] : files)
+        file.Write(data.data(), data.size());
+    return true;
+}
+
+ByteVector ReadAll(AbstractFile& file)
+{
+    ByteVector result(file.GetSize());
+    file.Read(result.data(), result.size());
+    return result;
+}
+
+}
+
+TEST_CASE("PackageFile entries are read from memory mapped file")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto fileSystem = context->GetSubsystem<FileSystem>();
+
+    const ea::string xmlText = "<element><child value=\"42\" /></element>";
+
+    auto image = MakeShared<Image>(context);
+    image->SetSize(4, 4, 4);
+    for (int y = 0; y < 4; ++y)
+    {
+        for (int x = 0; x < 4; ++x)
+            image->SetPixel(x, y, Color(x / 3.0f, y / 3.0f, 0.5f, 1.0f));
+    }
+    VectorBuffer imageData;
+    REQUIRE(image->Save(imageData));
+
+    const ea::vector<ea::pair<ea::string, ByteVector>> files = {
+        {"Data/Text.xml", ByteVector(xmlText.begin(), xmlText.end())},
+        {"Data/Image.png", imageData.GetBuffer()},
+        {"Data/Empty.bin", ByteVector{}},
+    };
+
+    const ea::string directory = fileSystem->GetTemporaryDir() + "PackageFileTest/";
+    const ea::string packageName = directory + "Test.pak";
+    REQUIRE(fileSystem->CreateDirsRecursive(directory + "Data/"));
+    REQUIRE(WritePackage(context, packageName, files));
+
+    auto package = MakeShared<PackageFile>(context);
+    REQUIRE(package->Open(packageName));
+    REQUIRE_FALSE(package->IsMemoryMapped());
+    REQUIRE(package->SetMemoryMapped(true) == MemoryMappedFile::IsSupported());
+
+    // Mapped and regular reads should return the same data
+    for (const auto& [name, data] : files)
+    {
+        const PackageEntry* entry = package->GetEntry(name);
+        REQUIRE(entry);
+
+        AbstractFilePtr mappedFile = package->OpenFile(FileIdentifier{"", name}, FILE_READ);
+        REQUIRE(mappedFile);
+        REQUIRE(mappedFile->GetSize() == data.size());
+        REQUIRE(mappedFile->GetChecksum() == entry->checksum_);
+        REQUIRE(ReadAll(*mappedFile) == data);
+
+        File regularFile(context, package, name);
+        REQUIRE(ReadAll(regularFile) == data);
+
+        if (package->IsMemoryMapped())
+            REQUIRE(dynamic_cast<MemoryMappedFileView*>(mappedFile.Get()));
+    }
+
+    // Resources should parse directly from mapped file, which should be kept alive by the views
+    AbstractFilePtr xmlSource = package->OpenFile(FileIdentifier{"", "Data/Text.xml"}, FILE_READ);
+    AbstractFilePtr imageSource = package->OpenFile(FileIdentifier{"", "Data/Image.png"}, FILE_READ);
+    package->SetMemoryMapped(false);
+    REQUIRE_FALSE(package->IsMemoryMapped());
+
+    auto xmlFile = MakeShared<XMLFile>(context);
+    REQUIRE(xmlFile->Load(*xmlSource));
+    REQUIRE(xmlFile->GetRoot().GetChild("child").GetInt("value") == 42);
+
+    auto loadedImage = MakeShared<Image>(context);
+    REQUIRE(loadedImage->Load(*imageSource));
+    REQUIRE(loadedImage->GetWidth() == 4);
+    REQUIRE(loadedImage->GetHeight() == 4);
+    for (int y = 0; y < 4; ++y)
+    {
+        for (int x = 0; x < 4; ++x)
+            REQUIRE(loadedImage->GetPixelInt(x, y) == image->GetPixelInt(x, y));
+    }
+
+    // Mounted directory should map files as well
+    {
+        File file(context, directory + "Data/Text.xml", FILE_WRITE);
+        file.Write(xmlText.data(), xmlText.size());
+    }
+
+    auto mountedDirectory = MakeShared<MountedDirectory>(context, directory);
+    mountedDirectory->SetMemoryMapped(true);
+    AbstractFilePtr directoryFile = mountedDirectory->OpenFile(FileIdentifier{"", "Data/Text.xml"}, FILE_READ);
+    REQUIRE(directoryFile);
+    REQUIRE(ReadAll(*directoryFile) == files[0].second);
+    if (MemoryMappedFile::IsSupported())
+        REQUIRE(dynamic_cast<MemoryMappedFileView*>(directoryFile.Get()));
+
+    xmlSource = nullptr;
+    imageSource = nullptr;
+    directoryFile = nullptr;
+    package = nullptr;
+    fileSystem->RemoveDir(directory, true);
+}
+
+TEST_CASE("PackageFile entries are compressed with per-entry codecs and shared dictionary")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto fileSystem = context->GetSubsystem<FileSystem>();
+
+    // Small files with shared structure, big compressible file, incompressible file and empty file
+    RandomEngine random{0};
+    ea::vector<ea::pair<ea::string, ByteVector>> files;
+    for (unsigned i = 0; i < 32; ++i)
+    {
+        const ea::string text = Format("<material>\n"
+            "    <technique name=\"Techniques/LitOpaque.xml\" />\n"
+            "    <texture unit=\"diffuse\" name=\"Textures/Texture{}.png\" />\n"
+            "    <parameter name=\"MatDiffColor\" value=\"{} {} {} 1\" />\n"
+            "    <parameter name=\"MatSpecColor\" value=\"{} {} {} 16\" />\n"
+            "</material>\n",
+            i, random.GetFloat(), random.GetFloat(), random.GetFloat(), random.GetFloat(), random.GetFloat(),
+            random.GetFloat());
+        files.emplace_back(Format("Materials/Material{}.xml", i), ByteVector(text.begin(), text.end()));
+    }
+
+    ByteVector bigData(PACKAGE_PARALLEL_DECOMPRESSION_SIZE * 2 + 100);
+    for (unsigned i = 0; i < bigData.size(); ++i)
+        bigData[i] = static_cast<unsigned char>((i / 7) % 13 + (i % 1024 == 0 ? random.GetUInt(0, 8) : 0));
+    files.emplace_back("Data/Big.bin", bigData);
+
+    ByteVector randomData(4096);
+    for (unsigned char& value : randomData)
+        value = static_cast<unsigned char>(random.GetUInt(0, 256));
+    files.emplace_back("Data/Random.bin", randomData);
+    files.emplace_back("Data/Empty.bin", ByteVector{});
+
+    // Build dictionary from small files
+    ea::vector<ConstByteSpan> samples;
+    for (unsigned i = 0; i < 32; ++i)
+        samples.emplace_back(files[i].second);
+    const ByteVector dictionary = BuildCompressionDictionary(samples);
+    REQUIRE_FALSE(dictionary.empty());
+    REQUIRE(dictionary.size() <= MaxCompressionDictionarySize);
+
+    // Dictionary should help to compress small files
+    const ByteVector& sample = files[0].second;
+    ByteVector compressed(EstimateCompressBound(sample.size()));
+    const unsigned sizeWithoutDictionary =
+        CompressBlock(compressed.data(), sample.data(), sample.size(), CompressionCodec::LZ4HC);
+    const unsigned sizeWithDictionary =
+        CompressBlock(compressed.data(), sample.data(), sample.size(), CompressionCodec::LZ4HC, dictionary);
+    REQUIRE(sizeWithDictionary > 0);
+    REQUIRE(sizeWithDictionary < sizeWithoutDictionary);
+
+    ByteVector decompressed(sample.size());
+    REQUIRE(DecompressBlock(decompressed.data(), decompressed.size(), compressed.data(), sizeWithDictionary,
+        CompressionCodec::LZ4HC, dictionary));
+    REQUIRE(decompressed == sample);
+
+    // Write package
+    const ea::string packageName = fileSystem->GetTemporaryDir() + "PackageFileCodecsTest.pak";
+    {
+        File file(context, packageName, FILE_WRITE);
+        REQUIRE(file.IsOpen());
+
+        PackageBuilder builder;
+        REQUIRE(builder.Create(&file, dictionary));
+        for (unsigned i = 0; i < 32; ++i)
+        {
+            const CompressionCodec codec = i % 2 ? CompressionCodec::LZ4HC : CompressionCodec::LZ4;
+            REQUIRE(builder.Append(files[i].first, files[i].second, codec, true));
+        }
+        REQUIRE(builder.Append("Data/Big.bin", bigData, CompressionCodec::LZ4HC));
+        REQUIRE(builder.Append("Data/Random.bin", randomData, CompressionCodec::LZ4));
+        REQUIRE(builder.Append("Data/Empty.bin", {}, CompressionCodec::LZ4));
+        REQUIRE(builder.Build());
+    }
+
+    auto package = MakeShared<PackageFile>(context);
+    REQUIRE(package->Open(packageName));
+    REQUIRE(package->IsCompressed());
+    REQUIRE(package->GetNumFiles() == files.size());
+    REQUIRE(package->GetDictionary());
+    REQUIRE(*package->GetDictionary() == dictionary);
+
+    REQUIRE(package->GetEntry("Materials/Material0.xml")->codec_ == CompressionCodec::LZ4);
+    REQUIRE(package->GetEntry("Materials/Material0.xml")->useDictionary_);
+    REQUIRE(package->GetEntry("Materials/Material1.xml")->codec_ == CompressionCodec::LZ4HC);
+    REQUIRE(package->GetEntry("Data/Big.bin")->codec_ == CompressionCodec::LZ4HC);
+    REQUIRE(package->GetEntry("Data/Big.bin")->packedSize_ < bigData.size() / 2);
+    REQUIRE_FALSE(package->GetEntry("Data/Big.bin")->useDictionary_);
+    REQUIRE(package->GetEntry("Data/Random.bin")->codec_ == CompressionCodec::None);
+    REQUIRE(package->GetEntry("Data/Empty.bin")->codec_ == CompressionCodec::None);
+
+    // All ways of reading should return the same data
+    for (bool memoryMapped : {false, true})
+    {
+        package->SetMemoryMapped(memoryMapped);
+        for (const auto& [name, data] : files)
+        {
+            const PackageEntry* entry = package->GetEntry(name);
+            REQUIRE(entry);
+
+            AbstractFilePtr file = package->OpenFile(FileIdentifier{"", name}, FILE_READ);
+            REQUIRE(file);
+            REQUIRE(file->GetChecksum() == entry->checksum_);
+            REQUIRE(ReadAll(*file) == data);
+
+            File streamedFile(context, package, name);
+            REQUIRE(ReadAll(streamedFile) == data);
+
+            ByteVector entryData;
+            REQUIRE(package->ReadEntry(name, entryData));
+            REQUIRE(entryData == data);
+        }
+    }
+
+    package = nullptr;
+    fileSystem->Delete(packageName);
+}
+
+TEST_CASE("PackageFile compressed entries support random access")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto fileSystem = context->GetSubsystem<FileSystem>();
+
+    // Size is not aligned to blocks
+    ByteVector data(PACKAGE_COMPRESSED_BLOCK_SIZE * 10 + 1234);
+    for (unsigned i = 0; i < data.size(); ++i)
+        data[i] = static_cast<unsigned char>((i / 5) % 17 + i / PACKAGE_COMPRESSED_BLOCK_SIZE);
+
+    const ea::string packageName = fileSystem->GetTemporaryDir() + "PackageFileRandomAccessTest.pak";
+    {
+        File file(context, packageName, FILE_WRITE);
+        PackageBuilder builder;
+        REQUIRE(builder.Create(&file));
+        REQUIRE(builder.Append("Data.bin", data, CompressionCodec::LZ4HC));
+        REQUIRE(builder.Build());
+    }
+
+    auto package = MakeShared<PackageFile>(context);
+    REQUIRE(package->Open(packageName));
+
+    const PackageEntry* entry = package->GetEntry("Data.bin");
+    REQUIRE(entry);
+    REQUIRE(entry->blockOffsets_);
+    REQUIRE(entry->blockOffsets_->size() == 12);
+    REQUIRE(entry->blockOffsets_->front() == 0);
+    REQUIRE(entry->blockOffsets_->back() == entry->packedSize_);
+
+    // Entries with block index are streamed
+    AbstractFilePtr file = package->OpenFile(FileIdentifier{"", "Data.bin"}, FILE_READ);
+    REQUIRE(dynamic_cast<File*>(file.Get()));
+
+    const auto checkRead = [&](unsigned position, unsigned size)
+    {
+        REQUIRE(file->Seek(position) == position);
+        REQUIRE(file->GetPosition() == position);
+
+        ByteVector buffer(size);
+        REQUIRE(file->Read(buffer.data(), size) == size);
+        REQUIRE(ea::equal(buffer.begin(), buffer.end(), data.begin() + position));
+        REQUIRE(file->GetPosition() == position + size);
+    };
+
+    // Read within block, across blocks, whole blocks and till the end, seeking forward and backward
+    checkRead(100, 1000);
+    checkRead(PACKAGE_COMPRESSED_BLOCK_SIZE * 7 + 10, 100);
+    checkRead(PACKAGE_COMPRESSED_BLOCK_SIZE * 2 - 10, 20);
+    checkRead(PACKAGE_COMPRESSED_BLOCK_SIZE * 2 - 20, 10);
+    checkRead(PACKAGE_COMPRESSED_BLOCK_SIZE * 3, PACKAGE_COMPRESSED_BLOCK_SIZE * 4);
+    checkRead(PACKAGE_COMPRESSED_BLOCK_SIZE + 5, PACKAGE_COMPRESSED_BLOCK_SIZE * 5);
+    checkRead(PACKAGE_COMPRESSED_BLOCK_SIZE * 10 + 1000, 234);
+    checkRead(0, data.size());
+
+    // Seek back into the whole blocks read directly, bypassing the read buffer
+    const auto checkSequentialRead = [&](unsigned size)
+    {
+        const unsigned position = file->GetPosition();
+        ByteVector buffer(size);
+        REQUIRE(file->Read(buffer.data(), size) == size);
+        REQUIRE(ea::equal(buffer.begin(), buffer.end(), data.begin() + position));
+    };
+
+    REQUIRE(file->Seek(0) == 0);
+    checkSequentialRead(10);
+    checkSequentialRead(PACKAGE_COMPRESSED_BLOCK_SIZE - 10);
+    checkSequentialRead(PACKAGE_COMPRESSED_BLOCK_SIZE * 2);
+    checkRead(PACKAGE_COMPRESSED_BLOCK_SIZE * 2 + 100, 100);
+    checkRead(PACKAGE_COMPRESSED_BLOCK_SIZE * 3, PACKAGE_COMPRESSED_BLOCK_SIZE * 2);
+    checkRead(PACKAGE_COMPRESSED_BLOCK_SIZE * 4 + 100, 100);
+
+    REQUIRE(file->Seek(data.size()) == data.size());
+    REQUIRE(file->IsEof());
+
+    file = nullptr;
+    package = nullptr;
+    fileSystem->Delete(packageName);
+}
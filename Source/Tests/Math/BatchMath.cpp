@@ -0,0 +1,155 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Math/BatchMath.h>
+#include <Urho3D/Math/RandomEngine.h>
+
+namespace
+{
+
+Matrix3x4 RandomTransform(RandomEngine& random)
+{
+    const Vector3 position{random.GetFloat(-10.0f, 10.0f), random.GetFloat(-10.0f, 10.0f), random.GetFloat(-10.0f, 10.0f)};
+    const Quaternion rotation{random.GetFloat(0.0f, 360.0f), random.GetFloat(0.0f, 360.0f), random.GetFloat(0.0f, 360.0f)};
+    const Vector3 scale{random.GetFloat(0.5f, 2.0f), random.GetFloat(0.5f, 2.0f), random.GetFloat(0.5f, 2.0f)};
+    return Matrix3x4{position, rotation, scale};
+}
+
+BoundingBox RandomBoundingBox(RandomEngine& random)
+{
+    const Vector3 center{random.GetFloat(-50.0f, 50.0f), random.GetFloat(-50.0f, 50.0f), random.GetFloat(-50.0f, 50.0f)};
+    const Vector3 halfSize{random.GetFloat(0.1f, 5.0f), random.GetFloat(0.1f, 5.0f), random.GetFloat(0.1f, 5.0f)};
+    return BoundingBox{center - halfSize, center + halfSize};
+}
+
+bool AreBoxesEqual(const BoundingBox& lhs, const BoundingBox& rhs)
+{
+    return lhs.min_.Equals(rhs.min_, 0.001f) && lhs.max_.Equals(rhs.max_, 0.001f);
+}
+
+}
+
+TEST_CASE("Batch math functions match scalar operations")
+{
+    const SIMDLevel supportedLevel = GetSupportedSIMDLevel();
+    const SIMDLevel previousLevel = GetSIMDLevel();
+
+    // Odd count to test both vectorized and remainder code paths
+    static const unsigned count = 37;
+    RandomEngine random(0);
+
+    ea::vector<Matrix3x4> transforms(count);
+    ea::vector<Matrix3x4> otherTransforms(count);
+    ea::vector<Vector3> points(count);
+    ea::vector<BoundingBox> boxes(count);
+    for (unsigned i = 0; i < count; ++i)
+    {
+        transforms[i] = RandomTransform(random);
+        otherTransforms[i] = RandomTransform(random);
+        points[i] = Vector3{random.GetFloat(-10.0f, 10.0f), random.GetFloat(-10.0f, 10.0f), random.GetFloat(-10.0f, 10.0f)};
+        boxes[i] = RandomBoundingBox(random);
+    }
+
+    Frustum frustum;
+    frustum.Define(Vector3{1.0f, 1.0f, 1.0f}, Vector3{40.0f, 40.0f, 50.0f});
+
+    for (SIMDLevel level : {SIMDLevel::Scalar, SIMDLevel::SSE, SIMDLevel::AVX2})
+    {
+        if (level > supportedLevel)
+            continue;
+
+        SetSIMDLevel(level);
+        REQUIRE(GetSIMDLevel() == level);
+
+        ea::vector<Vector3> transformedPoints(count);
+        TransformPoints(transforms[0], points.data(), transformedPoints.data(), count);
+        for (unsigned i = 0; i < count; ++i)
+            REQUIRE(transformedPoints[i].Equals(transforms[0] * points[i], 0.001f));
+
+        ea::vector<BoundingBox> transformedBoxes(count);
+        TransformBoundingBoxes(transforms.data(), boxes.data(), transformedBoxes.data(), count);
+        for (unsigned i = 0; i < count; ++i)
+            REQUIRE(AreBoxesEqual(transformedBoxes[i], boxes[i].Transformed(transforms[i])));
+
+        TransformBoundingBoxes(transforms[0], boxes.data(), transformedBoxes.data(), count);
+        for (unsigned i = 0; i < count; ++i)
+            REQUIRE(AreBoxesEqual(transformedBoxes[i], boxes[i].Transformed(transforms[0])));
+
+        bool isInside[count];
+        TestBoundingBoxes(frustum, boxes.data(), isInside, count);
+        unsigned numInside = 0;
+        for (unsigned i = 0; i < count; ++i)
+        {
+            REQUIRE(isInside[i] == (frustum.IsInsideFast(boxes[i]) != OUTSIDE));
+            numInside += isInside[i];
+        }
+        REQUIRE(numInside > 0);
+        REQUIRE(numInside < count);
+
+        // Output aliases input
+        ea::vector<Matrix3x4> products = transforms;
+        MultiplyMatrices(products.data(), otherTransforms.data(), products.data(), count);
+        for (unsigned i = 0; i < count; ++i)
+            REQUIRE(products[i].Equals(transforms[i] * otherTransforms[i], 0.001f));
+
+        // Interleave values above and below the span so that both branches are taken
+        ea::vector<int> values(count);
+        for (unsigned i = 0; i < count; ++i)
+            values[i] = i % 3 == 0 ? -1000 : 1000;
+        MinLinearSpan(values.data(), count, -500, 40);
+        for (unsigned i = 0; i < count; ++i)
+            REQUIRE(values[i] == ea::min(i % 3 == 0 ? -1000 : 1000, -500 + 40 * static_cast<int>(i)));
+
+        // Vectors of 3 components don't match SIMD width, so repeated operand is not aligned to it
+        const Vector3 offset{1.0f, -2.0f, 3.0f};
+        const BatchOperand pointsOperand{&points[0].x_};
+        const BatchOperand offsetOperand{&offset.x_, true};
+        ea::vector<Vector3> results(count);
+        AddVectors(pointsOperand, offsetOperand, &results[0].x_, count, 3);
+        for (unsigned i = 0; i < count; ++i)
+            REQUIRE(results[i] == points[i] + offset);
+
+        SubtractVectors(offsetOperand, pointsOperand, &results[0].x_, count, 3);
+        for (unsigned i = 0; i < count; ++i)
+            REQUIRE(results[i] == offset - points[i]);
+
+        MultiplyVectors(pointsOperand, pointsOperand, &results[0].x_, count, 3);
+        for (unsigned i = 0; i < count; ++i)
+            REQUIRE(results[i] == points[i] * points[i]);
+
+        // Output aliases input
+        results = points;
+        MultiplyAddVectors({&results[0].x_}, offsetOperand, 0.5f, &results[0].x_, count, 3);
+        for (unsigned i = 0; i < count; ++i)
+            REQUIRE(results[i] == points[i] + offset * 0.5f);
+
+        const float scale = 2.0f;
+        ea::vector<float> floatResults(count);
+        MultiplyVectors({&points[0].x_}, {&scale, true}, floatResults.data(), count, 1);
+        for (unsigned i = 0; i < count; ++i)
+            REQUIRE(floatResults[i] == (&points[0].x_)[i] * scale);
+    }
+
+    SetSIMDLevel(previousLevel);
+}
@@ -185,5 +185,354 @@ TEST_CASE("Recast/Detour Crowdmanager test with DynamicNavigationMesh")
 
 }
 
+TEST_CASE("NavigationMesh reports progress of tile building")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto scene = CreateTestScene(context, 20);
+    scene->CreateComponent<Navigable>();
+
+    auto* navMesh = scene->CreateComponent<NavigationMesh>();
+    navMesh->SetTileSize(16);
+    auto* dynamicNavMesh = scene->CreateComponent<DynamicNavigationMesh>();
+    dynamicNavMesh->SetTileSize(16);
+
+    ea::vector<ea::pair<unsigned, unsigned>> progress;
+    unsigned numAreasRebuilt = 0;
+    scene->SubscribeToEvent(E_NAVIGATION_BUILD_PROGRESS, [&](VariantMap& eventData)
+    {
+        using namespace NavigationBuildProgress;
+        progress.emplace_back(eventData[P_NUMBUILTTILES].GetUInt(), eventData[P_NUMTILES].GetUInt());
+    });
+    scene->SubscribeToEvent(E_NAVIGATION_AREA_REBUILT, [&](VariantMap& eventData) { ++numAreasRebuilt; });
+
+    for (NavigationMesh* mesh : {navMesh, static_cast<NavigationMesh*>(dynamicNavMesh)})
+    {
+        progress.clear();
+        numAreasRebuilt = 0;
+        REQUIRE(mesh->Rebuild());
+
+        // Progress is reported once per batch of tiles
+        REQUIRE(!progress.empty());
+        const unsigned numTiles = progress.back().second;
+        REQUIRE(numTiles > NavigationMesh::TileBuildBatchSize);
+        REQUIRE(progress.size() == (numTiles + NavigationMesh::TileBuildBatchSize - 1) / NavigationMesh::TileBuildBatchSize);
+        for (unsigned i = 0; i < progress.size(); ++i)
+        {
+            REQUIRE(progress[i].first == ea::min((i + 1) * NavigationMesh::TileBuildBatchSize, numTiles));
+            REQUIRE(progress[i].second == numTiles);
+        }
+        REQUIRE(numAreasRebuilt > 0);
+
+        const Vector3 nearestPoint = mesh->FindNearestPoint(Vector3(-40.0f, 0.0f, 0.0f), Vector3(1.0f, 1.0f, 1.0f));
+        REQUIRE(nearestPoint.DistanceToPoint(Vector3(-40.0f, 0.0f, 0.0f)) < 0.5f);
+    }
+}
+
+TEST_CASE("NavigationMesh rebuilds tiles of changed geometry in background")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto scene = CreateTestScene(context, 0);
+    scene->CreateComponent<Navigable>();
+
+    Node* boxNode = scene->CreateChild("Box");
+    boxNode->SetPosition(Vector3(10.0f, 2.0f, 10.0f));
+    boxNode->SetScale(4.0f);
+    boxNode->CreateComponent<RigidBody>();
+    auto* boxShape = boxNode->CreateComponent<CollisionShape>();
+    boxShape->SetShapeType(SHAPE_BOX);
+    boxShape->SetBox(Vector3::ONE);
+
+    auto* navMesh = scene->CreateComponent<NavigationMesh>();
+    auto* dynamicNavMesh = scene->CreateComponent<DynamicNavigationMesh>();
+    const ea::vector<NavigationMesh*> meshes{navMesh, dynamicNavMesh};
+    for (NavigationMesh* mesh : meshes)
+    {
+        mesh->SetTileSize(16);
+        // Exclude the space inside of the box
+        mesh->SetAgentHeight(10.0f);
+        mesh->SetAutoUpdate(true);
+        REQUIRE(mesh->Rebuild());
+    }
+
+    const auto isWalkable = [](NavigationMesh* mesh, const Vector3& position)
+    {
+        dtPolyRef polyRef{};
+        const Vector3 nearestPoint = mesh->FindNearestPoint(position, Vector3(0.1f, 1.0f, 0.1f), nullptr, &polyRef);
+        return polyRef != 0 && nearestPoint.DistanceToPoint(position) < 0.5f;
+    };
+    const auto updateMeshes = [&]
+    {
+        for (unsigned i = 0; i < 100; ++i)
+        {
+            Tests::RunFrame(context, 0.05f, 0.05f);
+            if (navMesh->GetNumDirtyTiles() == 0 && dynamicNavMesh->GetNumDirtyTiles() == 0)
+                break;
+        }
+    };
+
+    const Vector3 firstPosition{10.0f, 0.0f, 10.0f};
+    const Vector3 secondPosition{-10.0f, 0.0f, -10.0f};
+
+    // Start tracking geometry
+    updateMeshes();
+    for (NavigationMesh* mesh : meshes)
+    {
+        REQUIRE(!isWalkable(mesh, firstPosition));
+        REQUIRE(isWalkable(mesh, secondPosition));
+    }
+
+    // Moved geometry is removed from old tiles and added to new tiles
+    boxNode->SetPosition(Vector3(-10.0f, 2.0f, -10.0f));
+    updateMeshes();
+    for (NavigationMesh* mesh : meshes)
+    {
+        REQUIRE(mesh->GetNumDirtyTiles() == 0);
+        REQUIRE(isWalkable(mesh, firstPosition));
+        REQUIRE(!isWalkable(mesh, secondPosition));
+    }
+
+    // Removed geometry is removed from tiles
+    boxNode->Remove();
+    updateMeshes();
+    for (NavigationMesh* mesh : meshes)
+    {
+        REQUIRE(mesh->GetNumDirtyTiles() == 0);
+        REQUIRE(isWalkable(mesh, firstPosition));
+        REQUIRE(isWalkable(mesh, secondPosition));
+    }
+}
+
+TEST_CASE("NavigationMesh finds requested paths in batches")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto scene = CreateTestScene(context, 20);
+    scene->CreateComponent<Navigable>();
+
+    auto* navMesh = scene->CreateComponent<NavigationMesh>();
+    navMesh->SetTileSize(16);
+    REQUIRE(navMesh->Rebuild());
+
+    // Small budget spreads searches over multiple frames
+    navMesh->SetMaxPathIterations(16);
+
+    // Partial paths are not cached, so pick only reachable endpoints
+    RandomEngine random{0};
+    ea::vector<ea::pair<Vector3, Vector3>> endpoints;
+    while (endpoints.size() < 32)
+    {
+        const Vector3 start{random.GetFloat(-40.0f, 40.0f), 0.0f, random.GetFloat(-40.0f, 40.0f)};
+        const Vector3 end{random.GetFloat(-40.0f, 40.0f), 0.0f, random.GetFloat(-40.0f, 40.0f)};
+
+        ea::vector<NavigationPathPoint> path;
+        navMesh->FindPath(path, start, end);
+        if (!path.empty() && path.back().position_.ToXZ().Equals(end.ToXZ(), 0.5f))
+            endpoints.emplace_back(start, end);
+    }
+
+    ea::unordered_map<unsigned, ea::vector<NavigationPathPoint>> paths;
+    const auto onPathFound = [&](unsigned requestId, const ea::vector<NavigationPathPoint>& path)
+    {
+        REQUIRE(!paths.contains(requestId));
+        paths[requestId] = path;
+    };
+    const auto findPaths = [&]
+    {
+        paths.clear();
+        ea::vector<unsigned> requestIds;
+        for (const auto& [start, end] : endpoints)
+            requestIds.push_back(navMesh->RequestPath(start, end, onPathFound));
+
+        const unsigned cancelledId = navMesh->RequestPath(Vector3::ZERO, Vector3::ONE, onPathFound);
+        REQUIRE(navMesh->CancelPathRequest(cancelledId));
+        REQUIRE(!navMesh->CancelPathRequest(cancelledId));
+
+        unsigned numFrames = 0;
+        while (navMesh->GetNumPathRequests() != 0 && numFrames < 1000)
+        {
+            Tests::RunFrame(context, 0.05f, 0.05f);
+            ++numFrames;
+        }
+
+        REQUIRE(navMesh->GetNumPathRequests() == 0);
+        REQUIRE(paths.size() == endpoints.size());
+
+        // Sliced search may pick slightly different corridor at tile borders
+        const auto getLength = [](const ea::vector<NavigationPathPoint>& path)
+        {
+            float length = 0.0f;
+            for (unsigned i = 1; i < path.size(); ++i)
+                length += (path[i].position_ - path[i - 1].position_).Length();
+            return length;
+        };
+        for (unsigned i = 0; i < endpoints.size(); ++i)
+        {
+            ea::vector<NavigationPathPoint> expectedPath;
+            navMesh->FindPath(expectedPath, endpoints[i].first, endpoints[i].second);
+
+            const ea::vector<NavigationPathPoint>& path = paths[requestIds[i]];
+            REQUIRE(!path.empty());
+            REQUIRE(path.front().position_.Equals(expectedPath.front().position_, 0.01f));
+
+            // Partial paths may end at different polygons
+            const Vector3 endOffset = expectedPath.back().position_ - endpoints[i].second;
+            if (Vector2(endOffset.x_, endOffset.z_).Length() < 0.5f)
+            {
+                REQUIRE(path.back().position_.Equals(expectedPath.back().position_, 0.01f));
+                REQUIRE(getLength(path) <= getLength(expectedPath) * 1.1f + 0.01f);
+            }
+        }
+        return numFrames;
+    };
+
+    const unsigned numFramesUncached = findPaths();
+    REQUIRE(numFramesUncached > 2);
+
+    // Cached corridors cost one iteration per request
+    const unsigned numFramesCached = findPaths();
+    REQUIRE(numFramesCached <= 3);
+
+    navMesh->ClearPathCache();
+    REQUIRE(findPaths() > 2);
+}
+
+TEST_CASE("NavigationMesh doesn't reuse partial paths after tiles are added")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto scene = CreateTestScene(context, 0);
+    scene->CreateComponent<Navigable>();
+
+    auto* navMesh = scene->CreateComponent<NavigationMesh>();
+    navMesh->SetTileSize(16);
+    REQUIRE(navMesh->Rebuild());
+
+    // Remove the column of tiles in the middle of the plane
+    const int gapTileX = navMesh->GetTileIndex(Vector3::ZERO).x_;
+    ea::vector<ea::vector<unsigned char>> gapTiles;
+    for (const IntVector2& tileIndex : navMesh->GetAllTileIndices())
+    {
+        if (tileIndex.x_ == gapTileX)
+        {
+            gapTiles.push_back(navMesh->GetTileData(tileIndex));
+            navMesh->RemoveTile(tileIndex);
+        }
+    }
+    REQUIRE(!gapTiles.empty());
+
+    const Vector3 start{-20.0f, 0.0f, 0.0f};
+    const Vector3 end{20.0f, 0.0f, 0.0f};
+    const auto requestPath = [&]
+    {
+        ea::vector<NavigationPathPoint> result;
+        navMesh->RequestPath(start, end,
+            [&](unsigned requestId, const ea::vector<NavigationPathPoint>& path) { result = path; });
+
+        for (unsigned i = 0; i < 100 && navMesh->GetNumPathRequests() != 0; ++i)
+            Tests::RunFrame(context, 0.05f, 0.05f);
+
+        REQUIRE(navMesh->GetNumPathRequests() == 0);
+        REQUIRE(!result.empty());
+        return result;
+    };
+
+    // Path ends at the gap
+    const auto partialPath = requestPath();
+    REQUIRE(!partialPath.back().position_.ToXZ().Equals(end.ToXZ(), 0.1f));
+
+    // Bridge the gap and expect full path
+    for (const auto& tileData : gapTiles)
+        REQUIRE(navMesh->AddTile(tileData));
+
+    const auto fullPath = requestPath();
+    REQUIRE(fullPath.back().position_.ToXZ().Equals(end.ToXZ(), 0.1f));
+}
+
+TEST_CASE("CrowdManager updates far agents at reduced rate")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto scene = CreateTestScene(context, 0);
+    scene->CreateComponent<Navigable>();
+    auto* navMesh = scene->CreateComponent<NavigationMesh>();
+    navMesh->SetTileSize(32);
+    REQUIRE(navMesh->Rebuild());
+
+    auto* crowdManager = scene->CreateComponent<CrowdManager>();
+    crowdManager->SetLodCenter(Vector3(-40.0f, 0.0f, 0.0f));
+    crowdManager->SetLodDistance(50.0f);
+    crowdManager->SetLodUpdateInterval(4);
+
+    // Spawn enough agents in each group to use parallel update
+    static const unsigned numRows = 16;
+    static const unsigned numColumns = 4;
+    Node* agentsSceneNode = scene->CreateChild("AgentsSceneNode");
+    ea::vector<CrowdAgentTest> testAgents;
+    for (float groupX : {-40.0f, 40.0f})
+    {
+        for (unsigned row = 0; row < numRows; ++row)
+        {
+            for (unsigned column = 0; column < numColumns; ++column)
+            {
+                const Vector3 position{groupX + column * 2.5f, 0.0f, row * 2.5f - 25.0f};
+                testAgents.push_back(SpawnCrowdAgent(position, agentsSceneNode, groupX > 0.0f));
+            }
+        }
+    }
+
+    static const Vector3 offset{0.0f, 0.0f, 10.0f};
+    for (const CrowdAgentTest& testAgent : testAgents)
+        testAgent.crowdAgentNode->GetComponent<CrowdAgent>()->SetTargetPosition(testAgent.startPosition + offset);
+
+    // Far agents are simulated every 4th update with accumulated time step and interpolated in between
+    ea::unordered_map<Node*, ea::vector<float>> timeSteps;
+    scene->SubscribeToEvent(crowdManager, E_CROWD_AGENT_REPOSITION, [&](VariantMap& eventData)
+    {
+        using namespace CrowdAgentReposition;
+        auto node = static_cast<Node*>(eventData[P_NODE].GetPtr());
+        timeSteps[node].push_back(eventData[P_TIMESTEP].GetFloat());
+    });
+
+    unsigned numMovedFar = 0;
+    for (unsigned frame = 0; frame < 40; ++frame)
+    {
+        ea::vector<Vector3> previousPositions;
+        for (const CrowdAgentTest& testAgent : testAgents)
+            previousPositions.push_back(testAgent.crowdAgentNode->GetWorldPosition());
+
+        Tests::RunFrame(context, 0.05f, 0.05f);
+
+        for (unsigned i = 0; i < testAgents.size(); ++i)
+        {
+            if (testAgents[i].validAgent && testAgents[i].crowdAgentNode->GetWorldPosition() != previousPositions[i])
+                ++numMovedFar;
+        }
+    }
+    scene->UnsubscribeFromEvent(crowdManager, E_CROWD_AGENT_REPOSITION);
+
+    for (const CrowdAgentTest& testAgent : testAgents)
+    {
+        const ea::vector<float>& agentTimeSteps = timeSteps[testAgent.crowdAgentNode];
+        REQUIRE(!agentTimeSteps.empty());
+        const bool isFar = testAgent.validAgent;
+        for (unsigned i = 1; i < agentTimeSteps.size(); ++i)
+            REQUIRE(Equals(agentTimeSteps[i], isFar ? 0.2f : 0.05f, 0.001f));
+    }
+
+    // Interpolated agents move between simulation steps
+    REQUIRE(numMovedFar > numRows * numColumns * 30);
+
+    // All agents eventually reach their targets
+    Tests::RunFrame(context, 5.0f, 0.05f);
+    for (const CrowdAgentTest& testAgent : testAgents)
+    {
+        const Vector3 position = testAgent.crowdAgentNode->GetWorldPosition();
+        const Vector3 target = testAgent.startPosition + offset;
+        REQUIRE(Vector2(position.x_, position.z_).Equals(Vector2(target.x_, target.z_), 1.0f));
+    }
+}
+
 #endif
 #endif
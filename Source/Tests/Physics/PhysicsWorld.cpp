@@ -0,0 +1,351 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#if URHO3D_PHYSICS
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Math/RandomEngine.h>
+#include <Urho3D/Physics/CollisionShape.h>
+#include <Urho3D/Physics/PhysicsEvents.h>
+#include <Urho3D/Physics/PhysicsWorld.h>
+#include <Urho3D/Physics/RigidBody.h>
+#include <Urho3D/Scene/Scene.h>
+
+namespace
+{
+
+struct BoxStackResult
+{
+    ea::vector<Vector3> positions_;
+    Vector3 childPosition_;
+    unsigned numCollisionStarts_{};
+    bool multithreaded_{};
+};
+
+BoxStackResult SimulateBoxStack(Context* context, bool multithreaded)
+{
+    const PhysicsWorldConfig previousConfig = PhysicsWorld::config;
+    PhysicsWorld::config.multithreaded_ = multithreaded;
+
+    auto scene = MakeShared<Scene>(context);
+    auto physicsWorld = scene->CreateComponent<PhysicsWorld>();
+    PhysicsWorld::config = previousConfig;
+
+    BoxStackResult result;
+    result.multithreaded_ = physicsWorld->IsMultithreaded();
+    scene->SubscribeToEvent(physicsWorld, E_PHYSICSCOLLISIONSTART, [&] { ++result.numCollisionStarts_; });
+
+    Node* groundNode = scene->CreateChild("Ground");
+    groundNode->SetPosition({0.0f, -0.5f, 0.0f});
+    groundNode->SetScale({20.0f, 1.0f, 20.0f});
+    groundNode->CreateComponent<RigidBody>();
+    groundNode->CreateComponent<CollisionShape>()->SetBox(Vector3::ONE);
+
+    ea::vector<Node*> boxNodes;
+    for (int x = -2; x <= 2; ++x)
+    {
+        for (int z = -2; z <= 2; ++z)
+        {
+            for (int y = 0; y < 4; ++y)
+            {
+                Node* boxNode = scene->CreateChild("Box");
+                boxNode->SetPosition(Vector3(x * 2.0f, y * 1.0f + 0.5f, z * 2.0f));
+                boxNode->CreateComponent<RigidBody>()->SetMass(1.0f);
+                boxNode->CreateComponent<CollisionShape>()->SetBox(Vector3::ONE);
+                boxNodes.push_back(boxNode);
+            }
+        }
+    }
+
+    // Parented body is synchronized via delayed world transforms
+    Node* childNode = boxNodes.back()->CreateChild("Child");
+    childNode->SetPosition({0.0f, 2.0f, 0.0f});
+    childNode->CreateComponent<RigidBody>()->SetMass(1.0f);
+    childNode->CreateComponent<CollisionShape>()->SetBox(Vector3::ONE);
+
+    for (unsigned i = 0; i < 120; ++i)
+        physicsWorld->Update(1.0f / 60.0f);
+
+    for (Node* boxNode : boxNodes)
+        result.positions_.push_back(boxNode->GetWorldPosition());
+    result.childPosition_ = childNode->GetWorldPosition();
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("Multithreaded physics world simulates like single-threaded one")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    const BoxStackResult singleThreaded = SimulateBoxStack(context, false);
+    const BoxStackResult multiThreaded = SimulateBoxStack(context, true);
+
+    REQUIRE_FALSE(singleThreaded.multithreaded_);
+#if URHO3D_THREADING
+    REQUIRE(multiThreaded.multithreaded_);
+#endif
+
+    REQUIRE(singleThreaded.numCollisionStarts_ > 0);
+    REQUIRE(multiThreaded.numCollisionStarts_ == singleThreaded.numCollisionStarts_);
+
+    REQUIRE(singleThreaded.positions_.size() == multiThreaded.positions_.size());
+    for (unsigned i = 0; i < singleThreaded.positions_.size(); ++i)
+        REQUIRE(singleThreaded.positions_[i].Equals(multiThreaded.positions_[i], 0.05f));
+
+    // Resting box stacks stay in place
+    REQUIRE(singleThreaded.positions_.back().Equals({4.0f, 3.5f, 4.0f}, 0.05f));
+    REQUIRE(singleThreaded.childPosition_.Equals({4.0f, 4.5f, 4.0f}, 0.05f));
+    REQUIRE(multiThreaded.childPosition_.Equals(singleThreaded.childPosition_, 0.05f));
+}
+
+TEST_CASE("Batched physics queries match single queries")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto scene = MakeShared<Scene>(context);
+    auto physicsWorld = scene->CreateComponent<PhysicsWorld>();
+
+    for (int x = -5; x <= 5; ++x)
+    {
+        for (int z = -5; z <= 5; ++z)
+        {
+            Node* boxNode = scene->CreateChild("Box");
+            boxNode->SetPosition(Vector3(x * 3.0f, 0.0f, z * 3.0f));
+            boxNode->CreateComponent<RigidBody>()->SetCollisionLayer(((x + z) & 1) ? 1 : 2);
+            boxNode->CreateComponent<CollisionShape>()->SetBox(Vector3::ONE);
+        }
+    }
+
+    // Shape of the caster itself should be ignored
+    Node* casterNode = scene->CreateChild("Caster");
+    casterNode->CreateComponent<RigidBody>();
+    auto casterShape = casterNode->CreateComponent<CollisionShape>();
+    casterShape->SetSphere(0.5f);
+
+    physicsWorld->UpdateCollisions();
+
+    RandomEngine random(0);
+    ea::vector<PhysicsRaycastQuery> rayQueries(1000);
+    ea::vector<PhysicsSphereCastQuery> sphereQueries(1000);
+    ea::vector<PhysicsConvexCastQuery> convexQueries(1000);
+    for (unsigned i = 0; i < rayQueries.size(); ++i)
+    {
+        const Vector3 origin = random.GetVector3({-20.0f, -2.0f, -20.0f}, {20.0f, 2.0f, 20.0f});
+        const Vector3 direction = random.GetDirectionVector3();
+        const unsigned collisionMask = (i % 3 == 0) ? 1 : M_MAX_UNSIGNED;
+
+        rayQueries[i] = {Ray{origin, direction}, 10.0f, collisionMask};
+        sphereQueries[i] = {Ray{origin, direction}, 0.25f, 10.0f, collisionMask};
+        convexQueries[i] = {origin, Quaternion::IDENTITY, origin + direction * 10.0f, Quaternion::IDENTITY, collisionMask};
+    }
+
+    unsigned numHits = 0;
+    ea::vector<PhysicsRaycastResult> batchResults(rayQueries.size());
+
+    physicsWorld->RaycastSingleBatch(batchResults, rayQueries);
+    for (unsigned i = 0; i < rayQueries.size(); ++i)
+    {
+        PhysicsRaycastResult result;
+        physicsWorld->RaycastSingle(result, rayQueries[i].ray_, rayQueries[i].maxDistance_, rayQueries[i].collisionMask_);
+        REQUIRE(batchResults[i].body_ == result.body_);
+        REQUIRE(batchResults[i].position_.Equals(result.position_));
+        numHits += result.body_ ? 1 : 0;
+    }
+
+    physicsWorld->SphereCastBatch(batchResults, sphereQueries);
+    for (unsigned i = 0; i < sphereQueries.size(); ++i)
+    {
+        const PhysicsSphereCastQuery& query = sphereQueries[i];
+        PhysicsRaycastResult result;
+        physicsWorld->SphereCast(result, query.ray_, query.radius_, query.maxDistance_, query.collisionMask_);
+        REQUIRE(batchResults[i].body_ == result.body_);
+        REQUIRE(batchResults[i].position_.Equals(result.position_));
+        numHits += result.body_ ? 1 : 0;
+    }
+
+    physicsWorld->ConvexCastBatch(batchResults, casterShape, convexQueries);
+    for (unsigned i = 0; i < convexQueries.size(); ++i)
+    {
+        const PhysicsConvexCastQuery& query = convexQueries[i];
+        PhysicsRaycastResult result;
+        physicsWorld->ConvexCast(result, casterShape, query.startPos_, query.startRot_, query.endPos_, query.endRot_,
+            query.collisionMask_);
+        REQUIRE(batchResults[i].body_ == result.body_);
+        REQUIRE(batchResults[i].position_.Equals(result.position_));
+        REQUIRE(result.body_ != casterNode->GetComponent<RigidBody>());
+        numHits += result.body_ ? 1 : 0;
+    }
+
+    REQUIRE(numHits > 100);
+}
+
+namespace
+{
+
+struct TestContactListener : public PhysicsContactListener
+{
+    void OnPhysicsContacts(PhysicsWorld* physicsWorld, RigidBody* body, ea::span<const PhysicsContactPair> contacts,
+        ea::span<const PhysicsContactPoint> points) override
+    {
+        for (const PhysicsContactPair& pair : contacts)
+        {
+            REQUIRE(pair.bodyA_ == body);
+            phases_.push_back(pair.phase_);
+            for (const PhysicsContactPoint& point : points.subspan(pair.firstPoint_, pair.numPoints_))
+            {
+                positions_.push_back(point.position_);
+                normals_.push_back(point.normal_);
+            }
+        }
+    }
+
+    ea::vector<PhysicsContactPhase> phases_;
+    ea::vector<Vector3> positions_;
+    ea::vector<Vector3> normals_;
+};
+
+} // namespace
+
+TEST_CASE("Physics contact stream reports contacts to listeners")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto scene = MakeShared<Scene>(context);
+    auto physicsWorld = scene->CreateComponent<PhysicsWorld>();
+    physicsWorld->SetCollisionEventsEnabled(false);
+
+    unsigned numCollisionEvents = 0;
+    scene->SubscribeToEvent(physicsWorld, E_PHYSICSCOLLISION, [&] { ++numCollisionEvents; });
+
+    Node* groundNode = scene->CreateChild("Ground");
+    groundNode->SetPosition({0.0f, -0.5f, 0.0f});
+    groundNode->SetScale({20.0f, 1.0f, 20.0f});
+    auto groundBody = groundNode->CreateComponent<RigidBody>();
+    groundNode->CreateComponent<CollisionShape>()->SetBox(Vector3::ONE);
+
+    Node* boxNode = scene->CreateChild("Box");
+    boxNode->SetPosition({0.0f, 1.0f, 0.0f});
+    auto boxBody = boxNode->CreateComponent<RigidBody>();
+    boxBody->SetMass(1.0f);
+    boxNode->CreateComponent<CollisionShape>()->SetBox(Vector3::ONE);
+
+    TestContactListener groundListener;
+    TestContactListener boxListener;
+    groundBody->SetContactListener(&groundListener);
+    boxBody->SetContactListener(&boxListener);
+
+    // Let the box land
+    for (unsigned i = 0; i < 60; ++i)
+        physicsWorld->Update(1.0f / 60.0f);
+
+    REQUIRE(numCollisionEvents == 0);
+    REQUIRE(boxListener.phases_.size() > 1);
+    REQUIRE(boxListener.phases_.front() == PhysicsContactPhase::Begin);
+    REQUIRE(boxListener.phases_.back() == PhysicsContactPhase::Stay);
+    REQUIRE(groundListener.phases_ == boxListener.phases_);
+
+    // Normals point towards the listened body
+    REQUIRE(boxListener.normals_.back().Equals(Vector3::UP, 0.01f));
+    REQUIRE(groundListener.normals_.back().Equals(Vector3::DOWN, 0.01f));
+
+    // Contact points are at the top of the ground
+    REQUIRE(boxListener.positions_.back().y_ == Catch::Approx(0.0f).margin(0.05f));
+    REQUIRE(groundListener.positions_.back().y_ == Catch::Approx(0.0f).margin(0.05f));
+
+    const ea::span<const PhysicsContactPair> pairs = physicsWorld->GetContactPairs();
+    REQUIRE(pairs.size() == 1);
+    REQUIRE(pairs[0].phase_ == PhysicsContactPhase::Stay);
+    REQUIRE(physicsWorld->GetContactPoints(pairs[0]).size() > 0);
+    // Points seen by listeners are not added to the contact stream
+    REQUIRE(physicsWorld->GetContactPoints().size() == pairs[0].numPoints_);
+
+    // Move the box away to end the contact
+    boxNode->SetPosition({0.0f, 10.0f, 0.0f});
+    boxBody->SetLinearVelocity(Vector3::ZERO);
+    physicsWorld->Update(1.0f / 60.0f);
+
+    REQUIRE(boxListener.phases_.back() == PhysicsContactPhase::End);
+    REQUIRE(groundListener.phases_.back() == PhysicsContactPhase::End);
+    REQUIRE(physicsWorld->GetContactPairs().size() == 1);
+
+    // Collision events are still available
+    boxNode->SetPosition({0.0f, 0.5f, 0.0f});
+    physicsWorld->SetCollisionEventsEnabled(true);
+    for (unsigned i = 0; i < 10; ++i)
+        physicsWorld->Update(1.0f / 60.0f);
+    REQUIRE(numCollisionEvents > 0);
+
+    groundBody->SetContactListener(nullptr);
+    boxBody->SetContactListener(nullptr);
+}
+
+TEST_CASE("Physics world applies transforms of moved bodies only")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto scene = MakeShared<Scene>(context);
+    auto physicsWorld = scene->CreateComponent<PhysicsWorld>();
+
+    Node* groundNode = scene->CreateChild("Ground");
+    groundNode->SetPosition({0.0f, -0.5f, 0.0f});
+    groundNode->SetScale({20.0f, 1.0f, 20.0f});
+    groundNode->CreateComponent<RigidBody>();
+    groundNode->CreateComponent<CollisionShape>()->SetBox(Vector3::ONE);
+
+    Node* restingNode = scene->CreateChild("Resting Box");
+    restingNode->SetPosition({-5.0f, 0.5f, 0.0f});
+    auto restingBody = restingNode->CreateComponent<RigidBody>();
+    restingBody->SetMass(1.0f);
+    restingNode->CreateComponent<CollisionShape>()->SetBox(Vector3::ONE);
+
+    // Let the box fall asleep
+    for (unsigned i = 0; i < 300; ++i)
+        physicsWorld->Update(1.0f / 60.0f);
+    REQUIRE_FALSE(restingBody->IsActive());
+
+    Node* fallingNode = scene->CreateChild("Falling Box");
+    fallingNode->SetPosition({5.0f, 10.0f, 0.0f});
+    auto fallingBody = fallingNode->CreateComponent<RigidBody>();
+    fallingBody->SetMass(1.0f);
+    fallingNode->CreateComponent<CollisionShape>()->SetBox(Vector3::ONE);
+
+    // Nodes are up to date when substep events are sent
+    ea::vector<float> preStepHeights;
+    scene->SubscribeToEvent(physicsWorld, E_PHYSICSPRESTEP, [&] { preStepHeights.push_back(fallingNode->GetWorldPosition().y_); });
+
+    const Vector3 restingPosition = restingNode->GetWorldPosition();
+    REQUIRE_FALSE(restingNode->IsDirty());
+
+    physicsWorld->CustomUpdate(3, 1.0f / 60.0f, 0.0f, ea::nullopt);
+
+    REQUIRE_FALSE(restingNode->IsDirty());
+    REQUIRE(restingNode->GetWorldPosition() == restingPosition);
+
+    REQUIRE(preStepHeights.size() == 3);
+    REQUIRE(preStepHeights[0] == 10.0f);
+    REQUIRE(preStepHeights[2] < 10.0f);
+    REQUIRE(fallingNode->GetWorldPosition().y_ < preStepHeights[2]);
+}
+
+#endif
@@ -31,6 +31,7 @@
 #include <Urho3D/Scene/SceneEvents.h>
 #include <Urho3D/Replica/BehaviorNetworkObject.h>
 #include <Urho3D/Replica/FilteredByDistance.h>
+#include <Urho3D/Replica/NetworkSettingsConsts.h>
 #include <Urho3D/Replica/ReplicationManager.h>
 #include <Urho3D/Replica/ReplicatedTransform.h>
 
@@ -49,6 +50,42 @@ SharedPtr<PrefabResource> CreateFilteredTestPrefab(Context* context)
     return Tests::ConvertNodeToPrefab(node);
 }
 
+/// Behavior that hides the object from all clients except the owner, e.g. a team filter.
+class HiddenTestBehavior : public NetworkBehavior
+{
+    URHO3D_OBJECT(HiddenTestBehavior, NetworkBehavior);
+
+public:
+    explicit HiddenTestBehavior(Context* context) : NetworkBehavior(context, NetworkCallbackMask::GetRelevanceForClient) {}
+
+    static void RegisterObject(Context* context)
+    {
+        context->AddFactoryReflection<HiddenTestBehavior>();
+        URHO3D_COPY_BASE_ATTRIBUTES(NetworkBehavior);
+    }
+
+    ea::optional<NetworkObjectRelevance> GetRelevanceForClient(AbstractConnection* connection) override
+    {
+        if (GetNetworkObject()->GetOwnerConnection() == connection)
+            return ea::nullopt;
+        return NetworkObjectRelevance::Irrelevant;
+    }
+};
+
+SharedPtr<PrefabResource> CreateFilteredHiddenTestPrefab(Context* context)
+{
+    auto node = MakeShared<Node>(context);
+    node->CreateComponent<ReplicatedTransform>();
+
+    auto filter = node->CreateComponent<FilteredByDistance>();
+    filter->SetRelevant(false);
+    filter->SetDistance(10.0f);
+
+    node->CreateComponent<HiddenTestBehavior>();
+
+    return Tests::ConvertNodeToPrefab(node);
+}
+
 SharedPtr<PrefabResource> CreateUnfilteredTestPrefab(Context* context)
 {
     auto node = MakeShared<Node>(context);
@@ -162,3 +199,120 @@ TEST_CASE("FilteredByDistance handles object hierarchies")
         REQUIRE_FALSE(unfilteredChildNode);
     }
 }
+
+TEST_CASE("FilteredByDistance objects are managed by interest grid")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    context->GetSubsystem<Network>()->SetUpdateFps(Tests::NetworkSimulator::FramesInSecond);
+
+    auto filteredPrefab = Tests::GetOrCreateResource<PrefabResource>(context, "@/FilteredByDistance/FilteredTest.prefab", CreateFilteredTestPrefab);
+
+    // Create scenes
+    auto serverScene = MakeShared<Scene>(context);
+    auto clientScene = MakeShared<Scene>(context);
+
+    const auto quality = Tests::ConnectionQuality{ 0.08f, 0.12f, 0.20f, 0.02f, 0.02f };
+    Tests::NetworkSimulator sim(serverScene);
+
+    ServerReplicator* serverReplicator = serverScene->GetComponent<ReplicationManager>()->GetServerReplicator();
+    serverReplicator->SetSetting(NetworkSettings::InterestGridCellSize, 4.0f);
+    serverReplicator->SetSetting(NetworkSettings::InterestHysteresis, 0.2f);
+
+    sim.AddClient(clientScene, quality);
+    sim.SimulateTime(5.0f);
+
+    // Spawn objects
+    {
+        auto clientNode = Tests::SpawnOnServer<BehaviorNetworkObject>(serverScene, filteredPrefab, "Client Node");
+        clientNode->GetComponent<BehaviorNetworkObject>()->SetOwner(sim.GetServerToClientConnection(clientScene));
+        clientNode->SetWorldPosition(Vector3(0.0f, 0.0f, 0.0f));
+
+        auto nearNode = Tests::SpawnOnServer<BehaviorNetworkObject>(serverScene, filteredPrefab, "Near Node");
+        nearNode->SetWorldPosition(Vector3(0.0f, 0.0f, 5.0f));
+
+        auto borderNode = Tests::SpawnOnServer<BehaviorNetworkObject>(serverScene, filteredPrefab, "Border Node");
+        borderNode->SetWorldPosition(Vector3(0.0f, 0.0f, 11.0f));
+
+        auto farNode = Tests::SpawnOnServer<BehaviorNetworkObject>(serverScene, filteredPrefab, "Far Node");
+        farNode->SetWorldPosition(Vector3(0.0f, 0.0f, -30.0f));
+    }
+
+    // Expect only objects in range
+    sim.SimulateTime(8.0f);
+
+    REQUIRE(clientScene->GetChild("Client Node", true));
+    REQUIRE(clientScene->GetChild("Near Node", true));
+    REQUIRE_FALSE(clientScene->GetChild("Border Node", true));
+    REQUIRE_FALSE(clientScene->GetChild("Far Node", true));
+
+    // Move the object into the range
+    serverScene->GetChild("Border Node", true)->SetWorldPosition(Vector3{0.0f, 0.0f, 9.0f});
+    sim.SimulateTime(8.0f);
+
+    REQUIRE(clientScene->GetChild("Border Node", true));
+    REQUIRE(clientScene->GetChild("Border Node", true)->GetWorldPosition() == Vector3{0.0f, 0.0f, 9.0f});
+
+    // Expect the object to stay while it is within hysteresis
+    serverScene->GetChild("Border Node", true)->SetWorldPosition(Vector3{0.0f, 0.0f, 11.0f});
+    sim.SimulateTime(8.0f);
+
+    REQUIRE(clientScene->GetChild("Border Node", true));
+    REQUIRE(clientScene->GetChild("Border Node", true)->GetWorldPosition() == Vector3{0.0f, 0.0f, 11.0f});
+
+    serverScene->GetChild("Border Node", true)->SetWorldPosition(Vector3{0.0f, 0.0f, 13.0f});
+    sim.SimulateTime(8.0f);
+
+    REQUIRE_FALSE(clientScene->GetChild("Border Node", true));
+
+    // Move the client to the far object
+    serverScene->GetChild("Client Node", true)->SetWorldPosition(Vector3{0.0f, 0.0f, -25.0f});
+    sim.SimulateTime(8.0f);
+
+    REQUIRE(clientScene->GetChild("Client Node", true));
+    REQUIRE_FALSE(clientScene->GetChild("Near Node", true));
+    REQUIRE(clientScene->GetChild("Far Node", true));
+    REQUIRE(clientScene->GetChild("Far Node", true)->GetWorldPosition() == Vector3{0.0f, 0.0f, -30.0f});
+}
+
+TEST_CASE("Interest grid keeps other relevance filters of FilteredByDistance objects")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    context->GetSubsystem<Network>()->SetUpdateFps(Tests::NetworkSimulator::FramesInSecond);
+    auto guard = Tests::MakeScopedReflection<Tests::RegisterObject<HiddenTestBehavior>>(context);
+
+    auto filteredPrefab = Tests::GetOrCreateResource<PrefabResource>(context, "@/FilteredByDistance/FilteredTest.prefab", CreateFilteredTestPrefab);
+    auto hiddenPrefab = Tests::GetOrCreateResource<PrefabResource>(context, "@/FilteredByDistance/FilteredHiddenTest.prefab", CreateFilteredHiddenTestPrefab);
+
+    // Create scenes
+    auto serverScene = MakeShared<Scene>(context);
+    auto clientScene = MakeShared<Scene>(context);
+
+    const auto quality = Tests::ConnectionQuality{ 0.08f, 0.12f, 0.20f, 0.02f, 0.02f };
+    Tests::NetworkSimulator sim(serverScene);
+
+    ServerReplicator* serverReplicator = serverScene->GetComponent<ReplicationManager>()->GetServerReplicator();
+    serverReplicator->SetSetting(NetworkSettings::InterestGridCellSize, 4.0f);
+
+    sim.AddClient(clientScene, quality);
+    sim.SimulateTime(5.0f);
+
+    // Spawn objects
+    {
+        auto clientNode = Tests::SpawnOnServer<BehaviorNetworkObject>(serverScene, filteredPrefab, "Client Node");
+        clientNode->GetComponent<BehaviorNetworkObject>()->SetOwner(sim.GetServerToClientConnection(clientScene));
+        clientNode->SetWorldPosition(Vector3(0.0f, 0.0f, 0.0f));
+
+        auto nearNode = Tests::SpawnOnServer<BehaviorNetworkObject>(serverScene, filteredPrefab, "Near Node");
+        nearNode->SetWorldPosition(Vector3(0.0f, 0.0f, 5.0f));
+
+        auto hiddenNode = Tests::SpawnOnServer<BehaviorNetworkObject>(serverScene, hiddenPrefab, "Hidden Node");
+        hiddenNode->SetWorldPosition(Vector3(0.0f, 0.0f, 5.0f));
+    }
+
+    // Expect objects in range except the hidden one
+    sim.SimulateTime(8.0f);
+
+    REQUIRE(clientScene->GetChild("Client Node", true));
+    REQUIRE(clientScene->GetChild("Near Node", true));
+    REQUIRE_FALSE(clientScene->GetChild("Hidden Node", true));
+}
@@ -25,6 +25,7 @@
 #include <Urho3D/IO/MountedExternalMemory.h>
 #include <Urho3D/IO/VirtualFileSystem.h>
 #include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Resource/XMLFile.h>
 
 namespace Tests
 {
@@ -52,4 +53,64 @@ TEST_CASE("ResourceCache loads resources from memory")
     CHECK(xmlFile->GetRoot().GetName() == "something_else");
 }
 
+TEST_CASE("ResourceCache loads resources in background")
+{
+    const auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    const auto resourceCache = context->GetSubsystem<ResourceCache>();
+    auto mountPoint = MakeShared<MountedExternalMemory>(context, "memory");
+    const MountPointGuard mountPointGuard(mountPoint);
+
+    // Memory is not copied and should be kept alive
+    static const unsigned numFiles = 16;
+    ea::vector<ea::string> fileContents;
+    for (unsigned i = 0; i < numFiles; ++i)
+        fileContents.push_back(Format("<file index=\"{}\" />", i));
+    for (unsigned i = 0; i < numFiles; ++i)
+        mountPoint->LinkMemory(Format("background/file{}.xml", i), fileContents[i]);
+
+    const auto statisticsBefore = resourceCache->GetBackgroundLoadStatistics()[XMLFile::GetTypeStatic()];
+
+    for (unsigned i = 0; i < numFiles; ++i)
+    {
+        const int priority = i % 4 == 0 ? 1 : 0;
+        REQUIRE(resourceCache->BackgroundLoadResource<XMLFile>(
+            Format("memory://background/file{}.xml", i), true, nullptr, priority));
+    }
+    REQUIRE_FALSE(resourceCache->BackgroundLoadResource<XMLFile>("memory://background/file0.xml"));
+
+    // Cancelled resource should never get to the cache
+    REQUIRE(resourceCache->CancelBackgroundLoadResource(XMLFile::GetTypeStatic(), "memory://background/file1.xml"));
+    REQUIRE_FALSE(resourceCache->CancelBackgroundLoadResource(XMLFile::GetTypeStatic(), "memory://background/none.xml"));
+
+    // Resource that is requested explicitly should be available immediately
+    auto xmlFile = resourceCache->GetResource<XMLFile>("memory://background/file2.xml");
+    REQUIRE(xmlFile);
+    CHECK(xmlFile->GetRoot().GetUInt("index") == 2);
+
+    for (unsigned i = 0; i < 1000 && resourceCache->GetNumBackgroundLoadResources() > 0; ++i)
+        Tests::RunFrame(context, 0.01f);
+    REQUIRE(resourceCache->GetNumBackgroundLoadResources() == 0);
+
+    for (unsigned i = 0; i < numFiles; ++i)
+    {
+        const auto existingFile = resourceCache->GetExistingResource<XMLFile>(Format("memory://background/file{}.xml", i));
+        if (i == 1)
+        {
+            CHECK_FALSE(existingFile);
+            continue;
+        }
+
+        REQUIRE(existingFile);
+        CHECK(existingFile->GetRoot().GetUInt("index") == i);
+    }
+
+    const auto statisticsAfter = resourceCache->GetBackgroundLoadStatistics()[XMLFile::GetTypeStatic()];
+    CHECK(statisticsAfter.numLoaded_ - statisticsBefore.numLoaded_ == numFiles - 1);
+    CHECK(statisticsAfter.numFailed_ == statisticsBefore.numFailed_);
+    CHECK(statisticsAfter.numCancelled_ - statisticsBefore.numCancelled_ == 1);
+
+    for (unsigned i = 0; i < numFiles; ++i)
+        resourceCache->ReleaseResource<XMLFile>(Format("memory://background/file{}.xml", i), true);
+}
+
 } // namespace Tests
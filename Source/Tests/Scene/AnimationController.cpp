@@ -26,6 +26,7 @@
 
 #include <Urho3D/Graphics/AnimatedModel.h>
 #include <Urho3D/Graphics/AnimationController.h>
+#include <Urho3D/Graphics/AnimationPoseCache.h>
 #include <Urho3D/Graphics/Camera.h>
 #include <Urho3D/Graphics/Octree.h>
 #include <Urho3D/Scene/Scene.h>
@@ -857,3 +858,110 @@ TEST_CASE("AnimationController merges result in smooth transition")
 
     animationController2->Update(0.25);
 }
+
+TEST_CASE("AnimatedModels with identical animation states share cached pose")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto model = Tests::GetOrCreateResource<Model>(context, "@Tests/AnimationController/SkinnedModel.mdl", CreateTestSkinnedModel);
+    auto animationTranslateX = Tests::GetOrCreateResource<Animation>(context, "@Tests/AnimationController/TranslateX.ani", CreateTestTranslateXAnimation);
+    auto animationRotate = Tests::GetOrCreateResource<Animation>(context, "@Tests/AnimationController/Rotation.ani", CreateTestRotationAnimation);
+
+    auto poseCache = context->GetSubsystem<AnimationPoseCache>();
+    REQUIRE(poseCache);
+    poseCache->SetEnabled(true);
+
+    // Setup
+    auto scene = MakeShared<Scene>(context);
+    scene->CreateComponent<Octree>();
+
+    static const unsigned numModels = 4;
+    ea::vector<WeakPtr<Node>> quads;
+    for (unsigned i = 0; i < numModels; ++i)
+    {
+        auto node = scene->CreateChild("Node");
+        node->SetPosition({10.0f * i, 0.0f, 0.0f});
+        auto animatedModel = node->CreateComponent<AnimatedModel>();
+        animatedModel->SetModel(model);
+
+        // Last model is out of sync with others
+        const float startTime = i + 1 == numModels ? 0.5f : 0.0f;
+        auto animationController = node->CreateComponent<AnimationController>();
+        animationController->PlayNew(AnimationParameters{animationRotate}.Looped().Time(startTime));
+        animationController->PlayNew(AnimationParameters{animationTranslateX}.Looped().Time(startTime));
+
+        quads.emplace_back(node->GetChild("Quad 2", true));
+    }
+
+    // Time 0.5: Translate X to -1, Rotate 90 degrees (X to -Z, Z to X)
+    const unsigned numHits = poseCache->GetNumHits();
+    Tests::RunFrame(context, 0.5f, 0.05f);
+    REQUIRE(poseCache->GetNumHits() > numHits);
+    for (unsigned i = 0; i + 1 < numModels; ++i)
+        REQUIRE(quads[i]->GetWorldPosition().Equals({10.0f * i, 1.0f, 1.0f}, M_LARGE_EPSILON));
+
+    // Time 1.0: Translate X to 0, Rotate 180 degrees (X to -X, Z to -Z)
+    REQUIRE(quads[numModels - 1]->GetWorldPosition().Equals({10.0f * (numModels - 1), 1.0f, 0.0f}, M_LARGE_EPSILON));
+
+    poseCache->SetEnabled(false);
+}
+
+TEST_CASE("AnimatedModels blending onto different start poses don't share cached pose")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto model = Tests::GetOrCreateResource<Model>(context, "@Tests/AnimationController/SkinnedModel.mdl", CreateTestSkinnedModel);
+    auto animationTranslateX = Tests::GetOrCreateResource<Animation>(context, "@Tests/AnimationController/TranslateX.ani", CreateTestTranslateXAnimation);
+    auto animationTranslateZ = Tests::GetOrCreateResource<Animation>(context, "@Tests/AnimationController/TranslateZ.ani", CreateTestTranslateZAnimation);
+
+    auto poseCache = context->GetSubsystem<AnimationPoseCache>();
+    REQUIRE(poseCache);
+
+    // Setup: identical crossfades, Quad 2 of each model starts in different pose
+    const auto createScene = [&](ea::vector<WeakPtr<Node>>& quads)
+    {
+        auto scene = MakeShared<Scene>(context);
+        scene->CreateComponent<Octree>();
+
+        for (unsigned i = 0; i < 2; ++i)
+        {
+            auto node = scene->CreateChild("Node");
+            node->SetPosition({10.0f * i, 0.0f, 0.0f});
+            auto animatedModel = node->CreateComponent<AnimatedModel>();
+            animatedModel->SetModel(model);
+
+            auto quad = node->GetChild("Quad 2", true);
+            quad->SetPosition(quad->GetPosition() + Vector3{0.0f, 4.0f * i, 0.0f});
+            quad->SetRotation(Quaternion{90.0f * i, Vector3::UP});
+
+            auto animationController = node->CreateComponent<AnimationController>();
+            animationController->PlayNew(AnimationParameters{animationTranslateX}.Looped().Weight(0.5f));
+            animationController->PlayNew(AnimationParameters{animationTranslateZ}.Looped().Weight(0.5f));
+
+            quads.emplace_back(quad);
+        }
+        return scene;
+    };
+
+    // Assert: cached run matches uncached one for each model
+    poseCache->SetEnabled(true);
+    ea::vector<WeakPtr<Node>> cachedQuads;
+    auto cachedScene = createScene(cachedQuads);
+
+    const unsigned numHits = poseCache->GetNumHits();
+    Tests::RunFrame(context, 0.05f, 0.05f);
+    REQUIRE(poseCache->GetNumHits() == numHits);
+
+    ea::vector<Matrix3x4> cachedTransforms;
+    for (Node* quad : cachedQuads)
+        cachedTransforms.push_back(quad->GetWorldTransform());
+    cachedScene = nullptr;
+
+    poseCache->SetEnabled(false);
+    ea::vector<WeakPtr<Node>> referenceQuads;
+    auto referenceScene = createScene(referenceQuads);
+    Tests::RunFrame(context, 0.05f, 0.05f);
+
+    for (unsigned i = 0; i < 2; ++i)
+        REQUIRE(cachedTransforms[i].Equals(referenceQuads[i]->GetWorldTransform(), M_LARGE_EPSILON));
+}
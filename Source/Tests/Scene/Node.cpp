@@ -199,3 +199,80 @@ TEST_CASE("Test FindComponents<WeakPtr<T>>")
         CHECK(dest == ea::vector<WeakPtr<StaticModel>>{WeakPtr<StaticModel>(nodeComponent)});
     }
 };
+
+TEST_CASE("TransformStore updates world transforms in batch")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto scene = MakeShared<Scene>(context);
+    scene->SetTransformStoreEnabled(true);
+
+    auto root = scene->CreateChild("Root");
+    auto child = root->CreateChild("Child");
+    auto grandChild = child->CreateChild("GrandChild");
+    auto otherRoot = scene->CreateChild("OtherRoot");
+
+    root->SetPosition({1.0f, 0.0f, 0.0f});
+    root->SetRotation({90.0f, Vector3::UP});
+    child->SetPosition({0.0f, 0.0f, 1.0f});
+    child->SetScale(2.0f);
+    grandChild->SetPosition({0.0f, 1.0f, 1.0f});
+    otherRoot->SetPosition({0.0f, 5.0f, 0.0f});
+
+    scene->UpdateWorldTransforms();
+    TransformStore* store = scene->GetTransformStore();
+    REQUIRE(store->GetNumNodes() == 4);
+    REQUIRE(store->GetNumLevels() == 3);
+    REQUIRE(store->GetNumUpdatedNodes() == 4);
+    REQUIRE_FALSE(grandChild->IsDirty());
+    REQUIRE(grandChild->GetWorldPosition().Equals({4.0f, 2.0f, 0.0f}));
+    REQUIRE(grandChild->GetWorldRotation().Equals(Quaternion{90.0f, Vector3::UP}));
+    const unsigned grandChildIndex = store->GetNodeIndex(grandChild);
+    REQUIRE(store->GetNodes()[grandChildIndex] == grandChild);
+    REQUIRE(store->GetWorldTransforms()[grandChildIndex].Translation().Equals({4.0f, 2.0f, 0.0f}));
+
+    // Only dirty subtree is updated
+    child->SetPosition({0.0f, 0.0f, 2.0f});
+    scene->UpdateWorldTransforms();
+    REQUIRE(store->GetNumUpdatedNodes() == 2);
+    REQUIRE(grandChild->GetWorldPosition().Equals({5.0f, 2.0f, 0.0f}));
+
+    scene->UpdateWorldTransforms();
+    REQUIRE(store->GetNumUpdatedNodes() == 0);
+
+    // Nested dirty subtrees are updated once
+    grandChild->SetPosition({0.0f, 1.0f, 0.0f});
+    root->SetPosition({2.0f, 0.0f, 0.0f});
+    scene->UpdateWorldTransforms();
+    REQUIRE(store->GetNumUpdatedNodes() == 3);
+    REQUIRE(grandChild->GetWorldPosition().Equals({4.0f, 2.0f, 0.0f}));
+
+    // Reparent and move
+    otherRoot->AddChild(grandChild);
+    otherRoot->SetPosition({0.0f, 10.0f, 0.0f});
+    scene->UpdateWorldTransforms();
+    REQUIRE(store->GetNumNodes() == 4);
+    REQUIRE(store->GetNumLevels() == 2);
+    REQUIRE(store->GetNodeIndex(grandChild) == grandChildIndex);
+    REQUIRE_FALSE(grandChild->IsDirty());
+    REQUIRE(grandChild->GetWorldPosition().Equals({0.0f, 11.0f, 0.0f}));
+
+    // Remove nodes
+    SharedPtr<Node> removedChild{child};
+    root->Remove();
+    scene->UpdateWorldTransforms();
+    REQUIRE(store->GetNumNodes() == 2);
+    REQUIRE(store->GetNumLevels() == 2);
+    REQUIRE(store->GetNodeIndex(removedChild) == M_MAX_UNSIGNED);
+
+    // Add new subtree and reuse indices
+    auto newChild = grandChild->CreateChild("NewChild");
+    newChild->SetPosition({1.0f, 0.0f, 0.0f});
+    scene->UpdateWorldTransforms();
+    REQUIRE(store->GetNumNodes() == 3);
+    REQUIRE(store->GetNodes().size() == 4);
+    REQUIRE(store->GetNumLevels() == 3);
+    REQUIRE(newChild->GetWorldPosition().Equals({1.0f, 11.0f, 0.0f}));
+
+    scene->SetTransformStoreEnabled(false);
+    REQUIRE(newChild->GetWorldPosition().Equals({1.0f, 11.0f, 0.0f}));
+}
@@ -171,6 +171,12 @@ struct dtCrowdAgent
 	dtPathQueueRef targetPathqRef;		///< Path finder ref.
 	bool targetReplan;					///< Flag indicating that the current path is being replanned.
 	float targetReplanTime;				/// <Time since the agent's target was replanned.
+
+	// Urho3D: Add crowd LOD support
+	/// True if the agent is not simulated in the current update. Other agents still avoid it.
+	bool lodSkip;
+	/// Time step of the agent in the current update, or zero to use the time step of the crowd.
+	float lodTimeStep;
 };
 
 struct dtCrowdAgentAnimation
@@ -204,6 +210,12 @@ struct dtCrowdAgentDebugInfo
 /// Type for the update callback.
 typedef void (*dtUpdateCallback)(bool positionUpdate, dtCrowdAgent* agent, float* pos, float dt);
 
+// Urho3D: Add parallel update support
+/// Type for the task that processes agents in range [begin, end) in the thread with the specified index.
+typedef void (*dtCrowdTask)(void* context, int begin, int end, int threadIndex);
+/// Type for the parallel for callback. It should invoke the task for ranges covering [0, count) and wait for completion.
+typedef void (*dtCrowdParallelForCallback)(void* userData, int count, dtCrowdTask task, void* context);
+
 /// Provides local steering behaviors for a group of agents. 
 /// @ingroup crowd
 class dtCrowd
@@ -234,6 +246,21 @@ class dtCrowd
 
 	dtNavMeshQuery* m_navquery;
 
+	// Urho3D: Add parallel update support
+	dtCrowdParallelForCallback m_parallelFor;
+	void* m_parallelForUserData;
+	int m_maxThreads;
+	dtNavMeshQuery** m_threadNavQueries;
+	dtObstacleAvoidanceQuery** m_threadObstacleQueries;
+	int* m_threadSampleCounts;
+	int* m_agentOrder;
+	long long* m_agentCells;
+
+	bool allocThreadData(const int maxThreads);
+	void freeThreadData();
+	int partitionAgents(dtCrowdAgent** agents, const int nagents, int* order);
+	template <class T> void parallelFor(const int count, const T& task);
+
 	void updateTopologyOptimization(dtCrowdAgent** agents, const int nagents, const float dt);
 	void updateMoveRequest(const float dt);
 	void checkPathValidity(dtCrowdAgent** agents, const int nagents, const float dt);
@@ -255,6 +282,15 @@ public:
 	///  @param[in]		nav				The navigation mesh to use for planning.
 	/// @return True if the initialization succeeded.
 	bool init(const int maxAgents, const float maxAgentRadius, dtNavMesh* nav, dtUpdateCallback cb = 0);
+
+	// Urho3D: Add parallel update support
+	/// Enables parallel update of the agents. Agents are partitioned spatially and processed in ranges.
+	/// Update callbacks are still invoked from the calling thread.
+	///  @param[in]		cb			The parallel for callback, or null to update agents in the calling thread.
+	///  @param[in]		userData	User data passed to the callback.
+	///  @param[in]		maxThreads	The maximum number of threads. Thread index passed to tasks should be less than this value.
+	/// @return True if the per-thread queries are successfully allocated.
+	bool setParallelFor(dtCrowdParallelForCallback cb, void* userData, const int maxThreads);
 	
 	/// Sets the shared avoidance configuration for the specified index.
 	///  @param[in]		idx		The index. [Limits: 0 <= value < #DT_CROWD_MAX_OBSTAVOIDANCE_PARAMS]
@@ -23,6 +23,7 @@
 #include <float.h>
 #include <stdlib.h>
 #include <new>
+#include <algorithm>
 #include "DetourCrowd.h"
 #include "DetourNavMesh.h"
 #include "DetourNavMeshQuery.h"
@@ -52,6 +53,15 @@ static const int MAX_ITERS_PER_UPDATE = 100;
 
 static const int MAX_PATHQUEUE_NODES = 4096;
 static const int MAX_COMMON_NODES = 512;
+// Urho3D: Minimum number of agents to update in parallel, and size of the spatial partition cell in proximity grid cells
+static const int MIN_PARALLEL_AGENTS = 64;
+static const float PARTITION_CELL_SCALE = 8.0f;
+
+// Urho3D: Add crowd LOD support
+inline float getAgentTimeStep(const dtCrowdAgent* ag, const float dt)
+{
+	return ag->lodTimeStep > 0.0f ? ag->lodTimeStep : dt;
+}
 
 inline float tween(const float t, const float t0, const float t1)
 {
@@ -343,7 +353,15 @@ dtCrowd::dtCrowd() :
 	m_maxPathResult(0),
 	m_maxAgentRadius(0),
 	m_velocitySampleCount(0),
-	m_navquery(0)
+	m_navquery(0),
+	m_parallelFor(0), // Urho3D: Add parallel update support
+	m_parallelForUserData(0),
+	m_maxThreads(0),
+	m_threadNavQueries(0),
+	m_threadObstacleQueries(0),
+	m_threadSampleCounts(0),
+	m_agentOrder(0),
+	m_agentCells(0)
 {
 	// Urho3D: initialize all class members
 	memset(&m_agentPlacementHalfExtents, 0, sizeof(m_agentPlacementHalfExtents));
@@ -357,6 +375,15 @@ dtCrowd::~dtCrowd()
 
 void dtCrowd::purge()
 {
+	// Urho3D: Add parallel update support
+	freeThreadData();
+
+	dtFree(m_agentOrder);
+	m_agentOrder = 0;
+
+	dtFree(m_agentCells);
+	m_agentCells = 0;
+
 	for (int i = 0; i < m_maxAgents; ++i)
 		m_agents[i].~dtCrowdAgent();
 	dtFree(m_agents);
@@ -466,10 +493,138 @@ bool dtCrowd::init(const int maxAgents, const float maxAgentRadius, dtNavMesh* n
 		return false;
 	if (dtStatusFailed(m_navquery->init(nav, MAX_COMMON_NODES)))
 		return false;
-	
+
+	// Urho3D: Add parallel update support
+	m_agentOrder = (int*)dtAlloc(sizeof(int)*m_maxAgents, DT_ALLOC_PERM);
+	if (!m_agentOrder)
+		return false;
+
+	m_agentCells = (long long*)dtAlloc(sizeof(long long)*m_maxAgents, DT_ALLOC_PERM);
+	if (!m_agentCells)
+		return false;
+
+	return allocThreadData(dtMax(m_maxThreads, 1));
+}
+
+// Urho3D: Add parallel update support
+bool dtCrowd::setParallelFor(dtCrowdParallelForCallback cb, void* userData, const int maxThreads)
+{
+	m_parallelFor = cb;
+	m_parallelForUserData = userData;
+	if (!m_navquery)
+	{
+		m_maxThreads = dtMax(maxThreads, 1);
+		return true;
+	}
+	return allocThreadData(dtMax(maxThreads, 1));
+}
+
+bool dtCrowd::allocThreadData(const int maxThreads)
+{
+	freeThreadData();
+	m_maxThreads = maxThreads;
+
+	m_threadNavQueries = (dtNavMeshQuery**)dtAlloc(sizeof(dtNavMeshQuery*)*maxThreads, DT_ALLOC_PERM);
+	if (!m_threadNavQueries)
+		return false;
+	memset(m_threadNavQueries, 0, sizeof(dtNavMeshQuery*)*maxThreads);
+
+	m_threadObstacleQueries = (dtObstacleAvoidanceQuery**)dtAlloc(sizeof(dtObstacleAvoidanceQuery*)*maxThreads, DT_ALLOC_PERM);
+	if (!m_threadObstacleQueries)
+		return false;
+	memset(m_threadObstacleQueries, 0, sizeof(dtObstacleAvoidanceQuery*)*maxThreads);
+
+	m_threadSampleCounts = (int*)dtAlloc(sizeof(int)*maxThreads, DT_ALLOC_PERM);
+	if (!m_threadSampleCounts)
+		return false;
+
+	// The first thread uses queries of the crowd
+	m_threadNavQueries[0] = m_navquery;
+	m_threadObstacleQueries[0] = m_obstacleQuery;
+
+	for (int i = 1; i < maxThreads; ++i)
+	{
+		m_threadNavQueries[i] = dtAllocNavMeshQuery();
+		if (!m_threadNavQueries[i])
+			return false;
+		if (dtStatusFailed(m_threadNavQueries[i]->init(m_navquery->getAttachedNavMesh(), MAX_COMMON_NODES)))
+			return false;
+
+		m_threadObstacleQueries[i] = dtAllocObstacleAvoidanceQuery();
+		if (!m_threadObstacleQueries[i])
+			return false;
+		if (!m_threadObstacleQueries[i]->init(6, 8))
+			return false;
+	}
+
 	return true;
 }
 
+void dtCrowd::freeThreadData()
+{
+	for (int i = 1; i < m_maxThreads; ++i)
+	{
+		if (m_threadNavQueries)
+			dtFreeNavMeshQuery(m_threadNavQueries[i]);
+		if (m_threadObstacleQueries)
+			dtFreeObstacleAvoidanceQuery(m_threadObstacleQueries[i]);
+	}
+
+	dtFree(m_threadNavQueries);
+	m_threadNavQueries = 0;
+
+	dtFree(m_threadObstacleQueries);
+	m_threadObstacleQueries = 0;
+
+	dtFree(m_threadSampleCounts);
+	m_threadSampleCounts = 0;
+}
+
+int dtCrowd::partitionAgents(dtCrowdAgent** agents, const int nagents, int* order)
+{
+	int norder = 0;
+	for (int i = 0; i < nagents; ++i)
+	{
+		if (!agents[i]->lodSkip)
+			order[norder++] = i;
+	}
+
+	// Sort agents by partition cell so that each task processes agents that are close to each other
+	if (m_parallelFor && m_maxThreads > 1 && norder >= MIN_PARALLEL_AGENTS)
+	{
+		const float invCellSize = 1.0f / (m_grid->getCellSize() * PARTITION_CELL_SCALE);
+		long long* cells = m_agentCells;
+		for (int i = 0; i < nagents; ++i)
+		{
+			const float* p = agents[i]->npos;
+			const long long x = (long long)dtMathFloorf(p[0] * invCellSize);
+			const long long z = (long long)dtMathFloorf(p[2] * invCellSize);
+			cells[i] = (z << 32) + (x & 0xffffffffll);
+		}
+		std::sort(order, order + norder, [cells](int lhs, int rhs)
+		{
+			return cells[lhs] != cells[rhs] ? cells[lhs] < cells[rhs] : lhs < rhs;
+		});
+	}
+
+	return norder;
+}
+
+template <class T> void dtCrowd::parallelFor(const int count, const T& task)
+{
+	if (!m_parallelFor || m_maxThreads <= 1 || count < MIN_PARALLEL_AGENTS)
+	{
+		task(0, count, 0);
+		return;
+	}
+
+	const dtCrowdTask invoke = [](void* context, int begin, int end, int threadIndex)
+	{
+		(*static_cast<const T*>(context))(begin, end, threadIndex);
+	};
+	m_parallelFor(m_parallelForUserData, count, invoke, const_cast<T*>(&task));
+}
+
 void dtCrowd::setObstacleAvoidanceParams(const int idx, const dtObstacleAvoidanceParams* params)
 {
 	if (idx >= 0 && idx < DT_CROWD_MAX_OBSTAVOIDANCE_PARAMS)
@@ -574,6 +729,10 @@ int dtCrowd::addAgent(const float* pos, const dtCrowdAgentParams* params)
 	// Urho3D: added to fix illegal memory access when ncorners is queried before the agent has updated
 	ag->ncorners = 0;
 
+	// Urho3D: Add crowd LOD support
+	ag->lodSkip = false;
+	ag->lodTimeStep = 0.0f;
+
 	return idx;
 }
 
@@ -1083,73 +1242,87 @@ void dtCrowd::update(const float dt, dtCrowdAgentDebugInfo* debug)
 		m_grid->addItem((unsigned short)i, p[0]-r, p[2]-r, p[0]+r, p[2]+r);
 	}
 	
+	// Urho3D: Partition simulated agents spatially and process them in parallel.
+	// Each task writes only to its own agents and reads other agents' results from previous stages.
+	int* order = m_agentOrder;
+	const int norder = partitionAgents(agents, nagents, order);
+
 	// Get nearby navmesh segments and agents to collide with.
-	for (int i = 0; i < nagents; ++i)
+	parallelFor(norder, [&](int begin, int end, int threadIndex)
 	{
-		dtCrowdAgent* ag = agents[i];
-		if (ag->state != DT_CROWDAGENT_STATE_WALKING)
-			continue;
-
-		// Update the collision boundary after certain distance has been passed or
-		// if it has become invalid.
-		const float updateThr = ag->params.collisionQueryRange*0.25f;
-		if (dtVdist2DSqr(ag->npos, ag->boundary.getCenter()) > dtSqr(updateThr) ||
-			!ag->boundary.isValid(m_navquery, &m_filters[ag->params.queryFilterType]))
+		dtNavMeshQuery* navquery = m_threadNavQueries[threadIndex];
+		for (int k = begin; k < end; ++k)
 		{
-			ag->boundary.update(ag->corridor.getFirstPoly(), ag->npos, ag->params.collisionQueryRange,
-								m_navquery, &m_filters[ag->params.queryFilterType]);
+			dtCrowdAgent* ag = agents[order[k]];
+			if (ag->state != DT_CROWDAGENT_STATE_WALKING)
+				continue;
+
+			// Update the collision boundary after certain distance has been passed or
+			// if it has become invalid.
+			const float updateThr = ag->params.collisionQueryRange*0.25f;
+			if (dtVdist2DSqr(ag->npos, ag->boundary.getCenter()) > dtSqr(updateThr) ||
+				!ag->boundary.isValid(navquery, &m_filters[ag->params.queryFilterType]))
+			{
+				ag->boundary.update(ag->corridor.getFirstPoly(), ag->npos, ag->params.collisionQueryRange,
+									navquery, &m_filters[ag->params.queryFilterType]);
+			}
+			// Query neighbour agents
+			ag->nneis = getNeighbours(ag->npos, ag->params.height, ag->params.collisionQueryRange,
+									  ag, ag->neis, DT_CROWDAGENT_MAX_NEIGHBOURS,
+									  agents, nagents, m_grid);
+			for (int j = 0; j < ag->nneis; j++)
+				ag->neis[j].idx = getAgentIndex(agents[ag->neis[j].idx]);
 		}
-		// Query neighbour agents
-		ag->nneis = getNeighbours(ag->npos, ag->params.height, ag->params.collisionQueryRange,
-								  ag, ag->neis, DT_CROWDAGENT_MAX_NEIGHBOURS,
-								  agents, nagents, m_grid);
-		for (int j = 0; j < ag->nneis; j++)
-			ag->neis[j].idx = getAgentIndex(agents[ag->neis[j].idx]);
-	}
+	});
 	
 	// Find next corner to steer to.
-	for (int i = 0; i < nagents; ++i)
+	parallelFor(norder, [&](int begin, int end, int threadIndex)
 	{
-		dtCrowdAgent* ag = agents[i];
-		
-		if (ag->state != DT_CROWDAGENT_STATE_WALKING)
-			continue;
-		if (ag->targetState == DT_CROWDAGENT_TARGET_NONE || ag->targetState == DT_CROWDAGENT_TARGET_VELOCITY)
-			continue;
-		
-		// Find corners for steering
-		ag->ncorners = ag->corridor.findCorners(ag->cornerVerts, ag->cornerFlags, ag->cornerPolys,
-												DT_CROWDAGENT_MAX_CORNERS, m_navquery, &m_filters[ag->params.queryFilterType]);
-		
-		// Check to see if the corner after the next corner is directly visible,
-		// and short cut to there.
-		if ((ag->params.updateFlags & DT_CROWD_OPTIMIZE_VIS) && ag->ncorners > 0)
+		dtNavMeshQuery* navquery = m_threadNavQueries[threadIndex];
+		for (int k = begin; k < end; ++k)
 		{
-			const float* target = &ag->cornerVerts[dtMin(1,ag->ncorners-1)*3];
-			ag->corridor.optimizePathVisibility(target, ag->params.pathOptimizationRange, m_navquery, &m_filters[ag->params.queryFilterType]);
+			const int i = order[k];
+			dtCrowdAgent* ag = agents[i];
+			
+			if (ag->state != DT_CROWDAGENT_STATE_WALKING)
+				continue;
+			if (ag->targetState == DT_CROWDAGENT_TARGET_NONE || ag->targetState == DT_CROWDAGENT_TARGET_VELOCITY)
+				continue;
 			
-			// Copy data for debug purposes.
-			if (debugIdx == i)
+			// Find corners for steering
+			ag->ncorners = ag->corridor.findCorners(ag->cornerVerts, ag->cornerFlags, ag->cornerPolys,
+													DT_CROWDAGENT_MAX_CORNERS, navquery, &m_filters[ag->params.queryFilterType]);
+			
+			// Check to see if the corner after the next corner is directly visible,
+			// and short cut to there.
+			if ((ag->params.updateFlags & DT_CROWD_OPTIMIZE_VIS) && ag->ncorners > 0)
 			{
-				dtVcopy(debug->optStart, ag->corridor.getPos());
-				dtVcopy(debug->optEnd, target);
+				const float* target = &ag->cornerVerts[dtMin(1,ag->ncorners-1)*3];
+				ag->corridor.optimizePathVisibility(target, ag->params.pathOptimizationRange, navquery, &m_filters[ag->params.queryFilterType]);
+				
+				// Copy data for debug purposes.
+				if (debugIdx == i)
+				{
+					dtVcopy(debug->optStart, ag->corridor.getPos());
+					dtVcopy(debug->optEnd, target);
+				}
 			}
-		}
-		else
-		{
-			// Copy data for debug purposes.
-			if (debugIdx == i)
+			else
 			{
-				dtVset(debug->optStart, 0,0,0);
-				dtVset(debug->optEnd, 0,0,0);
+				// Copy data for debug purposes.
+				if (debugIdx == i)
+				{
+					dtVset(debug->optStart, 0,0,0);
+					dtVset(debug->optEnd, 0,0,0);
+				}
 			}
 		}
-	}
+	});
 	
 	// Trigger off-mesh connections (depends on corners).
-	for (int i = 0; i < nagents; ++i)
+	for (int k = 0; k < norder; ++k)
 	{
-		dtCrowdAgent* ag = agents[i];
+		dtCrowdAgent* ag = agents[order[k]];
 		
 		if (ag->state != DT_CROWDAGENT_STATE_WALKING)
 			continue;
@@ -1188,45 +1361,71 @@ void dtCrowd::update(const float dt, dtCrowdAgentDebugInfo* debug)
 	}
 		
 	// Calculate steering.
-	for (int i = 0; i < nagents; ++i)
+	parallelFor(norder, [&](int begin, int end, int threadIndex)
 	{
-		dtCrowdAgent* ag = agents[i];
+		for (int k = begin; k < end; ++k)
+		{
+			dtCrowdAgent* ag = agents[order[k]];
 
-		if (ag->state != DT_CROWDAGENT_STATE_WALKING)
-			continue;
-		if (ag->targetState == DT_CROWDAGENT_TARGET_NONE)
-			continue;
-		
-		float dvel[3] = {0,0,0};
+			if (ag->state != DT_CROWDAGENT_STATE_WALKING)
+				continue;
+			if (ag->targetState == DT_CROWDAGENT_TARGET_NONE)
+				continue;
+			
+			float dvel[3] = {0,0,0};
 
-		if (ag->targetState == DT_CROWDAGENT_TARGET_VELOCITY)
-		{
-			dtVcopy(dvel, ag->targetPos);
-			ag->desiredSpeed = dtVlen(ag->targetPos);
-		}
-		else
-		{
-			// Calculate steering direction.
-			if (ag->params.updateFlags & DT_CROWD_ANTICIPATE_TURNS)
-				calcSmoothSteerDirection(ag, dvel);
+			if (ag->targetState == DT_CROWDAGENT_TARGET_VELOCITY)
+			{
+				dtVcopy(dvel, ag->targetPos);
+				ag->desiredSpeed = dtVlen(ag->targetPos);
+			}
 			else
-				calcStraightSteerDirection(ag, dvel);
-			
-			// Calculate speed scale, which tells the agent to slowdown at the end of the path.
-			const float slowDownRadius = ag->params.radius*2;	// TODO: make less hacky.
-			const float speedScale = getDistanceToGoal(ag, slowDownRadius) / slowDownRadius;
+			{
+				// Calculate steering direction.
+				if (ag->params.updateFlags & DT_CROWD_ANTICIPATE_TURNS)
+					calcSmoothSteerDirection(ag, dvel);
+				else
+					calcStraightSteerDirection(ag, dvel);
 				
-			ag->desiredSpeed = ag->params.maxSpeed;
-			dtVscale(dvel, dvel, ag->desiredSpeed * speedScale);
+				// Calculate speed scale, which tells the agent to slowdown at the end of the path.
+				const float slowDownRadius = ag->params.radius*2;	// TODO: make less hacky.
+				const float speedScale = getDistanceToGoal(ag, slowDownRadius) / slowDownRadius;
+					
+				ag->desiredSpeed = ag->params.maxSpeed;
+				dtVscale(dvel, dvel, ag->desiredSpeed * speedScale);
+			}
+
+			dtVcopy(ag->dvel, dvel);
 		}
+	});
 
-		// Urho3D: Update velocity callback
-		if (m_updateCallback)
-			m_updateCallback(false, ag, dvel, dt);
+	// Urho3D: Update velocity callback. Invoked from the calling thread.
+	if (m_updateCallback)
+	{
+		for (int i = 0; i < nagents; ++i)
+		{
+			dtCrowdAgent* ag = agents[i];
+			if (ag->lodSkip || ag->state != DT_CROWDAGENT_STATE_WALKING || ag->targetState == DT_CROWDAGENT_TARGET_NONE)
+				continue;
+			m_updateCallback(false, ag, ag->dvel, getAgentTimeStep(ag, dt));
+		}
+	}
 
-		// Separation
-		if (ag->params.updateFlags & DT_CROWD_SEPARATION)
+	// Separation
+	parallelFor(norder, [&](int begin, int end, int threadIndex)
+	{
+		for (int k = begin; k < end; ++k)
 		{
+			dtCrowdAgent* ag = agents[order[k]];
+
+			if (ag->state != DT_CROWDAGENT_STATE_WALKING)
+				continue;
+			if (ag->targetState == DT_CROWDAGENT_TARGET_NONE)
+				continue;
+			if (!(ag->params.updateFlags & DT_CROWD_SEPARATION))
+				continue;
+
+			float* dvel = ag->dvel;
 			const float separationDist = ag->params.collisionQueryRange; 
 			const float invSeparationDist = 1.0f / separationDist; 
 			const float separationWeight = ag->params.separationWeight;
@@ -1265,182 +1464,209 @@ void dtCrowd::update(const float dt, dtCrowdAgentDebugInfo* debug)
 					dtVscale(dvel, dvel, desiredSqr/speedSqr);
 			}
 		}
-		
-		// Set the desired velocity.
-		dtVcopy(ag->dvel, dvel);
-	}
+	});
 	
 	// Velocity planning.	
-	for (int i = 0; i < nagents; ++i)
+	for (int t = 0; t < m_maxThreads; ++t)
+		m_threadSampleCounts[t] = 0;
+	parallelFor(norder, [&](int begin, int end, int threadIndex)
 	{
-		dtCrowdAgent* ag = agents[i];
-		
-		if (ag->state != DT_CROWDAGENT_STATE_WALKING)
-			continue;
-		
-		if (ag->params.updateFlags & DT_CROWD_OBSTACLE_AVOIDANCE)
+		dtObstacleAvoidanceQuery* obstacleQuery = m_threadObstacleQueries[threadIndex];
+		for (int k = begin; k < end; ++k)
 		{
-			m_obstacleQuery->reset();
+			const int i = order[k];
+			dtCrowdAgent* ag = agents[i];
 			
-			// Add neighbours as obstacles.
-			for (int j = 0; j < ag->nneis; ++j)
-			{
-				const dtCrowdAgent* nei = &m_agents[ag->neis[j].idx];
-				m_obstacleQuery->addCircle(nei->npos, nei->params.radius, nei->vel, nei->dvel);
-			}
-
-			// Append neighbour segments as obstacles.
-			for (int j = 0; j < ag->boundary.getSegmentCount(); ++j)
+			if (ag->state != DT_CROWDAGENT_STATE_WALKING)
+				continue;
+			
+			if (ag->params.updateFlags & DT_CROWD_OBSTACLE_AVOIDANCE)
 			{
-				const float* s = ag->boundary.getSegment(j);
-				if (dtTriArea2D(ag->npos, s, s+3) < 0.0f)
-					continue;
-				m_obstacleQuery->addSegment(s, s+3);
-			}
+				obstacleQuery->reset();
+				
+				// Add neighbours as obstacles.
+				for (int j = 0; j < ag->nneis; ++j)
+				{
+					const dtCrowdAgent* nei = &m_agents[ag->neis[j].idx];
+					obstacleQuery->addCircle(nei->npos, nei->params.radius, nei->vel, nei->dvel);
+				}
 
-			dtObstacleAvoidanceDebugData* vod = 0;
-			if (debugIdx == i) 
-				vod = debug->vod;
-			
-			// Sample new safe velocity.
-			bool adaptive = true;
-			int ns = 0;
+				// Append neighbour segments as obstacles.
+				for (int j = 0; j < ag->boundary.getSegmentCount(); ++j)
+				{
+					const float* s = ag->boundary.getSegment(j);
+					if (dtTriArea2D(ag->npos, s, s+3) < 0.0f)
+						continue;
+					obstacleQuery->addSegment(s, s+3);
+				}
 
-			const dtObstacleAvoidanceParams* params = &m_obstacleQueryParams[ag->params.obstacleAvoidanceType];
+				dtObstacleAvoidanceDebugData* vod = 0;
+				if (debugIdx == i) 
+					vod = debug->vod;
 				
-			if (adaptive)
-			{
-				ns = m_obstacleQuery->sampleVelocityAdaptive(ag->npos, ag->params.radius, ag->desiredSpeed,
+				// Sample new safe velocity.
+				bool adaptive = true;
+				int ns = 0;
+
+				const dtObstacleAvoidanceParams* params = &m_obstacleQueryParams[ag->params.obstacleAvoidanceType];
+					
+				if (adaptive)
+				{
+					ns = obstacleQuery->sampleVelocityAdaptive(ag->npos, ag->params.radius, ag->desiredSpeed,
+																 ag->vel, ag->dvel, ag->nvel, params, vod);
+				}
+				else
+				{
+					ns = obstacleQuery->sampleVelocityGrid(ag->npos, ag->params.radius, ag->desiredSpeed,
 															 ag->vel, ag->dvel, ag->nvel, params, vod);
+				}
+				m_threadSampleCounts[threadIndex] += ns;
 			}
 			else
 			{
-				ns = m_obstacleQuery->sampleVelocityGrid(ag->npos, ag->params.radius, ag->desiredSpeed,
-														 ag->vel, ag->dvel, ag->nvel, params, vod);
+				// If not using velocity planning, new velocity is directly the desired velocity.
+				dtVcopy(ag->nvel, ag->dvel);
 			}
-			m_velocitySampleCount += ns;
-		}
-		else
-		{
-			// If not using velocity planning, new velocity is directly the desired velocity.
-			dtVcopy(ag->nvel, ag->dvel);
 		}
-	}
+	});
+	for (int t = 0; t < m_maxThreads; ++t)
+		m_velocitySampleCount += m_threadSampleCounts[t];
 
 	// Integrate.
-	for (int i = 0; i < nagents; ++i)
+	parallelFor(norder, [&](int begin, int end, int threadIndex)
 	{
-		dtCrowdAgent* ag = agents[i];
-		if (ag->state != DT_CROWDAGENT_STATE_WALKING)
-			continue;
-		integrate(ag, dt);
-	}
+		for (int k = begin; k < end; ++k)
+		{
+			dtCrowdAgent* ag = agents[order[k]];
+			if (ag->state != DT_CROWDAGENT_STATE_WALKING)
+				continue;
+			integrate(ag, getAgentTimeStep(ag, dt));
+		}
+	});
 	
 	// Handle collisions.
 	static const float COLLISION_RESOLVE_FACTOR = 0.7f;
 	
 	for (int iter = 0; iter < 4; ++iter)
 	{
-		for (int i = 0; i < nagents; ++i)
+		parallelFor(norder, [&](int begin, int end, int threadIndex)
 		{
-			dtCrowdAgent* ag = agents[i];
-			const int idx0 = getAgentIndex(ag);
-			
-			if (ag->state != DT_CROWDAGENT_STATE_WALKING)
-				continue;
-
-			dtVset(ag->disp, 0,0,0);
-			
-			float w = 0;
-
-			for (int j = 0; j < ag->nneis; ++j)
+			for (int k = begin; k < end; ++k)
 			{
-				const dtCrowdAgent* nei = &m_agents[ag->neis[j].idx];
-				const int idx1 = getAgentIndex(nei);
-
-				float diff[3];
-				dtVsub(diff, ag->npos, nei->npos);
-				diff[1] = 0;
+				dtCrowdAgent* ag = agents[order[k]];
+				const int idx0 = getAgentIndex(ag);
 				
-				float dist = dtVlenSqr(diff);
-				if (dist > dtSqr(ag->params.radius + nei->params.radius))
+				if (ag->state != DT_CROWDAGENT_STATE_WALKING)
 					continue;
-				dist = dtMathSqrtf(dist);
-				float pen = (ag->params.radius + nei->params.radius) - dist;
-				if (dist < 0.0001f)
+
+				dtVset(ag->disp, 0,0,0);
+				
+				float w = 0;
+
+				for (int j = 0; j < ag->nneis; ++j)
 				{
-					// Agents on top of each other, try to choose diverging separation directions.
-					if (idx0 > idx1)
-						dtVset(diff, -ag->dvel[2],0,ag->dvel[0]);
+					const dtCrowdAgent* nei = &m_agents[ag->neis[j].idx];
+					const int idx1 = getAgentIndex(nei);
+
+					float diff[3];
+					dtVsub(diff, ag->npos, nei->npos);
+					diff[1] = 0;
+					
+					float dist = dtVlenSqr(diff);
+					if (dist > dtSqr(ag->params.radius + nei->params.radius))
+						continue;
+					dist = dtMathSqrtf(dist);
+					float pen = (ag->params.radius + nei->params.radius) - dist;
+					if (dist < 0.0001f)
+					{
+						// Agents on top of each other, try to choose diverging separation directions.
+						if (idx0 > idx1)
+							dtVset(diff, -ag->dvel[2],0,ag->dvel[0]);
+						else
+							dtVset(diff, ag->dvel[2],0,-ag->dvel[0]);
+						pen = 0.01f;
+					}
 					else
-						dtVset(diff, ag->dvel[2],0,-ag->dvel[0]);
-					pen = 0.01f;
+					{
+						pen = (1.0f/dist) * (pen*0.5f) * COLLISION_RESOLVE_FACTOR;
+					}
+					
+					// Urho3D: Avoid tremble when another agent can not move away
+					if (ag->params.separationWeight < 0.0001f)
+						continue;
+					
+					dtVmad(ag->disp, ag->disp, diff, pen);			
+					
+					w += 1.0f;
 				}
-				else
+				
+				if (w > 0.0001f)
 				{
-					pen = (1.0f/dist) * (pen*0.5f) * COLLISION_RESOLVE_FACTOR;
+					const float iw = 1.0f / w;
+					dtVscale(ag->disp, ag->disp, iw);
 				}
-				
-				// Urho3D: Avoid tremble when another agent can not move away
-				if (ag->params.separationWeight < 0.0001f)
+			}
+		});
+		
+		parallelFor(norder, [&](int begin, int end, int threadIndex)
+		{
+			for (int k = begin; k < end; ++k)
+			{
+				dtCrowdAgent* ag = agents[order[k]];
+				if (ag->state != DT_CROWDAGENT_STATE_WALKING)
 					continue;
 				
-				dtVmad(ag->disp, ag->disp, diff, pen);			
-				
-				w += 1.0f;
+				dtVadd(ag->npos, ag->npos, ag->disp);
 			}
+		});
+	}
+	
+	parallelFor(norder, [&](int begin, int end, int threadIndex)
+	{
+		dtNavMeshQuery* navquery = m_threadNavQueries[threadIndex];
+		for (int k = begin; k < end; ++k)
+		{
+			dtCrowdAgent* ag = agents[order[k]];
+			if (ag->state != DT_CROWDAGENT_STATE_WALKING)
+				continue;
 			
-			if (w > 0.0001f)
+			// Move along navmesh.
+			ag->corridor.movePosition(ag->npos, navquery, &m_filters[ag->params.queryFilterType]);
+			// Get valid constrained position back.
+			dtVcopy(ag->npos, ag->corridor.getPos());
+
+			// If not using path, truncate the corridor to just one poly.
+			if (ag->targetState == DT_CROWDAGENT_TARGET_NONE || ag->targetState == DT_CROWDAGENT_TARGET_VELOCITY)
 			{
-				const float iw = 1.0f / w;
-				dtVscale(ag->disp, ag->disp, iw);
+				ag->corridor.reset(ag->corridor.getFirstPoly(), ag->npos);
+				ag->partial = false;
 			}
 		}
-		
+	});
+
+	// Urho3D: Update position callback support. Invoked from the calling thread.
+	if (m_updateCallback)
+	{
 		for (int i = 0; i < nagents; ++i)
 		{
 			dtCrowdAgent* ag = agents[i];
-			if (ag->state != DT_CROWDAGENT_STATE_WALKING)
+			if (ag->lodSkip || ag->state != DT_CROWDAGENT_STATE_WALKING)
 				continue;
-			
-			dtVadd(ag->npos, ag->npos, ag->disp);
+			m_updateCallback(true, ag, ag->npos, getAgentTimeStep(ag, dt));
 		}
 	}
 	
-	for (int i = 0; i < nagents; ++i)
-	{
-		dtCrowdAgent* ag = agents[i];
-		if (ag->state != DT_CROWDAGENT_STATE_WALKING)
-			continue;
-		
-		// Move along navmesh.
-		ag->corridor.movePosition(ag->npos, m_navquery, &m_filters[ag->params.queryFilterType]);
-		// Get valid constrained position back.
-		dtVcopy(ag->npos, ag->corridor.getPos());
-
-		// If not using path, truncate the corridor to just one poly.
-		if (ag->targetState == DT_CROWDAGENT_TARGET_NONE || ag->targetState == DT_CROWDAGENT_TARGET_VELOCITY)
-		{
-			ag->corridor.reset(ag->corridor.getFirstPoly(), ag->npos);
-			ag->partial = false;
-		}
-		
-		// Urho3D: Update position callback support
-		if (m_updateCallback)
-			m_updateCallback(true, ag, ag->npos, dt);
-	}
-	
 	// Update agents using off-mesh connection.
 	for (int i = 0; i < nagents; ++i)
 	{
 		dtCrowdAgent* ag = agents[i];
 		const int idx = (int)(ag - m_agents);
 		dtCrowdAgentAnimation* anim = &m_agentAnims[idx];
-		if (!anim->active)
+		if (!anim->active || ag->lodSkip)
 			continue;
 		
 
-		anim->t += dt;
+		anim->t += getAgentTimeStep(ag, dt);
 		if (anim->t > anim->tmax)
 		{
 			// Reset animation
@@ -26,6 +26,7 @@
 #include <Urho3D/Core/ProcessUtils.h>
 #include <Urho3D/IO/File.h>
 #include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/IO/PackageBuilder.h>
 #include <Urho3D/IO/PackageFile.h>
 
 #ifdef WIN32
@@ -42,6 +43,7 @@
 using namespace Urho3D;
 
 static const unsigned COMPRESSED_BLOCK_SIZE = 32768;
+static const unsigned MAX_DICTIONARY_SAMPLE_SIZE = 65536;
 
 struct FileEntry
 {
@@ -57,6 +59,8 @@ ea::string basePath_;
 ea::vector<FileEntry> entries_;
 unsigned checksum_ = 0;
 bool compress_ = false;
+bool compressHC_ = false;
+bool useDictionary_ = false;
 bool quiet_ = false;
 unsigned blockSize_ = COMPRESSED_BLOCK_SIZE;
 
@@ -69,6 +73,7 @@ int main(int argc, char** argv);
 void Run(const ea::vector<ea::string>& arguments);
 void ProcessFile(const ea::string& fileName, const ea::string& rootDir);
 void WritePackageFile(const ea::string& fileName, const ea::string& rootDir);
+void BuildPackageFile(const ea::string& fileName, const ea::string& rootDir);
 void WriteHeader(File& dest);
 
 int main(int argc, char** argv)
@@ -97,6 +102,8 @@ void Run(const ea::vector<ea::string>& arguments)
             "\n"
             "Options:\n"
             "-c      Enable package file LZ4 compression\n"
+            "-h      Enable per-file LZ4HC compression, requires engine with package format version 1\n"
+            "-d      Same as -h, also compress small files with shared dictionary\n"
             "-q      Enable quiet mode\n"
             "\n"
             "Basepath is an optional prefix that will be added to the file entries.\n\n"
@@ -125,6 +132,13 @@ void Run(const ea::vector<ea::string>& arguments)
                     case 'c':
                         compress_ = true;
                         break;
+                    case 'h':
+                        compressHC_ = true;
+                        break;
+                    case 'd':
+                        compressHC_ = true;
+                        useDictionary_ = true;
+                        break;
                     case 'q':
                         quiet_ = true;
                         break;
@@ -192,7 +206,10 @@ void Run(const ea::vector<ea::string>& arguments)
         for (unsigned i = 0; i < fileNames.size(); ++i)
             ProcessFile(fileNames[i], dirName);
 
-        WritePackageFile(packageName, dirName);
+        if (compressHC_)
+            BuildPackageFile(packageName, dirName);
+        else
+            WritePackageFile(packageName, dirName);
     }
     else
     {
@@ -221,9 +238,12 @@ void Run(const ea::vector<ea::string>& arguments)
                     ea::string fileEntry(current->first);
                     if (outputCompressionRatio)
                     {
-                        unsigned compressedSize =
-                            (i == entries.end() ? packageFile->GetTotalSize() - sizeof(unsigned) : i->second.offset_) -
-                            current->second.offset_;
+                        unsigned compressedSize = current->second.packedSize_;
+                        if (!compressedSize)
+                        {
+                            compressedSize = (i == entries.end() ? packageFile->GetTotalSize() - sizeof(unsigned)
+                                                                 : i->second.offset_) - current->second.offset_;
+                        }
                         fileEntry.append_sprintf("\tin: %u\tout: %u\tratio: %f", current->second.size_, compressedSize,
                             compressedSize ? 1.f * current->second.size_ / compressedSize : 0.f);
                     }
@@ -366,6 +386,79 @@ void WritePackageFile(const ea::string& fileName, const ea::string& rootDir)
     }
 }
 
+void BuildPackageFile(const ea::string& fileName, const ea::string& rootDir)
+{
+    if (!quiet_)
+        PrintLine("Writing package");
+
+    File dest(context_);
+    if (!dest.Open(fileName, FILE_WRITE))
+        ErrorExit("Could not open output file " + fileName);
+
+    ea::vector<ByteVector> fileData(entries_.size());
+    for (unsigned i = 0; i < entries_.size(); ++i)
+    {
+        const ea::string fileFullPath = rootDir + "/" + entries_[i].name_;
+        File srcFile(context_, fileFullPath);
+        if (!srcFile.IsOpen())
+            ErrorExit("Could not open file " + fileFullPath);
+
+        fileData[i].resize(entries_[i].size_);
+        if (srcFile.Read(fileData[i].data(), entries_[i].size_) != entries_[i].size_)
+            ErrorExit("Could not read file " + fileFullPath);
+    }
+
+    // Small files benefit from the dictionary the most
+    ByteVector dictionary;
+    if (useDictionary_)
+    {
+        ea::vector<ConstByteSpan> samples;
+        for (const ByteVector& data : fileData)
+        {
+            if (data.size() <= MAX_DICTIONARY_SAMPLE_SIZE)
+                samples.emplace_back(data);
+        }
+        dictionary = BuildCompressionDictionary(samples);
+        if (!quiet_)
+            PrintLine("Dictionary size: " + ea::to_string(dictionary.size()));
+    }
+
+    PackageBuilder builder;
+    if (!builder.Create(&dest, dictionary))
+        ErrorExit("Could not write package header");
+
+    unsigned totalDataSize = 0;
+    for (unsigned i = 0; i < entries_.size(); ++i)
+    {
+        const ByteVector& data = fileData[i];
+        const unsigned offset = dest.GetPosition();
+        const bool useDictionary = !dictionary.empty() && data.size() <= MAX_DICTIONARY_SAMPLE_SIZE;
+        if (!builder.Append(basePath_ + entries_[i].name_, data, CompressionCodec::LZ4HC, useDictionary))
+            ErrorExit("Could not write file " + entries_[i].name_);
+
+        totalDataSize += data.size();
+        if (!quiet_)
+        {
+            unsigned totalPackedBytes = dest.GetPosition() - offset;
+            ea::string fileEntry(entries_[i].name_);
+            fileEntry.append_sprintf("\tin: %u\tout: %u\tratio: %f", data.size(), totalPackedBytes,
+                totalPackedBytes ? 1.f * data.size() / totalPackedBytes : 0.f);
+            PrintLine(fileEntry);
+        }
+    }
+
+    if (!builder.Build())
+        ErrorExit("Could not write package file list");
+
+    if (!quiet_)
+    {
+        PrintLine("Number of files: " + ea::to_string(entries_.size()));
+        PrintLine("File data size: " + ea::to_string(totalDataSize));
+        PrintLine("Package size: " + ea::to_string(dest.GetSize()));
+        PrintLine("Compressed: yes");
+    }
+}
+
 void WriteHeader(File& dest)
 {
     if (!compress_)
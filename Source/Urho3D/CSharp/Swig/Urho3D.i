@@ -438,6 +438,9 @@ URHO3D_REFCOUNTED_INTERFACE(Urho3D::AbstractFile, Urho3D::RefCounted);
 %ignore Urho3D::MountPointGuard;
 %include "Urho3D/IO/AbstractFile.h"
 %include "Urho3D/IO/ScanFlags.h"
+%ignore Urho3D::CompressBlock;
+%ignore Urho3D::DecompressBlock;
+%ignore Urho3D::BuildCompressionDictionary;
 %include "Urho3D/IO/Compression.h"
 %include "Urho3D/IO/File.h"
 %include "Urho3D/IO/Log.h"
@@ -447,6 +450,9 @@ URHO3D_REFCOUNTED_INTERFACE(Urho3D::AbstractFile, Urho3D::RefCounted);
 %include "Urho3D/IO/FileIdentifier.h"
 %include "Urho3D/IO/MountPoint.h"
 %include "Urho3D/IO/VirtualFileSystem.h"
+%ignore Urho3D::PackageFile::GetDictionary;
+%ignore Urho3D::PackageEntry::blockOffsets_;
+%ignore Urho3D::DecompressPackageBlocks;
 %include "Urho3D/IO/PackageFile.h"
 
 %ignore Urho3D::NonCopyable;
@@ -489,6 +495,8 @@ public:
 // These expose iterators of underlying collection. Iterate object through GetObject() instead.
 %ignore Urho3D::BackgroundLoadItem;
 %ignore Urho3D::BackgroundLoader::ThreadFunction;
+%ignore Urho3D::BackgroundLoader::GetStatistics;
+%ignore Urho3D::ResourceCache::GetBackgroundLoadStatistics;
 %ignore Urho3D::ImageCube::CalculateSphericalHarmonics;
 %rename(GetValueType) Urho3D::PListValue::GetType;
 
@@ -529,6 +537,9 @@ public:
 %ignore Urho3D::Node::SetEntity;
 %ignore Urho3D::Scene::GetRegistry;
 %ignore Urho3D::Scene::GetComponentIndex;
+%ignore Urho3D::Scene::GetTypedUpdateEvent;
+%ignore Urho3D::SceneUpdateEventData;
+%ignore Urho3D::SceneUpdateEvent;
 %ignore Urho3D::Animatable::animationEnabled_;
 %ignore Urho3D::Animatable::objectAnimation_;
 %ignore Urho3D::Component::node_;
@@ -795,6 +806,7 @@ public:
 %ignore Urho3D::CrowdManager::SetVelocityCallback;
 %ignore Urho3D::NavBuildData::navAreas_;
 %ignore Urho3D::NavigationMesh::FindPath;
+%ignore Urho3D::NavigationMesh::RequestPath;
 %include "generated/Urho3D/_pre_navigation.i"
 %include "Urho3D/Navigation/CrowdAgent.h"
 %include "Urho3D/Navigation/CrowdManager.h"
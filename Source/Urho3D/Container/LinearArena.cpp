@@ -0,0 +1,95 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Container/LinearArena.h"
+
+#include "Urho3D/Core/Assert.h"
+#include "Urho3D/Math/MathDefs.h"
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+LinearArena::LinearArena(unsigned blockSize)
+    : blockSize_(ea::max(blockSize, 1u))
+{
+}
+
+void* LinearArena::Allocate(unsigned size, unsigned alignment)
+{
+    URHO3D_ASSERT(IsPowerOfTwo(alignment));
+
+    if (!blocks_.empty())
+    {
+        Block& block = blocks_.back();
+        const auto base = reinterpret_cast<uintptr_t>(block.data_.get());
+        const auto alignedAddress = (base + offset_ + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+        const auto alignedOffset = static_cast<unsigned>(alignedAddress - base);
+        if (alignedOffset + size <= block.size_)
+        {
+            usedMemory_ += alignedOffset + size - offset_;
+            highWaterMark_ = ea::max(highWaterMark_, usedMemory_);
+            offset_ = alignedOffset + size;
+            return block.data_.get() + alignedOffset;
+        }
+    }
+
+    AllocateBlock(size + alignment);
+    return Allocate(size, alignment);
+}
+
+void LinearArena::Reset()
+{
+    if (blocks_.size() > 1)
+    {
+        blocks_.clear();
+        AllocateBlock(capacity_);
+    }
+
+    offset_ = 0;
+    usedMemory_ = 0;
+}
+
+void LinearArena::AllocateBlock(unsigned minSize)
+{
+    // Grow geometrically so that the number of blocks stays small until the next Reset
+    const unsigned size = ea::max({minSize, blockSize_, capacity_});
+
+    // Account for unused tail of the current block
+    if (!blocks_.empty())
+        usedMemory_ += blocks_.back().size_ - offset_;
+
+    // Capacity is recalculated when blocks are merged
+    if (blocks_.empty())
+        capacity_ = 0;
+
+    Block& block = blocks_.emplace_back();
+    block.data_.reset(new unsigned char[size]);
+    block.size_ = size;
+    capacity_ += size;
+    offset_ = 0;
+}
+
+}
@@ -0,0 +1,82 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "Urho3D/Core/NonCopyable.h"
+
+#include <Urho3D/Urho3D.h>
+
+#include <EASTL/unique_ptr.h>
+#include <EASTL/vector.h>
+
+#include <cstddef>
+
+namespace Urho3D
+{
+
+/// Linear (bump) memory arena. Not thread-safe.
+/// Individual allocations are never freed, all memory is reclaimed at once on Reset.
+class URHO3D_API LinearArena : public MovableNonCopyable
+{
+public:
+    /// Default size of the first memory block.
+    static constexpr unsigned DefaultBlockSize = 64 * 1024;
+
+    explicit LinearArena(unsigned blockSize = DefaultBlockSize);
+
+    /// Allocate memory block of specified size and alignment. Alignment should be power of two.
+    void* Allocate(unsigned size, unsigned alignment = alignof(std::max_align_t));
+    /// Allocate uninitialized storage for array of objects.
+    template <class T> T* AllocateArray(unsigned count) { return static_cast<T*>(Allocate(count * sizeof(T), alignof(T))); }
+    /// Reclaim all allocated memory.
+    /// If arena had to grow, memory blocks are merged into one so that the next cycle doesn't need to allocate.
+    void Reset();
+
+    /// Return amount of memory allocated since last Reset, including alignment padding.
+    unsigned GetUsedMemory() const { return usedMemory_; }
+    /// Return maximum amount of memory allocated between two Resets.
+    unsigned GetHighWaterMark() const { return highWaterMark_; }
+    /// Return total size of owned memory blocks.
+    unsigned GetCapacity() const { return capacity_; }
+    /// Return number of owned memory blocks.
+    unsigned GetNumBlocks() const { return blocks_.size(); }
+
+private:
+    struct Block
+    {
+        ea::unique_ptr<unsigned char[]> data_;
+        unsigned size_{};
+    };
+
+    void AllocateBlock(unsigned minSize);
+
+    unsigned blockSize_{};
+    ea::vector<Block> blocks_;
+    unsigned offset_{};
+
+    unsigned capacity_{};
+    unsigned usedMemory_{};
+    unsigned highWaterMark_{};
+};
+
+}
@@ -83,7 +83,10 @@ void EventReceiverGroup::EndSendEvent()
 void EventReceiverGroup::Add(Object* object)
 {
     if (object)
+    {
         receivers_.push_back(object);
+        ++revision_;
+    }
 }
 
 void EventReceiverGroup::Remove(Object* object)
@@ -99,6 +102,8 @@ void EventReceiverGroup::Remove(Object* object)
     }
     else
         receivers_.erase_first(object);
+
+    ++revision_;
 }
 
 void RemoveNamedAttribute(ea::unordered_map<StringHash, ea::vector<AttributeInfo> >& attributes, StringHash objectType, const char* name)
@@ -300,7 +305,10 @@ void Context::AddEventReceiver(Object* receiver, StringHash eventType)
 {
     SharedPtr<EventReceiverGroup>& group = eventReceivers_[eventType];
     if (!group)
+    {
         group = new EventReceiverGroup();
+        ++eventReceiversRevision_;
+    }
     group->Add(receiver);
 }
 
@@ -308,7 +316,10 @@ void Context::AddEventReceiver(Object* receiver, Object* sender, StringHash even
 {
     SharedPtr<EventReceiverGroup>& group = specificEventReceivers_[sender][eventType];
     if (!group)
+    {
         group = new EventReceiverGroup();
+        ++eventReceiversRevision_;
+    }
     group->Add(receiver);
 }
 
@@ -329,6 +340,7 @@ void Context::RemoveEventSender(Object* sender)
             }
         }
         specificEventReceivers_.erase(i);
+        ++eventReceiversRevision_;
     }
 }
 
@@ -33,6 +33,11 @@
 namespace Urho3D
 {
 
+namespace Detail
+{
+class TypedEventBase;
+}
+
 /// Tracking structure for event receivers.
 class URHO3D_API EventReceiverGroup : public RefCounted
 {
@@ -56,6 +61,9 @@ public:
     /// Remove receiver. Leave holes during send, which requires later cleanup.
     void Remove(Object* object);
 
+    /// Return revision of receivers. Changes when any receiver is added or removed.
+    unsigned GetRevision() const { return revision_; }
+
     /// Receivers. May contain holes during sending.
     ea::vector<Object*> receivers_;
 
@@ -64,12 +72,15 @@ private:
     unsigned inSend_;
     /// Cleanup required flag.
     bool dirty_;
+    /// Revision of receivers.
+    unsigned revision_{};
 };
 
 /// Urho3D execution context. Provides access to subsystems, object factories and attributes, and event receivers.
 class URHO3D_API Context : public RefCounted, public ObjectReflectionRegistry
 {
     friend class Object;
+    friend class Detail::TypedEventBase;
 
 public:
     /// Construct.
@@ -159,6 +170,9 @@ public:
         return i != eventReceivers_.end() ? i->second : nullptr;
     }
 
+    /// Return revision of event receiver groups. Changes when any group is created or destroyed.
+    unsigned GetEventReceiversRevision() const { return eventReceiversRevision_; }
+
 private:
     /// Add event receiver.
     void AddEventReceiver(Object* receiver, StringHash eventType);
@@ -184,6 +198,8 @@ private:
     ea::unordered_map<StringHash, SharedPtr<EventReceiverGroup> > eventReceivers_;
     /// Event receivers for specific senders' events.
     ea::unordered_map<Object*, ea::unordered_map<StringHash, SharedPtr<EventReceiverGroup> > > specificEventReceivers_;
+    /// Revision of event receiver groups, used to invalidate cached groups.
+    unsigned eventReceiversRevision_{1};
     /// Event sender stack.
     ea::vector<Object*> eventSenders_;
     /// Event data stack.
@@ -0,0 +1,137 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Core/FrameArena.h"
+
+#include "Urho3D/Core/Context.h"
+#include "Urho3D/Core/CoreEvents.h"
+#include "Urho3D/Core/Profiler.h"
+#include "Urho3D/Core/WorkQueue.h"
+
+#include <EASTL/allocator.h>
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+FrameArena::FrameArena(Context* context)
+    : Object(context)
+{
+    SubscribeToEvent(E_BEGINFRAME, &FrameArena::BeginFrame);
+    SubscribeToEvent(E_ENDFRAME, &FrameArena::EndFrame);
+}
+
+FrameArena::~FrameArena() = default;
+
+void* FrameArena::Allocate(unsigned size, unsigned alignment)
+{
+    const unsigned threadIndex = WorkQueue::GetThreadIndex();
+    if (threadIndex < threadArenas_.size())
+        return threadArenas_[threadIndex].Allocate(size, alignment);
+
+    MutexLock lock(sharedArenaMutex_);
+    return sharedArena_.Allocate(size, alignment);
+}
+
+void FrameArena::BeginFrame()
+{
+    inFrame_ = true;
+}
+
+void FrameArena::EndFrame()
+{
+    Reset();
+    inFrame_ = false;
+}
+
+void FrameArena::Reset()
+{
+    const unsigned usedMemory = GetUsedMemory();
+    highWaterMark_ = ea::max(highWaterMark_, usedMemory);
+    URHO3D_PROFILE_VALUE("FrameArena", static_cast<int64_t>(highWaterMark_));
+
+    for (LinearArena& arena : threadArenas_)
+        arena.Reset();
+    sharedArena_.Reset();
+
+    // WorkQueue threads are created after subsystems, allocate per-thread arenas lazily
+    const unsigned numThreads = WorkQueue::GetThreadIndexCount();
+    if (threadArenas_.size() != numThreads)
+    {
+        threadArenas_.clear();
+        threadArenas_.resize(numThreads);
+    }
+}
+
+unsigned FrameArena::GetUsedMemory() const
+{
+    unsigned result = sharedArena_.GetUsedMemory();
+    for (const LinearArena& arena : threadArenas_)
+        result += arena.GetUsedMemory();
+    return result;
+}
+
+unsigned FrameArena::GetCapacity() const
+{
+    unsigned result = sharedArena_.GetCapacity();
+    for (const LinearArena& arena : threadArenas_)
+        result += arena.GetCapacity();
+    return result;
+}
+
+FrameArena* FrameArena::GetInstance()
+{
+    Context* context = Context::GetInstance();
+    return context ? context->GetSubsystem<FrameArena>() : nullptr;
+}
+
+FrameAllocator::FrameAllocator(const char* name)
+    : arena_(FrameArena::GetInstance())
+{
+}
+
+void* FrameAllocator::allocate(size_t n, int flags)
+{
+    if (!arena_)
+        return ea::GetDefaultAllocator()->allocate(n, flags);
+    return arena_->Allocate(static_cast<unsigned>(n), EASTL_ALLOCATOR_MIN_ALIGNMENT);
+}
+
+void* FrameAllocator::allocate(size_t n, size_t alignment, size_t offset, int flags)
+{
+    if (!arena_)
+        return ea::GetDefaultAllocator()->allocate(n, alignment, offset, flags);
+
+    URHO3D_ASSERT(offset == 0);
+    return arena_->Allocate(static_cast<unsigned>(n), ea::max<unsigned>(alignment, EASTL_ALLOCATOR_MIN_ALIGNMENT));
+}
+
+void FrameAllocator::deallocate(void* p, size_t n)
+{
+    if (!arena_)
+        ea::GetDefaultAllocator()->deallocate(p, n);
+}
+
+}
@@ -0,0 +1,108 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "Urho3D/Container/LinearArena.h"
+#include "Urho3D/Core/Mutex.h"
+#include "Urho3D/Core/Object.h"
+
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+/// Frame-scoped memory arena subsystem.
+/// Each WorkQueue thread allocates from its own linear arena without synchronization.
+/// All arenas are reset at the end of the frame, memory allocated from FrameArena must not outlive the frame.
+/// Engine::RunFrame begins and ends the frame automatically.
+/// Code that runs its own loop (e.g. tools or tests that call Scene::Update manually) should call BeginFrame and
+/// EndFrame explicitly, otherwise memory is not reclaimed.
+class URHO3D_API FrameArena : public Object
+{
+    URHO3D_OBJECT(FrameArena, Object);
+
+public:
+    explicit FrameArena(Context* context);
+    ~FrameArena() override;
+
+    /// Allocate memory. Can be called from any thread.
+    /// Threads not owned by WorkQueue share one arena protected by mutex.
+    void* Allocate(unsigned size, unsigned alignment);
+    /// Begin the frame. Called automatically on E_BEGINFRAME.
+    void BeginFrame();
+    /// End the frame and reset all arenas. Called automatically on E_ENDFRAME.
+    /// Should be called from main thread when no other thread is using the arena.
+    void EndFrame();
+    /// Reset all arenas. Should be called from main thread when no other thread is using the arena.
+    void Reset();
+    /// Return whether the frame is in progress.
+    bool IsInFrame() const { return inFrame_; }
+
+    /// Return amount of memory used in current frame.
+    unsigned GetUsedMemory() const;
+    /// Return maximum amount of memory used in one frame.
+    unsigned GetHighWaterMark() const { return highWaterMark_; }
+    /// Return total capacity of all arenas.
+    unsigned GetCapacity() const;
+
+    /// Return FrameArena of the current Context, if any.
+    static FrameArena* GetInstance();
+
+private:
+    ea::vector<LinearArena> threadArenas_;
+    LinearArena sharedArena_;
+    Mutex sharedArenaMutex_;
+
+    unsigned highWaterMark_{};
+    bool inFrame_{};
+};
+
+/// EASTL-compatible allocator that allocates memory from FrameArena.
+/// Deallocation is no-op, memory is reclaimed at the end of the frame.
+/// Uses default heap allocator if FrameArena doesn't exist at the moment of allocator construction.
+class URHO3D_API FrameAllocator
+{
+public:
+    explicit FrameAllocator(const char* name = nullptr);
+    FrameAllocator(const FrameAllocator& other) = default;
+    FrameAllocator(const FrameAllocator& other, const char* name) : arena_(other.arena_) {}
+    FrameAllocator& operator=(const FrameAllocator& other) = default;
+
+    void* allocate(size_t n, int flags = 0);
+    void* allocate(size_t n, size_t alignment, size_t offset, int flags = 0);
+    void deallocate(void* p, size_t n);
+
+    const char* get_name() const { return "FrameAllocator"; }
+    void set_name(const char* name) {}
+
+    bool operator==(const FrameAllocator& rhs) const { return arena_ == rhs.arena_; }
+    bool operator!=(const FrameAllocator& rhs) const { return arena_ != rhs.arena_; }
+
+private:
+    FrameArena* arena_{};
+};
+
+/// Vector allocated from FrameArena. Should not outlive the frame.
+template <class T> using FrameVector = ea::vector<T, FrameAllocator>;
+
+}
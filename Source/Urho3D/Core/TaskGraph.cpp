@@ -0,0 +1,272 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Core/TaskGraph.h"
+
+#ifdef URHO3D_THREADING
+#include <enkiTS/src/TaskScheduler.h>
+#endif
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+class TaskGraph::NodeTask
+#ifdef URHO3D_THREADING
+    : public enki::ITaskSet
+#endif
+{
+public:
+    WorkQueue* workQueue_{};
+    TaskFunction function_;
+    RangeTaskFunction rangeFunction_;
+    unsigned size_{1};
+    ea::vector<NodeIndex> dependsOn_;
+
+    void Run(unsigned beginIndex, unsigned endIndex, unsigned threadIndex)
+    {
+        if (rangeFunction_)
+        {
+            endIndex = ea::min(endIndex, size_);
+            if (beginIndex < endIndex)
+                rangeFunction_(beginIndex, endIndex, threadIndex);
+        }
+        else
+            function_(threadIndex, workQueue_);
+    }
+
+#ifdef URHO3D_THREADING
+    ea::vector<enki::Dependency> dependencies_;
+    enki::Dependency observerDependency_;
+
+    void ExecuteRange(enki::TaskSetPartition range, uint32_t threadNum) override
+    {
+        Run(range.start, range.end, threadNum);
+    }
+#endif
+};
+
+#ifdef URHO3D_THREADING
+class TaskGraph::CompletionObserver : public enki::ICompletable
+{
+};
+#endif
+
+TaskGraph::TaskGraph(WorkQueue* workQueue, TaskPriority priority)
+    : workQueue_(workQueue)
+    , priority_(priority)
+{
+    URHO3D_ASSERT(workQueue_);
+}
+
+TaskGraph::~TaskGraph()
+{
+    if (running_)
+        Wait();
+    ResetDependencies();
+}
+
+TaskGraph::NodeIndex TaskGraph::AddTaskInternal(TaskFunction&& task)
+{
+    URHO3D_ASSERT(!running_, "TaskGraph cannot be modified while running");
+
+    auto node = ea::make_unique<NodeTask>();
+    node->workQueue_ = workQueue_;
+    node->function_ = ea::move(task);
+#ifdef URHO3D_THREADING
+    node->m_Priority = static_cast<enki::TaskPriority>(priority_);
+#endif
+
+    nodes_.push_back(ea::move(node));
+    dirty_ = true;
+    return nodes_.size() - 1;
+}
+
+TaskGraph::NodeIndex TaskGraph::AddParallelFor(unsigned size, unsigned minRange, RangeTaskFunction task)
+{
+    URHO3D_ASSERT(!running_, "TaskGraph cannot be modified while running");
+
+    auto node = ea::make_unique<NodeTask>();
+    node->workQueue_ = workQueue_;
+    node->rangeFunction_ = ea::move(task);
+    node->size_ = size;
+#ifdef URHO3D_THREADING
+    // Empty range still has to complete to unblock dependent nodes
+    node->m_Priority = static_cast<enki::TaskPriority>(priority_);
+    node->m_SetSize = ea::max(size, 1u);
+    node->m_MinRange = ea::max(minRange, 1u);
+#endif
+
+    nodes_.push_back(ea::move(node));
+    dirty_ = true;
+    return nodes_.size() - 1;
+}
+
+void TaskGraph::AddDependency(NodeIndex node, NodeIndex dependsOn)
+{
+    URHO3D_ASSERT(!running_, "TaskGraph cannot be modified while running");
+    URHO3D_ASSERT(node < nodes_.size() && dependsOn < nodes_.size() && node != dependsOn);
+
+    auto& dependsOnNodes = nodes_[node]->dependsOn_;
+    if (ea::find(dependsOnNodes.begin(), dependsOnNodes.end(), dependsOn) == dependsOnNodes.end())
+    {
+        dependsOnNodes.push_back(dependsOn);
+        dirty_ = true;
+    }
+}
+
+void TaskGraph::Clear()
+{
+    URHO3D_ASSERT(!running_, "TaskGraph cannot be modified while running");
+
+    ResetDependencies();
+    nodes_.clear();
+    sortedNodes_.clear();
+    dirty_ = false;
+}
+
+void TaskGraph::ResetDependencies()
+{
+#ifdef URHO3D_THREADING
+    // Dependencies reference both tasks by pointer and should be cleared before any task is destroyed
+    for (const auto& node : nodes_)
+    {
+        node->dependencies_.clear();
+        node->observerDependency_.ClearDependency();
+    }
+    observer_ = nullptr;
+#endif
+}
+
+void TaskGraph::ValidateGraph()
+{
+    const unsigned numNodes = nodes_.size();
+
+    // Kahn's algorithm: sort nodes and detect cycles
+    ea::vector<unsigned> numPendingDependencies(numNodes);
+    ea::vector<ea::vector<NodeIndex>> dependentNodes(numNodes);
+    for (NodeIndex index = 0; index < numNodes; ++index)
+    {
+        numPendingDependencies[index] = nodes_[index]->dependsOn_.size();
+        for (NodeIndex dependsOn : nodes_[index]->dependsOn_)
+            dependentNodes[dependsOn].push_back(index);
+    }
+
+    sortedNodes_.clear();
+    for (NodeIndex index = 0; index < numNodes; ++index)
+    {
+        if (numPendingDependencies[index] == 0)
+            sortedNodes_.push_back(index);
+    }
+
+    for (unsigned i = 0; i < sortedNodes_.size(); ++i)
+    {
+        for (NodeIndex dependentNode : dependentNodes[sortedNodes_[i]])
+        {
+            if (--numPendingDependencies[dependentNode] == 0)
+                sortedNodes_.push_back(dependentNode);
+        }
+    }
+
+    URHO3D_ASSERT(sortedNodes_.size() == numNodes, "TaskGraph contains cycles");
+
+#ifdef URHO3D_THREADING
+    if (!workQueue_->taskScheduler_)
+        return;
+
+    ResetDependencies();
+    observer_ = ea::make_unique<CompletionObserver>();
+    for (const auto& node : nodes_)
+    {
+        const unsigned numDependencies = node->dependsOn_.size();
+        node->dependencies_.resize(numDependencies);
+        for (unsigned i = 0; i < numDependencies; ++i)
+            node->SetDependency(node->dependencies_[i], nodes_[node->dependsOn_[i]].get());
+
+        node->observerDependency_.SetDependency(node.get(), observer_.get());
+    }
+#endif
+}
+
+void TaskGraph::ExecuteSerial()
+{
+    const unsigned threadIndex = WorkQueue::GetThreadIndex();
+    for (NodeIndex index : sortedNodes_)
+    {
+        NodeTask* node = nodes_[index].get();
+        node->Run(0, node->size_, threadIndex);
+    }
+}
+
+void TaskGraph::Launch()
+{
+    URHO3D_ASSERT(!running_, "TaskGraph is already running");
+    URHO3D_ASSERT(WorkQueue::IsProcessingThread(), "TaskGraph can be launched only from main thread or from another task");
+
+    if (dirty_)
+    {
+        ValidateGraph();
+        dirty_ = false;
+    }
+
+    if (nodes_.empty())
+        return;
+
+#ifdef URHO3D_THREADING
+    if (enki::TaskScheduler* taskScheduler = workQueue_->taskScheduler_.get())
+    {
+        running_ = true;
+        for (const auto& node : nodes_)
+        {
+            if (node->dependsOn_.empty())
+                taskScheduler->AddTaskSetToPipe(node.get());
+        }
+        return;
+    }
+#endif
+
+    // Execute graph right away if there are no worker threads
+    ExecuteSerial();
+}
+
+void TaskGraph::Wait()
+{
+    if (!running_)
+        return;
+
+#ifdef URHO3D_THREADING
+    const auto priority = static_cast<enki::TaskPriority>(priority_);
+    workQueue_->taskScheduler_->WaitforTask(observer_.get(), priority);
+#endif
+    running_ = false;
+}
+
+void TaskGraph::Execute()
+{
+    Launch();
+    Wait();
+}
+
+}
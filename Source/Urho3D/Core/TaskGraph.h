@@ -0,0 +1,102 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "Urho3D/Core/NonCopyable.h"
+#include "Urho3D/Core/WorkQueue.h"
+
+#include <EASTL/unique_ptr.h>
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+/// Directed acyclic graph of tasks executed by WorkQueue.
+/// Nodes are started as soon as all their dependencies are completed, without waiting on the whole "stage".
+/// Graph is launched from main thread or from another task, and may be launched again after completion.
+/// Graph structure should not be modified while the graph is running.
+class URHO3D_API TaskGraph : public NonCopyable
+{
+public:
+    /// Index of the node in the graph.
+    using NodeIndex = unsigned;
+
+    explicit TaskGraph(WorkQueue* workQueue, TaskPriority priority = TaskPriority::Highest);
+    ~TaskGraph();
+
+    /// Add task. Signature of task is the same as for WorkQueue::PostTask.
+    template <class T> NodeIndex AddTask(T task) { return AddTaskInternal(WorkQueue::WrapTask(ea::move(task))); }
+    /// Add task that processes range [0, size) with work stealing.
+    /// Range is split into chunks of at least minRange elements, chunks are picked by idle threads.
+    /// Signature of callback: void(unsigned beginIndex, unsigned endIndex, unsigned threadIndex)
+    NodeIndex AddParallelFor(unsigned size, unsigned minRange, RangeTaskFunction task);
+    /// Make node wait for completion of another node.
+    void AddDependency(NodeIndex node, NodeIndex dependsOn);
+    /// Add task that is started after completion of specified node.
+    template <class T> NodeIndex Then(NodeIndex node, T task);
+    /// Remove all nodes.
+    void Clear();
+
+    /// Start execution of the graph and return immediately.
+    void Launch();
+    /// Wait for completion of the graph. Current thread executes pending tasks while waiting.
+    void Wait();
+    /// Launch the graph and wait for its completion.
+    void Execute();
+
+    /// Return number of nodes.
+    unsigned GetNumNodes() const { return nodes_.size(); }
+    /// Return whether the graph is running.
+    bool IsRunning() const { return running_; }
+
+private:
+    class NodeTask;
+
+    NodeIndex AddTaskInternal(TaskFunction&& task);
+    void ResetDependencies();
+    void ValidateGraph();
+    void ExecuteSerial();
+
+    WorkQueue* workQueue_{};
+    TaskPriority priority_{};
+
+    ea::vector<ea::unique_ptr<NodeTask>> nodes_;
+    /// Topologically sorted nodes, updated on launch.
+    ea::vector<NodeIndex> sortedNodes_;
+    bool dirty_{};
+    bool running_{};
+
+#ifdef URHO3D_THREADING
+    class CompletionObserver;
+    ea::unique_ptr<CompletionObserver> observer_;
+#endif
+};
+
+template <class T> TaskGraph::NodeIndex TaskGraph::Then(NodeIndex node, T task)
+{
+    const NodeIndex continuation = AddTask(ea::move(task));
+    AddDependency(continuation, node);
+    return continuation;
+}
+
+}
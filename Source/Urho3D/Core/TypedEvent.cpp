@@ -0,0 +1,144 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Core/TypedEvent.h"
+
+#include "Urho3D/Core/Context.h"
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace Detail
+{
+
+TypedEventBase::TypedEventBase(Object* sender, StringHash eventType)
+    : sender_(sender)
+    , eventType_(eventType)
+{
+}
+
+TypedEventBase::~TypedEventBase() = default;
+
+void TypedEventBase::Unsubscribe(Object* receiver)
+{
+    if (IsSubscribed(receiver))
+        receiver->UnsubscribeFromEvent(sender_, eventType_);
+}
+
+bool TypedEventBase::IsSubscribed(Object* receiver) const
+{
+    const auto iter = subscriptions_.find(receiver);
+    return iter != subscriptions_.end() && iter->second;
+}
+
+unsigned TypedEventBase::GetNumReceivers() const
+{
+    return ea::count_if(subscriptions_.begin(), subscriptions_.end(),
+        [](const auto& elem) { return !!elem.second; });
+}
+
+void TypedEventBase::AddSubscription(Object* receiver, TypedSubscriptionBase* subscription)
+{
+    subscriptions_[receiver] = subscription;
+    receiversDirty_ = true;
+}
+
+void TypedEventBase::UpdateReceivers()
+{
+    if (sendDepth_ > 0)
+        return;
+
+    Context* context = sender_->GetContext();
+    const unsigned contextRevision = context->GetEventReceiversRevision();
+    if (contextRevision_ != contextRevision)
+    {
+        contextRevision_ = contextRevision;
+        specificGroup_ = context->GetEventReceivers(sender_, eventType_);
+        group_ = context->GetEventReceivers(eventType_);
+        receiversDirty_ = true;
+    }
+
+    const unsigned specificGroupRevision = specificGroup_ ? specificGroup_->GetRevision() : 0;
+    const unsigned groupRevision = group_ ? group_->GetRevision() : 0;
+    if (!receiversDirty_ && specificGroupRevision_ == specificGroupRevision && groupRevision_ == groupRevision)
+        return;
+
+    receiversDirty_ = false;
+    specificGroupRevision_ = specificGroupRevision;
+    groupRevision_ = groupRevision;
+
+    ea::erase_if(subscriptions_, [](const auto& elem) { return !elem.second; });
+
+    // Receivers of this sender go first, then receivers of any sender
+    receivers_.clear();
+    if (specificGroup_)
+    {
+        for (Object* receiver : specificGroup_->receivers_)
+        {
+            if (receiver)
+                AddReceiver(receiver);
+        }
+    }
+    if (group_)
+    {
+        for (Object* receiver : group_->receivers_)
+        {
+            if (receiver && !(specificGroup_ && specificGroup_->receivers_.contains(receiver)))
+                AddReceiver(receiver);
+        }
+    }
+}
+
+void TypedEventBase::AddReceiver(Object* receiver)
+{
+    ReceiverEntry& entry = receivers_.push_back();
+    entry.receiver_ = receiver;
+
+    const auto iter = subscriptions_.find(receiver);
+    if (iter != subscriptions_.end())
+        entry.subscription_ = iter->second;
+}
+
+void TypedEventBase::BeginSend()
+{
+    ++sendDepth_;
+    sender_->GetContext()->BeginSendEvent(sender_, eventType_);
+}
+
+void TypedEventBase::EndSend()
+{
+    --sendDepth_;
+    sender_->GetContext()->EndSendEvent();
+}
+
+void TypedEventBase::EndSendExpired(Context* context)
+{
+    context->EndSendEvent();
+}
+
+}
+
+}
@@ -0,0 +1,217 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "Urho3D/Core/Context.h"
+#include "Urho3D/Core/Object.h"
+
+#include <EASTL/fixed_function.h>
+#include <EASTL/unordered_map.h>
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+namespace Detail
+{
+
+/// Typed subscription. Owned by the event handler of the receiver, so it expires when the receiver unsubscribes.
+class URHO3D_API TypedSubscriptionBase : public RefCounted
+{
+};
+
+/// Type-independent part of TypedEvent.
+class URHO3D_API TypedEventBase : public NonCopyable
+{
+public:
+    TypedEventBase(Object* sender, StringHash eventType);
+    ~TypedEventBase();
+
+    /// Unsubscribe receiver. Same as Object::UnsubscribeFromEvent for the sender and event type.
+    void Unsubscribe(Object* receiver);
+    /// Return whether the receiver is subscribed via typed handler.
+    bool IsSubscribed(Object* receiver) const;
+
+    /// Return sender.
+    Object* GetSender() const { return sender_; }
+    /// Return event type.
+    StringHash GetEventType() const { return eventType_; }
+    /// Return number of typed receivers.
+    unsigned GetNumReceivers() const;
+
+protected:
+    struct ReceiverEntry
+    {
+        WeakPtr<Object> receiver_;
+        /// Typed subscription if any. VariantMap handler of the receiver is used otherwise.
+        WeakPtr<TypedSubscriptionBase> subscription_;
+    };
+
+    /// Remember typed subscription of the receiver.
+    void AddSubscription(Object* receiver, TypedSubscriptionBase* subscription);
+    /// Update ordered list of receivers if event receivers have changed. Ignored during sending.
+    void UpdateReceivers();
+    /// Begin sending. Receivers can query the sender via Object::GetEventSender.
+    void BeginSend();
+    /// End sending.
+    void EndSend();
+    /// End sending if the sender and this object have been destroyed during sending.
+    static void EndSendExpired(Context* context);
+
+    Object* const sender_{};
+    const StringHash eventType_;
+    /// All receivers in the same order as Object::SendEvent would use.
+    ea::vector<ReceiverEntry> receivers_;
+
+private:
+    void AddReceiver(Object* receiver);
+
+    ea::unordered_map<Object*, WeakPtr<TypedSubscriptionBase>> subscriptions_;
+    unsigned sendDepth_{};
+    bool receiversDirty_{true};
+
+    unsigned contextRevision_{};
+    SharedPtr<EventReceiverGroup> specificGroup_;
+    SharedPtr<EventReceiverGroup> group_;
+    unsigned specificGroupRevision_{};
+    unsigned groupRevision_{};
+};
+
+}
+
+/// Statically typed event channel owned by the sender.
+/// Receivers get payload struct by reference without VariantMap conversions or receiver map lookups.
+/// Payload type should implement `void ToEventData(VariantMap& eventData) const`
+/// and `void FromEventData(VariantMap& eventData)`.
+/// Typed subscription is also a regular subscription to the sender's event, so receivers subscribed via
+/// Object::SubscribeToEvent and typed receivers get the event in the same order as Object::SendEvent would use.
+/// Object::UnsubscribeFromEvent and similar functions remove typed subscriptions too.
+template <class T>
+class TypedEvent : public Detail::TypedEventBase
+{
+public:
+    /// Small object optimization buffer size.
+    static constexpr unsigned HandlerSize = 4 * sizeof(void*);
+    /// Event handler type.
+    using Handler = ea::fixed_function<HandlerSize, void(Object* receiver, T& payload)>;
+
+    TypedEvent(Object* sender, StringHash eventType) : TypedEventBase(sender, eventType) {}
+
+    /// Subscribe receiver. Handler should accept either (T&) or (Receiver*, T&), member function pointers are allowed.
+    /// Receivers subscribed during sending will get the event starting from the next send.
+    template <class Receiver, class Callback> void Subscribe(Receiver* receiver, Callback handler);
+    /// Send event to typed and VariantMap receivers.
+    void Send(T& payload);
+
+private:
+    struct Subscription : public Detail::TypedSubscriptionBase
+    {
+        explicit Subscription(Handler handler) : handler_(ea::move(handler)) {}
+
+        Handler handler_;
+    };
+};
+
+template <class T>
+template <class Receiver, class Callback>
+void TypedEvent<T>::Subscribe(Receiver* receiver, Callback handler)
+{
+    static_assert(ea::is_base_of_v<Object, Receiver>, "Receiver should be derived from Object.");
+    static_assert(ea::is_invocable_v<Callback, Receiver*, T&> || ea::is_invocable_v<Callback, T&>,
+        "Callback should accept either (T&) or (Receiver*, T&) as parameters.");
+
+    auto wrappedHandler = [handler](Object* receiverPtr, T& payload) mutable
+    {
+        auto receiver = static_cast<Receiver*>(receiverPtr);
+        if constexpr (ea::is_member_function_pointer_v<Callback>)
+            (receiver->*handler)(payload);
+        else if constexpr (ea::is_invocable_v<Callback, Receiver*, T&>)
+            handler(receiver, payload);
+        else
+            handler(payload);
+    };
+
+    // Event handler owns the subscription and is used when the event is sent via Object::SendEvent
+    SharedPtr<Subscription> subscription = MakeShared<Subscription>(ea::move(wrappedHandler));
+    AddSubscription(receiver, subscription);
+    receiver->SubscribeToEvent(sender_, eventType_,
+        [subscription](Object* self, StringHash eventType, VariantMap& eventData)
+    {
+        T payload{};
+        payload.FromEventData(eventData);
+        subscription->handler_(self, payload);
+    });
+}
+
+template <class T>
+void TypedEvent<T>::Send(T& payload)
+{
+    if (sender_->GetBlockEvents())
+        return;
+
+    UpdateReceivers();
+
+    // VariantMap receivers share the event data, same as in Object::SendEvent
+    VariantMap& eventData = sender_->GetEventDataMap();
+    bool hasEventData = false;
+
+    // Receivers may destroy the sender together with this object
+    WeakPtr<Object> self(sender_);
+    Context* context = sender_->GetContext();
+    BeginSend();
+
+    const unsigned numReceivers = receivers_.size();
+    for (unsigned i = 0; i < numReceivers; ++i)
+    {
+        const ReceiverEntry& entry = receivers_[i];
+        Object* receiver = entry.receiver_.Get();
+        if (!receiver)
+            continue;
+
+        if (entry.subscription_)
+        {
+            // Handler may unsubscribe the receiver and destroy the subscription
+            SharedPtr<Subscription> subscription{static_cast<Subscription*>(entry.subscription_.Get())};
+            subscription->handler_(receiver, payload);
+        }
+        else
+        {
+            if (!hasEventData)
+            {
+                payload.ToEventData(eventData);
+                hasEventData = true;
+            }
+            receiver->OnEvent(sender_, eventType_, eventData);
+        }
+
+        if (self.Expired())
+        {
+            EndSendExpired(context);
+            return;
+        }
+    }
+
+    EndSend();
+}
+
+}
@@ -248,6 +248,25 @@ public:
     }
 };
 
+class WorkQueue::ParallelForTask : public enki::ITaskSet
+{
+public:
+    ParallelForTask(RangeCallback invoke, const void* callback)
+        : invoke_(invoke)
+        , callback_(callback)
+    {
+    }
+
+    void ExecuteRange(enki::TaskSetPartition range, uint32_t threadNum) override
+    {
+        invoke_(callback_, range.start, range.end, threadNum);
+    }
+
+private:
+    RangeCallback invoke_{};
+    const void* callback_{};
+};
+
 #endif
 
 WorkQueue::WorkQueue(Context* context)
@@ -495,6 +514,33 @@ void WorkQueue::CompleteImmediateForAnotherThread(unsigned threadIndex)
     // Fallback queue never contains immediate tasks
 }
 
+void WorkQueue::ParallelForInternal(unsigned size, unsigned minRange, RangeCallback invoke, const void* callback)
+{
+    if (size == 0)
+        return;
+
+    minRange = ea::max(minRange, 1u);
+
+#ifdef URHO3D_THREADING
+    static const auto priority = static_cast<enki::TaskPriority>(TaskPriority::Immediate);
+    if (taskScheduler_ && size > minRange)
+    {
+        URHO3D_ASSERT(IsProcessingThread(), "ParallelFor can be called only from main thread or from another task");
+
+        ParallelForTask task{invoke, callback};
+        task.m_SetSize = size;
+        task.m_MinRange = minRange;
+        task.m_Priority = priority;
+
+        taskScheduler_->AddTaskSetToPipe(&task);
+        taskScheduler_->WaitforTask(&task, priority);
+        return;
+    }
+#endif
+
+    invoke(callback, 0, size, GetThreadIndex());
+}
+
 void WorkQueue::CompleteImmediateForThisThread()
 {
 #ifdef URHO3D_THREADING
@@ -70,6 +70,9 @@ static constexpr unsigned TaskBufferSize = sizeof(void*) * 8;
 using TaskFunction = ea::internal::function_detail<TaskBufferSize, void(unsigned threadIndex, WorkQueue* queue)>;
 //using TaskFunction = ea::function<void(unsigned threadIndex, WorkQueue* queue)>;
 
+/// Range task function signature.
+using RangeTaskFunction = ea::function<void(unsigned beginIndex, unsigned endIndex, unsigned threadIndex)>;
+
 /// Vector-like collection that can be safely filled from different WorkQueue threads simultaneously.
 template <class T>
 class WorkQueueVector : public MultiVector<T>
@@ -119,6 +122,7 @@ class URHO3D_API WorkQueue : public Object
     URHO3D_OBJECT(WorkQueue, Object);
 
     friend class WorkerThread;
+    friend class TaskGraph;
 
 public:
     /// Construct.
@@ -144,6 +148,12 @@ public:
     void PostDelayedTaskForMainThread(TaskFunction&& task);
     template <class T> void PostDelayedTaskForMainThread(T task);
 
+    /// Process range [0, size) in multiple threads with work stealing and wait for completion.
+    /// Range is split into chunks of at least minRange elements, idle threads steal remaining chunks.
+    /// Can be called only from main thread or from another task.
+    /// Signature of callback: void(unsigned beginIndex, unsigned endIndex, unsigned threadIndex)
+    template <class Callback> void ParallelFor(unsigned size, unsigned minRange, const Callback& callback);
+
     /// Complete tasks with Immediate priority, posted from this thread.
     /// Can be called only from main thread or from another task.
     void CompleteImmediateForThisThread();
@@ -189,6 +199,9 @@ private:
     void PurgeProcessedTasksInFallbackQueue();
     void CompleteImmediateForAnotherThread(unsigned threadIndex);
 
+    using RangeCallback = void (*)(const void* callback, unsigned beginIndex, unsigned endIndex, unsigned threadIndex);
+    void ParallelForInternal(unsigned size, unsigned minRange, RangeCallback invoke, const void* callback);
+
     template <class T> static TaskFunction WrapTask(T&& task);
 
 #ifdef URHO3D_THREADING
@@ -234,6 +247,7 @@ private:
     class InternalTaskInStack;
     class InternalPinnedTaskInStack;
     class TaskCompletionObserver;
+    class ParallelForTask;
 
     /// Task scheduler.
     ea::unique_ptr<enki::TaskScheduler> taskScheduler_;
@@ -394,6 +408,14 @@ template <class T> void WorkQueue::PostTaskForThread(T task, TaskPriority priori
     PostTaskForThread(WrapTask(ea::move(task)), priority, threadIndex);
 }
 
+template <class Callback> void WorkQueue::ParallelFor(unsigned size, unsigned minRange, const Callback& callback)
+{
+    const auto invoke = [](const void* callback, unsigned beginIndex, unsigned endIndex, unsigned threadIndex)
+    { (*static_cast<const Callback*>(callback))(beginIndex, endIndex, threadIndex); };
+
+    ParallelForInternal(size, minRange, invoke, &callback);
+}
+
 template <class T> void WorkQueue::PostTaskForMainThread(T task, TaskPriority priority)
 {
     PostTaskForMainThread(WrapTask(ea::move(task)), priority);
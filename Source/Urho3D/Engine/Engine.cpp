@@ -25,6 +25,7 @@
 #include "../Audio/Audio.h"
 #include "../Core/Context.h"
 #include "../Core/CoreEvents.h"
+#include "../Core/FrameArena.h"
 #include "../Core/Profiler.h"
 #include "../Core/ProcessUtils.h"
 #include "../Core/Thread.h"
@@ -38,6 +39,7 @@
 #include "../Engine/Engine.h"
 #include "../Engine/EngineDefs.h"
 #include "../Engine/StateManager.h"
+#include "../Graphics/AnimationPoseCache.h"
 #include "../Graphics/Graphics.h"
 #include "../Graphics/GraphicsEvents.h"
 #include "../RenderAPI/PipelineState.h"
@@ -247,6 +249,7 @@ Engine::Engine(Context* context) :
     // Create subsystems which do not depend on engine initialization or startup parameters
     context_->RegisterSubsystem(new Time(context_));
     context_->RegisterSubsystem(new WorkQueue(context_));
+    context_->RegisterSubsystem(new FrameArena(context_));
     context_->RegisterSubsystem(new FileSystem(context_));
     context_->RegisterSubsystem(new VirtualFileSystem(context_));
 #ifdef URHO3D_LOGGING
@@ -259,6 +262,7 @@ Engine::Engine(Context* context) :
 #endif
     // Required in headless mode as well.
     RegisterGraphicsLibrary(context_);
+    context_->RegisterSubsystem(new AnimationPoseCache(context_));
     // Register object factories for libraries which are not automatically registered along with subsystem creation
     RegisterSceneLibrary(context_);
     // Register UI library object factories before creation of subsystem. This is not done inside subsystem because
@@ -25,9 +25,11 @@
 #include <EASTL/sort.h>
 
 #include "../Core/Context.h"
+#include "../Core/FrameArena.h"
 #include "../Core/Profiler.h"
 #include "../Graphics/AnimatedModel.h"
 #include "../Graphics/Animation.h"
+#include "../Graphics/AnimationPoseCache.h"
 #include "../Graphics/AnimationState.h"
 #include "../Graphics/Camera.h"
 #include "../Graphics/DebugRenderer.h"
@@ -41,6 +43,7 @@
 #include "../Graphics/SoftwareModelAnimator.h"
 #include "../Graphics/VertexBuffer.h"
 #include "../IO/Log.h"
+#include "../Math/BatchMath.h"
 #include "../Resource/ResourceCache.h"
 #include "../Resource/ResourceEvents.h"
 #include "../Scene/Scene.h"
@@ -97,6 +100,7 @@ void AnimatedModel::RegisterObject(Context* context)
     URHO3D_ACCESSOR_ATTRIBUTE("Shadow Distance", GetShadowDistance, SetShadowDistance, float, 0.0f, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("LOD Bias", GetLodBias, SetLodBias, float, 1.0f, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Animation LOD Bias", GetAnimationLodBias, SetAnimationLodBias, float, 1.0f, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Bone LOD Distance", GetBoneLodDistance, SetBoneLodDistance, float, 0.0f, AM_DEFAULT);
     URHO3D_COPY_BASE_ATTRIBUTES(Drawable);
     URHO3D_MIXED_ACCESSOR_ATTRIBUTE("Bone Animation Enabled", GetBonesEnabledAttr, SetBonesEnabledAttr, VariantVector,
         Variant::emptyVariantVector, AM_DEFAULT | AM_NOEDIT);
@@ -249,13 +253,14 @@ void AnimatedModel::Update(const FrameInfo& frame)
 
         if (transformsDirty)
         {
+            // Bones skipped by bone LOD keep their transforms
             Octree* octree = octant_->GetOctree();
             for (unsigned boneIndex = 0; boneIndex < skeleton_.GetNumBones(); ++boneIndex)
             {
                 Node* node = skeleton_.GetBone(boneIndex)->node_;
-                const Transform& transform = skeletonData_[boneIndex].localToParent_;
-                if (node)
-                    octree->QueueNodeTransformUpdate(node, transform);
+                const ModelAnimationOutput& output = skeletonData_[boneIndex];
+                if (node && !output.skipped_)
+                    octree->QueueNodeTransformUpdate(node, output.localToParent_);
             }
         }
     }
@@ -271,6 +276,33 @@ void AnimatedModel::Update(const FrameInfo& frame)
     }
 }
 
+void AnimatedModel::UpdateBoneHeights()
+{
+    const unsigned numBones = skeleton_.GetNumBones();
+    boneHeights_.assign(numBones, 0);
+    maxBoneHeight_ = 0;
+
+    // Bones are ordered from parents to children, iterate in reverse to propagate heights up
+    const ea::vector<unsigned>& bonesOrder = skeleton_.GetBonesOrder();
+    for (auto iter = bonesOrder.rbegin(); iter != bonesOrder.rend(); ++iter)
+    {
+        const unsigned boneIndex = *iter;
+        const unsigned parentIndex = skeleton_.GetBone(boneIndex)->parentIndex_;
+        if (parentIndex != boneIndex && parentIndex < numBones)
+            boneHeights_[parentIndex] = ea::max(boneHeights_[parentIndex], boneHeights_[boneIndex] + 1);
+        maxBoneHeight_ = ea::max(maxBoneHeight_, boneHeights_[boneIndex]);
+    }
+}
+
+unsigned AnimatedModel::GetBoneLod() const
+{
+    if (boneLodDistance_ <= 0.0f || animationLodDistance_ <= 0.0f)
+        return 0;
+
+    // Root bones are never skipped
+    return ea::min(static_cast<unsigned>(animationLodDistance_ / boneLodDistance_), maxBoneHeight_);
+}
+
 void AnimatedModel::InitializeLocalBoneTransforms(bool reset)
 {
     URHO3D_ASSERT(skeleton_.GetNumBones() == skeletonData_.size());
@@ -438,6 +470,7 @@ void AnimatedModel::SetModel(Model* model, bool createBones)
         // Reserve space for skinning matrices
         skinMatrices_.resize(skeleton_.GetNumBones());
         skeletonData_.resize(skeleton_.GetNumBones());
+        UpdateBoneHeights();
         SetGeometryBoneMappings();
 
         // Reconsider software skinning
@@ -488,6 +521,7 @@ void AnimatedModel::SetModel(Model* model, bool createBones)
         modelAnimator_ = nullptr;
         morphs_.clear();
         skeletonData_.clear();
+        UpdateBoneHeights();
         SetBoundingBox(BoundingBox());
         SetSkeleton(Skeleton(), false);
     }
@@ -498,6 +532,11 @@ void AnimatedModel::SetAnimationLodBias(float bias)
     animationLodBias_ = Max(bias, 0.0f);
 }
 
+void AnimatedModel::SetBoneLodDistance(float distance)
+{
+    boneLodDistance_ = Max(distance, 0.0f);
+}
+
 void AnimatedModel::SetUpdateInvisible(bool enable)
 {
     updateInvisible_ = enable;
@@ -1041,8 +1080,18 @@ void AnimatedModel::CalculateAnimations()
     // AnimationStateSource is a weak pointer which may or may not be an issue
     if (AnimationStateSource* animationStateSource = animationStateSource_)
     {
-        for (AnimationState* state : animationStateSource->GetAnimationStates())
-            state->CalculateModelTracks(skeletonData_);
+        const unsigned boneLod = GetBoneLod();
+        for (unsigned boneIndex = 0; boneIndex < skeletonData_.size(); ++boneIndex)
+            skeletonData_[boneIndex].skipped_ = boneHeights_[boneIndex] < boneLod;
+
+        const AnimationStateVector& states = animationStateSource->GetAnimationStates();
+        if (auto poseCache = GetSubsystem<AnimationPoseCache>())
+            poseCache->CalculateModelTracks(model_, skeleton_, states, boneLod, skeletonData_);
+        else
+        {
+            for (AnimationState* state : states)
+                state->CalculateModelTracks(skeletonData_);
+        }
     }
 
     animationDirty_ = false;
@@ -1088,30 +1137,30 @@ void AnimatedModel::UpdateSkinning()
     // Use model's world transform in case a bone is missing
     const Matrix3x4& worldTransform = node_->GetWorldTransform();
 
-    // Skinning with global matrices only
-    if (!geometrySkinMatrices_.size())
+    // Gather bone transforms and multiply them in batch
+    const unsigned numBones = bones.size();
+    FrameVector<Matrix3x4> offsetMatrices(numBones);
+    for (unsigned i = 0; i < numBones; ++i)
     {
-        for (unsigned i = 0; i < bones.size(); ++i)
+        const Bone& bone = bones[i];
+        if (bone.node_)
         {
-            const Bone& bone = bones[i];
-            if (bone.node_)
-                skinMatrices_[i] = bone.node_->GetWorldTransform() * bone.offsetMatrix_;
-            else
-                skinMatrices_[i] = worldTransform;
+            skinMatrices_[i] = bone.node_->GetWorldTransform();
+            offsetMatrices[i] = bone.offsetMatrix_;
+        }
+        else
+        {
+            skinMatrices_[i] = worldTransform;
+            offsetMatrices[i] = Matrix3x4::IDENTITY;
         }
     }
-    // Skinning with per-geometry matrices
-    else
+    MultiplyMatrices(skinMatrices_.data(), offsetMatrices.data(), skinMatrices_.data(), numBones);
+
+    // Copy the skin matrices to per-geometry matrices as needed
+    if (geometrySkinMatrices_.size())
     {
-        for (unsigned i = 0; i < bones.size(); ++i)
+        for (unsigned i = 0; i < numBones; ++i)
         {
-            const Bone& bone = bones[i];
-            if (bone.node_)
-                skinMatrices_[i] = bone.node_->GetWorldTransform() * bone.offsetMatrix_;
-            else
-                skinMatrices_[i] = worldTransform;
-
-            // Copy the skin matrix to per-geometry matrices as needed
             for (unsigned j = 0; j < geometrySkinMatrixPtrs_[i].size(); ++j)
                 *geometrySkinMatrixPtrs_[i][j] = skinMatrices_[i];
         }
@@ -1132,11 +1181,9 @@ void AnimatedModel::UpdateMorphs()
 
     if (modelAnimator_)
     {
-        modelAnimator_->ResetAnimation();
-        modelAnimator_->ApplyMorphs(morphs_);
-        if (softwareSkinning_)
-            modelAnimator_->ApplySkinning(skinMatrices_);
-        modelAnimator_->Commit();
+        // Skinning matrices are ignored if animator is not skinned
+        if (modelAnimator_->ApplyAnimation(morphs_, skinMatrices_))
+            modelAnimator_->Commit();
     }
 
     morphsDirty_ = false;
@@ -77,6 +77,10 @@ public:
     /// Set animation LOD bias.
     /// @property
     void SetAnimationLodBias(float bias);
+    /// Set animation LOD distance step for bone LOD. Each step excludes one more level of leaf bones from animation.
+    /// Zero disables bone LOD.
+    /// @property
+    void SetBoneLodDistance(float distance);
     /// Set whether to update animation and the bounding box when not visible. Recommended to enable for physically controlled models like ragdolls.
     /// @property
     void SetUpdateInvisible(bool enable);
@@ -104,6 +108,13 @@ public:
     /// @property
     float GetAnimationLodBias() const { return animationLodBias_; }
 
+    /// Return animation LOD distance step for bone LOD.
+    /// @property
+    float GetBoneLodDistance() const { return boneLodDistance_; }
+
+    /// Return current bone LOD, i.e. number of leaf bone levels excluded from animation.
+    unsigned GetBoneLod() const;
+
     /// Return whether to update animation when not visible.
     /// @property
     bool GetUpdateInvisible() const { return updateInvisible_; }
@@ -186,6 +197,7 @@ private:
     bool PrepareForThreadedUpdate(Camera* camera, unsigned frameNumber);
     bool UpdateAndCheckAnimationTimers(float timeStep);
 
+    void UpdateBoneHeights();
     void InitializeLocalBoneTransforms(bool reset);
     void CalculateFinalBoneTransforms();
     void CalculateLocalBoundingBox();
@@ -234,6 +246,12 @@ private:
     float animationLodTimer_;
     /// Animation LOD distance, the minimum of all LOD view distances last frame.
     float animationLodDistance_;
+    /// Animation LOD distance step for bone LOD.
+    float boneLodDistance_{};
+    /// Distance from each bone to the furthest leaf bone in its subtree.
+    ea::vector<unsigned> boneHeights_;
+    /// Max value in boneHeights_.
+    unsigned maxBoneHeight_{};
     /// Update animation when invisible flag.
     bool updateInvisible_;
     /// Software skinning flag.
@@ -0,0 +1,223 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Graphics/AnimationPoseCache.h"
+
+#include "Urho3D/Core/CoreEvents.h"
+#include "Urho3D/Graphics/Animation.h"
+#include "Urho3D/Graphics/Model.h"
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+bool AnimationPoseCache::StateKey::operator==(const StateKey& rhs) const
+{
+    return animation_ == rhs.animation_ && startBone_ == rhs.startBone_ && blendMode_ == rhs.blendMode_
+        && looped_ == rhs.looped_ && weight_ == rhs.weight_ && time_ == rhs.time_;
+}
+
+unsigned AnimationPoseCache::PoseKey::ToHash() const
+{
+    unsigned result = MakeHash(model_);
+    CombineHash(result, boneLod_);
+    for (const StateKey& state : states_)
+    {
+        CombineHash(result, MakeHash(state.animation_));
+        CombineHash(result, state.startBone_.Value());
+        CombineHash(result, state.blendMode_);
+        CombineHash(result, state.looped_);
+        CombineHash(result, MakeHash(state.weight_));
+        CombineHash(result, MakeHash(state.time_));
+    }
+    return result;
+}
+
+bool AnimationPoseCache::PoseKey::operator==(const PoseKey& rhs) const
+{
+    return model_ == rhs.model_ && boneLod_ == rhs.boneLod_ && states_ == rhs.states_;
+}
+
+AnimationPoseCache::AnimationPoseCache(Context* context)
+    : Object(context)
+{
+    SubscribeToEvent(E_ENDFRAME, &AnimationPoseCache::Reset);
+}
+
+AnimationPoseCache::~AnimationPoseCache() = default;
+
+bool AnimationPoseCache::MakeKey(Model* model, const Skeleton& skeleton, const AnimationStateVector& states,
+    unsigned boneLod, PoseKey& key) const
+{
+    if (!model)
+        return false;
+
+    // Bones with disabled animation are configured per model instance and cannot be shared
+    for (const Bone& bone : skeleton.GetBones())
+    {
+        if (!bone.animated_)
+            return false;
+    }
+
+    key.model_ = model;
+    key.boneLod_ = boneLod;
+    for (const AnimationState* state : states)
+    {
+        if (!state->GetAnimation() || !state->IsEnabled())
+            continue;
+
+        // Pose is blended onto per-instance bone transforms unless the first state fully overrides them
+        if (key.states_.empty() && (!IsFullOverride(state) || !CoversSkeleton(skeleton, state)))
+            return false;
+
+        if (key.states_.size() >= MaxStates)
+            return false;
+
+        const float time = state->GetTime();
+        StateKey& stateKey = key.states_.push_back();
+        stateKey.animation_ = state->GetAnimation();
+        stateKey.startBone_ = StringHash{state->GetStartBone()};
+        stateKey.blendMode_ = state->GetBlendMode();
+        stateKey.looped_ = state->IsLooped();
+        stateKey.weight_ = state->GetWeight();
+        stateKey.time_ = timeStep_ > 0.0f ? Floor(time / timeStep_) : time;
+    }
+
+    return true;
+}
+
+bool AnimationPoseCache::IsFullOverride(const AnimationState* state) const
+{
+    if (state->GetBlendMode() != ABM_LERP || state->GetWeight() != 1.0f)
+        return false;
+
+    for (const auto& [nameHash, track] : state->GetAnimation()->GetTracks())
+    {
+        if (track.positionWeight_ != 1.0f || track.rotationWeight_ != 1.0f || track.scaleWeight_ != 1.0f)
+            return false;
+    }
+    return true;
+}
+
+bool AnimationPoseCache::CoversSkeleton(const Skeleton& skeleton, const AnimationState* state) const
+{
+    const ea::string& startBone = state->GetStartBone();
+    if (startBone.empty())
+        return true;
+
+    const unsigned boneIndex = skeleton.GetBoneIndex(startBone);
+    return boneIndex < skeleton.GetNumBones() && skeleton.GetBones()[boneIndex].parentIndex_ == boneIndex;
+}
+
+void AnimationPoseCache::CalculateModelTracks(Model* model, const Skeleton& skeleton,
+    const AnimationStateVector& states, unsigned boneLod, ea::vector<ModelAnimationOutput>& output)
+{
+    PoseKey key;
+    if (!enabled_ || !MakeKey(model, skeleton, states, boneLod, key))
+    {
+        for (AnimationState* state : states)
+            state->CalculateModelTracks(output);
+        return;
+    }
+
+    // Poses are never removed or modified until Reset, so it's safe to read them without lock
+    const Pose* cachedPose = nullptr;
+    {
+        MutexLock lock(mutex_);
+        const auto iter = poses_.find(key);
+        if (iter != poses_.end())
+        {
+            cachedPose = &iter->second;
+            ++numHits_;
+        }
+    }
+
+    if (cachedPose && cachedPose->size() == output.size())
+    {
+        for (unsigned boneIndex = 0; boneIndex < output.size(); ++boneIndex)
+        {
+            const BonePose& bonePose = (*cachedPose)[boneIndex];
+            ModelAnimationOutput& boneOutput = output[boneIndex];
+
+            boneOutput.dirty_ |= bonePose.dirty_;
+            if (bonePose.dirty_.Test(CHANNEL_POSITION))
+                boneOutput.localToParent_.position_ = bonePose.localToParent_.position_;
+            if (bonePose.dirty_.Test(CHANNEL_ROTATION))
+                boneOutput.localToParent_.rotation_ = bonePose.localToParent_.rotation_;
+            if (bonePose.dirty_.Test(CHANNEL_SCALE))
+                boneOutput.localToParent_.scale_ = bonePose.localToParent_.scale_;
+        }
+        return;
+    }
+
+    // Channels that are not dirty depend on the model instance and are never copied from cache.
+    // Channels first written by blending state are mixed with per-instance transforms and cannot be shared either.
+    Pose pose(output.size());
+    bool dependsOnInstance = false;
+    for (AnimationState* state : states)
+    {
+        if (!state->GetAnimation() || !state->IsEnabled())
+            continue;
+
+        state->CalculateModelTracks(output);
+
+        const bool isFullOverride = IsFullOverride(state);
+        for (unsigned boneIndex = 0; boneIndex < output.size(); ++boneIndex)
+        {
+            if (!isFullOverride && (output[boneIndex].dirty_ & ~pose[boneIndex].dirty_))
+                dependsOnInstance = true;
+            pose[boneIndex].dirty_ = output[boneIndex].dirty_;
+        }
+    }
+
+    if (dependsOnInstance)
+        return;
+
+    for (unsigned boneIndex = 0; boneIndex < output.size(); ++boneIndex)
+        pose[boneIndex].localToParent_ = output[boneIndex].localToParent_;
+
+    MutexLock lock(mutex_);
+    poses_.emplace(ea::move(key), ea::move(pose));
+}
+
+void AnimationPoseCache::Reset()
+{
+    MutexLock lock(mutex_);
+    poses_.clear();
+}
+
+unsigned AnimationPoseCache::GetNumPoses() const
+{
+    MutexLock lock(mutex_);
+    return poses_.size();
+}
+
+unsigned AnimationPoseCache::GetNumHits() const
+{
+    MutexLock lock(mutex_);
+    return numHits_;
+}
+
+}
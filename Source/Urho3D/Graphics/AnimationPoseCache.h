@@ -0,0 +1,121 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "Urho3D/Core/Mutex.h"
+#include "Urho3D/Core/Object.h"
+#include "Urho3D/Graphics/AnimationState.h"
+
+#include <EASTL/fixed_vector.h>
+#include <EASTL/unordered_map.h>
+
+namespace Urho3D
+{
+
+class Model;
+
+/// Cache of skeleton poses shared between AnimatedModel-s playing identical animation states, e.g. in crowds.
+/// Pose is shared if models, animations, start bones, blend modes, weights and time buckets of enabled states match.
+/// Only poses that don't depend on the model instance are shared: the first enabled state should be LERP
+/// at full weight over the whole skeleton, and blending states should not touch channels left intact before them.
+/// Disabled by default. Cache is cleared at the end of each frame.
+class URHO3D_API AnimationPoseCache : public Object
+{
+    URHO3D_OBJECT(AnimationPoseCache, Object);
+
+public:
+    /// Max number of animation states that can be shared. Models with more states are always evaluated directly.
+    static constexpr unsigned MaxStates = 4;
+
+    explicit AnimationPoseCache(Context* context);
+    ~AnimationPoseCache() override;
+
+    /// Set whether the cache is enabled.
+    void SetEnabled(bool enabled) { enabled_ = enabled; }
+    /// Set time bucket size. States with times in the same bucket share the pose.
+    /// Zero means that times should match exactly, which doesn't affect animation quality.
+    void SetTimeStep(float timeStep) { timeStep_ = ea::max(timeStep, 0.0f); }
+    /// Apply animation states to model skeleton, reusing cached pose if possible. Safe to call from worker threads.
+    /// Bone LOD is used only as part of the key, bones should be already marked as skipped in the output.
+    void CalculateModelTracks(Model* model, const Skeleton& skeleton, const AnimationStateVector& states,
+        unsigned boneLod, ea::vector<ModelAnimationOutput>& output);
+    /// Remove all cached poses. Called automatically at the end of the frame.
+    void Reset();
+
+    /// Return whether the cache is enabled.
+    bool IsEnabled() const { return enabled_; }
+    /// Return time bucket size.
+    float GetTimeStep() const { return timeStep_; }
+    /// Return number of cached poses.
+    unsigned GetNumPoses() const;
+    /// Return total number of poses reused from cache.
+    unsigned GetNumHits() const;
+
+private:
+    struct StateKey
+    {
+        Animation* animation_{};
+        StringHash startBone_;
+        AnimationBlendMode blendMode_{};
+        bool looped_{};
+        float weight_{};
+        float time_{};
+
+        bool operator==(const StateKey& rhs) const;
+    };
+
+    struct PoseKey
+    {
+        Model* model_{};
+        unsigned boneLod_{};
+        ea::fixed_vector<StateKey, MaxStates, false> states_;
+
+        unsigned ToHash() const;
+        bool operator==(const PoseKey& rhs) const;
+    };
+
+    struct BonePose
+    {
+        AnimationChannelFlags dirty_;
+        Transform localToParent_;
+    };
+
+    using Pose = ea::vector<BonePose>;
+
+    /// Fill the key. Return false if the states cannot be cached.
+    bool MakeKey(Model* model, const Skeleton& skeleton, const AnimationStateVector& states, unsigned boneLod,
+        PoseKey& key) const;
+    /// Return whether the state completely replaces per-instance transforms of the bones it animates.
+    bool IsFullOverride(const AnimationState* state) const;
+    /// Return whether the state starts from the root bone.
+    bool CoversSkeleton(const Skeleton& skeleton, const AnimationState* state) const;
+
+    bool enabled_{};
+    float timeStep_{};
+
+    ea::unordered_map<PoseKey, Pose> poses_;
+    unsigned numHits_{};
+    mutable Mutex mutex_;
+};
+
+}
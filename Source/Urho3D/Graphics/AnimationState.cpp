@@ -237,13 +237,13 @@ void AnimationState::CalculateModelTracks(ea::vector<ModelAnimationOutput>& outp
 
     for (const ModelAnimationStateTrack& stateTrack : modelTracks_)
     {
-        // Do not apply if the bone has animation disabled
-        if (!stateTrack.bone_->animated_)
-            continue;
-
         URHO3D_ASSERT(output.size() > stateTrack.boneIndex_);
         ModelAnimationOutput& trackOutput = output[stateTrack.boneIndex_];
 
+        // Do not apply if the bone has animation disabled
+        if (!stateTrack.bone_->animated_ || trackOutput.skipped_)
+            continue;
+
         unsigned keyFrame = stateTrack.keyFrame_;
         CalculateTransformTrack(trackOutput, *stateTrack.track_, keyFrame, weight_);
         stateTrack.keyFrame_ = keyFrame;
@@ -85,6 +85,8 @@ struct ModelAnimationOutput : public NodeAnimationOutput
 {
     // Unused by AnimationState, but it's just convinient to have here.
     Matrix3x4 localToComponent_;
+    /// Whether the bone is excluded from animation, e.g. by bone LOD.
+    bool skipped_{};
 };
 
 /// Custom attribute type, used to support sub-attribute animation in special cases.
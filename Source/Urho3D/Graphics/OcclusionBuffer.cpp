@@ -28,6 +28,7 @@
 #include "../Graphics/Camera.h"
 #include "../Graphics/OcclusionBuffer.h"
 #include "../IO/Log.h"
+#include "../Math/BatchMath.h"
 
 #include "../DebugNew.h"
 
@@ -63,7 +64,7 @@ bool OcclusionBuffer::SetSize(int width, int height, bool threaded)
     if (height & 1u)
         ++height;
 
-    if (width == width_ && height == height_)
+    if (width == width_ && height == height_ && threaded == threaded_)
         return true;
 
     if (width <= 0 || height <= 0)
@@ -77,17 +78,21 @@ bool OcclusionBuffer::SetSize(int width, int height, bool threaded)
 
     width_ = width;
     height_ = height;
+    numTiles_ = (height + OCCLUSION_TILE_HEIGHT - 1) / OCCLUSION_TILE_HEIGHT;
 
-    // Build work buffers for threading
-    unsigned numThreadBuffers = threaded ? GetSubsystem<WorkQueue>()->GetNumProcessingThreads() : 1;
-    buffers_.resize(numThreadBuffers);
-    for (unsigned i = 0; i < numThreadBuffers; ++i)
+    // Reserve extra memory in case 3D clipping is not exact
+    buffer_.dataWithSafety_ = new int[width * (height + 2) + 2];
+    buffer_.data_ = buffer_.dataWithSafety_.get() + width + 1;
+
+    // Build triangle bins for threading. Each thread bins its triangles, then each tile is rasterized by one thread
+    threaded_ = threaded;
+    const unsigned numThreadBins = threaded ? GetSubsystem<WorkQueue>()->GetNumProcessingThreads() : 0;
+    triangleBins_.resize(numThreadBins);
+    for (TriangleBins& bins : triangleBins_)
     {
-        // Reserve extra memory in case 3D clipping is not exact
-        OcclusionBufferData& buffer = buffers_[i];
-        buffer.dataWithSafety_ = new int[width * (height + 2) + 2];
-        buffer.data_ = buffer.dataWithSafety_.get() + width + 1;
-        buffer.used_ = false;
+        bins.triangles_.clear();
+        bins.tiles_.clear();
+        bins.tiles_.resize(numTiles_);
     }
 
     mipBuffers_.clear();
@@ -105,7 +110,7 @@ bool OcclusionBuffer::SetSize(int width, int height, bool threaded)
     }
 
     URHO3D_LOGDEBUG("Set occlusion buffer size " + ea::to_string(width_) + "x" + ea::to_string(height_) + " with " +
-             ea::to_string(mipBuffers_.size()) + " mip levels and " + ea::to_string(numThreadBuffers) + " thread buffers");
+             ea::to_string(mipBuffers_.size()) + " mip levels and " + ea::to_string(numTiles_) + " tiles");
 
     CalculateViewport();
     return true;
@@ -151,12 +156,7 @@ void OcclusionBuffer::Reset()
 void OcclusionBuffer::Clear()
 {
     Reset();
-
-    // Only clear the main thread buffer. Rest are cleared on-demand when drawing the first batch
-    ClearBuffer(0);
-    for (unsigned i = 1; i < buffers_.size(); ++i)
-        buffers_[i].used_ = false;
-
+    ClearBuffer();
     depthHierarchyDirty_ = true;
 }
 
@@ -200,33 +200,48 @@ void OcclusionBuffer::DrawTriangles()
 {
     URHO3D_PROFILE("DrawOcclusionBatchWork");
 
-    if (buffers_.size() == 1)
+    if (!buffer_.data_)
+    {
+        batches_.clear();
+        return;
+    }
+
+    if (!threaded_)
     {
-        // Not threaded
         for (auto i = batches_.begin(); i != batches_.end(); ++i)
             DrawBatch(*i, 0);
-
-        depthHierarchyDirty_ = true;
     }
-    else if (buffers_.size() > 1)
+    else
     {
-        // Threaded
+        for (TriangleBins& bins : triangleBins_)
+        {
+            bins.triangles_.clear();
+            for (ea::vector<unsigned>& tile : bins.tiles_)
+                tile.clear();
+        }
+
+        // Transform, clip and bin triangles in worker threads
         auto* queue = GetSubsystem<WorkQueue>();
         ForEachParallel(queue, batches_, [this](unsigned, const OcclusionBatch& batch)
         {
             DrawBatch(batch, WorkQueue::GetThreadIndex());
         });
 
-        MergeBuffers();
-        depthHierarchyDirty_ = true;
+        // Rasterize tiles in worker threads. Tiles don't overlap, so no merge is needed
+        queue->ParallelFor(numTiles_, 1, [this](unsigned beginIndex, unsigned endIndex, unsigned)
+        {
+            for (unsigned tileIndex = beginIndex; tileIndex < endIndex; ++tileIndex)
+                DrawTile(tileIndex);
+        });
     }
 
+    depthHierarchyDirty_ = true;
     batches_.clear();
 }
 
 void OcclusionBuffer::BuildDepthHierarchy()
 {
-    if (buffers_.empty() || !depthHierarchyDirty_)
+    if (!buffer_.data_ || !depthHierarchyDirty_)
         return;
 
     URHO3D_PROFILE("BuildDepthHierarchy");
@@ -238,7 +253,7 @@ void OcclusionBuffer::BuildDepthHierarchy()
     {
         for (int y = 0; y < height; ++y)
         {
-            int* src = buffers_[0].data_ + (y * 2) * width_;
+            int* src = buffer_.data_ + (y * 2) * width_;
             DepthValue* dest = mipBuffers_[0].get() + y * width;
             DepthValue* end = dest + width;
 
@@ -328,9 +343,95 @@ void OcclusionBuffer::ResetUseTimer()
 
 bool OcclusionBuffer::IsVisible(const BoundingBox& worldSpaceBox) const
 {
-    if (buffers_.empty())
+    if (!buffer_.data_)
+        return true;
+
+    IntRect rect;
+    int depth{};
+    if (!CalculateScreenRect(worldSpaceBox, rect, depth))
         return true;
 
+    return IsRectVisible(rect, depth);
+}
+
+void OcclusionBuffer::IsVisible(const BoundingBox* worldSpaceBoxes, bool* result, unsigned count) const
+{
+    if (!buffer_.data_)
+    {
+        ea::fill_n(result, count, true);
+        return;
+    }
+
+    for (unsigned i = 0; i < count; ++i)
+    {
+        IntRect rect;
+        int depth{};
+        result[i] = !CalculateScreenRect(worldSpaceBoxes[i], rect, depth) || IsRectVisible(rect, depth);
+    }
+}
+
+bool OcclusionBuffer::CalculateScreenRect(const BoundingBox& worldSpaceBox, IntRect& rect, int& depth) const
+{
+    float minX, maxX, minY, maxY, minZ;
+
+#ifdef URHO3D_SSE
+    // Transform corners to projection space. Sum terms in the same order as ModelTransform
+    const Matrix4& m = viewProj_;
+    const __m128 column0 = _mm_setr_ps(m.m00_, m.m10_, m.m20_, m.m30_);
+    const __m128 column1 = _mm_setr_ps(m.m01_, m.m11_, m.m21_, m.m31_);
+    const __m128 column2 = _mm_setr_ps(m.m02_, m.m12_, m.m22_, m.m32_);
+    const __m128 column3 = _mm_setr_ps(m.m03_, m.m13_, m.m23_, m.m33_);
+    const __m128 xs[2] = {_mm_mul_ps(column0, _mm_set1_ps(worldSpaceBox.min_.x_)),
+        _mm_mul_ps(column0, _mm_set1_ps(worldSpaceBox.max_.x_))};
+    const __m128 ys[2] = {_mm_mul_ps(column1, _mm_set1_ps(worldSpaceBox.min_.y_)),
+        _mm_mul_ps(column1, _mm_set1_ps(worldSpaceBox.max_.y_))};
+    const __m128 zs[2] = {_mm_mul_ps(column2, _mm_set1_ps(worldSpaceBox.min_.z_)),
+        _mm_mul_ps(column2, _mm_set1_ps(worldSpaceBox.max_.z_))};
+
+    __m128 projectedMin = _mm_set1_ps(M_INFINITY);
+    __m128 projectedMax = _mm_set1_ps(-M_INFINITY);
+    for (unsigned z = 0; z < 2; ++z)
+    {
+        // Process 4 corners with the same Z at once
+        __m128 corner0 = _mm_add_ps(_mm_add_ps(_mm_add_ps(xs[0], ys[0]), zs[z]), column3);
+        __m128 corner1 = _mm_add_ps(_mm_add_ps(_mm_add_ps(xs[1], ys[0]), zs[z]), column3);
+        __m128 corner2 = _mm_add_ps(_mm_add_ps(_mm_add_ps(xs[0], ys[1]), zs[z]), column3);
+        __m128 corner3 = _mm_add_ps(_mm_add_ps(_mm_add_ps(xs[1], ys[1]), zs[z]), column3);
+        _MM_TRANSPOSE4_PS(corner0, corner1, corner2, corner3);
+
+        // Apply a far clip relative bias. If any of the corners cross the near plane, assume visible
+        const __m128 cornerZ = _mm_sub_ps(corner2, _mm_set1_ps(OCCLUSION_RELATIVE_BIAS));
+        if (_mm_movemask_ps(_mm_cmple_ps(cornerZ, _mm_setzero_ps())))
+            return false;
+
+        // Transform to screen space
+        const __m128 invW = _mm_div_ps(_mm_set1_ps(1.0f), corner3);
+        const __m128 projectedX = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(invW, corner0), _mm_set1_ps(scaleX_)), _mm_set1_ps(offsetX_));
+        const __m128 projectedY = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(invW, corner1), _mm_set1_ps(scaleY_)), _mm_set1_ps(offsetY_));
+        const __m128 projectedZ = _mm_mul_ps(_mm_mul_ps(invW, cornerZ), _mm_set1_ps(OCCLUSION_Z_SCALE));
+
+        // Reduce to min and max of X, Y and Z in lanes 0, 1 and 2
+        __m128 minXY = _mm_min_ps(_mm_unpacklo_ps(projectedX, projectedY), _mm_unpackhi_ps(projectedX, projectedY));
+        __m128 maxXY = _mm_max_ps(_mm_unpacklo_ps(projectedX, projectedY), _mm_unpackhi_ps(projectedX, projectedY));
+        minXY = _mm_min_ps(minXY, _mm_movehl_ps(minXY, minXY));
+        maxXY = _mm_max_ps(maxXY, _mm_movehl_ps(maxXY, maxXY));
+        __m128 minZ4 = _mm_min_ps(projectedZ, _mm_movehl_ps(projectedZ, projectedZ));
+        minZ4 = _mm_min_ss(minZ4, _mm_shuffle_ps(minZ4, minZ4, _MM_SHUFFLE(1, 1, 1, 1)));
+
+        projectedMin = _mm_min_ps(projectedMin, _mm_movelh_ps(minXY, minZ4));
+        projectedMax = _mm_max_ps(projectedMax, maxXY);
+    }
+
+    alignas(16) float minValues[4];
+    alignas(16) float maxValues[4];
+    _mm_store_ps(minValues, projectedMin);
+    _mm_store_ps(maxValues, projectedMax);
+    minX = minValues[0];
+    minY = minValues[1];
+    minZ = minValues[2];
+    maxX = maxValues[0];
+    maxY = maxValues[1];
+#else
     // Transform corners to projection space
     Vector4 vertices[8];
     vertices[0] = ModelTransform(viewProj_, worldSpaceBox.min_);
@@ -347,10 +448,8 @@ bool OcclusionBuffer::IsVisible(const BoundingBox& worldSpaceBox) const
         vertice.z_ -= OCCLUSION_RELATIVE_BIAS;
 
     // Transform to screen space. If any of the corners cross the near plane, assume visible
-    float minX, maxX, minY, maxY, minZ;
-
     if (vertices[0].z_ <= 0.0f)
-        return true;
+        return false;
 
     Vector3 projected = ViewportTransform(vertices[0]);
     minX = maxX = projected.x_;
@@ -361,7 +460,7 @@ bool OcclusionBuffer::IsVisible(const BoundingBox& worldSpaceBox) const
     for (unsigned i = 1; i < 8; ++i)
     {
         if (vertices[i].z_ <= 0.0f)
-            return true;
+            return false;
 
         projected = ViewportTransform(vertices[i]);
 
@@ -371,15 +470,16 @@ bool OcclusionBuffer::IsVisible(const BoundingBox& worldSpaceBox) const
         if (projected.y_ > maxY) maxY = projected.y_;
         if (projected.z_ < minZ) minZ = projected.z_;
     }
+#endif
 
     // Expand the bounding box 1 pixel in each direction to be conservative and correct rasterization offset
-    IntRect rect((int)(minX - 1.5f), (int)(minY - 1.5f), RoundToInt(maxX), RoundToInt(maxY));
+    rect = IntRect((int)(minX - 1.5f), (int)(minY - 1.5f), RoundToInt(maxX), RoundToInt(maxY));
 
     // If the rect is outside, let frustum culling handle
     if (rect.right_ < 0 || rect.bottom_ < 0)
-        return true;
+        return false;
     if (rect.left_ >= width_ || rect.top_ >= height_)
-        return true;
+        return false;
 
     // Clipping of rect
     if (rect.left_ < 0)
@@ -392,7 +492,13 @@ bool OcclusionBuffer::IsVisible(const BoundingBox& worldSpaceBox) const
         rect.bottom_ = height_ - 1;
 
     // Convert depth to integer and apply final bias
-    int z = RoundToInt(minZ) - OCCLUSION_FIXED_BIAS;
+    depth = RoundToInt(minZ) - OCCLUSION_FIXED_BIAS;
+    return true;
+}
+
+bool OcclusionBuffer::IsRectVisible(const IntRect& rect, int depth) const
+{
+    const int z = depth;
 
     if (!depthHierarchyDirty_)
     {
@@ -430,8 +536,8 @@ bool OcclusionBuffer::IsVisible(const BoundingBox& worldSpaceBox) const
     }
 
     // If no conclusive result, finally check the pixel-level data
-    int* row = buffers_[0].data_ + rect.top_ * width_;
-    int* endRow = buffers_[0].data_ + rect.bottom_ * width_;
+    int* row = buffer_.data_ + rect.top_ * width_;
+    int* endRow = buffer_.data_ + rect.bottom_ * width_;
     while (row <= endRow)
     {
         int* src = row + rect.left_;
@@ -456,13 +562,6 @@ unsigned OcclusionBuffer::GetUseTimer()
 
 void OcclusionBuffer::DrawBatch(const OcclusionBatch& batch, unsigned threadIndex)
 {
-    // If buffer not yet used, clear it
-    if (threadIndex > 0 && !buffers_[threadIndex].used_)
-    {
-        ClearBuffer(threadIndex);
-        buffers_[threadIndex].used_ = true;
-    }
-
     Matrix4 modelViewProj = viewProj_ * batch.model_;
 
     // Theoretical max. amount of vertices if each of the 6 clipping planes doubles the triangle count
@@ -626,7 +725,7 @@ void OcclusionBuffer::DrawTriangle(Vector4* vertices, unsigned threadIndex)
         bool clockwise = SignedArea(projected[0], projected[1], projected[2]) < 0.0f;
         if (cullMode_ == CULL_NONE || (cullMode_ == CULL_CCW && clockwise) || (cullMode_ == CULL_CW && !clockwise))
         {
-            DrawTriangle2D(projected, clockwise, threadIndex);
+            SubmitTriangle2D(projected, clockwise, threadIndex);
             drawOk = true;
         }
     }
@@ -664,7 +763,7 @@ void OcclusionBuffer::DrawTriangle(Vector4* vertices, unsigned threadIndex)
                 bool clockwise = SignedArea(projected[0], projected[1], projected[2]) < 0.0f;
                 if (cullMode_ == CULL_NONE || (cullMode_ == CULL_CCW && clockwise) || (cullMode_ == CULL_CW && !clockwise))
                 {
-                    DrawTriangle2D(projected, clockwise, threadIndex);
+                    SubmitTriangle2D(projected, clockwise, threadIndex);
                     drawOk = true;
                 }
             }
@@ -795,6 +894,13 @@ struct Edge
         invZStep_ = RoundToInt(slope * gradients.dInvZdX_ + gradients.dInvZdY_);
     }
 
+    /// Advance by given number of rows.
+    void Advance(int numRows)
+    {
+        x_ += xStep_ * numRows;
+        invZ_ += invZStep_ * numRows;
+    }
+
     /// X coordinate.
     int x_;
     /// X coordinate step.
@@ -805,7 +911,7 @@ struct Edge
     int invZStep_;
 };
 
-void OcclusionBuffer::DrawTriangle2D(const Vector3* vertices, bool clockwise, unsigned threadIndex)
+void OcclusionBuffer::DrawTriangle2D(const Vector3* vertices, bool clockwise, int minY, int maxY)
 {
     int top, middle, bottom;
     bool middleIsRight;
@@ -868,8 +974,8 @@ void OcclusionBuffer::DrawTriangle2D(const Vector3* vertices, bool clockwise, un
     auto middleY = (int)vertices[middle].y_;
     auto bottomY = (int)vertices[bottom].y_;
 
-    // Check for degenerate triangle
-    if (topY == bottomY)
+    // Check for degenerate triangle or triangle outside of drawn rows
+    if (topY == bottomY || bottomY <= minY || topY >= maxY)
         return;
 
     // Reverse middleIsRight test if triangle is counterclockwise
@@ -882,60 +988,20 @@ void OcclusionBuffer::DrawTriangle2D(const Vector3* vertices, bool clockwise, un
     Gradients gradients(vertices);
     Edge topToBottom(gradients, vertices[top], vertices[bottom], topY);
 
-    int* bufferData = buffers_[threadIndex].data_;
-
     if (middleIsRight)
     {
         // Top half
         if (!topDegenerate)
         {
             Edge topToMiddle(gradients, vertices[top], vertices[middle], topY);
-            int* row = bufferData + topY * width_;
-            int* endRow = bufferData + middleY * width_;
-            while (row < endRow)
-            {
-                int invZ = topToBottom.invZ_;
-                int* dest = row + (topToBottom.x_ >> 16u);
-                int* end = row + (topToMiddle.x_ >> 16u);
-                while (dest < end)
-                {
-                    if (invZ < *dest)
-                        *dest = invZ;
-                    invZ += gradients.dInvZdXInt_;
-                    ++dest;
-                }
-
-                topToBottom.x_ += topToBottom.xStep_;
-                topToBottom.invZ_ += topToBottom.invZStep_;
-                topToMiddle.x_ += topToMiddle.xStep_;
-                row += width_;
-            }
+            DrawTriangleRows(topY, middleY, minY, maxY, topToBottom, topToMiddle, gradients.dInvZdXInt_);
         }
 
         // Bottom half
         if (!bottomDegenerate)
         {
             Edge middleToBottom(gradients, vertices[middle], vertices[bottom], middleY);
-            int* row = bufferData + middleY * width_;
-            int* endRow = bufferData + bottomY * width_;
-            while (row < endRow)
-            {
-                int invZ = topToBottom.invZ_;
-                int* dest = row + (topToBottom.x_ >> 16u);
-                int* end = row + (middleToBottom.x_ >> 16u);
-                while (dest < end)
-                {
-                    if (invZ < *dest)
-                        *dest = invZ;
-                    invZ += gradients.dInvZdXInt_;
-                    ++dest;
-                }
-
-                topToBottom.x_ += topToBottom.xStep_;
-                topToBottom.invZ_ += topToBottom.invZStep_;
-                middleToBottom.x_ += middleToBottom.xStep_;
-                row += width_;
-            }
+            DrawTriangleRows(middleY, bottomY, minY, maxY, topToBottom, middleToBottom, gradients.dInvZdXInt_);
         }
     }
     else
@@ -944,86 +1010,92 @@ void OcclusionBuffer::DrawTriangle2D(const Vector3* vertices, bool clockwise, un
         if (!topDegenerate)
         {
             Edge topToMiddle(gradients, vertices[top], vertices[middle], topY);
-            int* row = bufferData + topY * width_;
-            int* endRow = bufferData + middleY * width_;
-            while (row < endRow)
-            {
-                int invZ = topToMiddle.invZ_;
-                int* dest = row + (topToMiddle.x_ >> 16u);
-                int* end = row + (topToBottom.x_ >> 16u);
-                while (dest < end)
-                {
-                    if (invZ < *dest)
-                        *dest = invZ;
-                    invZ += gradients.dInvZdXInt_;
-                    ++dest;
-                }
-
-                topToMiddle.x_ += topToMiddle.xStep_;
-                topToMiddle.invZ_ += topToMiddle.invZStep_;
-                topToBottom.x_ += topToBottom.xStep_;
-                row += width_;
-            }
+            DrawTriangleRows(topY, middleY, minY, maxY, topToMiddle, topToBottom, gradients.dInvZdXInt_);
         }
 
         // Bottom half
         if (!bottomDegenerate)
         {
             Edge middleToBottom(gradients, vertices[middle], vertices[bottom], middleY);
-            int* row = bufferData + middleY * width_;
-            int* endRow = bufferData + bottomY * width_;
-            while (row < endRow)
-            {
-                int invZ = middleToBottom.invZ_;
-                int* dest = row + (middleToBottom.x_ >> 16u);
-                int* end = row + (topToBottom.x_ >> 16u);
-                while (dest < end)
-                {
-                    if (invZ < *dest)
-                        *dest = invZ;
-                    invZ += gradients.dInvZdXInt_;
-                    ++dest;
-                }
-
-                middleToBottom.x_ += middleToBottom.xStep_;
-                middleToBottom.invZ_ += middleToBottom.invZStep_;
-                topToBottom.x_ += topToBottom.xStep_;
-                row += width_;
-            }
+            DrawTriangleRows(middleY, bottomY, minY, maxY, middleToBottom, topToBottom, gradients.dInvZdXInt_);
         }
     }
 }
 
-void OcclusionBuffer::MergeBuffers()
+void OcclusionBuffer::DrawTriangleRows(int startY, int endY, int minY, int maxY, Edge& left, Edge& right, int dInvZdX)
 {
-    URHO3D_PROFILE("MergeBuffers");
+    // Skip rows outside of drawn range, but keep edges in sync with the rows
+    const int firstY = Clamp(minY, startY, endY);
+    const int lastY = Clamp(maxY, firstY, endY);
+    left.Advance(firstY - startY);
+    right.Advance(firstY - startY);
+
+    int* row = buffer_.data_ + firstY * width_;
+    for (int y = firstY; y < lastY; ++y)
+    {
+        // Clip spans horizontally so that tiles never write outside of their rows
+        const int leftX = left.x_ >> 16;
+        const int beginX = Max(leftX, 0);
+        const int endX = Min(right.x_ >> 16, width_);
+        if (beginX < endX)
+            MinLinearSpan(row + beginX, endX - beginX, left.invZ_ + (beginX - leftX) * dInvZdX, dInvZdX);
+
+        left.Advance(1);
+        right.Advance(1);
+        row += width_;
+    }
+
+    left.Advance(endY - lastY);
+    right.Advance(endY - lastY);
+}
 
-    for (unsigned i = 1; i < buffers_.size(); ++i)
+void OcclusionBuffer::SubmitTriangle2D(const Vector3* vertices, bool clockwise, unsigned threadIndex)
+{
+    if (!threaded_)
     {
-        if (!buffers_[i].used_)
-            continue;
+        DrawTriangle2D(vertices, clockwise, 0, height_);
+        return;
+    }
+
+    // Bin the triangle by rows it covers, same as DrawTriangle2D
+    const auto topY = (int)Min(vertices[0].y_, Min(vertices[1].y_, vertices[2].y_));
+    const auto bottomY = (int)Max(vertices[0].y_, Max(vertices[1].y_, vertices[2].y_));
+    if (topY == bottomY || bottomY <= 0 || topY >= height_)
+        return;
 
-        int* src = buffers_[i].data_;
-        int* dest = buffers_[0].data_;
-        int count = width_ * height_;
+    TriangleBins& bins = triangleBins_[threadIndex];
+    const unsigned triangleIndex = bins.triangles_.size();
+    Triangle& triangle = bins.triangles_.emplace_back();
+    ea::copy_n(vertices, 3, triangle.vertices_);
+    triangle.clockwise_ = clockwise;
 
-        while (count--)
+    const int firstTile = Max(topY, 0) / OCCLUSION_TILE_HEIGHT;
+    const int lastTile = (Min(bottomY, height_) - 1) / OCCLUSION_TILE_HEIGHT;
+    for (int tileIndex = firstTile; tileIndex <= lastTile; ++tileIndex)
+        bins.tiles_[tileIndex].push_back(triangleIndex);
+}
+
+void OcclusionBuffer::DrawTile(unsigned tileIndex)
+{
+    const int minY = tileIndex * OCCLUSION_TILE_HEIGHT;
+    const int maxY = Min(minY + OCCLUSION_TILE_HEIGHT, height_);
+
+    for (const TriangleBins& bins : triangleBins_)
+    {
+        for (unsigned triangleIndex : bins.tiles_[tileIndex])
         {
-            // If thread buffer's depth value is closer, overwrite the original
-            if (*src < *dest)
-                *dest = *src;
-            ++src;
-            ++dest;
+            const Triangle& triangle = bins.triangles_[triangleIndex];
+            DrawTriangle2D(triangle.vertices_, triangle.clockwise_, minY, maxY);
         }
     }
 }
 
-void OcclusionBuffer::ClearBuffer(unsigned threadIndex)
+void OcclusionBuffer::ClearBuffer()
 {
-    if (threadIndex >= buffers_.size())
+    if (!buffer_.data_)
         return;
 
-    int* dest = buffers_[threadIndex].data_;
+    int* dest = buffer_.data_;
     int count = width_ * height_;
     auto fillValue = (int)OCCLUSION_Z_SCALE;
 
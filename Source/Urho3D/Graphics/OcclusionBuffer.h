@@ -30,6 +30,7 @@
 #include "../Core/Timer.h"
 #include "../Graphics/GraphicsDefs.h"
 #include "../Math/Frustum.h"
+#include "../Math/Rect.h"
 
 namespace Urho3D
 {
@@ -37,7 +38,6 @@ namespace Urho3D
 class BoundingBox;
 class Camera;
 class IndexBuffer;
-class IntRect;
 class VertexBuffer;
 struct Edge;
 struct Gradients;
@@ -51,15 +51,13 @@ struct DepthValue
     int max_;
 };
 
-/// Per-thread occlusion buffer data.
+/// Occlusion buffer data.
 struct OcclusionBufferData
 {
     /// Full buffer data with safety padding.
     ea::shared_array<int> dataWithSafety_;
     /// Buffer data.
-    int* data_;
-    /// Use flag.
-    bool used_;
+    int* data_{};
 };
 
 /// Stored occlusion render job.
@@ -87,6 +85,7 @@ static const float OCCLUSION_RELATIVE_BIAS = 0.00001f;
 static const int OCCLUSION_FIXED_BIAS = 16;
 static const float OCCLUSION_X_SCALE = 65536.0f;
 static const float OCCLUSION_Z_SCALE = 16777216.0f;
+static const int OCCLUSION_TILE_HEIGHT = 16;
 
 /// Software renderer for occlusion.
 class URHO3D_API OcclusionBuffer : public Object
@@ -102,7 +101,7 @@ public:
     /// Register object with the engine.
     static void RegisterObject(Context* context);
 
-    /// Set occlusion buffer size and whether to reserve multiple buffers for threading optimization.
+    /// Set occlusion buffer size and whether to rasterize tiles in worker threads.
     bool SetSize(int width, int height, bool threaded);
     /// Set camera view to render from.
     void SetView(Camera* camera);
@@ -127,7 +126,7 @@ public:
     void ResetUseTimer();
 
     /// Return highest level depth values.
-    int* GetBuffer() const { return buffers_.size() ? buffers_[0].data_ : nullptr; }
+    int* GetBuffer() const { return buffer_.data_; }
 
     /// Return view transform matrix.
     const Matrix3x4& GetView() const { return view_; }
@@ -151,10 +150,12 @@ public:
     CullMode GetCullMode() const { return cullMode_; }
 
     /// Return whether is using threads to speed up rendering.
-    bool IsThreaded() const { return buffers_.size() > 1; }
+    bool IsThreaded() const { return threaded_; }
 
     /// Test a bounding box for visibility. For best performance, build depth hierarchy first.
     bool IsVisible(const BoundingBox& worldSpaceBox) const;
+    /// Test bounding boxes for visibility. Result is the same as of IsVisible for each box.
+    void IsVisible(const BoundingBox* worldSpaceBoxes, bool* result, unsigned count) const;
     /// Return time since last use in milliseconds.
     unsigned GetUseTimer();
 
@@ -162,6 +163,24 @@ public:
     void DrawBatch(const OcclusionBatch& batch, unsigned threadIndex);
 
 private:
+    /// Triangle in viewport space waiting for rasterization.
+    struct Triangle
+    {
+        /// Vertices.
+        Vector3 vertices_[3];
+        /// Whether the triangle is clockwise.
+        bool clockwise_{};
+    };
+
+    /// Triangles submitted from one thread, binned by tiles.
+    struct TriangleBins
+    {
+        /// Triangles.
+        ea::vector<Triangle> triangles_;
+        /// Indices of triangles overlapping each tile.
+        ea::vector<ea::vector<unsigned>> tiles_;
+    };
+
     /// Apply modelview transform to vertex.
     inline Vector4 ModelTransform(const Matrix4& transform, const Vector3& vertex) const;
     /// Apply projection and viewport transform to vertex.
@@ -176,15 +195,25 @@ private:
     void DrawTriangle(Vector4* vertices, unsigned threadIndex);
     /// Clip vertices against a plane.
     void ClipVertices(const Vector4& plane, Vector4* vertices, bool* triangles, unsigned& numTriangles);
-    /// Draw a clipped triangle.
-    void DrawTriangle2D(const Vector3* vertices, bool clockwise, unsigned threadIndex);
-    /// Clear a thread work buffer.
-    void ClearBuffer(unsigned threadIndex);
-    /// Merge thread work buffers into the first buffer.
-    void MergeBuffers();
-
-    /// Highest-level buffer data per thread.
-    ea::vector<OcclusionBufferData> buffers_;
+    /// Draw a clipped triangle or store it for tiled rasterization.
+    void SubmitTriangle2D(const Vector3* vertices, bool clockwise, unsigned threadIndex);
+    /// Draw rows [minY, maxY) of a clipped triangle.
+    void DrawTriangle2D(const Vector3* vertices, bool clockwise, int minY, int maxY);
+    /// Draw rows [startY, endY) of a triangle half clipped to rows [minY, maxY). Edges are advanced to endY.
+    void DrawTriangleRows(int startY, int endY, int minY, int maxY, Edge& left, Edge& right, int dInvZdX);
+    /// Draw all binned triangles overlapping the tile.
+    void DrawTile(unsigned tileIndex);
+    /// Calculate conservative screen rectangle and depth of a box. Return false if the box should be considered visible.
+    bool CalculateScreenRect(const BoundingBox& worldSpaceBox, IntRect& rect, int& depth) const;
+    /// Test screen rectangle against depth buffer and depth hierarchy.
+    bool IsRectVisible(const IntRect& rect, int depth) const;
+    /// Clear the buffer.
+    void ClearBuffer();
+
+    /// Highest-level buffer data.
+    OcclusionBufferData buffer_;
+    /// Triangles submitted from each thread when rasterizing in threads.
+    ea::vector<TriangleBins> triangleBins_;
     /// Reduced size depth buffers.
     ea::vector<ea::shared_array<DepthValue> > mipBuffers_;
     /// Submitted render jobs.
@@ -193,6 +222,10 @@ private:
     int width_{};
     /// Buffer height.
     int height_{};
+    /// Number of tiles.
+    unsigned numTiles_{};
+    /// Whether to rasterize tiles in worker threads.
+    bool threaded_{};
     /// Number of rendered triangles.
     unsigned numTriangles_{};
     /// Maximum number of triangles.
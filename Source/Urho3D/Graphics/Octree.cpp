@@ -49,17 +49,77 @@ namespace Urho3D
 
 static const float DEFAULT_OCTREE_SIZE = 1000.0f;
 static const int DEFAULT_OCTREE_LEVELS = 8;
+static const unsigned INITIAL_OCTANT_POOL_SIZE = 64;
 
 inline bool CompareRayQueryResults(const RayQueryResult& lhs, const RayQueryResult& rhs)
 {
     return lhs.distance_ < rhs.distance_;
 }
 
+static BoundingBox GetChildOctantBox(const BoundingBox& box, unsigned index)
+{
+    Vector3 newMin = box.min_;
+    Vector3 newMax = box.max_;
+    Vector3 oldCenter = box.Center();
+
+    if (index & 1u)
+        newMin.x_ = oldCenter.x_;
+    else
+        newMax.x_ = oldCenter.x_;
+
+    if (index & 2u)
+        newMin.y_ = oldCenter.y_;
+    else
+        newMax.y_ = oldCenter.y_;
+
+    if (index & 4u)
+        newMin.z_ = oldCenter.z_;
+    else
+        newMax.z_ = oldCenter.z_;
+
+    return BoundingBox(newMin, newMax);
+}
+
+static unsigned GetChildOctantIndex(const Vector3& octantCenter, const BoundingBox& box)
+{
+    Vector3 boxCenter = box.Center();
+    unsigned x = boxCenter.x_ < octantCenter.x_ ? 0 : 1;
+    unsigned y = boxCenter.y_ < octantCenter.y_ ? 0 : 2;
+    unsigned z = boxCenter.z_ < octantCenter.z_ ? 0 : 4;
+    return x + y + z;
+}
+
+static bool CheckDrawableFitInOctant(const BoundingBox& box, const BoundingBox& octantBox, const Vector3& octantHalfSize,
+    unsigned level, unsigned numLevels)
+{
+    Vector3 boxSize = box.Size();
+
+    // If max split level, size always OK, otherwise check that box is at least half size of octant
+    if (level >= numLevels || boxSize.x_ >= octantHalfSize.x_ || boxSize.y_ >= octantHalfSize.y_ ||
+        boxSize.z_ >= octantHalfSize.z_)
+        return true;
+    // Also check if the box can not fit a child octant's culling box, in that case size OK (must insert here)
+    else
+    {
+        if (box.min_.x_ <= octantBox.min_.x_ - 0.5f * octantHalfSize.x_ ||
+            box.max_.x_ >= octantBox.max_.x_ + 0.5f * octantHalfSize.x_ ||
+            box.min_.y_ <= octantBox.min_.y_ - 0.5f * octantHalfSize.y_ ||
+            box.max_.y_ >= octantBox.max_.y_ + 0.5f * octantHalfSize.y_ ||
+            box.min_.z_ <= octantBox.min_.z_ - 0.5f * octantHalfSize.z_ ||
+            box.max_.z_ >= octantBox.max_.z_ + 0.5f * octantHalfSize.z_)
+            return true;
+    }
+
+    // Bounding box too small, should create a child octant
+    return false;
+}
+
 Octant::Octant(const BoundingBox& box, unsigned level, Octant* parent, Octree* octree, unsigned index) :
     level_(level),
     parent_(parent),
     octree_(octree),
-    index_(index)
+    index_(index),
+    allocator_(parent ? parent->allocator_ : &octree->octantAllocator_)
 {
     Initialize(box);
 }
@@ -90,34 +150,18 @@ Octant* Octant::GetOrCreateChild(unsigned index)
     if (children_[index])
         return children_[index];
 
-    Vector3 newMin = worldBoundingBox_.min_;
-    Vector3 newMax = worldBoundingBox_.max_;
-    Vector3 oldCenter = worldBoundingBox_.Center();
-
-    if (index & 1u)
-        newMin.x_ = oldCenter.x_;
-    else
-        newMax.x_ = oldCenter.x_;
-
-    if (index & 2u)
-        newMin.y_ = oldCenter.y_;
-    else
-        newMax.y_ = oldCenter.y_;
-
-    if (index & 4u)
-        newMin.z_ = oldCenter.z_;
-    else
-        newMax.z_ = oldCenter.z_;
-
-    children_[index] = new Octant(BoundingBox(newMin, newMax), level_ + 1, this, octree_, index);
+    children_[index] = allocator_->Reserve(GetChildOctantBox(worldBoundingBox_, index), level_ + 1, this, octree_, index);
     return children_[index];
 }
 
 void Octant::DeleteChild(unsigned index)
 {
     assert(index < NUM_OCTANTS);
-    delete children_[index];
-    children_[index] = nullptr;
+    if (children_[index])
+    {
+        allocator_->Free(children_[index]);
+        children_[index] = nullptr;
+    }
 }
 
 void Octant::InsertDrawable(Drawable* drawable)
@@ -133,49 +177,14 @@ void Octant::InsertDrawable(Drawable* drawable)
         insertHere = CheckDrawableFit(box);
 
     if (insertHere)
-    {
-        Octant* oldOctant = drawable->octant_;
-        if (oldOctant != this)
-        {
-            // Add first, then remove, because drawable count going to zero deletes the octree branch in question
-            AddDrawable(drawable);
-            if (oldOctant)
-                oldOctant->RemoveDrawable(drawable, false);
-        }
-    }
+        MoveDrawable(drawable);
     else
-    {
-        Vector3 boxCenter = box.Center();
-        unsigned x = boxCenter.x_ < center_.x_ ? 0 : 1;
-        unsigned y = boxCenter.y_ < center_.y_ ? 0 : 2;
-        unsigned z = boxCenter.z_ < center_.z_ ? 0 : 4;
-
-        GetOrCreateChild(x + y + z)->InsertDrawable(drawable);
-    }
+        GetOrCreateChild(GetChildOctantIndex(center_, box))->InsertDrawable(drawable);
 }
 
 bool Octant::CheckDrawableFit(const BoundingBox& box) const
 {
-    Vector3 boxSize = box.Size();
-
-    // If max split level, size always OK, otherwise check that box is at least half size of octant
-    if (level_ >= octree_->GetNumLevels() || boxSize.x_ >= halfSize_.x_ || boxSize.y_ >= halfSize_.y_ ||
-        boxSize.z_ >= halfSize_.z_)
-        return true;
-    // Also check if the box can not fit a child octant's culling box, in that case size OK (must insert here)
-    else
-    {
-        if (box.min_.x_ <= worldBoundingBox_.min_.x_ - 0.5f * halfSize_.x_ ||
-            box.max_.x_ >= worldBoundingBox_.max_.x_ + 0.5f * halfSize_.x_ ||
-            box.min_.y_ <= worldBoundingBox_.min_.y_ - 0.5f * halfSize_.y_ ||
-            box.max_.y_ >= worldBoundingBox_.max_.y_ + 0.5f * halfSize_.y_ ||
-            box.min_.z_ <= worldBoundingBox_.min_.z_ - 0.5f * halfSize_.z_ ||
-            box.max_.z_ >= worldBoundingBox_.max_.z_ + 0.5f * halfSize_.z_)
-            return true;
-    }
-
-    // Bounding box too small, should create a child octant
-    return false;
+    return CheckDrawableFitInOctant(box, worldBoundingBox_, halfSize_, level_, octree_->GetNumLevels());
 }
 
 void Octant::SetRootSize(const BoundingBox& box)
@@ -404,6 +413,7 @@ Zone* ZoneLookupIndex::GetBackgroundZone() const
 
 Octree::Octree(Context* context) :
     Component(context),
+    octantAllocator_(INITIAL_OCTANT_POOL_SIZE),
     rootOctant_(BoundingBox(-DEFAULT_OCTREE_SIZE, DEFAULT_OCTREE_SIZE), 0, nullptr, this),
     numLevels_(DEFAULT_OCTREE_LEVELS),
     worldBoundingBox_(rootOctant_.GetWorldBoundingBox()),
@@ -450,7 +460,7 @@ void Octree::SetSize(const BoundingBox& box, unsigned numLevels)
 
     worldBoundingBox_ = box;
     rootOctant_.SetRootSize(box);
-    numLevels_ = Max(numLevels, 1U);
+    numLevels_ = Clamp(numLevels, 1U, MAX_OCTREE_LEVELS);
 }
 
 void Octree::Update(const FrameInfo& frame)
@@ -527,25 +537,32 @@ void Octree::Update(const FrameInfo& frame)
     {
         URHO3D_PROFILE("ReinsertToOctree");
 
-        for (auto i = drawableUpdates_.begin(); i != drawableUpdates_.end(); ++i)
+        // Find new octants in worker threads without touching the hierarchy, then move drawables from main thread
+        const unsigned numUpdates = drawableUpdates_.size();
+        reinsertionPaths_.resize(numUpdates);
+
+        auto* queue = GetSubsystem<WorkQueue>();
+        queue->ParallelFor(numUpdates, MinDrawablesPerTask, [this](unsigned begin, unsigned end, unsigned)
         {
-            Drawable* drawable = *i;
+            for (unsigned i = begin; i < end; ++i)
+                reinsertionPaths_[i] = CalculateReinsertionPath(drawableUpdates_[i]);
+        });
+
+        for (unsigned i = 0; i < numUpdates; ++i)
+        {
+            Drawable* drawable = drawableUpdates_[i];
             drawable->updateQueued_ = false;
-            Octant* octant = drawable->GetOctant();
-            const BoundingBox& box = drawable->GetWorldBoundingBox();
 
-            // Skip if no octant or does not belong to this octree anymore
-            if (!octant || octant->GetOctree() != this)
-                continue;
-            // Skip if still fits the current octant
-            if (drawable->IsOccludee() && octant->GetCullingBox().IsInside(box) == INSIDE && octant->CheckDrawableFit(box))
+            const OctantPath& path = reinsertionPaths_[i];
+            if (!path.reinsert_)
                 continue;
 
-            rootOctant_.InsertDrawable(drawable);
+            Octant* octant = GetOrCreateOctant(path);
+            octant->MoveDrawable(drawable);
 
 #ifdef _DEBUG
             // Verify that the drawable will be culled correctly
-            octant = drawable->GetOctant();
+            const BoundingBox& box = drawable->GetWorldBoundingBox();
             if (octant != GetRootOctant() && octant->GetCullingBox().IsInside(box) != INSIDE)
             {
                 URHO3D_LOGERROR("Drawable is not fully inside its octant's culling bounds: drawable box " + box.ToString() +
@@ -568,6 +585,51 @@ void Octree::Update(const FrameInfo& frame)
     }
 }
 
+Octree::OctantPath Octree::CalculateReinsertionPath(Drawable* drawable) const
+{
+    OctantPath path;
+
+    // Skip if no octant or does not belong to this octree anymore
+    const Octant* octant = drawable->GetOctant();
+    if (!octant || octant->GetOctree() != this)
+        return path;
+
+    // Skip if still fits the current octant
+    const BoundingBox& box = drawable->GetWorldBoundingBox();
+    if (drawable->IsOccludee() && octant->GetCullingBox().IsInside(box) == INSIDE && octant->CheckDrawableFit(box))
+        return path;
+
+    path.reinsert_ = true;
+
+    // Insert all non-occludees and drawables outside the root octant bounds to root, same as Octant::InsertDrawable
+    if (!drawable->IsOccludee() || rootOctant_.GetCullingBox().IsInside(box) != INSIDE || rootOctant_.CheckDrawableFit(box))
+        return path;
+
+    // Descend without creating octants. Child boxes are calculated exactly as in Octant::GetOrCreateChild
+    BoundingBox octantBox = rootOctant_.GetWorldBoundingBox();
+    Vector3 octantCenter = octantBox.Center();
+    while (true)
+    {
+        const unsigned childIndex = GetChildOctantIndex(octantCenter, box);
+        octantBox = GetChildOctantBox(octantBox, childIndex);
+        octantCenter = octantBox.Center();
+        path.childIndices_ = (path.childIndices_ << 3u) | childIndex;
+        ++path.numLevels_;
+
+        const Vector3 octantHalfSize = 0.5f * octantBox.Size();
+        if (CheckDrawableFitInOctant(box, octantBox, octantHalfSize, path.numLevels_, numLevels_))
+            return path;
+    }
+}
+
+Octant* Octree::GetOrCreateOctant(const OctantPath& path)
+{
+    Octant* octant = &rootOctant_;
+    for (unsigned level = path.numLevels_; level > 0; --level)
+        octant = octant->GetOrCreateChild((path.childIndices_ >> (3u * (level - 1))) & 7u);
+    return octant;
+}
+
 void Octree::AddManualDrawable(Drawable* drawable)
 {
     if (!drawable || drawable->GetOctant())
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include "../Container/Allocator.h"
 #include "../Container/MultiVector.h"
 #include "../Core/Mutex.h"
 #include "../Core/WorkQueue.h"
@@ -37,6 +38,8 @@ class Zone;
 
 static const int NUM_OCTANTS = 8;
 static const unsigned ROOT_INDEX = M_MAX_UNSIGNED;
+/// Maximum number of octree subdivision levels.
+static const unsigned MAX_OCTREE_LEVELS = 21;
 
 /// %Octree octant.
 /// @nobind
@@ -56,6 +59,18 @@ public:
     void InsertDrawable(Drawable* drawable);
     /// Check if a drawable object fits.
     bool CheckDrawableFit(const BoundingBox& box) const;
+    /// Move a drawable object to this octant from its current octant, if any.
+    void MoveDrawable(Drawable* drawable)
+    {
+        Octant* oldOctant = drawable->octant_;
+        if (oldOctant != this)
+        {
+            // Add first, then remove, because drawable count going to zero deletes the octree branch in question
+            AddDrawable(drawable);
+            if (oldOctant)
+                oldOctant->RemoveDrawable(drawable, false);
+        }
+    }
 
     /// Add a drawable object to this octant.
     void AddDrawable(Drawable* drawable)
@@ -165,6 +180,8 @@ protected:
     Octree* octree_{};
     /// Octant index relative to its siblings or ROOT_INDEX for root octant.
     unsigned index_{};
+    /// Pool allocator for child octants, owned by octree.
+    Allocator<Octant>* allocator_{};
 };
 
 /// Acceleration structure for zone search.
@@ -215,7 +232,12 @@ class URHO3D_API Octree : public Component
 {
     URHO3D_OBJECT(Octree, Component);
 
+    friend class Octant;
+
 public:
+    /// Minimum number of reinserted drawables processed by one worker thread.
+    static const unsigned MinDrawablesPerTask = 128;
+
     /// Construct.
     explicit Octree(Context* context);
     /// Destruct.
@@ -286,10 +308,29 @@ private:
     /// Update octree size.
     void UpdateOctreeSize() { SetSize(worldBoundingBox_, numLevels_); }
 
+    /// Location of octant in the hierarchy, stored as child indices for each level starting from the root.
+    struct OctantPath
+    {
+        /// Index of each child octant, 3 bits per level. The first level is stored in the highest bits.
+        unsigned long long childIndices_{};
+        /// Number of levels below the root.
+        unsigned numLevels_{};
+        /// Whether the drawable should be reinserted.
+        bool reinsert_{};
+    };
+    /// Calculate new octant for the drawable without modifying the hierarchy. Safe to call from worker threads.
+    OctantPath CalculateReinsertionPath(Drawable* drawable) const;
+    /// Return octant at given path, create if missing.
+    Octant* GetOrCreateOctant(const OctantPath& path);
+
+    /// Pool allocator for octants. Should be destroyed after root octant.
+    Allocator<Octant> octantAllocator_;
     /// Root octant.
     Octant rootOctant_;
     /// Drawable objects that require update.
     ea::vector<Drawable*> drawableUpdates_;
+    /// New octants of the drawables that require update.
+    ea::vector<OctantPath> reinsertionPaths_;
     /// Drawable objects that were inserted during threaded update phase.
     ea::vector<Drawable*> threadedDrawableUpdates_;
     /// Node transforms to be applied before reinsertion.
@@ -23,6 +23,7 @@
 #include "../Precompiled.h"
 
 #include "../Graphics/OctreeQuery.h"
+#include "../Math/BatchMath.h"
 
 #include "../DebugNew.h"
 
@@ -105,14 +106,36 @@ Intersection FrustumOctreeQuery::TestOctant(const BoundingBox& box, bool inside)
 
 void FrustumOctreeQuery::TestDrawables(Drawable** start, Drawable** end, bool inside)
 {
+    // Test bounding boxes in batches
+    static constexpr unsigned BatchSize = 32;
+    Drawable* candidates[BatchSize];
+    BoundingBox boundingBoxes[BatchSize];
+    bool isVisible[BatchSize];
+
     while (start != end)
     {
-        Drawable* drawable = *start++;
+        unsigned numCandidates = 0;
+        while (start != end && numCandidates < BatchSize)
+        {
+            Drawable* drawable = *start++;
+            if ((drawable->GetDrawableFlags() & drawableFlags_) && (drawable->GetViewMask() & viewMask_))
+            {
+                if (inside)
+                    result_.push_back(drawable);
+                else
+                {
+                    candidates[numCandidates] = drawable;
+                    boundingBoxes[numCandidates] = drawable->GetWorldBoundingBox();
+                    ++numCandidates;
+                }
+            }
+        }
 
-        if ((drawable->GetDrawableFlags() & drawableFlags_) && (drawable->GetViewMask() & viewMask_))
+        TestBoundingBoxes(frustum_, boundingBoxes, isVisible, numCandidates);
+        for (unsigned i = 0; i < numCandidates; ++i)
         {
-            if (inside || frustum_.IsInsideFast(drawable->GetWorldBoundingBox()))
-                result_.push_back(drawable);
+            if (isVisible[i])
+                result_.push_back(candidates[i]);
         }
     }
 }
@@ -23,6 +23,8 @@
 #include "../Precompiled.h"
 
 #include "../Core/Context.h"
+#include "../Core/FrameArena.h"
+#include "../Core/WorkQueue.h"
 #include "../IO/Log.h"
 #include "../Graphics/Geometry.h"
 #include "../Graphics/IndexBuffer.h"
@@ -31,6 +33,10 @@
 
 #include <EASTL/sort.h>
 
+#ifdef URHO3D_SSE
+#include <emmintrin.h>
+#endif
+
 #include "../DebugNew.h"
 
 namespace Urho3D
@@ -48,6 +54,137 @@ Vector3 TransformNormal(const Matrix3x4& m, const Vector3& v)
     };
 }
 
+#ifdef URHO3D_SSE
+/// Skin matrices are stored transposed, so that each row is a column of original matrix.
+/// This way vertices are transformed without horizontal operations.
+using SkinMatrix = Matrix4;
+
+void StoreVector3(float* dest, __m128 value)
+{
+    _mm_storel_pi(reinterpret_cast<__m64*>(dest), value);
+    _mm_store_ss(dest + 2, _mm_movehl_ps(value, value));
+}
+
+template <bool SkinNormals, bool SkinTangents>
+void SkinVertices(VertexBuffer* clonedBuffer, const VertexBufferAnimationData& animationData,
+    const SkinMatrix* skinMatrices, unsigned numBones, unsigned beginVertex, unsigned endVertex)
+{
+    const unsigned clonedVertexSize = clonedBuffer->GetVertexSize();
+    const unsigned normalOffset = clonedBuffer->GetElementOffset(TYPE_VECTOR3, SEM_NORMAL);
+    const unsigned tangentOffset = clonedBuffer->GetElementOffset(TYPE_VECTOR4, SEM_TANGENT);
+
+    unsigned char* vertexData = clonedBuffer->GetShadowData() + beginVertex * clonedVertexSize;
+    const unsigned char* indicesData = animationData.blendIndices_.data() + beginVertex * numBones;
+    const float* weightsData = animationData.blendWeights_.data() + beginVertex * numBones;
+
+    for (unsigned vertexIndex = beginVertex; vertexIndex < endVertex; ++vertexIndex)
+    {
+        // Blend matrix columns
+        const SkinMatrix& firstMatrix = skinMatrices[indicesData[0]];
+        const __m128 firstWeight = _mm_set1_ps(weightsData[0]);
+        __m128 column0 = _mm_mul_ps(_mm_loadu_ps(&firstMatrix.m00_), firstWeight);
+        __m128 column1 = _mm_mul_ps(_mm_loadu_ps(&firstMatrix.m10_), firstWeight);
+        __m128 column2 = _mm_mul_ps(_mm_loadu_ps(&firstMatrix.m20_), firstWeight);
+        __m128 column3 = _mm_mul_ps(_mm_loadu_ps(&firstMatrix.m30_), firstWeight);
+        for (unsigned boneIndex = 1; boneIndex < numBones; ++boneIndex)
+        {
+            const SkinMatrix& matrix = skinMatrices[indicesData[boneIndex]];
+            const __m128 weight = _mm_set1_ps(weightsData[boneIndex]);
+            column0 = _mm_add_ps(column0, _mm_mul_ps(_mm_loadu_ps(&matrix.m00_), weight));
+            column1 = _mm_add_ps(column1, _mm_mul_ps(_mm_loadu_ps(&matrix.m10_), weight));
+            column2 = _mm_add_ps(column2, _mm_mul_ps(_mm_loadu_ps(&matrix.m20_), weight));
+            column3 = _mm_add_ps(column3, _mm_mul_ps(_mm_loadu_ps(&matrix.m30_), weight));
+        }
+
+        const auto transformDirection = [&](float* data)
+        {
+            const __m128 x = _mm_mul_ps(column0, _mm_set1_ps(data[0]));
+            const __m128 y = _mm_mul_ps(column1, _mm_set1_ps(data[1]));
+            const __m128 z = _mm_mul_ps(column2, _mm_set1_ps(data[2]));
+            return _mm_add_ps(_mm_add_ps(x, y), z);
+        };
+
+        auto position = reinterpret_cast<float*>(vertexData);
+        StoreVector3(position, _mm_add_ps(transformDirection(position), column3));
+
+        if constexpr (SkinNormals)
+        {
+            auto normal = reinterpret_cast<float*>(vertexData + normalOffset);
+            StoreVector3(normal, transformDirection(normal));
+        }
+
+        if constexpr (SkinTangents)
+        {
+            auto tangent = reinterpret_cast<float*>(vertexData + tangentOffset);
+            StoreVector3(tangent, transformDirection(tangent));
+        }
+
+        // Advance
+        indicesData += numBones;
+        weightsData += numBones;
+        vertexData += clonedVertexSize;
+    }
+}
+#else
+using SkinMatrix = Matrix3x4;
+
+template <bool SkinNormals, bool SkinTangents>
+void SkinVertices(VertexBuffer* clonedBuffer, const VertexBufferAnimationData& animationData,
+    const SkinMatrix* skinMatrices, unsigned numBones, unsigned beginVertex, unsigned endVertex)
+{
+    const unsigned clonedVertexSize = clonedBuffer->GetVertexSize();
+    const unsigned normalOffset = clonedBuffer->GetElementOffset(TYPE_VECTOR3, SEM_NORMAL);
+    const unsigned tangentOffset = clonedBuffer->GetElementOffset(TYPE_VECTOR4, SEM_TANGENT);
+
+    unsigned char* vertexData = clonedBuffer->GetShadowData() + beginVertex * clonedVertexSize;
+    const unsigned char* indicesData = animationData.blendIndices_.data() + beginVertex * numBones;
+    const float* weightsData = animationData.blendWeights_.data() + beginVertex * numBones;
+
+    Matrix3x4 matrix;
+    for (unsigned vertexIndex = beginVertex; vertexIndex < endVertex; ++vertexIndex)
+    {
+        matrix = skinMatrices[indicesData[0]] * weightsData[0];
+        for (unsigned boneIndex = 1; boneIndex < numBones; ++boneIndex)
+            matrix = matrix + skinMatrices[indicesData[boneIndex]] * weightsData[boneIndex];
+
+        Vector3& position = *reinterpret_cast<Vector3*>(vertexData);
+        position = matrix * position;
+
+        if constexpr (SkinNormals)
+        {
+            Vector3& normal = *reinterpret_cast<Vector3*>(vertexData + normalOffset);
+            normal = TransformNormal(matrix, normal);
+        }
+
+        if constexpr (SkinTangents)
+        {
+            Vector3& tangent = *reinterpret_cast<Vector3*>(vertexData + tangentOffset);
+            tangent = TransformNormal(matrix, tangent);
+        }
+
+        // Advance
+        indicesData += numBones;
+        weightsData += numBones;
+        vertexData += clonedVertexSize;
+    }
+}
+#endif
+
+void SkinVertices(VertexBuffer* clonedBuffer, const VertexBufferAnimationData& animationData,
+    const SkinMatrix* skinMatrices, unsigned numBones, unsigned beginVertex, unsigned endVertex)
+{
+    const bool skinNormals = animationData.skinNormals_;
+    const bool skinTangents = animationData.skinTangents_;
+    if (!skinNormals && !skinTangents)
+        SkinVertices<false, false>(clonedBuffer, animationData, skinMatrices, numBones, beginVertex, endVertex);
+    else if (skinNormals && !skinTangents)
+        SkinVertices<true, false>(clonedBuffer, animationData, skinMatrices, numBones, beginVertex, endVertex);
+    else if (skinNormals && skinTangents)
+        SkinVertices<true, true>(clonedBuffer, animationData, skinMatrices, numBones, beginVertex, endVertex);
+    else
+        SkinVertices<false, true>(clonedBuffer, animationData, skinMatrices, numBones, beginVertex, endVertex); // this is really weird case
+}
+
 }
 
 SoftwareModelAnimator::SoftwareModelAnimator(Context* context) : Object(context) {}
@@ -66,34 +203,31 @@ void SoftwareModelAnimator::Initialize(Model* model, bool skinned, unsigned numB
     numBones_ = numBones;
     CloneModelGeometries();
     InitializeAnimationData();
+
+    appliedMorphWeights_.clear();
+    dirtyBuffers_.assign(vertexBuffers_.size(), false);
 }
 
 void SoftwareModelAnimator::ResetAnimation()
 {
-    // Copy vertices from original vertex buffers
     for (unsigned i = 0; i < vertexBuffers_.size(); ++i)
-    {
-        VertexBuffer* clonedBuffer = vertexBuffers_[i];
-        if (!clonedBuffer)
-            continue;
+        ResetVertexBuffer(i);
 
-        VertexBuffer* originalBuffer = originalModel_->GetVertexBuffers()[i];
-        const unsigned vertexStart = skinned_ ? 0 : originalModel_->GetMorphRangeStart(i);
-        const unsigned vertexCount = skinned_ ? originalBuffer->GetVertexCount() : originalModel_->GetMorphRangeCount(i);
-        const unsigned char* sourceData = originalBuffer->GetShadowData() + vertexStart * originalBuffer->GetVertexSize();
-        unsigned char* destData = clonedBuffer->GetShadowData() + vertexStart * clonedBuffer->GetVertexSize();
-
-        CopyMorphVertices(destData, sourceData, vertexCount, clonedBuffer, originalBuffer);
-    }
+    ea::fill(appliedMorphWeights_.begin(), appliedMorphWeights_.end(), 0.0f);
 }
 
 void SoftwareModelAnimator::ApplyMorphs(ea::span<const ModelMorph> morphs)
 {
-    for (const ModelMorph& morph : morphs)
+    if (appliedMorphWeights_.size() < morphs.size())
+        appliedMorphWeights_.resize(morphs.size(), 0.0f);
+
+    for (unsigned morphIndex = 0; morphIndex < morphs.size(); ++morphIndex)
     {
+        const ModelMorph& morph = morphs[morphIndex];
         if (morph.weight_ == 0.0f)
             continue;
 
+        appliedMorphWeights_[morphIndex] += morph.weight_;
         for (const auto& bufferMorph : morph.buffers_)
         {
             VertexBuffer* clonedBuffer = vertexBuffers_[bufferMorph.first];
@@ -101,6 +235,7 @@ void SoftwareModelAnimator::ApplyMorphs(ea::span<const ModelMorph> morphs)
                 continue;
 
             ApplyMorph(clonedBuffer, bufferMorph.second, morph.weight_);
+            dirtyBuffers_[bufferMorph.first] = true;
         }
     }
 }
@@ -110,6 +245,15 @@ void SoftwareModelAnimator::ApplySkinning(ea::span<const Matrix3x4> worldTransfo
     if (!skinned_)
         return;
 
+#ifdef URHO3D_SSE
+    FrameVector<SkinMatrix> skinMatrices(worldTransforms.size());
+    for (unsigned i = 0; i < worldTransforms.size(); ++i)
+        skinMatrices[i] = worldTransforms[i].ToMatrix4().Transpose();
+#else
+    const ea::span<const SkinMatrix> skinMatrices = worldTransforms;
+#endif
+
+    auto workQueue = GetSubsystem<WorkQueue>();
     for (unsigned bufferIndex = 0; bufferIndex < vertexBuffers_.size(); ++bufferIndex)
     {
         VertexBuffer* clonedBuffer = vertexBuffers_[bufferIndex];
@@ -117,79 +261,98 @@ void SoftwareModelAnimator::ApplySkinning(ea::span<const Matrix3x4> worldTransfo
         if (!clonedBuffer || !animationData.hasSkeletalAnimation_)
             continue;
 
-        if (!animationData.skinNormals_ && !animationData.skinTangents_)
-            ApplyVertexBufferSkinning<false, false>(clonedBuffer, animationData, worldTransforms);
-        else if (animationData.skinNormals_ && !animationData.skinTangents_)
-            ApplyVertexBufferSkinning<true, false>(clonedBuffer, animationData, worldTransforms);
-        else if (animationData.skinNormals_ && animationData.skinTangents_)
-            ApplyVertexBufferSkinning<true, true>(clonedBuffer, animationData, worldTransforms);
+        const auto skinVertexRange = [&](unsigned beginVertex, unsigned endVertex, unsigned /*threadIndex*/)
+        { SkinVertices(clonedBuffer, animationData, skinMatrices.data(), numBones_, beginVertex, endVertex); };
+
+        const unsigned numVertices = clonedBuffer->GetVertexCount();
+        if (workQueue)
+            workQueue->ParallelFor(numVertices, MinVerticesPerTask, skinVertexRange);
         else
-            ApplyVertexBufferSkinning<false, true>(clonedBuffer, animationData, worldTransforms); // this is really weird case
+            skinVertexRange(0, numVertices, 0);
+
+        dirtyBuffers_[bufferIndex] = true;
     }
 }
 
-template <bool SkinNormals, bool SkinTangents>
-void SoftwareModelAnimator::ApplyVertexBufferSkinning(VertexBuffer* clonedBuffer, const VertexBufferAnimationData& animationData,
-    ea::span<const Matrix3x4> worldTransforms) const
+bool SoftwareModelAnimator::ApplyAnimation(ea::span<const ModelMorph> morphs, ea::span<const Matrix3x4> worldTransforms)
 {
-    const unsigned clonedVertexSize = clonedBuffer->GetVertexSize();
-    const unsigned normalOffset = clonedBuffer->GetElementOffset(TYPE_VECTOR3, SEM_NORMAL);
-    const unsigned tangentOffset = clonedBuffer->GetElementOffset(TYPE_VECTOR4, SEM_TANGENT);
-
-    unsigned char* clonedBufferData = clonedBuffer->GetShadowData();
-
-    unsigned char* positionsData = clonedBufferData;
-    unsigned char* normalsData = SkinNormals ? clonedBufferData + normalOffset : nullptr;
-    unsigned char* tangentsData = SkinTangents ? clonedBufferData + tangentOffset : nullptr;
+    const unsigned numBuffers = vertexBuffers_.size();
+    if (appliedMorphWeights_.size() < morphs.size())
+        appliedMorphWeights_.resize(morphs.size(), 0.0f);
 
-    const unsigned char* indicesData = animationData.blendIndices_.data();
-    const float* weightsData = animationData.blendWeights_.data();
+    // Skinned buffers are always updated, other buffers are updated only if their morphs are changed
+    FrameVector<bool> updateBuffers(numBuffers, false);
+    for (unsigned bufferIndex = 0; bufferIndex < numBuffers; ++bufferIndex)
+        updateBuffers[bufferIndex] = skinned_ && vertexBuffersData_[bufferIndex].hasSkeletalAnimation_;
 
-    const unsigned numVertices = clonedBuffer->GetVertexCount();
-    Matrix3x4 matrix;
-    for (unsigned vertexIndex = 0; vertexIndex < numVertices; ++vertexIndex)
+    for (unsigned morphIndex = 0; morphIndex < morphs.size(); ++morphIndex)
     {
-        matrix = worldTransforms[indicesData[0]] * weightsData[0];
-        for (unsigned boneIndex = 1; boneIndex < numBones_; ++boneIndex)
-            matrix = matrix + worldTransforms[indicesData[boneIndex]] * weightsData[boneIndex];
-
-        Vector3& position = *reinterpret_cast<Vector3*>(positionsData);
-        position = matrix * position;
+        const ModelMorph& morph = morphs[morphIndex];
+        if (morph.weight_ == appliedMorphWeights_[morphIndex])
+            continue;
 
-        if constexpr (SkinNormals)
+        appliedMorphWeights_[morphIndex] = morph.weight_;
+        for (const auto& bufferMorph : morph.buffers_)
         {
-            Vector3& normal = *reinterpret_cast<Vector3*>(normalsData);
-            normal = TransformNormal(matrix, normal);
+            if (bufferMorph.first < numBuffers)
+                updateBuffers[bufferMorph.first] = true;
         }
+    }
 
-        if constexpr (SkinTangents)
-        {
-            Vector3& tangent = *reinterpret_cast<Vector3*>(tangentsData);
-            tangent = TransformNormal(matrix, tangent);
-        }
+    bool anyUpdated = false;
+    for (unsigned bufferIndex = 0; bufferIndex < numBuffers; ++bufferIndex)
+    {
+        VertexBuffer* clonedBuffer = vertexBuffers_[bufferIndex];
+        if (!clonedBuffer || !updateBuffers[bufferIndex])
+            continue;
 
-        // Advance
-        indicesData += numBones_;
-        weightsData += numBones_;
+        ResetVertexBuffer(bufferIndex);
+        for (const ModelMorph& morph : morphs)
+        {
+            if (morph.weight_ == 0.0f)
+                continue;
 
-        positionsData += clonedVertexSize;
-        if constexpr (SkinNormals)
-            normalsData += clonedVertexSize;
-        if constexpr (SkinTangents)
-            tangentsData += clonedVertexSize;
+            const auto iter = morph.buffers_.find(bufferIndex);
+            if (iter != morph.buffers_.end())
+                ApplyMorph(clonedBuffer, iter->second, morph.weight_);
+        }
+        anyUpdated = true;
     }
 
+    ApplySkinning(worldTransforms);
+    return anyUpdated;
 }
 
 void SoftwareModelAnimator::Commit()
 {
-    for (VertexBuffer* clonedVertexBuffer : vertexBuffers_)
+    for (unsigned i = 0; i < vertexBuffers_.size(); ++i)
     {
-        if (clonedVertexBuffer)
+        VertexBuffer* clonedVertexBuffer = vertexBuffers_[i];
+        if (clonedVertexBuffer && dirtyBuffers_[i])
+        {
             clonedVertexBuffer->Update(clonedVertexBuffer->GetShadowData());
+            dirtyBuffers_[i] = false;
+        }
     }
 }
 
+void SoftwareModelAnimator::ResetVertexBuffer(unsigned bufferIndex)
+{
+    VertexBuffer* clonedBuffer = vertexBuffers_[bufferIndex];
+    if (!clonedBuffer)
+        return;
+
+    // Copy vertices from original vertex buffer
+    VertexBuffer* originalBuffer = originalModel_->GetVertexBuffers()[bufferIndex];
+    const unsigned vertexStart = skinned_ ? 0 : originalModel_->GetMorphRangeStart(bufferIndex);
+    const unsigned vertexCount = skinned_ ? originalBuffer->GetVertexCount() : originalModel_->GetMorphRangeCount(bufferIndex);
+    const unsigned char* sourceData = originalBuffer->GetShadowData() + vertexStart * originalBuffer->GetVertexSize();
+    unsigned char* destData = clonedBuffer->GetShadowData() + vertexStart * clonedBuffer->GetVertexSize();
+
+    CopyMorphVertices(destData, sourceData, vertexCount, clonedBuffer, originalBuffer);
+    dirtyBuffers_[bufferIndex] = true;
+}
+
 VertexMaskFlags SoftwareModelAnimator::GetMorphElementMask() const
 {
     if (skinned_)
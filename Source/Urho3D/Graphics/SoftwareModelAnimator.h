@@ -53,6 +53,8 @@ class URHO3D_API SoftwareModelAnimator : public Object
 public:
     /// Max number of bones.
     static const unsigned MaxBones = 4;
+    /// Min number of vertices skinned by one worker thread.
+    static const unsigned MinVerticesPerTask = 512;
 
     /// Construct.
     explicit SoftwareModelAnimator(Context* context);
@@ -68,9 +70,13 @@ public:
     void ResetAnimation();
     /// Apply morphs. Safe to call from worker thread.
     void ApplyMorphs(ea::span<const ModelMorph> morphs);
-    /// Apply skinning.
+    /// Apply skinning. Large vertex buffers are split between worker threads.
     void ApplySkinning(ea::span<const Matrix3x4> worldTransforms);
-    /// Commit data to GPU.
+    /// Reset and re-apply morphs and skinning only for vertex buffers that need it.
+    /// Buffers are skipped if they are not skinned and their morph weights are unchanged since the last call.
+    /// Return whether any vertex buffer was updated.
+    bool ApplyAnimation(ea::span<const ModelMorph> morphs, ea::span<const Matrix3x4> worldTransforms);
+    /// Commit changed vertex buffers to GPU.
     void Commit();
 
     /// Return animated geometries.
@@ -91,10 +97,8 @@ private:
         VertexBuffer* destBuffer, VertexBuffer* srcBuffer) const;
     /// Apply a vertex buffer morph.
     void ApplyMorph(VertexBuffer* buffer, const VertexBufferMorph& morph, float weight);
-    /// Apply skinning for given vertex buffer.
-    template <bool SkinNormals, bool SkinTangents>
-    void ApplyVertexBufferSkinning(VertexBuffer* clonedBuffer, const VertexBufferAnimationData& animationData,
-        ea::span<const Matrix3x4> worldTransforms) const;
+    /// Copy original vertices to cloned vertex buffer.
+    void ResetVertexBuffer(unsigned bufferIndex);
 
     /// Original model.
     SharedPtr<Model> originalModel_;
@@ -109,6 +113,10 @@ private:
     unsigned numBones_{};
     /// Animation data for vertex buffers.
     ea::vector<VertexBufferAnimationData> vertexBuffersData_;
+    /// Morph weights applied to vertex buffers.
+    ea::vector<float> appliedMorphWeights_;
+    /// Whether the vertex buffer is changed since last commit.
+    ea::vector<bool> dirtyBuffers_;
 };
 
 }
@@ -22,9 +22,13 @@
 
 #include "../Precompiled.h"
 
+#include <EASTL/priority_queue.h>
 #include <EASTL/shared_array.h>
+#include <EASTL/unique_ptr.h>
+#include <EASTL/unordered_map.h>
 
 #include "../IO/Compression.h"
+#include "../Math/MathDefs.h"
 #include "../IO/Deserializer.h"
 #include "../IO/Serializer.h"
 #include "../IO/VectorBuffer.h"
@@ -56,6 +60,192 @@ unsigned DecompressData(void* dest, const void* src, unsigned destSize)
         return (unsigned)LZ4_decompress_fast((const char*)src, (char*)dest, destSize);
 }
 
+unsigned CompressBlock(void* dest, const void* src, unsigned srcSize, CompressionCodec codec, ConstByteSpan dictionary)
+{
+    if (!dest || !src || !srcSize)
+        return 0;
+
+    const auto srcData = static_cast<const char*>(src);
+    const auto destData = static_cast<char*>(dest);
+    const int destCapacity = LZ4_compressBound(srcSize);
+    const auto dictionaryData = reinterpret_cast<const char*>(dictionary.data());
+    const int dictionarySize = static_cast<int>(Min<unsigned>(dictionary.size(), MaxCompressionDictionarySize));
+
+    switch (codec)
+    {
+    case CompressionCodec::None:
+        memcpy(dest, src, srcSize);
+        return srcSize;
+
+    case CompressionCodec::LZ4:
+        if (!dictionarySize)
+            return (unsigned)LZ4_compress_default(srcData, destData, srcSize, destCapacity);
+        else
+        {
+            // Use last bytes of the dictionary, they are the most valuable
+            LZ4_stream_t stream{};
+            LZ4_loadDict(&stream, dictionaryData + dictionary.size() - dictionarySize, dictionarySize);
+            return (unsigned)LZ4_compress_fast_continue(&stream, srcData, destData, srcSize, destCapacity, 1);
+        }
+
+    case CompressionCodec::LZ4HC:
+        if (!dictionarySize)
+            return (unsigned)LZ4_compress_HC(srcData, destData, srcSize, destCapacity, 0);
+        else
+        {
+            // HC stream is too big to be placed on stack
+            const ea::unique_ptr<LZ4_streamHC_t, int (*)(LZ4_streamHC_t*)> stream{LZ4_createStreamHC(), LZ4_freeStreamHC};
+            LZ4_resetStreamHC(stream.get(), 0);
+            LZ4_loadDictHC(stream.get(), dictionaryData + dictionary.size() - dictionarySize, dictionarySize);
+            return (unsigned)LZ4_compress_HC_continue(stream.get(), srcData, destData, srcSize, destCapacity);
+        }
+
+    default:
+        return 0;
+    }
+}
+
+bool DecompressBlock(
+    void* dest, unsigned destSize, const void* src, unsigned srcSize, CompressionCodec codec, ConstByteSpan dictionary)
+{
+    if (!dest || !src || !destSize)
+        return false;
+
+    switch (codec)
+    {
+    case CompressionCodec::None:
+        if (srcSize != destSize)
+            return false;
+        memcpy(dest, src, srcSize);
+        return true;
+
+    case CompressionCodec::LZ4:
+    case CompressionCodec::LZ4HC:
+    {
+        const auto srcData = static_cast<const char*>(src);
+        const auto destData = static_cast<char*>(dest);
+        const int dictionarySize = static_cast<int>(Min<unsigned>(dictionary.size(), MaxCompressionDictionarySize));
+        if (!dictionarySize)
+            return LZ4_decompress_safe(srcData, destData, srcSize, destSize) == static_cast<int>(destSize);
+
+        const auto dictionaryData = reinterpret_cast<const char*>(dictionary.data()) + dictionary.size() - dictionarySize;
+        return LZ4_decompress_safe_usingDict(srcData, destData, srcSize, destSize, dictionaryData, dictionarySize)
+            == static_cast<int>(destSize);
+    }
+
+    default:
+        return false;
+    }
+}
+
+ByteVector BuildCompressionDictionary(const ea::vector<ConstByteSpan>& samples, unsigned maxSize)
+{
+    // Simplified COVER algorithm: split samples into segments and greedily pick segments
+    // that cover the most of k-mers shared between different samples.
+    static constexpr unsigned kmerSize = 8;
+    static constexpr unsigned segmentSize = 256;
+
+    maxSize = Min(maxSize, MaxCompressionDictionarySize);
+
+    const auto readKmer = [](const unsigned char* data)
+    {
+        unsigned long long kmer;
+        memcpy(&kmer, data, kmerSize);
+        return kmer;
+    };
+
+    // Count samples containing each k-mer
+    ea::unordered_map<unsigned long long, unsigned> frequencies;
+    ea::unordered_map<unsigned long long, unsigned> lastSampleIndex;
+    for (unsigned sampleIndex = 0; sampleIndex < samples.size(); ++sampleIndex)
+    {
+        const ConstByteSpan sample = samples[sampleIndex];
+        for (unsigned i = 0; i + kmerSize <= sample.size(); ++i)
+        {
+            const unsigned long long kmer = readKmer(sample.data() + i);
+            const auto [iter, inserted] = lastSampleIndex.emplace(kmer, sampleIndex);
+            if (inserted || iter->second != sampleIndex)
+            {
+                iter->second = sampleIndex;
+                ++frequencies[kmer];
+            }
+        }
+    }
+
+    struct Segment
+    {
+        unsigned score_{};
+        unsigned sampleIndex_{};
+        unsigned offset_{};
+        unsigned size_{};
+
+        bool operator<(const Segment& rhs) const { return score_ < rhs.score_; }
+    };
+
+    // Only k-mers shared by multiple samples contribute to the score
+    const auto evaluateSegment = [&](Segment& segment)
+    {
+        const unsigned char* data = samples[segment.sampleIndex_].data() + segment.offset_;
+        segment.score_ = 0;
+        for (unsigned i = 0; i + kmerSize <= segment.size_; ++i)
+        {
+            const unsigned frequency = frequencies[readKmer(data + i)];
+            if (frequency > 1)
+                segment.score_ += frequency;
+        }
+    };
+
+    ea::priority_queue<Segment> candidates;
+    for (unsigned sampleIndex = 0; sampleIndex < samples.size(); ++sampleIndex)
+    {
+        const unsigned sampleSize = samples[sampleIndex].size();
+        for (unsigned offset = 0; offset < sampleSize; offset += segmentSize)
+        {
+            Segment segment{0, sampleIndex, offset, Min(segmentSize, sampleSize - offset)};
+            evaluateSegment(segment);
+            if (segment.score_ > 0)
+                candidates.push(segment);
+        }
+    }
+
+    // Scores only decrease when k-mers are covered, so lazy re-evaluation of the best candidate is enough
+    ea::vector<Segment> selectedSegments;
+    unsigned dictionarySize = 0;
+    while (!candidates.empty() && dictionarySize < maxSize)
+    {
+        Segment segment = candidates.top();
+        candidates.pop();
+
+        const unsigned oldScore = segment.score_;
+        evaluateSegment(segment);
+        if (segment.score_ == 0)
+            continue;
+        if (segment.score_ < oldScore && !candidates.empty() && segment.score_ < candidates.top().score_)
+        {
+            candidates.push(segment);
+            continue;
+        }
+
+        segment.size_ = Min(segment.size_, maxSize - dictionarySize);
+        selectedSegments.push_back(segment);
+        dictionarySize += segment.size_;
+
+        const unsigned char* data = samples[segment.sampleIndex_].data() + segment.offset_;
+        for (unsigned i = 0; i + kmerSize <= segment.size_; ++i)
+            frequencies[readKmer(data + i)] = 0;
+    }
+
+    // The best segments go last
+    ByteVector dictionary;
+    dictionary.reserve(dictionarySize);
+    for (auto iter = selectedSegments.rbegin(); iter != selectedSegments.rend(); ++iter)
+    {
+        const unsigned char* data = samples[iter->sampleIndex_].data() + iter->offset_;
+        dictionary.insert(dictionary.end(), data, data + iter->size_);
+    }
+    return dictionary;
+}
+
 bool CompressStream(Serializer& dest, Deserializer& src)
 {
     unsigned srcSize = src.GetSize() - src.GetPosition();
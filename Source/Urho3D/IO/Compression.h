@@ -23,6 +23,7 @@
 #pragma once
 
 #include <Urho3D/Urho3D.h>
+#include <Urho3D/Container/ByteVector.h>
 
 namespace Urho3D
 {
@@ -31,12 +32,38 @@ class Deserializer;
 class Serializer;
 class VectorBuffer;
 
+/// Codec used to compress blocks of data.
+enum class CompressionCodec : unsigned char
+{
+    /// Data is stored as is.
+    None,
+    /// Fast LZ4 compression.
+    LZ4,
+    /// High ratio LZ4 compression. Compression is slow, decompression is as fast as LZ4.
+    LZ4HC,
+};
+
+/// Max size of compression dictionary. LZ4 cannot reference data farther than that.
+static constexpr unsigned MaxCompressionDictionarySize = 65536;
+
 /// Estimate and return worst case LZ4 compressed output size in bytes for given input size.
 URHO3D_API unsigned EstimateCompressBound(unsigned srcSize);
 /// Compress data using the LZ4 algorithm and return the compressed data size. The needed destination buffer worst-case size is given by EstimateCompressBound().
 URHO3D_API unsigned CompressData(void* dest, const void* src, unsigned srcSize);
 /// Uncompress data using the LZ4 algorithm. The uncompressed data size must be known. Return the number of compressed data bytes consumed.
 URHO3D_API unsigned DecompressData(void* dest, const void* src, unsigned destSize);
+/// Compress a block of data with given codec and optional dictionary. Return compressed data size or 0 on failure.
+/// The needed destination buffer worst-case size is given by EstimateCompressBound().
+/// Blocks compressed with dictionary can be decompressed only with the same dictionary.
+URHO3D_API unsigned CompressBlock(
+    void* dest, const void* src, unsigned srcSize, CompressionCodec codec, ConstByteSpan dictionary = {});
+/// Decompress a block of data produced by CompressBlock(). The uncompressed data size must be known. Return true on success.
+URHO3D_API bool DecompressBlock(
+    void* dest, unsigned destSize, const void* src, unsigned srcSize, CompressionCodec codec, ConstByteSpan dictionary = {});
+/// Build compression dictionary from sample files that share structure, e.g. small XML or JSON files.
+/// Content that is common for more samples is placed closer to the end of dictionary where it is cheaper to reference.
+URHO3D_API ByteVector BuildCompressionDictionary(
+    const ea::vector<ConstByteSpan>& samples, unsigned maxSize = MaxCompressionDictionarySize);
 /// Compress a source stream (from current position to the end) to the destination stream using the LZ4 algorithm. Return true on success.
 URHO3D_API bool CompressStream(Serializer& dest, Deserializer& src);
 /// Decompress a compressed source stream produced using CompressStream() to the destination stream. Return true on success.
@@ -23,6 +23,8 @@
 #include "../Precompiled.h"
 
 #include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
+#include "../IO/Compression.h"
 #include "../IO/File.h"
 #include "../IO/FileSystem.h"
 #include "../IO/Log.h"
@@ -38,7 +40,6 @@
 #endif
 
 #include <cstdio>
-#include <LZ4/lz4.h>
 
 #include "../DebugNew.h"
 
@@ -151,7 +152,9 @@ bool File::Open(PackageFile* package, const ea::string& fileName)
     offset_ = entry->offset_;
     checksum_ = entry->checksum_;
     size_ = entry->size_;
-    compressed_ = package->IsCompressed();
+    compressed_ = entry->codec_ != CompressionCodec::None;
+    dictionary_ = entry->useDictionary_ ? package->GetDictionary() : nullptr;
+    blockOffsets_ = entry->blockOffsets_;
 
     // Seek to beginning of package entry's file data
     SeekInternal(offset_);
@@ -219,7 +222,38 @@ unsigned File::Read(void* dest, unsigned size)
 
         while (sizeLeft)
         {
-            if (!readBuffer_ || readBufferOffset_ >= readBufferSize_)
+            // Decompress whole blocks directly to the destination if possible
+            const bool isBufferConsumed = !readBuffer_ || readBufferOffset_ >= readBufferSize_;
+            if (blockOffsets_ && isBufferConsumed && position_ % PACKAGE_COMPRESSED_BLOCK_SIZE == 0
+                && sizeLeft >= 2 * PACKAGE_COMPRESSED_BLOCK_SIZE)
+            {
+                const unsigned firstBlock = position_ / PACKAGE_COMPRESSED_BLOCK_SIZE;
+                const unsigned numBlocks = sizeLeft / PACKAGE_COMPRESSED_BLOCK_SIZE;
+                const unsigned beginOffset = (*blockOffsets_)[firstBlock];
+                const unsigned endOffset = (*blockOffsets_)[firstBlock + numBlocks];
+                const unsigned unpackedSize = numBlocks * PACKAGE_COMPRESSED_BLOCK_SIZE;
+
+                ByteVector packedData(endOffset - beginOffset);
+                ReadInternal(packedData.data(), packedData.size());
+                const ConstByteSpan dictionary = dictionary_ ? ConstByteSpan{*dictionary_} : ConstByteSpan{};
+                if (!DecompressPackageBlocks(GetSubsystem<WorkQueue>(), ByteSpan{destPtr, unpackedSize}, packedData,
+                        CompressionCodec::LZ4, dictionary))
+                {
+                    URHO3D_LOGERROR("Error while decompressing file " + GetName());
+                    return size - sizeLeft;
+                }
+
+                // Buffered block is no longer adjacent to the current position
+                readBufferOffset_ = 0;
+                readBufferSize_ = 0;
+
+                destPtr += unpackedSize;
+                sizeLeft -= unpackedSize;
+                position_ += unpackedSize;
+                continue;
+            }
+
+            if (isBufferConsumed)
             {
                 unsigned char blockHeaderBytes[4];
                 ReadInternal(blockHeaderBytes, sizeof blockHeaderBytes);
@@ -230,13 +264,20 @@ unsigned File::Read(void* dest, unsigned size)
 
                 if (!readBuffer_)
                 {
-                    readBuffer_ = new unsigned char[unpackedSize];
-                    inputBuffer_ = new unsigned char[LZ4_compressBound(unpackedSize)];
+                    // First read block may be the last one if seeking, allocate enough space for any block
+                    const unsigned bufferSize = Max(unpackedSize, PACKAGE_COMPRESSED_BLOCK_SIZE);
+                    readBuffer_ = new unsigned char[bufferSize];
+                    inputBuffer_ = new unsigned char[EstimateCompressBound(bufferSize)];
                 }
 
-                /// \todo Handle errors
                 ReadInternal(inputBuffer_.get(), packedSize);
-                LZ4_decompress_fast((const char*)inputBuffer_.get(), (char*)readBuffer_.get(), unpackedSize);
+                const ConstByteSpan dictionary = dictionary_ ? ConstByteSpan{*dictionary_} : ConstByteSpan{};
+                if (!DecompressBlock(readBuffer_.get(), unpackedSize, inputBuffer_.get(), packedSize,
+                        CompressionCodec::LZ4, dictionary))
+                {
+                    URHO3D_LOGERROR("Error while decompressing file " + GetName());
+                    return size - sizeLeft;
+                }
 
                 readBufferSize_ = unpackedSize;
                 readBufferOffset_ = 0;
@@ -285,6 +326,31 @@ unsigned File::Seek(unsigned position)
     if (mode_ == FILE_READ && position > size_)
         position = size_;
 
+    if (compressed_ && blockOffsets_)
+    {
+        // Move within current block if possible
+        const unsigned bufferStart = position_ - readBufferOffset_;
+        if (readBuffer_ && position >= bufferStart && position < bufferStart + readBufferSize_)
+        {
+            readBufferOffset_ = position - bufferStart;
+            position_ = position;
+            return position_;
+        }
+
+        // Jump to the beginning of the block and skip remaining bytes
+        const unsigned numBlocks = blockOffsets_->size() - 1;
+        const unsigned blockIndex = Min(position / PACKAGE_COMPRESSED_BLOCK_SIZE, numBlocks - 1);
+        position_ = blockIndex * PACKAGE_COMPRESSED_BLOCK_SIZE;
+        readBufferOffset_ = 0;
+        readBufferSize_ = 0;
+        SeekInternal(offset_ + (*blockOffsets_)[blockIndex]);
+
+        unsigned char skipBuffer[SKIP_BUFFER_SIZE];
+        while (position > position_)
+            Read(skipBuffer, Min(position - position_, SKIP_BUFFER_SIZE));
+        return position_;
+    }
+
     if (compressed_)
     {
         // Start over from the beginning
@@ -401,6 +467,8 @@ void File::Close()
 
     readBuffer_.reset();
     inputBuffer_.reset();
+    dictionary_ = nullptr;
+    blockOffsets_ = nullptr;
 
     if (handle_)
     {
@@ -26,6 +26,7 @@
 
 #include <EASTL/shared_array.h>
 
+#include "../Container/ByteVector.h"
 #include "../Core/Object.h"
 #include "../IO/AbstractFile.h"
 
@@ -150,6 +151,10 @@ private:
     unsigned offset_;
     /// Content checksum.
     unsigned checksum_;
+    /// Compression dictionary of the package entry, if used.
+    SharedByteVector dictionary_;
+    /// Block index of the compressed package entry, if present.
+    ea::shared_ptr<const ea::vector<unsigned>> blockOffsets_;
     /// Compression flag.
     bool compressed_;
     /// Synchronization needed before read -flag.
@@ -0,0 +1,165 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Precompiled.h"
+
+#include "../IO/File.h"
+#include "../IO/FileSystem.h"
+#include "../IO/MemoryMappedFile.h"
+
+#if defined(_WIN32)
+    #include <windows.h>
+#elif !defined(__EMSCRIPTEN__)
+    #define URHO3D_POSIX_MEMORY_MAPPING
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+MemoryMappedFile::MemoryMappedFile() = default;
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    Close();
+}
+
+bool MemoryMappedFile::IsSupported()
+{
+#if defined(_WIN32) || defined(URHO3D_POSIX_MEMORY_MAPPING)
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool MemoryMappedFile::Open(const ea::string& fileName)
+{
+    Close();
+
+#ifdef __ANDROID__
+    // Assets are stored inside of APK and cannot be mapped
+    if (URHO3D_IS_ASSET(fileName))
+        return false;
+#endif
+
+#if defined(_WIN32)
+    HANDLE fileHandle = CreateFileW(GetWideNativePath(fileName).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0)
+    {
+        CloseHandle(fileHandle);
+        return false;
+    }
+
+    // Mapping keeps the file open, so the handle can be closed right away
+    HANDLE mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(fileHandle);
+    if (!mappingHandle)
+        return false;
+
+    void* data = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+    if (!data)
+    {
+        CloseHandle(mappingHandle);
+        return false;
+    }
+
+    mappingHandle_ = mappingHandle;
+    data_ = static_cast<const unsigned char*>(data);
+    size_ = static_cast<unsigned long long>(fileSize.QuadPart);
+#elif defined(URHO3D_POSIX_MEMORY_MAPPING)
+    const int fileDescriptor = open(GetNativePath(fileName).c_str(), O_RDONLY);
+    if (fileDescriptor < 0)
+        return false;
+
+    struct stat fileStat{};
+    if (fstat(fileDescriptor, &fileStat) != 0 || fileStat.st_size <= 0)
+    {
+        close(fileDescriptor);
+        return false;
+    }
+
+    // Mapping keeps the file open, so the descriptor can be closed right away
+    void* data = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+    close(fileDescriptor);
+    if (data == MAP_FAILED)
+        return false;
+
+    data_ = static_cast<const unsigned char*>(data);
+    size_ = static_cast<unsigned long long>(fileStat.st_size);
+#else
+    return false;
+#endif
+
+    fileName_ = fileName;
+    return true;
+}
+
+void MemoryMappedFile::Close()
+{
+    if (!data_)
+        return;
+
+#if defined(_WIN32)
+    UnmapViewOfFile(data_);
+    CloseHandle(mappingHandle_);
+    mappingHandle_ = nullptr;
+#elif defined(URHO3D_POSIX_MEMORY_MAPPING)
+    munmap(const_cast<unsigned char*>(data_), size_);
+#endif
+
+    data_ = nullptr;
+    size_ = 0;
+    fileName_.clear();
+}
+
+MemoryMappedFileView::MemoryMappedFileView(
+    MemoryMappedFile* mappedFile, unsigned long long offset, unsigned size, unsigned checksum)
+    : MemoryBuffer(mappedFile->GetData() + offset, size)
+    , mappedFile_(mappedFile)
+    , checksum_(checksum)
+{
+    assert(offset + size <= mappedFile->GetSize());
+}
+
+unsigned MemoryMappedFileView::GetChecksum()
+{
+    if (!checksum_)
+    {
+        const unsigned char* data = GetData();
+        for (unsigned i = 0; i < size_; ++i)
+            checksum_ = SDBMHash(checksum_, data[i]);
+    }
+    return checksum_;
+}
+
+}
@@ -0,0 +1,92 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "Urho3D/Container/RefCounted.h"
+#include "Urho3D/IO/MemoryBuffer.h"
+
+namespace Urho3D
+{
+
+/// Read-only view of the whole file mapped into memory.
+/// Pages are loaded by OS on demand and are shared between all views of the file.
+class URHO3D_API MemoryMappedFile : public RefCounted
+{
+public:
+    /// Construct.
+    MemoryMappedFile();
+    /// Destruct. Unmap the file.
+    ~MemoryMappedFile() override;
+
+    /// Return whether memory mapping is supported on current platform.
+    static bool IsSupported();
+
+    /// Map file into memory. Return true if successful.
+    bool Open(const ea::string& fileName);
+    /// Unmap the file. All views become invalid.
+    void Close();
+
+    /// Return whether the file is mapped.
+    bool IsOpen() const { return data_ != nullptr; }
+    /// Return mapped data.
+    const unsigned char* GetData() const { return data_; }
+    /// Return size of mapped data.
+    unsigned long long GetSize() const { return size_; }
+    /// Return file name.
+    const ea::string& GetFileName() const { return fileName_; }
+
+private:
+    /// Mapped data.
+    const unsigned char* data_{};
+    /// Size of mapped data.
+    unsigned long long size_{};
+    /// File name.
+    ea::string fileName_;
+#ifdef _WIN32
+    /// File mapping handle.
+    void* mappingHandle_{};
+#endif
+};
+
+/// Read-only file that points to the region of memory mapped file. Keeps the mapping alive.
+/// Resources can parse data directly from the mapping via MemoryBuffer::GetData without intermediate copies.
+/// @nobind
+class URHO3D_API MemoryMappedFileView : public RefCounted, public MemoryBuffer
+{
+public:
+    /// Construct. If checksum is not provided, it is calculated on demand.
+    MemoryMappedFileView(MemoryMappedFile* mappedFile, unsigned long long offset, unsigned size, unsigned checksum = 0);
+
+    /// Return checksum of the data.
+    unsigned GetChecksum() override;
+    /// Return mapped file.
+    MemoryMappedFile* GetMappedFile() const { return mappedFile_; }
+
+private:
+    /// Mapped file.
+    SharedPtr<MemoryMappedFile> mappedFile_;
+    /// Checksum.
+    unsigned checksum_{};
+};
+
+}
@@ -27,6 +27,7 @@
 #include "Urho3D/IO/File.h"
 #include "Urho3D/IO/FileSystem.h"
 #include "Urho3D/IO/Log.h"
+#include "Urho3D/IO/MemoryMappedFile.h"
 #include "Urho3D/Resource/ResourceEvents.h"
 
 namespace Urho3D
@@ -134,6 +135,18 @@ AbstractFilePtr MountedDirectory::OpenFile(const FileIdentifier& fileName, FileM
         }
     }
 
+    if (memoryMapped_ && mode == FILE_READ && MemoryMappedFile::IsSupported())
+    {
+        // Empty and unmappable files fall back to regular file reads
+        auto mappedFile = MakeShared<MemoryMappedFile>();
+        if (mappedFile->Open(fullPath) && mappedFile->GetSize() <= M_MAX_UNSIGNED)
+        {
+            auto view = MakeShared<MemoryMappedFileView>(mappedFile, 0, static_cast<unsigned>(mappedFile->GetSize()));
+            view->SetName(fileName.ToUri());
+            return view;
+        }
+    }
+
     auto file = MakeShared<File>(context_, fullPath, mode);
     if (!file->IsOpen())
         return nullptr;
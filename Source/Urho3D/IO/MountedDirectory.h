@@ -60,6 +60,13 @@ public:
     /// Get mounted directory path.
     const ea::string& GetDirectory() const { return directory_; }
 
+    /// Enable or disable memory mapping of files opened for reading.
+    /// Mapped files are opened as read-only views of mapped memory without any copying.
+    /// Files should not be truncated while mapped, so it is intended for immutable asset directories.
+    void SetMemoryMapped(bool enable) { memoryMapped_ = enable; }
+    /// Return whether files opened for reading are memory mapped.
+    bool IsMemoryMapped() const { return memoryMapped_; }
+
 protected:
     ea::string SanitizeDirName(const ea::string& name) const;
 
@@ -81,6 +88,8 @@ private:
     const ea::string name_;
     /// File watcher for resource directory, if automatic reloading enabled.
     SharedPtr<FileWatcher> fileWatcher_;
+    /// Whether to map files opened for reading into memory.
+    bool memoryMapped_{};
 };
 
 } // namespace Urho3D
@@ -0,0 +1,185 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Precompiled.h"
+
+#include "../IO/Log.h"
+#include "../IO/PackageBuilder.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+PackageBuilder::PackageBuilder() = default;
+
+PackageBuilder::~PackageBuilder()
+{
+    if (IsBuilding())
+        URHO3D_LOGWARNING("Package is not finished");
+}
+
+bool PackageBuilder::Create(AbstractFile* dest, ConstByteSpan dictionary)
+{
+    if (IsBuilding())
+    {
+        URHO3D_LOGERROR("Package is already being written");
+        return false;
+    }
+
+    if (!dest)
+        return false;
+
+    dest_ = dest;
+    startPosition_ = dest_->GetPosition();
+    dictionary_.assign(dictionary.begin(), dictionary.end());
+    entries_.clear();
+    checksum_ = 0;
+
+    // Header is written again when file list offset is known
+    return WriteHeader(0);
+}
+
+bool PackageBuilder::Append(const ea::string& name, ConstByteSpan data, CompressionCodec codec, bool useDictionary)
+{
+    if (!IsBuilding())
+    {
+        URHO3D_LOGERROR("Package is not being written");
+        return false;
+    }
+
+    PackageEntry entry{};
+    entry.offset_ = dest_->GetPosition() - startPosition_;
+    entry.size_ = data.size();
+    for (unsigned char value : data)
+    {
+        checksum_ = SDBMHash(checksum_, value);
+        entry.checksum_ = SDBMHash(entry.checksum_, value);
+    }
+
+    // Compress independent blocks so they can be decompressed in parallel
+    if (codec != CompressionCodec::None && !data.empty())
+    {
+        const ConstByteSpan dictionary = useDictionary ? ConstByteSpan{dictionary_} : ConstByteSpan{};
+        compressedData_.clear();
+        blockOffsets_.clear();
+        for (unsigned offset = 0; offset < data.size(); offset += PACKAGE_COMPRESSED_BLOCK_SIZE)
+        {
+            const unsigned unpackedSize = Min<unsigned>(data.size() - offset, PACKAGE_COMPRESSED_BLOCK_SIZE);
+            const unsigned blockOffset = compressedData_.size();
+            blockOffsets_.push_back(blockOffset);
+            compressedData_.resize(blockOffset + 2 * sizeof(unsigned short) + EstimateCompressBound(unpackedSize));
+
+            unsigned char* blockData = compressedData_.data() + blockOffset;
+            const unsigned packedSize = CompressBlock(
+                blockData + 2 * sizeof(unsigned short), data.data() + offset, unpackedSize, codec, dictionary);
+            if (!packedSize || packedSize > ea::numeric_limits<unsigned short>::max())
+            {
+                URHO3D_LOGERROR("Cannot compress file {} at offset {}", name, offset);
+                return false;
+            }
+
+            const unsigned short blockHeader[2] = {
+                static_cast<unsigned short>(unpackedSize), static_cast<unsigned short>(packedSize)};
+            memcpy(blockData, blockHeader, sizeof(blockHeader));
+            compressedData_.resize(blockOffset + 2 * sizeof(unsigned short) + packedSize);
+        }
+
+        if (compressedData_.size() < data.size())
+        {
+            entry.codec_ = codec;
+            entry.useDictionary_ = useDictionary && !dictionary_.empty();
+            entry.packedSize_ = compressedData_.size();
+            blockOffsets_.push_back(entry.packedSize_);
+            entry.blockOffsets_ = ea::make_shared<ea::vector<unsigned>>(blockOffsets_);
+        }
+    }
+
+    const ConstByteSpan storedData = entry.codec_ != CompressionCodec::None ? ConstByteSpan{compressedData_} : data;
+    if (entry.codec_ == CompressionCodec::None)
+        entry.packedSize_ = data.size();
+
+    if (dest_->Write(storedData.data(), storedData.size()) != storedData.size())
+    {
+        URHO3D_LOGERROR("Cannot write file {} to package", name);
+        return false;
+    }
+
+    entries_.emplace_back(name, entry);
+    return true;
+}
+
+bool PackageBuilder::Build()
+{
+    if (!IsBuilding())
+    {
+        URHO3D_LOGERROR("Package is not being written");
+        return false;
+    }
+
+    bool success = true;
+    const unsigned fileListOffset = dest_->GetPosition();
+    success &= dest_->WriteUInt(dictionary_.size());
+    success &= dest_->Write(dictionary_.data(), dictionary_.size()) == dictionary_.size();
+    for (const auto& [name, entry] : entries_)
+    {
+        success &= dest_->WriteString(name);
+        success &= dest_->WriteUInt(entry.offset_);
+        success &= dest_->WriteUInt(entry.size_);
+        success &= dest_->WriteUInt(entry.checksum_);
+        success &= dest_->WriteUByte(static_cast<unsigned char>(entry.codec_));
+        success &= dest_->WriteBool(entry.useDictionary_);
+        success &= dest_->WriteUInt(entry.packedSize_);
+        if (entry.blockOffsets_)
+        {
+            // Size of stored data is not duplicated
+            for (unsigned i = 0; i + 1 < entry.blockOffsets_->size(); ++i)
+                success &= dest_->WriteUInt((*entry.blockOffsets_)[i]);
+        }
+    }
+
+    // Write package size to the end of file to allow finding it linked to an executable file
+    const unsigned endPosition = dest_->GetPosition();
+    success &= dest_->WriteUInt(endPosition - startPosition_ + sizeof(unsigned));
+
+    dest_->Seek(startPosition_);
+    success &= WriteHeader(fileListOffset);
+    dest_->Seek(endPosition + sizeof(unsigned));
+
+    dest_ = nullptr;
+    if (!success)
+        URHO3D_LOGERROR("Cannot write package file list");
+    return success;
+}
+
+bool PackageBuilder::WriteHeader(unsigned long long fileListOffset)
+{
+    bool success = true;
+    success &= dest_->WriteFileID("RPAK");
+    success &= dest_->WriteUInt(entries_.size());
+    success &= dest_->WriteUInt(checksum_);
+    success &= dest_->WriteUInt(PACKAGE_FILE_VERSION);
+    success &= dest_->WriteInt64(static_cast<long long>(fileListOffset));
+    return success;
+}
+
+}
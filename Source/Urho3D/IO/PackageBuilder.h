@@ -0,0 +1,75 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "Urho3D/Core/NonCopyable.h"
+#include "Urho3D/IO/PackageFile.h"
+
+namespace Urho3D
+{
+
+/// Writes package file of the latest format version.
+/// Each entry is compressed with its own codec, optionally with the dictionary shared by the whole package.
+/// Compressed entries are split into independent blocks and indexed for random access.
+class URHO3D_API PackageBuilder : public NonCopyable
+{
+public:
+    /// Construct.
+    PackageBuilder();
+    /// Destruct.
+    ~PackageBuilder();
+
+    /// Start writing package to the file at current position. File should be kept alive until Build() is called.
+    bool Create(AbstractFile* dest, ConstByteSpan dictionary = {});
+    /// Append file to the package. Entry is stored uncompressed if compression doesn't reduce its size.
+    bool Append(const ea::string& name, ConstByteSpan data, CompressionCodec codec = CompressionCodec::None,
+        bool useDictionary = false);
+    /// Write file list and finish writing package.
+    bool Build();
+
+    /// Return whether the package is being written.
+    bool IsBuilding() const { return dest_ != nullptr; }
+    /// Return number of appended entries.
+    unsigned GetNumFiles() const { return entries_.size(); }
+
+private:
+    /// Write package header.
+    bool WriteHeader(unsigned long long fileListOffset);
+
+    /// Destination file.
+    AbstractFile* dest_{};
+    /// Position of the package in the destination file.
+    unsigned startPosition_{};
+    /// Shared compression dictionary.
+    ByteVector dictionary_;
+    /// Appended entries.
+    ea::vector<ea::pair<ea::string, PackageEntry>> entries_;
+    /// Checksum of all entries.
+    unsigned checksum_{};
+    /// Buffer for compressed data.
+    ByteVector compressedData_;
+    /// Offsets of blocks in compressed data.
+    ea::vector<unsigned> blockOffsets_;
+};
+
+}
@@ -22,14 +22,91 @@
 
 #include "../Precompiled.h"
 
+#include "../Core/WorkQueue.h"
 #include "../IO/File.h"
 #include "../IO/Log.h"
 #include "../IO/PackageFile.h"
 #include "../IO/FileSystem.h"
+#include "../IO/VectorBuffer.h"
+
+#include <atomic>
 
 namespace Urho3D
 {
 
+namespace
+{
+
+/// Decompressed package entry.
+class DecompressedPackageEntry : public RefCounted, public VectorBuffer
+{
+public:
+    explicit DecompressedPackageEntry(unsigned checksum) : checksum_(checksum) {}
+
+    unsigned GetChecksum() override { return checksum_; }
+
+private:
+    unsigned checksum_{};
+};
+
+/// Block of compressed package entry.
+struct CompressedBlock
+{
+    unsigned srcOffset_{};
+    unsigned srcSize_{};
+    unsigned destOffset_{};
+    unsigned destSize_{};
+};
+
+}
+
+bool DecompressPackageBlocks(
+    WorkQueue* workQueue, ByteSpan dest, ConstByteSpan src, CompressionCodec codec, ConstByteSpan dictionary)
+{
+    // Block headers are stored inline, collect them first
+    ea::vector<CompressedBlock> blocks;
+    unsigned srcOffset = 0;
+    unsigned destOffset = 0;
+    while (destOffset < dest.size())
+    {
+        if (srcOffset + 2 * sizeof(unsigned short) > src.size())
+            return false;
+
+        MemoryBuffer blockHeader(src.data() + srcOffset, 2 * sizeof(unsigned short));
+        const unsigned unpackedSize = blockHeader.ReadUShort();
+        const unsigned packedSize = blockHeader.ReadUShort();
+        srcOffset += 2 * sizeof(unsigned short);
+
+        if (!unpackedSize || srcOffset + packedSize > src.size() || destOffset + unpackedSize > dest.size())
+            return false;
+
+        blocks.push_back(CompressedBlock{srcOffset, packedSize, destOffset, unpackedSize});
+        srcOffset += packedSize;
+        destOffset += unpackedSize;
+    }
+
+    // Blocks are compressed independently and can be decompressed in any order
+    std::atomic_bool success{true};
+    const auto decompressBlocks = [&](unsigned begin, unsigned end)
+    {
+        for (unsigned i = begin; i < end; ++i)
+        {
+            const CompressedBlock& block = blocks[i];
+            if (!DecompressBlock(dest.data() + block.destOffset_, block.destSize_, src.data() + block.srcOffset_,
+                    block.srcSize_, codec, dictionary))
+                success = false;
+        }
+    };
+
+    // Background loading threads cannot start parallel tasks
+    if (workQueue && workQueue->IsProcessingThread())
+        workQueue->ParallelFor(blocks.size(), 2, [&](unsigned begin, unsigned end, unsigned) { decompressBlocks(begin, end); });
+    else
+        decompressBlocks(0, blocks.size());
+
+    return success;
+}
+
 PackageFile::PackageFile(Context* context) :
     MountPoint(context),
     totalSize_(0),
@@ -88,21 +165,38 @@ bool PackageFile::Open(const ea::string& fileName, unsigned startOffset)
     nameHash_ = fileName_;
     totalSize_ = file->GetSize();
     compressed_ = id == "ULZ4" || id == "RLZ4";
+    dictionary_ = nullptr;
     unsigned numFiles = file->ReadUInt();
     checksum_ = file->ReadUInt();
+    unsigned version = 0;
 
     if (id == "RPAK" || id == "RLZ4")
     {
         // New PAK file format includes two extra PAK header fields:
-        // * Version. At this time this field is unused and is always 0. It will be used in the future if PAK format needs to be extended.
+        // * Version of the format, up to PACKAGE_FILE_VERSION. Version 0 is the original format, version 1 adds shared
+        //   compression dictionary and per-entry codecs, version 2 adds block index of compressed entries.
         // * File list offset. New format writes file list in the end of the file. This allows PAK creation without knowing entire file list
         //   beforehand.
-        unsigned version = file->ReadUInt();                        // Reserved for future use.
-        assert(version == 0);
+        version = file->ReadUInt();
+        if (version > PACKAGE_FILE_VERSION)
+        {
+            URHO3D_LOGERROR("{} has unsupported package format version {}", fileName, version);
+            return false;
+        }
         int64_t fileListOffset = file->ReadInt64();                 // New format has file list at the end of the file.
         file->Seek(fileListOffset);                                 // TODO: Serializer/Deserializer do not support files bigger than 4 GB
     }
 
+    // Version 1 adds shared dictionary and per-entry codecs
+    if (version >= 1)
+    {
+        if (const unsigned dictionarySize = file->ReadUInt())
+        {
+            dictionary_ = ea::make_shared<ByteVector>(dictionarySize);
+            file->Read(dictionary_->data(), dictionarySize);
+        }
+    }
+
     for (unsigned i = 0; i < numFiles; ++i)
     {
         ea::string entryName = file->ReadString();
@@ -110,7 +204,37 @@ bool PackageFile::Open(const ea::string& fileName, unsigned startOffset)
         newEntry.offset_ = file->ReadUInt() + startOffset;
         totalDataSize_ += (newEntry.size_ = file->ReadUInt());
         newEntry.checksum_ = file->ReadUInt();
-        if (!compressed_ && newEntry.offset_ + newEntry.size_ > totalSize_)
+        if (version >= 1)
+        {
+            newEntry.codec_ = static_cast<CompressionCodec>(file->ReadUByte());
+            newEntry.useDictionary_ = file->ReadBool() && dictionary_;
+            newEntry.packedSize_ = file->ReadUInt();
+            compressed_ |= newEntry.codec_ != CompressionCodec::None;
+        }
+        else
+        {
+            newEntry.codec_ = compressed_ ? CompressionCodec::LZ4 : CompressionCodec::None;
+            newEntry.packedSize_ = compressed_ ? 0 : newEntry.size_;
+        }
+
+        // Version 2 adds block index for compressed entries
+        if (version >= 2 && newEntry.codec_ != CompressionCodec::None)
+        {
+            const unsigned numBlocks = (newEntry.size_ + PACKAGE_COMPRESSED_BLOCK_SIZE - 1) / PACKAGE_COMPRESSED_BLOCK_SIZE;
+            auto blockOffsets = ea::make_shared<ea::vector<unsigned>>(numBlocks + 1);
+            for (unsigned j = 0; j < numBlocks; ++j)
+                (*blockOffsets)[j] = file->ReadUInt();
+            blockOffsets->back() = newEntry.packedSize_;
+
+            if (!ea::is_sorted(blockOffsets->begin(), blockOffsets->end()))
+            {
+                URHO3D_LOGERROR("File entry " + entryName + " has invalid block index");
+                return false;
+            }
+            newEntry.blockOffsets_ = blockOffsets;
+        }
+
+        if (newEntry.offset_ + newEntry.packedSize_ > totalSize_)
         {
             URHO3D_LOGERROR("File entry " + entryName + " outside package file");
             return false;
@@ -119,6 +243,93 @@ bool PackageFile::Open(const ea::string& fileName, unsigned startOffset)
             entries_[entryName] = newEntry;
     }
 
+    // Remap if mapping was enabled for previously opened file
+    if (mappedFile_)
+    {
+        mappedFile_ = nullptr;
+        SetMemoryMapped(true);
+    }
+
+    return true;
+}
+
+bool PackageFile::SetMemoryMapped(bool enable)
+{
+    // Opened files keep the mapping alive on their own
+    if (!enable)
+    {
+        mappedFile_ = nullptr;
+        return false;
+    }
+
+    if (mappedFile_)
+        return true;
+
+    if (fileName_.empty() || !MemoryMappedFile::IsSupported())
+        return false;
+
+    auto mappedFile = MakeShared<MemoryMappedFile>();
+    if (!mappedFile->Open(fileName_) || mappedFile->GetSize() != totalSize_)
+    {
+        URHO3D_LOGWARNING("Cannot map package file {} to memory, falling back to file reads", fileName_);
+        return false;
+    }
+
+    mappedFile_ = mappedFile;
+    return true;
+}
+
+bool PackageFile::ReadEntry(const ea::string& fileName, ByteVector& data)
+{
+    const PackageEntry* entry = GetEntry(fileName);
+    if (!entry)
+        return false;
+
+    data.resize(entry->size_);
+    if (!entry->size_)
+        return true;
+
+    // Stored size of legacy compressed entries is unknown, they can only be streamed
+    if (!entry->packedSize_)
+    {
+        File file(context_, this, fileName);
+        return file.Read(data.data(), entry->size_) == entry->size_;
+    }
+
+    const bool isCompressed = entry->codec_ != CompressionCodec::None;
+    ByteVector packedData;
+    ConstByteSpan packedSpan;
+    if (mappedFile_)
+        packedSpan = ConstByteSpan{mappedFile_->GetData() + entry->offset_, entry->packedSize_};
+    else
+    {
+        File file(context_, fileName_);
+        if (!file.IsOpen())
+            return false;
+
+        if (isCompressed)
+            packedData.resize(entry->packedSize_);
+        unsigned char* dest = isCompressed ? packedData.data() : data.data();
+
+        file.Seek(entry->offset_);
+        if (file.Read(dest, entry->packedSize_) != entry->packedSize_)
+            return false;
+        packedSpan = ConstByteSpan{dest, entry->packedSize_};
+    }
+
+    if (!isCompressed)
+    {
+        if (mappedFile_)
+            ea::copy(packedSpan.begin(), packedSpan.end(), data.begin());
+        return true;
+    }
+
+    const ConstByteSpan dictionary = entry->useDictionary_ ? ConstByteSpan{*dictionary_} : ConstByteSpan{};
+    if (!DecompressPackageBlocks(GetSubsystem<WorkQueue>(), data, packedSpan, entry->codec_, dictionary))
+    {
+        URHO3D_LOGERROR("Cannot decompress entry {} of package file {}", fileName, fileName_);
+        return false;
+    }
     return true;
 }
 
@@ -217,9 +428,32 @@ AbstractFilePtr PackageFile::OpenFile(const FileIdentifier& fileName, FileMode m
         return {};
 
     // Quit if file doesn't exists in the package.
-    if (!Exists(fileName.fileName_))
+    const PackageEntry* entry = GetEntry(fileName.fileName_);
+    if (!entry)
         return {};
 
+    if (entry->codec_ == CompressionCodec::None && mappedFile_)
+    {
+        auto view = MakeShared<MemoryMappedFileView>(mappedFile_, entry->offset_, entry->size_, entry->checksum_);
+        view->SetName(fileName.ToUri());
+        return view;
+    }
+
+    // Decompress big entries in parallel instead of streaming.
+    // Entries with block index are streamed from file, which supports random access and decompresses big reads in parallel.
+    const bool isCompressed = entry->codec_ != CompressionCodec::None;
+    const bool isLargeEntry = entry->size_ >= PACKAGE_PARALLEL_DECOMPRESSION_SIZE && !entry->blockOffsets_;
+    if (isCompressed && entry->packedSize_ && (mappedFile_ || isLargeEntry))
+    {
+        auto file = MakeShared<DecompressedPackageEntry>(entry->checksum_);
+        if (!ReadEntry(fileName.fileName_, file->GetBuffer()))
+            return {};
+
+        file->Resize(entry->size_);
+        file->SetName(fileName.ToUri());
+        return file;
+    }
+
     auto file = MakeShared<File>(context_, this, fileName.fileName_);
     file->SetName(fileName.ToUri());
     return file;
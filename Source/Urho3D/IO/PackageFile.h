@@ -22,12 +22,24 @@
 
 #pragma once
 
+#include "Urho3D/IO/Compression.h"
+#include "Urho3D/IO/MemoryMappedFile.h"
 #include "Urho3D/IO/MountPoint.h"
 #include "Urho3D/IO/ScanFlags.h"
 
 namespace Urho3D
 {
 
+class WorkQueue;
+
+/// Latest version of package file format. Version 1 adds per-entry codecs and shared compression dictionary.
+/// Version 2 adds block index to compressed entries.
+static const unsigned PACKAGE_FILE_VERSION = 2;
+/// Max size of uncompressed block in compressed package entry.
+static const unsigned PACKAGE_COMPRESSED_BLOCK_SIZE = 32768;
+/// Min size of compressed package entry that is decompressed as a whole in parallel instead of streaming.
+static const unsigned PACKAGE_PARALLEL_DECOMPRESSION_SIZE = 256 * 1024;
+
 /// %File entry within the package file.
 struct PackageEntry
 {
@@ -37,8 +49,23 @@ struct PackageEntry
     unsigned size_;
     /// File checksum.
     unsigned checksum_;
+    /// Compression codec.
+    CompressionCodec codec_{};
+    /// Whether the entry is compressed with the package dictionary.
+    bool useDictionary_{};
+    /// Size of stored data. Unknown (0) for compressed entries of legacy packages.
+    unsigned packedSize_{};
+    /// Offsets of compressed blocks relative to the entry offset, followed by the size of stored data.
+    /// Block with index N contains uncompressed data starting at N * PACKAGE_COMPRESSED_BLOCK_SIZE.
+    /// Empty if the entry is not compressed or the package doesn't have block index.
+    ea::shared_ptr<const ea::vector<unsigned>> blockOffsets_;
 };
 
+/// Decompress sequence of compressed package entry blocks. Blocks are decompressed in parallel if called from main thread.
+/// Return true if successful.
+URHO3D_API bool DecompressPackageBlocks(
+    WorkQueue* workQueue, ByteSpan dest, ConstByteSpan src, CompressionCodec codec, ConstByteSpan dictionary);
+
 /// Stores files of a directory tree sequentially for convenient access.
 class URHO3D_API PackageFile : public MountPoint
 {
@@ -58,6 +85,15 @@ public:
     bool Exists(const ea::string& fileName) const;
     /// Return the file entry corresponding to the name, or null if not found. This will be case-insensitive on Windows and case-sensitive on other platforms.
     const PackageEntry* GetEntry(const ea::string& fileName) const;
+    /// Read and decompress the whole entry. Blocks of compressed entry are decompressed in parallel. Return true if successful.
+    bool ReadEntry(const ea::string& fileName, ByteVector& data);
+
+    /// Enable or disable memory mapping of the package file. Return whether the package is mapped.
+    /// Entries of mapped package are opened as read-only views of mapped memory without any copying.
+    /// Compressed packages and platforms without memory mapping fall back to regular file reads.
+    bool SetMemoryMapped(bool enable);
+    /// Return whether the package file is memory mapped.
+    bool IsMemoryMapped() const { return mappedFile_ != nullptr; }
 
     /// Return all file entries.
     const ea::unordered_map<ea::string, PackageEntry>& GetEntries() const { return entries_; }
@@ -81,10 +117,13 @@ public:
     /// @property
     unsigned GetChecksum() const { return checksum_; }
 
-    /// Return whether the files are compressed.
+    /// Return whether any of the files is compressed.
     /// @property
     bool IsCompressed() const { return compressed_; }
 
+    /// Return shared compression dictionary. May be null.
+    const SharedByteVector& GetDictionary() const { return dictionary_; }
+
     /// Return list of file names in the package.
     const ea::vector<ea::string> GetEntryNames() const { return entries_.keys(); }
 
@@ -129,6 +168,10 @@ private:
     unsigned checksum_;
     /// Compressed flag.
     bool compressed_;
+    /// Shared compression dictionary.
+    SharedByteVector dictionary_;
+    /// Memory mapped package file, if enabled.
+    SharedPtr<MemoryMappedFile> mappedFile_;
 };
 
 }
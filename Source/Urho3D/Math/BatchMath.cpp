@@ -0,0 +1,802 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Math/BatchMath.h"
+
+#include "Urho3D/Core/Assert.h"
+
+#include <SDL_cpuinfo.h>
+
+#ifdef URHO3D_SSE
+    #include <emmintrin.h>
+    #if defined(__x86_64__) || defined(_M_X64)
+        #include <immintrin.h>
+        #define URHO3D_BATCH_MATH_AVX2
+        #if defined(__GNUC__) || defined(__clang__)
+            #define URHO3D_TARGET_AVX2 __attribute__((target("avx2")))
+        #else
+            #define URHO3D_TARGET_AVX2
+        #endif
+    #endif
+#endif
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+SIMDLevel& GetCurrentSIMDLevel()
+{
+    static SIMDLevel level = GetSupportedSIMDLevel();
+    return level;
+}
+
+/// Scalar kernels.
+/// @{
+void TransformPointsScalar(const Matrix3x4& m, const Vector3* points, Vector3* result, unsigned count)
+{
+    for (unsigned i = 0; i < count; ++i)
+    {
+        const Vector3 p = points[i];
+        result[i] = Vector3{
+            m.m00_ * p.x_ + m.m01_ * p.y_ + m.m02_ * p.z_ + m.m03_,
+            m.m10_ * p.x_ + m.m11_ * p.y_ + m.m12_ * p.z_ + m.m13_,
+            m.m20_ * p.x_ + m.m21_ * p.y_ + m.m22_ * p.z_ + m.m23_,
+        };
+    }
+}
+
+/// Transforms are indexed with stride, zero stride is used to apply one transform to all boxes.
+void TransformBoundingBoxesScalar(
+    const Matrix3x4* transforms, unsigned stride, const BoundingBox* boxes, BoundingBox* result, unsigned count)
+{
+    for (unsigned i = 0; i < count; ++i)
+    {
+        const Matrix3x4& m = transforms[i * stride];
+        const Vector3 center = boxes[i].Center();
+        const Vector3 edge = center - boxes[i].min_;
+
+        Vector3 newCenter;
+        TransformPointsScalar(m, &center, &newCenter, 1);
+        const Vector3 newEdge{
+            Abs(m.m00_) * edge.x_ + Abs(m.m01_) * edge.y_ + Abs(m.m02_) * edge.z_,
+            Abs(m.m10_) * edge.x_ + Abs(m.m11_) * edge.y_ + Abs(m.m12_) * edge.z_,
+            Abs(m.m20_) * edge.x_ + Abs(m.m21_) * edge.y_ + Abs(m.m22_) * edge.z_,
+        };
+        result[i] = BoundingBox{newCenter - newEdge, newCenter + newEdge};
+    }
+}
+
+void TestBoundingBoxesScalar(const Frustum& frustum, const BoundingBox* boxes, bool* result, unsigned count)
+{
+    for (unsigned i = 0; i < count; ++i)
+    {
+        const Vector3 center = boxes[i].Center();
+        const Vector3 edge = center - boxes[i].min_;
+
+        bool isInside = true;
+        for (const Plane& plane : frustum.planes_)
+        {
+            const float dist = plane.normal_.DotProduct(center) + plane.d_;
+            const float absDist = plane.absNormal_.DotProduct(edge);
+            if (dist < -absDist)
+            {
+                isInside = false;
+                break;
+            }
+        }
+        result[i] = isInside;
+    }
+}
+
+void MultiplyMatricesScalar(const Matrix3x4* lhs, const Matrix3x4* rhs, Matrix3x4* result, unsigned count)
+{
+    for (unsigned i = 0; i < count; ++i)
+    {
+        const Matrix3x4& l = lhs[i];
+        const Matrix3x4& r = rhs[i];
+        result[i] = Matrix3x4{
+            l.m00_ * r.m00_ + l.m01_ * r.m10_ + l.m02_ * r.m20_,
+            l.m00_ * r.m01_ + l.m01_ * r.m11_ + l.m02_ * r.m21_,
+            l.m00_ * r.m02_ + l.m01_ * r.m12_ + l.m02_ * r.m22_,
+            l.m00_ * r.m03_ + l.m01_ * r.m13_ + l.m02_ * r.m23_ + l.m03_,
+            l.m10_ * r.m00_ + l.m11_ * r.m10_ + l.m12_ * r.m20_,
+            l.m10_ * r.m01_ + l.m11_ * r.m11_ + l.m12_ * r.m21_,
+            l.m10_ * r.m02_ + l.m11_ * r.m12_ + l.m12_ * r.m22_,
+            l.m10_ * r.m03_ + l.m11_ * r.m13_ + l.m12_ * r.m23_ + l.m13_,
+            l.m20_ * r.m00_ + l.m21_ * r.m10_ + l.m22_ * r.m20_,
+            l.m20_ * r.m01_ + l.m21_ * r.m11_ + l.m22_ * r.m21_,
+            l.m20_ * r.m02_ + l.m21_ * r.m12_ + l.m22_ * r.m22_,
+            l.m20_ * r.m03_ + l.m21_ * r.m13_ + l.m22_ * r.m23_ + l.m23_,
+        };
+    }
+}
+
+/// Integer overflow wraps around, same as incremental stepping.
+int GetLinearSpanValue(int first, int step, unsigned index)
+{
+    return static_cast<int>(static_cast<unsigned>(first) + static_cast<unsigned>(step) * index);
+}
+
+void MinLinearSpanScalar(int* values, unsigned count, int first, int step)
+{
+    for (unsigned i = 0; i < count; ++i)
+    {
+        const int value = GetLinearSpanValue(first, step, i);
+        if (value < values[i])
+            values[i] = value;
+    }
+}
+
+/// Element-wise operation on vectors of floats.
+enum class VectorOperation
+{
+    Add,
+    Subtract,
+    Multiply,
+    MultiplyAdd,
+};
+
+/// Repeated operand is expanded so that any chunk of 4 or 8 floats can be loaded at once.
+/// Period is divisible by any number of components and by SIMD width.
+static constexpr unsigned RepeatPeriod = 24;
+
+/// Operand of element-wise operation, addressed per float.
+struct VectorOperand
+{
+    VectorOperand(const BatchOperand& operand, unsigned numComponents)
+        : data_(operand.data_)
+        , repeat_(operand.repeat_)
+    {
+        if (repeat_)
+        {
+            for (unsigned i = 0; i < RepeatPeriod; ++i)
+                pattern_[i] = operand.data_[i % numComponents];
+        }
+    }
+
+    /// Return pointer to floats starting at offset. Offset should be aligned to SIMD width for SIMD loads.
+    const float* At(unsigned offset) const { return repeat_ ? pattern_ + offset % RepeatPeriod : data_ + offset; }
+
+    const float* data_{};
+    bool repeat_{};
+    float pattern_[RepeatPeriod];
+};
+
+template <VectorOperation Op> inline float ApplyVectorOperation(float lhs, float rhs, float scale)
+{
+    if constexpr (Op == VectorOperation::Add)
+        return lhs + rhs;
+    else if constexpr (Op == VectorOperation::Subtract)
+        return lhs - rhs;
+    else if constexpr (Op == VectorOperation::Multiply)
+        return lhs * rhs;
+    else
+        return lhs + rhs * scale;
+}
+
+template <VectorOperation Op>
+void ProcessVectorsScalar(
+    const VectorOperand& lhs, const VectorOperand& rhs, float scale, float* result, unsigned begin, unsigned end)
+{
+    for (unsigned i = begin; i < end; ++i)
+        result[i] = ApplyVectorOperation<Op>(*lhs.At(i), *rhs.At(i), scale);
+}
+/// @}
+
+#ifdef URHO3D_SSE
+
+/// SSE kernels. Process 4 elements at once where possible.
+/// @{
+void TransformPointsSSE(const Matrix3x4& m, const Vector3* points, Vector3* result, unsigned count)
+{
+    const __m128 m00 = _mm_set1_ps(m.m00_), m01 = _mm_set1_ps(m.m01_), m02 = _mm_set1_ps(m.m02_), m03 = _mm_set1_ps(m.m03_);
+    const __m128 m10 = _mm_set1_ps(m.m10_), m11 = _mm_set1_ps(m.m11_), m12 = _mm_set1_ps(m.m12_), m13 = _mm_set1_ps(m.m13_);
+    const __m128 m20 = _mm_set1_ps(m.m20_), m21 = _mm_set1_ps(m.m21_), m22 = _mm_set1_ps(m.m22_), m23 = _mm_set1_ps(m.m23_);
+
+    unsigned i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        // Deinterleave 4 points: x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3
+        const float* src = &points[i].x_;
+        const __m128 a = _mm_loadu_ps(src);
+        const __m128 b = _mm_loadu_ps(src + 4);
+        const __m128 c = _mm_loadu_ps(src + 8);
+
+        const __m128 x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+        const __m128 y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)),
+            _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+        const __m128 z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)),
+            _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+
+        const __m128 rx = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, x), _mm_mul_ps(m01, y)), _mm_mul_ps(m02, z)), m03);
+        const __m128 ry = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m10, x), _mm_mul_ps(m11, y)), _mm_mul_ps(m12, z)), m13);
+        const __m128 rz = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m20, x), _mm_mul_ps(m21, y)), _mm_mul_ps(m22, z)), m23);
+
+        // Interleave back
+        float* dest = &result[i].x_;
+        _mm_storeu_ps(dest, _mm_shuffle_ps(_mm_shuffle_ps(rx, ry, _MM_SHUFFLE(0, 0, 0, 0)),
+            _mm_shuffle_ps(rz, rx, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(dest + 4, _mm_shuffle_ps(_mm_shuffle_ps(ry, rz, _MM_SHUFFLE(1, 1, 1, 1)),
+            _mm_shuffle_ps(rx, ry, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(dest + 8, _mm_shuffle_ps(_mm_shuffle_ps(rz, rx, _MM_SHUFFLE(3, 3, 2, 2)),
+            _mm_shuffle_ps(ry, rz, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+    }
+
+    TransformPointsScalar(m, points + i, result + i, count - i);
+}
+
+void TransformBoundingBoxesSSE(
+    const Matrix3x4* transforms, unsigned stride, const BoundingBox* boxes, BoundingBox* result, unsigned count)
+{
+    for (unsigned i = 0; i < count; ++i)
+        result[i] = boxes[i].Transformed(transforms[i * stride]);
+}
+
+void TestBoundingBoxesSSE(const Frustum& frustum, const BoundingBox* boxes, bool* result, unsigned count)
+{
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 zero = _mm_setzero_ps();
+
+    unsigned i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 minX = _mm_loadu_ps(&boxes[i].min_.x_);
+        __m128 minY = _mm_loadu_ps(&boxes[i + 1].min_.x_);
+        __m128 minZ = _mm_loadu_ps(&boxes[i + 2].min_.x_);
+        __m128 minW = _mm_loadu_ps(&boxes[i + 3].min_.x_);
+        _MM_TRANSPOSE4_PS(minX, minY, minZ, minW);
+
+        __m128 maxX = _mm_loadu_ps(&boxes[i].max_.x_);
+        __m128 maxY = _mm_loadu_ps(&boxes[i + 1].max_.x_);
+        __m128 maxZ = _mm_loadu_ps(&boxes[i + 2].max_.x_);
+        __m128 maxW = _mm_loadu_ps(&boxes[i + 3].max_.x_);
+        _MM_TRANSPOSE4_PS(maxX, maxY, maxZ, maxW);
+
+        const __m128 centerX = _mm_mul_ps(_mm_add_ps(minX, maxX), half);
+        const __m128 centerY = _mm_mul_ps(_mm_add_ps(minY, maxY), half);
+        const __m128 centerZ = _mm_mul_ps(_mm_add_ps(minZ, maxZ), half);
+        const __m128 edgeX = _mm_sub_ps(centerX, minX);
+        const __m128 edgeY = _mm_sub_ps(centerY, minY);
+        const __m128 edgeZ = _mm_sub_ps(centerZ, minZ);
+
+        __m128 outside = zero;
+        for (const Plane& plane : frustum.planes_)
+        {
+            const __m128 dist = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+                _mm_mul_ps(_mm_set1_ps(plane.normal_.x_), centerX),
+                _mm_mul_ps(_mm_set1_ps(plane.normal_.y_), centerY)),
+                _mm_mul_ps(_mm_set1_ps(plane.normal_.z_), centerZ)),
+                _mm_set1_ps(plane.d_));
+            const __m128 absDist = _mm_add_ps(_mm_add_ps(
+                _mm_mul_ps(_mm_set1_ps(plane.absNormal_.x_), edgeX),
+                _mm_mul_ps(_mm_set1_ps(plane.absNormal_.y_), edgeY)),
+                _mm_mul_ps(_mm_set1_ps(plane.absNormal_.z_), edgeZ));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(dist, _mm_sub_ps(zero, absDist)));
+        }
+
+        const int mask = _mm_movemask_ps(outside);
+        for (unsigned j = 0; j < 4; ++j)
+            result[i + j] = !(mask & (1 << j));
+    }
+
+    TestBoundingBoxesScalar(frustum, boxes + i, result + i, count - i);
+}
+
+void MultiplyMatricesSSE(const Matrix3x4* lhs, const Matrix3x4* rhs, Matrix3x4* result, unsigned count)
+{
+    for (unsigned i = 0; i < count; ++i)
+        result[i] = lhs[i] * rhs[i];
+}
+
+void MinLinearSpanSSE(int* values, unsigned count, int first, int step)
+{
+    // SSE2 has no integer min, so select with comparison mask
+    __m128i value = _mm_setr_epi32(first, GetLinearSpanValue(first, step, 1), GetLinearSpanValue(first, step, 2),
+        GetLinearSpanValue(first, step, 3));
+    const __m128i valueStep = _mm_set1_epi32(GetLinearSpanValue(0, step, 4));
+
+    unsigned i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        auto dest = reinterpret_cast<__m128i*>(values + i);
+        const __m128i oldValue = _mm_loadu_si128(dest);
+        const __m128i isLess = _mm_cmplt_epi32(value, oldValue);
+        _mm_storeu_si128(dest, _mm_or_si128(_mm_and_si128(isLess, value), _mm_andnot_si128(isLess, oldValue)));
+        value = _mm_add_epi32(value, valueStep);
+    }
+
+    MinLinearSpanScalar(values + i, count - i, GetLinearSpanValue(first, step, i), step);
+}
+
+template <VectorOperation Op> inline __m128 ApplyVectorOperationSSE(__m128 lhs, __m128 rhs, __m128 scale)
+{
+    if constexpr (Op == VectorOperation::Add)
+        return _mm_add_ps(lhs, rhs);
+    else if constexpr (Op == VectorOperation::Subtract)
+        return _mm_sub_ps(lhs, rhs);
+    else if constexpr (Op == VectorOperation::Multiply)
+        return _mm_mul_ps(lhs, rhs);
+    else
+        return _mm_add_ps(lhs, _mm_mul_ps(rhs, scale));
+}
+
+template <VectorOperation Op>
+void ProcessVectorsSSE(const VectorOperand& lhs, const VectorOperand& rhs, float scale, float* result, unsigned count)
+{
+    const __m128 scaleVec = _mm_set1_ps(scale);
+
+    unsigned i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 value = ApplyVectorOperationSSE<Op>(_mm_loadu_ps(lhs.At(i)), _mm_loadu_ps(rhs.At(i)), scaleVec);
+        _mm_storeu_ps(result + i, value);
+    }
+
+    ProcessVectorsScalar<Op>(lhs, rhs, scale, result, i, count);
+}
+/// @}
+
+#endif
+
+#ifdef URHO3D_BATCH_MATH_AVX2
+
+/// AVX2 kernels. Process 8 elements at once where possible.
+/// @{
+URHO3D_TARGET_AVX2 inline __m256 LoadTwoHalves(const float* low, const float* high)
+{
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(low)), _mm_loadu_ps(high), 1);
+}
+
+URHO3D_TARGET_AVX2 inline void StoreTwoHalves(float* low, float* high, __m256 value)
+{
+    _mm_storeu_ps(low, _mm256_castps256_ps128(value));
+    _mm_storeu_ps(high, _mm256_extractf128_ps(value, 1));
+}
+
+/// Transpose 8x8 matrix stored in rows.
+URHO3D_TARGET_AVX2 inline void Transpose8x8(__m256* rows)
+{
+    const __m256 t0 = _mm256_unpacklo_ps(rows[0], rows[1]);
+    const __m256 t1 = _mm256_unpackhi_ps(rows[0], rows[1]);
+    const __m256 t2 = _mm256_unpacklo_ps(rows[2], rows[3]);
+    const __m256 t3 = _mm256_unpackhi_ps(rows[2], rows[3]);
+    const __m256 t4 = _mm256_unpacklo_ps(rows[4], rows[5]);
+    const __m256 t5 = _mm256_unpackhi_ps(rows[4], rows[5]);
+    const __m256 t6 = _mm256_unpacklo_ps(rows[6], rows[7]);
+    const __m256 t7 = _mm256_unpackhi_ps(rows[6], rows[7]);
+
+    const __m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+
+    rows[0] = _mm256_permute2f128_ps(s0, s4, 0x20);
+    rows[1] = _mm256_permute2f128_ps(s1, s5, 0x20);
+    rows[2] = _mm256_permute2f128_ps(s2, s6, 0x20);
+    rows[3] = _mm256_permute2f128_ps(s3, s7, 0x20);
+    rows[4] = _mm256_permute2f128_ps(s0, s4, 0x31);
+    rows[5] = _mm256_permute2f128_ps(s1, s5, 0x31);
+    rows[6] = _mm256_permute2f128_ps(s2, s6, 0x31);
+    rows[7] = _mm256_permute2f128_ps(s3, s7, 0x31);
+}
+
+URHO3D_TARGET_AVX2 void TransformPointsAVX2(const Matrix3x4& m, const Vector3* points, Vector3* result, unsigned count)
+{
+    const __m256 m00 = _mm256_set1_ps(m.m00_), m01 = _mm256_set1_ps(m.m01_), m02 = _mm256_set1_ps(m.m02_), m03 = _mm256_set1_ps(m.m03_);
+    const __m256 m10 = _mm256_set1_ps(m.m10_), m11 = _mm256_set1_ps(m.m11_), m12 = _mm256_set1_ps(m.m12_), m13 = _mm256_set1_ps(m.m13_);
+    const __m256 m20 = _mm256_set1_ps(m.m20_), m21 = _mm256_set1_ps(m.m21_), m22 = _mm256_set1_ps(m.m22_), m23 = _mm256_set1_ps(m.m23_);
+
+    unsigned i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        // Points 0-3 go to low lanes and points 4-7 go to high lanes, then deinterleave lane-wise as in SSE version
+        const float* src = &points[i].x_;
+        const __m256 a = LoadTwoHalves(src, src + 12);
+        const __m256 b = LoadTwoHalves(src + 4, src + 16);
+        const __m256 c = LoadTwoHalves(src + 8, src + 20);
+
+        const __m256 x = _mm256_shuffle_ps(a, _mm256_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+        const __m256 y = _mm256_shuffle_ps(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)),
+            _mm256_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+        const __m256 z = _mm256_shuffle_ps(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)),
+            _mm256_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+
+        const __m256 rx = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+            _mm256_mul_ps(m00, x), _mm256_mul_ps(m01, y)), _mm256_mul_ps(m02, z)), m03);
+        const __m256 ry = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+            _mm256_mul_ps(m10, x), _mm256_mul_ps(m11, y)), _mm256_mul_ps(m12, z)), m13);
+        const __m256 rz = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+            _mm256_mul_ps(m20, x), _mm256_mul_ps(m21, y)), _mm256_mul_ps(m22, z)), m23);
+
+        float* dest = &result[i].x_;
+        StoreTwoHalves(dest, dest + 12, _mm256_shuffle_ps(_mm256_shuffle_ps(rx, ry, _MM_SHUFFLE(0, 0, 0, 0)),
+            _mm256_shuffle_ps(rz, rx, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0)));
+        StoreTwoHalves(dest + 4, dest + 16, _mm256_shuffle_ps(_mm256_shuffle_ps(ry, rz, _MM_SHUFFLE(1, 1, 1, 1)),
+            _mm256_shuffle_ps(rx, ry, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0)));
+        StoreTwoHalves(dest + 8, dest + 20, _mm256_shuffle_ps(_mm256_shuffle_ps(rz, rx, _MM_SHUFFLE(3, 3, 2, 2)),
+            _mm256_shuffle_ps(ry, rz, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+    }
+
+    TransformPointsSSE(m, points + i, result + i, count - i);
+}
+
+URHO3D_TARGET_AVX2 void TransformBoundingBoxesAVX2(
+    const Matrix3x4* transforms, unsigned stride, const BoundingBox* boxes, BoundingBox* result, unsigned count)
+{
+    static_assert(sizeof(BoundingBox) == 8 * sizeof(float), "Unexpected BoundingBox layout");
+    static_assert(sizeof(Matrix3x4) == 12 * sizeof(float), "Unexpected Matrix3x4 layout");
+
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    const __m256i matrixOffsets = _mm256_mullo_epi32(
+        _mm256_setr_epi32(0, 12, 24, 36, 48, 60, 72, 84), _mm256_set1_epi32(static_cast<int>(stride)));
+
+    unsigned i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        // Load 8 boxes as columns: min x, y, z, pad, max x, y, z, pad
+        __m256 box[8];
+        for (unsigned j = 0; j < 8; ++j)
+            box[j] = _mm256_loadu_ps(&boxes[i + j].min_.x_);
+        Transpose8x8(box);
+
+        // Load 8 matrices as columns
+        __m256 m[12];
+        const float* matrixData = &transforms[i * stride].m00_;
+        for (unsigned j = 0; j < 12; ++j)
+            m[j] = _mm256_i32gather_ps(matrixData + j, matrixOffsets, 4);
+
+        const __m256 centerX = _mm256_mul_ps(_mm256_add_ps(box[0], box[4]), half);
+        const __m256 centerY = _mm256_mul_ps(_mm256_add_ps(box[1], box[5]), half);
+        const __m256 centerZ = _mm256_mul_ps(_mm256_add_ps(box[2], box[6]), half);
+        const __m256 edgeX = _mm256_sub_ps(centerX, box[0]);
+        const __m256 edgeY = _mm256_sub_ps(centerY, box[1]);
+        const __m256 edgeZ = _mm256_sub_ps(centerZ, box[2]);
+
+        __m256 newCenter[3];
+        __m256 newEdge[3];
+        for (unsigned row = 0; row < 3; ++row)
+        {
+            const __m256 r0 = m[row * 4], r1 = m[row * 4 + 1], r2 = m[row * 4 + 2], r3 = m[row * 4 + 3];
+            newCenter[row] = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+                _mm256_mul_ps(r0, centerX), _mm256_mul_ps(r1, centerY)), _mm256_mul_ps(r2, centerZ)), r3);
+            newEdge[row] = _mm256_add_ps(_mm256_add_ps(
+                _mm256_mul_ps(_mm256_and_ps(r0, absMask), edgeX),
+                _mm256_mul_ps(_mm256_and_ps(r1, absMask), edgeY)),
+                _mm256_mul_ps(_mm256_and_ps(r2, absMask), edgeZ));
+        }
+
+        const __m256 zero = _mm256_setzero_ps();
+        box[0] = _mm256_sub_ps(newCenter[0], newEdge[0]);
+        box[1] = _mm256_sub_ps(newCenter[1], newEdge[1]);
+        box[2] = _mm256_sub_ps(newCenter[2], newEdge[2]);
+        box[3] = zero;
+        box[4] = _mm256_add_ps(newCenter[0], newEdge[0]);
+        box[5] = _mm256_add_ps(newCenter[1], newEdge[1]);
+        box[6] = _mm256_add_ps(newCenter[2], newEdge[2]);
+        box[7] = zero;
+        Transpose8x8(box);
+        for (unsigned j = 0; j < 8; ++j)
+            _mm256_storeu_ps(&result[i + j].min_.x_, box[j]);
+    }
+
+    TransformBoundingBoxesSSE(transforms + i * stride, stride, boxes + i, result + i, count - i);
+}
+
+URHO3D_TARGET_AVX2 void TestBoundingBoxesAVX2(const Frustum& frustum, const BoundingBox* boxes, bool* result, unsigned count)
+{
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 zero = _mm256_setzero_ps();
+
+    unsigned i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 box[8];
+        for (unsigned j = 0; j < 8; ++j)
+            box[j] = _mm256_loadu_ps(&boxes[i + j].min_.x_);
+        Transpose8x8(box);
+
+        const __m256 centerX = _mm256_mul_ps(_mm256_add_ps(box[0], box[4]), half);
+        const __m256 centerY = _mm256_mul_ps(_mm256_add_ps(box[1], box[5]), half);
+        const __m256 centerZ = _mm256_mul_ps(_mm256_add_ps(box[2], box[6]), half);
+        const __m256 edgeX = _mm256_sub_ps(centerX, box[0]);
+        const __m256 edgeY = _mm256_sub_ps(centerY, box[1]);
+        const __m256 edgeZ = _mm256_sub_ps(centerZ, box[2]);
+
+        __m256 outside = zero;
+        for (const Plane& plane : frustum.planes_)
+        {
+            const __m256 dist = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+                _mm256_mul_ps(_mm256_set1_ps(plane.normal_.x_), centerX),
+                _mm256_mul_ps(_mm256_set1_ps(plane.normal_.y_), centerY)),
+                _mm256_mul_ps(_mm256_set1_ps(plane.normal_.z_), centerZ)),
+                _mm256_set1_ps(plane.d_));
+            const __m256 absDist = _mm256_add_ps(_mm256_add_ps(
+                _mm256_mul_ps(_mm256_set1_ps(plane.absNormal_.x_), edgeX),
+                _mm256_mul_ps(_mm256_set1_ps(plane.absNormal_.y_), edgeY)),
+                _mm256_mul_ps(_mm256_set1_ps(plane.absNormal_.z_), edgeZ));
+            outside = _mm256_or_ps(outside, _mm256_cmp_ps(dist, _mm256_sub_ps(zero, absDist), _CMP_LT_OQ));
+        }
+
+        const int mask = _mm256_movemask_ps(outside);
+        for (unsigned j = 0; j < 8; ++j)
+            result[i + j] = !(mask & (1 << j));
+    }
+
+    TestBoundingBoxesSSE(frustum, boxes + i, result + i, count - i);
+}
+
+URHO3D_TARGET_AVX2 void MultiplyMatricesAVX2(const Matrix3x4* lhs, const Matrix3x4* rhs, Matrix3x4* result, unsigned count)
+{
+    const __m256 r3 = _mm256_setr_ps(0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f);
+
+    // Multiply two pairs at once, one in each lane
+    unsigned i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        const Matrix3x4& ra = rhs[i];
+        const Matrix3x4& rb = rhs[i + 1];
+        const __m256 r0 = LoadTwoHalves(&ra.m00_, &rb.m00_);
+        const __m256 r1 = LoadTwoHalves(&ra.m10_, &rb.m10_);
+        const __m256 r2 = LoadTwoHalves(&ra.m20_, &rb.m20_);
+
+        const Matrix3x4& la = lhs[i];
+        const Matrix3x4& lb = lhs[i + 1];
+        __m256 rows[3];
+        for (unsigned row = 0; row < 3; ++row)
+        {
+            const __m256 l = LoadTwoHalves(&la.m00_ + row * 4, &lb.m00_ + row * 4);
+            const __m256 t0 = _mm256_mul_ps(_mm256_permute_ps(l, _MM_SHUFFLE(0, 0, 0, 0)), r0);
+            const __m256 t1 = _mm256_mul_ps(_mm256_permute_ps(l, _MM_SHUFFLE(1, 1, 1, 1)), r1);
+            const __m256 t2 = _mm256_mul_ps(_mm256_permute_ps(l, _MM_SHUFFLE(2, 2, 2, 2)), r2);
+            const __m256 t3 = _mm256_mul_ps(l, r3);
+            rows[row] = _mm256_add_ps(_mm256_add_ps(t0, t1), _mm256_add_ps(t2, t3));
+        }
+
+        Matrix3x4& outa = result[i];
+        Matrix3x4& outb = result[i + 1];
+        for (unsigned row = 0; row < 3; ++row)
+            StoreTwoHalves(&outa.m00_ + row * 4, &outb.m00_ + row * 4, rows[row]);
+    }
+
+    MultiplyMatricesSSE(lhs + i, rhs + i, result + i, count - i);
+}
+
+URHO3D_TARGET_AVX2 void MinLinearSpanAVX2(int* values, unsigned count, int first, int step)
+{
+    const __m256i offsets = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i value = _mm256_add_epi32(_mm256_set1_epi32(first), _mm256_mullo_epi32(offsets, _mm256_set1_epi32(step)));
+    const __m256i valueStep = _mm256_set1_epi32(GetLinearSpanValue(0, step, 8));
+
+    unsigned i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        auto dest = reinterpret_cast<__m256i*>(values + i);
+        _mm256_storeu_si256(dest, _mm256_min_epi32(value, _mm256_loadu_si256(dest)));
+        value = _mm256_add_epi32(value, valueStep);
+    }
+
+    MinLinearSpanSSE(values + i, count - i, GetLinearSpanValue(first, step, i), step);
+}
+
+/// Multiplication and addition are not fused so that results match other instruction sets exactly.
+template <VectorOperation Op> URHO3D_TARGET_AVX2 inline __m256 ApplyVectorOperationAVX2(__m256 lhs, __m256 rhs, __m256 scale)
+{
+    if constexpr (Op == VectorOperation::Add)
+        return _mm256_add_ps(lhs, rhs);
+    else if constexpr (Op == VectorOperation::Subtract)
+        return _mm256_sub_ps(lhs, rhs);
+    else if constexpr (Op == VectorOperation::Multiply)
+        return _mm256_mul_ps(lhs, rhs);
+    else
+        return _mm256_add_ps(lhs, _mm256_mul_ps(rhs, scale));
+}
+
+template <VectorOperation Op>
+URHO3D_TARGET_AVX2 void ProcessVectorsAVX2(
+    const VectorOperand& lhs, const VectorOperand& rhs, float scale, float* result, unsigned count)
+{
+    const __m256 scaleVec = _mm256_set1_ps(scale);
+
+    unsigned i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256 value =
+            ApplyVectorOperationAVX2<Op>(_mm256_loadu_ps(lhs.At(i)), _mm256_loadu_ps(rhs.At(i)), scaleVec);
+        _mm256_storeu_ps(result + i, value);
+    }
+
+    ProcessVectorsScalar<Op>(lhs, rhs, scale, result, i, count);
+}
+/// @}
+
+#endif
+
+template <VectorOperation Op>
+void ProcessVectors(const BatchOperand& lhs, const BatchOperand& rhs, float scale, float* result, unsigned count,
+    unsigned numComponents)
+{
+    URHO3D_ASSERT(numComponents >= 1 && numComponents <= 4);
+    const VectorOperand lhsOperand{lhs, numComponents};
+    const VectorOperand rhsOperand{rhs, numComponents};
+    const unsigned numFloats = count * numComponents;
+
+    switch (GetCurrentSIMDLevel())
+    {
+#ifdef URHO3D_BATCH_MATH_AVX2
+    case SIMDLevel::AVX2: ProcessVectorsAVX2<Op>(lhsOperand, rhsOperand, scale, result, numFloats); break;
+#endif
+#ifdef URHO3D_SSE
+    case SIMDLevel::SSE: ProcessVectorsSSE<Op>(lhsOperand, rhsOperand, scale, result, numFloats); break;
+#endif
+    default: ProcessVectorsScalar<Op>(lhsOperand, rhsOperand, scale, result, 0, numFloats); break;
+    }
+}
+
+}
+
+SIMDLevel GetSupportedSIMDLevel()
+{
+    static const SIMDLevel supportedLevel = []
+    {
+#ifdef URHO3D_BATCH_MATH_AVX2
+        if (SDL_HasAVX2())
+            return SIMDLevel::AVX2;
+#endif
+#ifdef URHO3D_SSE
+        return SIMDLevel::SSE;
+#else
+        return SIMDLevel::Scalar;
+#endif
+    }();
+    return supportedLevel;
+}
+
+SIMDLevel GetSIMDLevel()
+{
+    return GetCurrentSIMDLevel();
+}
+
+void SetSIMDLevel(SIMDLevel level)
+{
+    GetCurrentSIMDLevel() = ea::min(level, GetSupportedSIMDLevel());
+}
+
+void TransformPoints(const Matrix3x4& transform, const Vector3* points, Vector3* result, unsigned count)
+{
+    switch (GetCurrentSIMDLevel())
+    {
+#ifdef URHO3D_BATCH_MATH_AVX2
+    case SIMDLevel::AVX2: TransformPointsAVX2(transform, points, result, count); break;
+#endif
+#ifdef URHO3D_SSE
+    case SIMDLevel::SSE: TransformPointsSSE(transform, points, result, count); break;
+#endif
+    default: TransformPointsScalar(transform, points, result, count); break;
+    }
+}
+
+void TransformBoundingBoxes(const Matrix3x4* transforms, const BoundingBox* boxes, BoundingBox* result, unsigned count)
+{
+    switch (GetCurrentSIMDLevel())
+    {
+#ifdef URHO3D_BATCH_MATH_AVX2
+    case SIMDLevel::AVX2: TransformBoundingBoxesAVX2(transforms, 1, boxes, result, count); break;
+#endif
+#ifdef URHO3D_SSE
+    case SIMDLevel::SSE: TransformBoundingBoxesSSE(transforms, 1, boxes, result, count); break;
+#endif
+    default: TransformBoundingBoxesScalar(transforms, 1, boxes, result, count); break;
+    }
+}
+
+void TransformBoundingBoxes(const Matrix3x4& transform, const BoundingBox* boxes, BoundingBox* result, unsigned count)
+{
+    switch (GetCurrentSIMDLevel())
+    {
+#ifdef URHO3D_BATCH_MATH_AVX2
+    case SIMDLevel::AVX2: TransformBoundingBoxesAVX2(&transform, 0, boxes, result, count); break;
+#endif
+#ifdef URHO3D_SSE
+    case SIMDLevel::SSE: TransformBoundingBoxesSSE(&transform, 0, boxes, result, count); break;
+#endif
+    default: TransformBoundingBoxesScalar(&transform, 0, boxes, result, count); break;
+    }
+}
+
+void TestBoundingBoxes(const Frustum& frustum, const BoundingBox* boxes, bool* result, unsigned count)
+{
+    switch (GetCurrentSIMDLevel())
+    {
+#ifdef URHO3D_BATCH_MATH_AVX2
+    case SIMDLevel::AVX2: TestBoundingBoxesAVX2(frustum, boxes, result, count); break;
+#endif
+#ifdef URHO3D_SSE
+    case SIMDLevel::SSE: TestBoundingBoxesSSE(frustum, boxes, result, count); break;
+#endif
+    default: TestBoundingBoxesScalar(frustum, boxes, result, count); break;
+    }
+}
+
+void MultiplyMatrices(const Matrix3x4* lhs, const Matrix3x4* rhs, Matrix3x4* result, unsigned count)
+{
+    switch (GetCurrentSIMDLevel())
+    {
+#ifdef URHO3D_BATCH_MATH_AVX2
+    case SIMDLevel::AVX2: MultiplyMatricesAVX2(lhs, rhs, result, count); break;
+#endif
+#ifdef URHO3D_SSE
+    case SIMDLevel::SSE: MultiplyMatricesSSE(lhs, rhs, result, count); break;
+#endif
+    default: MultiplyMatricesScalar(lhs, rhs, result, count); break;
+    }
+}
+
+void MinLinearSpan(int* values, unsigned count, int first, int step)
+{
+    switch (GetCurrentSIMDLevel())
+    {
+#ifdef URHO3D_BATCH_MATH_AVX2
+    case SIMDLevel::AVX2: MinLinearSpanAVX2(values, count, first, step); break;
+#endif
+#ifdef URHO3D_SSE
+    case SIMDLevel::SSE: MinLinearSpanSSE(values, count, first, step); break;
+#endif
+    default: MinLinearSpanScalar(values, count, first, step); break;
+    }
+}
+
+void AddVectors(
+    const BatchOperand& lhs, const BatchOperand& rhs, float* result, unsigned count, unsigned numComponents)
+{
+    ProcessVectors<VectorOperation::Add>(lhs, rhs, 0.0f, result, count, numComponents);
+}
+
+void SubtractVectors(
+    const BatchOperand& lhs, const BatchOperand& rhs, float* result, unsigned count, unsigned numComponents)
+{
+    ProcessVectors<VectorOperation::Subtract>(lhs, rhs, 0.0f, result, count, numComponents);
+}
+
+void MultiplyVectors(
+    const BatchOperand& lhs, const BatchOperand& rhs, float* result, unsigned count, unsigned numComponents)
+{
+    ProcessVectors<VectorOperation::Multiply>(lhs, rhs, 0.0f, result, count, numComponents);
+}
+
+void MultiplyAddVectors(const BatchOperand& lhs, const BatchOperand& rhs, float scale, float* result,
+    unsigned count, unsigned numComponents)
+{
+    ProcessVectors<VectorOperation::MultiplyAdd>(lhs, rhs, scale, result, count, numComponents);
+}
+
+}
@@ -0,0 +1,87 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "Urho3D/Math/BoundingBox.h"
+#include "Urho3D/Math/Frustum.h"
+#include "Urho3D/Math/Matrix3x4.h"
+#include "Urho3D/Math/Vector3.h"
+
+#include <Urho3D/Urho3D.h>
+
+namespace Urho3D
+{
+
+/// Instruction set used by batch math functions.
+enum class SIMDLevel
+{
+    Scalar,
+    SSE,
+    AVX2,
+};
+
+/// Operand of element-wise batch operations on vectors of floats.
+struct BatchOperand
+{
+    /// Components of the first vector. Vectors are stored contiguously.
+    const float* data_{};
+    /// Whether the first vector is used for all elements.
+    bool repeat_{};
+};
+
+/// Return best instruction set supported by both the build and the CPU. Detected once.
+URHO3D_API SIMDLevel GetSupportedSIMDLevel();
+/// Return instruction set currently used by batch math functions.
+URHO3D_API SIMDLevel GetSIMDLevel();
+/// Override instruction set used by batch math functions. Clamped to supported level. Not thread-safe.
+URHO3D_API void SetSIMDLevel(SIMDLevel level);
+
+/// Transform points by one matrix. Input and output may be the same array.
+URHO3D_API void TransformPoints(const Matrix3x4& transform, const Vector3* points, Vector3* result, unsigned count);
+/// Transform bounding boxes by corresponding matrices. Input and output may be the same array.
+URHO3D_API void TransformBoundingBoxes(
+    const Matrix3x4* transforms, const BoundingBox* boxes, BoundingBox* result, unsigned count);
+/// Transform bounding boxes by one matrix. Input and output may be the same array.
+URHO3D_API void TransformBoundingBoxes(
+    const Matrix3x4& transform, const BoundingBox* boxes, BoundingBox* result, unsigned count);
+/// Test bounding boxes against frustum. Result is true if box is (partially) inside, same as Frustum::IsInsideFast.
+URHO3D_API void TestBoundingBoxes(const Frustum& frustum, const BoundingBox* boxes, bool* result, unsigned count);
+/// Multiply pairs of matrices. Output may be the same array as any of inputs.
+URHO3D_API void MultiplyMatrices(const Matrix3x4* lhs, const Matrix3x4* rhs, Matrix3x4* result, unsigned count);
+/// Set each value to the minimum of itself and `first + index * step`. Used to rasterize depth spans.
+URHO3D_API void MinLinearSpan(int* values, unsigned count, int first, int step);
+
+/// Add vectors of 1-4 components, `result = lhs + rhs`. Output may be the same array as any of inputs.
+URHO3D_API void AddVectors(
+    const BatchOperand& lhs, const BatchOperand& rhs, float* result, unsigned count, unsigned numComponents);
+/// Subtract vectors of 1-4 components, `result = lhs - rhs`. Output may be the same array as any of inputs.
+URHO3D_API void SubtractVectors(
+    const BatchOperand& lhs, const BatchOperand& rhs, float* result, unsigned count, unsigned numComponents);
+/// Multiply vectors of 1-4 components per component, `result = lhs * rhs`. Output may be the same array as any of inputs.
+URHO3D_API void MultiplyVectors(
+    const BatchOperand& lhs, const BatchOperand& rhs, float* result, unsigned count, unsigned numComponents);
+/// Add scaled vectors of 1-4 components, `result = lhs + rhs * scale`. Output may be the same array as any of inputs.
+URHO3D_API void MultiplyAddVectors(const BatchOperand& lhs, const BatchOperand& rhs, float scale, float* result,
+    unsigned count, unsigned numComponents);
+
+}
@@ -609,6 +609,20 @@ void CrowdAgent::OnCrowdPositionUpdate(dtCrowdAgent* ag, float* /*pos*/, float d
     }
 }
 
+void CrowdAgent::OnCrowdLodInterpolate(dtCrowdAgent* ag, float elapsedTime)
+{
+    assert (ag);
+    if (node_ && updateNodePosition_ && ag->state == DT_CROWDAGENT_STATE_WALKING)
+    {
+        Vector3 newPos = Vector3(ag->npos) + Vector3(ag->vel) * elapsedTime;
+        crowdManager_->UpdateAgentPosition(this, elapsedTime, newPos);
+
+        ignoreTransformChanges_ = true;
+        node_->SetWorldPosition(newPos);
+        ignoreTransformChanges_ = false;
+    }
+}
+
 void CrowdAgent::OnNodeSet(Node* previousNode, Node* currentNode)
 {
     if (node_)
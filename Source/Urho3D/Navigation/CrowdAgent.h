@@ -227,6 +227,8 @@ protected:
     virtual void OnCrowdVelocityUpdate(dtCrowdAgent* ag, float* pos, float dt);
     /// Handle crowd agent being updated. It is called by CrowdManager::Update() via callback.
     virtual void OnCrowdPositionUpdate(dtCrowdAgent* ag, float* pos, float dt);
+    /// Handle crowd agent being skipped by crowd LOD. Node position is interpolated along the velocity since the last update.
+    virtual void OnCrowdLodInterpolate(dtCrowdAgent* ag, float elapsedTime);
     /// Handle node being assigned.
     void OnNodeSet(Node* previousNode, Node* currentNode) override;
     /// Handle node being assigned.
@@ -24,6 +24,7 @@
 
 #include "../Core/Context.h"
 #include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
 #include "../Graphics/DebugRenderer.h"
 #include "../IO/Log.h"
 #include "../Navigation/CrowdAgent.h"
@@ -43,6 +44,10 @@ namespace Urho3D
 
 static const unsigned DEFAULT_MAX_AGENTS = 512;
 static const float DEFAULT_MAX_AGENT_RADIUS = 0.f;
+static const float DEFAULT_LOD_DISTANCE = 0.f;
+static const unsigned DEFAULT_LOD_UPDATE_INTERVAL = 1;
+/// Minimum number of agents processed by one crowd task.
+static const unsigned MIN_AGENTS_PER_TASK = 32;
 
 static const StringVector filterTypesStructureElementNames =
 {
@@ -76,6 +81,22 @@ void CrowdAgentUpdateCallback(bool positionUpdate, dtCrowdAgent* ag, float* pos,
         crowdAgent->OnCrowdVelocityUpdate(ag, pos, dt);
 }
 
+void CrowdParallelForCallback(void* userData, int count, dtCrowdTask task, void* context)
+{
+    auto workQueue = static_cast<WorkQueue*>(userData);
+    if (!WorkQueue::IsProcessingThread())
+    {
+        task(context, 0, count, 0);
+        return;
+    }
+
+    workQueue->ParallelFor(count, MIN_AGENTS_PER_TASK,
+        [&](unsigned beginIndex, unsigned endIndex, unsigned threadIndex)
+    {
+        task(context, static_cast<int>(beginIndex), static_cast<int>(endIndex), static_cast<int>(threadIndex));
+    });
+}
+
 CrowdManager::CrowdManager(Context* context) :
     Component(context),
     maxAgents_(DEFAULT_MAX_AGENTS),
@@ -106,6 +127,9 @@ void CrowdManager::RegisterObject(Context* context)
     URHO3D_MIXED_ACCESSOR_ATTRIBUTE("Obstacle Avoidance Types", GetObstacleAvoidanceTypesAttr, SetObstacleAvoidanceTypesAttr,
         VariantVector, Variant::emptyVariantVector, AM_DEFAULT)
         .SetMetadata(AttributeMetadata::VectorStructElements, obstacleAvoidanceTypesStructureElementNames);
+    URHO3D_ACCESSOR_ATTRIBUTE("LOD Distance", GetLodDistance, SetLodDistance, float, DEFAULT_LOD_DISTANCE, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("LOD Update Interval", GetLodUpdateInterval, SetLodUpdateInterval, unsigned,
+        DEFAULT_LOD_UPDATE_INTERVAL, AM_DEFAULT);
 }
 
 void CrowdManager::ApplyAttributes()
@@ -601,6 +625,15 @@ bool CrowdManager::CreateCrowd()
         return false;
     }
 
+    // Update agents in worker threads if possible, the callbacks are still invoked from this thread
+    if (auto workQueue = GetSubsystem<WorkQueue>())
+    {
+        if (workQueue->IsMultithreaded()
+            && !crowd_->setParallelFor(CrowdParallelForCallback, workQueue, WorkQueue::GetThreadIndexCount()))
+            URHO3D_LOGWARNING("Could not initialize parallel update of DetourCrowd");
+    }
+    lodElapsedTimes_.clear();
+
     // Reconfigure the newly initialized crowd
     SetQueryFilterTypesAttr(queryFilterTypeConfiguration);
     SetObstacleAvoidanceTypesAttr(obstacleAvoidanceTypeConfiguration);
@@ -632,7 +665,10 @@ int CrowdManager::AddAgent(CrowdAgent* agent, const Vector3& pos)
         agent->height_ = navigationMesh_->GetAgentHeight();
     // dtCrowd::addAgent() requires the query filter type to find the nearest position on navmesh as the initial agent's position
     params.queryFilterType = (unsigned char)agent->GetQueryFilterType();
-    return crowd_->addAgent(pos.Data(), &params);
+    const int agentId = crowd_->addAgent(pos.Data(), &params);
+    if (agentId >= 0 && static_cast<unsigned>(agentId) < lodElapsedTimes_.size())
+        lodElapsedTimes_[agentId] = 0.0f;
+    return agentId;
 }
 
 void CrowdManager::RemoveAgent(CrowdAgent* agent)
@@ -687,7 +723,57 @@ void CrowdManager::Update(float delta)
 {
     assert(crowd_ && navigationMesh_);
     URHO3D_PROFILE("UpdateCrowd");
+
+    UpdateLod(delta);
     crowd_->update(delta, nullptr);
+
+    // Move agents skipped by LOD along their last known velocity
+    for (unsigned i = 0; i < lodElapsedTimes_.size(); ++i)
+    {
+        dtCrowdAgent* ag = crowd_->getEditableAgent(i);
+        if (ag->active && ag->lodSkip && ag->params.userData)
+            static_cast<CrowdAgent*>(ag->params.userData)->OnCrowdLodInterpolate(ag, lodElapsedTimes_[i]);
+    }
+}
+
+void CrowdManager::UpdateLod(float delta)
+{
+    const unsigned numAgents = static_cast<unsigned>(crowd_->getAgentCount());
+    if (lodUpdateInterval_ <= 1 || lodDistance_ <= 0.0f)
+    {
+        // Restore full rate update of all agents once
+        if (!lodElapsedTimes_.empty())
+        {
+            for (unsigned i = 0; i < numAgents; ++i)
+            {
+                dtCrowdAgent* ag = crowd_->getEditableAgent(i);
+                ag->lodSkip = false;
+                ag->lodTimeStep = 0.0f;
+            }
+            lodElapsedTimes_.clear();
+        }
+        return;
+    }
+
+    lodElapsedTimes_.resize(numAgents, 0.0f);
+    ++lodUpdateIndex_;
+
+    // Far agents are spread evenly between updates, each is simulated with the time accumulated since its last update
+    const float lodDistanceSquared = lodDistance_ * lodDistance_;
+    for (unsigned i = 0; i < numAgents; ++i)
+    {
+        dtCrowdAgent* ag = crowd_->getEditableAgent(i);
+        if (!ag->active)
+            continue;
+
+        lodElapsedTimes_[i] += delta;
+        const Vector2 offset{ag->npos[0] - lodCenter_.x_, ag->npos[2] - lodCenter_.z_};
+        const bool isFar = offset.LengthSquared() > lodDistanceSquared;
+        ag->lodSkip = isFar && (lodUpdateIndex_ + i) % lodUpdateInterval_ != 0;
+        ag->lodTimeStep = ag->lodSkip ? 0.0f : lodElapsedTimes_[i];
+        if (!ag->lodSkip)
+            lodElapsedTimes_[i] = 0.0f;
+    }
 }
 
 const dtCrowdAgent* CrowdManager::GetDetourCrowdAgent(int agent) const
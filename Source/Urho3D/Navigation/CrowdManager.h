@@ -121,6 +121,15 @@ public:
     void SetObstacleAvoidanceTypesAttr(const VariantVector& value);
     /// Set the params for the specified obstacle avoidance type.
     void SetObstacleAvoidanceParams(unsigned obstacleAvoidanceType, const CrowdObstacleAvoidanceParams& params);
+    /// Set distance from the LOD center beyond which agents are updated at reduced rate.
+    /// @property
+    void SetLodDistance(float distance) { lodDistance_ = Max(distance, 0.0f); }
+    /// Set how often agents beyond the LOD distance are updated, in crowd updates. 1 disables crowd LOD.
+    /// @property
+    void SetLodUpdateInterval(unsigned interval) { lodUpdateInterval_ = Max(interval, 1u); }
+    /// Set LOD center, usually the position of the camera.
+    /// @property
+    void SetLodCenter(const Vector3& center) { lodCenter_ = center; }
 
     /// Get all the crowd agent components in the specified node hierarchy. If the node is not specified then use scene node. When inCrowdFilter is set to true then only get agents that are in the crowd.
     ea::vector<CrowdAgent*> GetAgents(Node* node = nullptr, bool inCrowdFilter = true) const;
@@ -175,6 +184,15 @@ public:
     VariantVector GetObstacleAvoidanceTypesAttr() const;
     /// Get the params for the specified obstacle avoidance type.
     const CrowdObstacleAvoidanceParams& GetObstacleAvoidanceParams(unsigned obstacleAvoidanceType) const;
+    /// Return distance from the LOD center beyond which agents are updated at reduced rate.
+    /// @property
+    float GetLodDistance() const { return lodDistance_; }
+    /// Return how often agents beyond the LOD distance are updated, in crowd updates.
+    /// @property
+    unsigned GetLodUpdateInterval() const { return lodUpdateInterval_; }
+    /// Return LOD center.
+    /// @property
+    const Vector3& GetLodCenter() const { return lodCenter_; }
 
 protected:
     /// Create and initialized internal Detour crowd object. When it is a recreate, it preserves the configuration and attempts to re-add existing agents in the previous crowd back to the newly created crowd.
@@ -189,6 +207,8 @@ protected:
     void OnSceneSet(Scene* scene) override;
     /// Update the crowd simulation.
     void Update(float delta);
+    /// Select agents skipped by crowd LOD in the current update.
+    void UpdateLod(float delta);
     /// Get the detour crowd agent.
     const dtCrowdAgent* GetDetourCrowdAgent(int agent) const;
     /// Get editable detour crowd agent.
@@ -227,6 +247,16 @@ private:
     ea::vector<unsigned> numAreas_;
     /// Number of obstacle avoidance types configured in the crowd. Limit to DT_CROWD_MAX_OBSTAVOIDANCE_PARAMS.
     unsigned numObstacleAvoidanceTypes_{};
+    /// Distance from the LOD center beyond which agents are updated at reduced rate.
+    float lodDistance_{};
+    /// How often agents beyond the LOD distance are updated, in crowd updates.
+    unsigned lodUpdateInterval_{1};
+    /// LOD center.
+    Vector3 lodCenter_;
+    /// Index of the current crowd update, used to spread far agents between updates.
+    unsigned lodUpdateIndex_{};
+    /// Time since the last simulation of each agent.
+    ea::vector<float> lodElapsedTimes_;
 };
 
 }
@@ -58,12 +58,6 @@ namespace Urho3D
 static const int DEFAULT_MAX_OBSTACLES = 1024;
 static const int DEFAULT_MAX_LAYERS = 16;
 
-struct DynamicNavigationMesh::TileCacheData
-{
-    unsigned char* data;
-    int dataSize;
-};
-
 struct TileCompressor : public dtTileCacheCompressor
 {
     int maxCompressedSize(const int bufferSize) override
@@ -223,6 +217,8 @@ DynamicNavigationMesh::DynamicNavigationMesh(Context* context) :
 
 DynamicNavigationMesh::~DynamicNavigationMesh()
 {
+    // Background tasks use the tile cache settings
+    StopBackgroundTasks();
     ReleaseNavigationMesh();
 }
 
@@ -316,6 +312,8 @@ bool DynamicNavigationMesh::IsObstacleInTile(Obstacle* obstacle, const IntVector
 
 bool DynamicNavigationMesh::AddTile(const ea::vector<unsigned char>& tileData)
 {
+    ClearPathCache();
+
     MemoryBuffer buffer(tileData);
     return ReadTiles(buffer, false);
 }
@@ -561,23 +559,17 @@ bool DynamicNavigationMesh::ReadTiles(Deserializer& source, bool silent)
     return true;
 }
 
-int DynamicNavigationMesh::BuildTile(ea::vector<NavigationGeometryInfo>& geometryList, int x, int z, TileCacheData* tiles)
+ea::unique_ptr<NavBuildData> DynamicNavigationMesh::CreateTileBuildData() const
 {
-    URHO3D_PROFILE("BuildNavigationMeshTile");
-
-    const dtMeshTile* tilesToRemove[MaxLayers];
-    const int numTilesToRemove = navMesh_->getTilesAt(x, z, tilesToRemove, MaxLayers);
-    for (int i = 0; i < numTilesToRemove; ++i)
-    {
-        const dtTileRef tileRef = navMesh_->getTileRefAt(x, z, tilesToRemove[i]->header->layer);
-        tileCache_->removeTile(tileRef, nullptr, nullptr);
-    }
+    return ea::make_unique<DynamicNavBuildData>(allocator_.get());
+}
 
-    const BoundingBox tileColumn = GetTileBoundingBoxColumn(IntVector2{x, z});
-    const BoundingBox tileBoundingBox =
-        IsHeightRangeValid() ? tileColumn : CalculateTileBoundingBox(geometryList, tileColumn);
+bool DynamicNavigationMesh::BuildTile(BuiltTile& tile) const
+{
+    URHO3D_PROFILE("BuildNavigationMeshTile");
 
-    DynamicNavBuildData build(allocator_.get());
+    auto& build = static_cast<DynamicNavBuildData&>(*tile.build_);
+    const BoundingBox& tileBoundingBox = tile.boundingBox_;
 
     rcConfig cfg;   // NOLINT(hicpp-member-init)
     memset(&cfg, 0, sizeof(cfg));
@@ -608,24 +600,21 @@ int DynamicNavigationMesh::BuildTile(ea::vector<NavigationGeometryInfo>& geometr
     cfg.bmax[1] += padding_.y_;
     cfg.bmax[2] += cfg.borderSize * cfg.cs;
 
-    BoundingBox expandedBox(*reinterpret_cast<Vector3*>(cfg.bmin), *reinterpret_cast<Vector3*>(cfg.bmax));
-    GetTileGeometry(&build, geometryList, expandedBox);
-
     if (build.vertices_.empty() || build.indices_.empty())
-        return 0; // Nothing to do
+        return true; // Nothing to do
 
     build.heightField_ = rcAllocHeightfield();
     if (!build.heightField_)
     {
         URHO3D_LOGERROR("Could not allocate heightfield");
-        return 0;
+        return false;
     }
 
     if (!rcCreateHeightfield(build.ctx_, *build.heightField_, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs,
         cfg.ch))
     {
         URHO3D_LOGERROR("Could not create heightfield");
-        return 0;
+        return false;
     }
 
     unsigned numTriangles = build.indices_.size() / 3;
@@ -645,18 +634,18 @@ int DynamicNavigationMesh::BuildTile(ea::vector<NavigationGeometryInfo>& geometr
     if (!build.compactHeightField_)
     {
         URHO3D_LOGERROR("Could not allocate create compact heightfield");
-        return 0;
+        return false;
     }
     if (!rcBuildCompactHeightfield(build.ctx_, cfg.walkableHeight, cfg.walkableClimb, *build.heightField_,
         *build.compactHeightField_))
     {
         URHO3D_LOGERROR("Could not build compact heightfield");
-        return 0;
+        return false;
     }
     if (!rcErodeWalkableArea(build.ctx_, cfg.walkableRadius, *build.compactHeightField_))
     {
         URHO3D_LOGERROR("Could not erode compact heightfield");
-        return 0;
+        return false;
     }
 
     // area volumes
@@ -669,13 +658,13 @@ int DynamicNavigationMesh::BuildTile(ea::vector<NavigationGeometryInfo>& geometr
         if (!rcBuildDistanceField(build.ctx_, *build.compactHeightField_))
         {
             URHO3D_LOGERROR("Could not build distance field");
-            return 0;
+            return false;
         }
         if (!rcBuildRegions(build.ctx_, *build.compactHeightField_, cfg.borderSize, cfg.minRegionArea,
             cfg.mergeRegionArea))
         {
             URHO3D_LOGERROR("Could not build regions");
-            return 0;
+            return false;
         }
     }
     else
@@ -683,7 +672,7 @@ int DynamicNavigationMesh::BuildTile(ea::vector<NavigationGeometryInfo>& geometr
         if (!rcBuildRegionsMonotone(build.ctx_, *build.compactHeightField_, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea))
         {
             URHO3D_LOGERROR("Could not build monotone regions");
-            return 0;
+            return false;
         }
     }
 
@@ -691,24 +680,23 @@ int DynamicNavigationMesh::BuildTile(ea::vector<NavigationGeometryInfo>& geometr
     if (!build.heightFieldLayers_)
     {
         URHO3D_LOGERROR("Could not allocate height field layer set");
-        return 0;
+        return false;
     }
 
     if (!rcBuildHeightfieldLayers(build.ctx_, *build.compactHeightField_, cfg.borderSize, cfg.walkableHeight,
         *build.heightFieldLayers_))
     {
         URHO3D_LOGERROR("Could not build height field layers");
-        return 0;
+        return false;
     }
 
-    int retCt = 0;
     for (int i = 0; i < build.heightFieldLayers_->nlayers; ++i)
     {
         dtTileCacheLayerHeader header;      // NOLINT(hicpp-member-init)
         header.magic = DT_TILECACHE_MAGIC;
         header.version = DT_TILECACHE_VERSION;
-        header.tx = x;
-        header.ty = z;
+        header.tx = tile.tileIndex_.x_;
+        header.ty = tile.tileIndex_.y_;
         header.tlayer = i;
 
         rcHeightfieldLayer* layer = &build.heightFieldLayers_->layers[i];
@@ -725,70 +713,58 @@ int DynamicNavigationMesh::BuildTile(ea::vector<NavigationGeometryInfo>& geometr
         header.hmin = (unsigned short)layer->hmin;
         header.hmax = (unsigned short)layer->hmax;
 
+        unsigned char* data = nullptr;
+        int dataSize = 0;
         if (dtStatusFailed(
             dtBuildTileCacheLayer(compressor_.get()/*compressor*/, &header, layer->heights, layer->areas/*areas*/, layer->cons,
-                &(tiles[retCt].data), &tiles[retCt].dataSize)))
+                &data, &dataSize)))
         {
             URHO3D_LOGERROR("Failed to build tile cache layers");
-            return 0;
+            return false;
         }
-        else
-            ++retCt;
-    }
 
-    // Send a notification of the rebuild of this tile to anyone interested
-    {
-        using namespace NavigationAreaRebuilt;
-        VariantMap& eventData = GetContext()->GetEventDataMap();
-        eventData[P_NODE] = GetNode();
-        eventData[P_MESH] = this;
-        eventData[P_BOUNDSMIN] = Variant(tileBoundingBox.min_);
-        eventData[P_BOUNDSMAX] = Variant(tileBoundingBox.max_);
-        SendEvent(E_NAVIGATION_AREA_REBUILT, eventData);
+        tile.data_.emplace_back(data, dataSize);
     }
 
-    return retCt;
+    return true;
 }
 
-unsigned DynamicNavigationMesh::BuildTilesFromGeometry(
-    ea::vector<NavigationGeometryInfo>& geometryList, const IntVector2& from, const IntVector2& to)
+unsigned DynamicNavigationMesh::AddBuiltTile(BuiltTile& tile)
 {
-    unsigned numTiles = 0;
+    const int x = tile.tileIndex_.x_;
+    const int z = tile.tileIndex_.y_;
 
-    for (int z = from.y_; z <= to.y_; ++z)
+    const dtMeshTile* tilesToRemove[MaxLayers];
+    const int numTilesToRemove = navMesh_->getTilesAt(x, z, tilesToRemove, MaxLayers);
+    for (int i = 0; i < numTilesToRemove; ++i)
     {
-        for (int x = from.x_; x <= to.x_; ++x)
-        {
-            dtCompressedTileRef existing[MaxLayers];
-            const int existingCt = tileCache_->getTilesAt(x, z, existing, maxLayers_);
-            for (int i = 0; i < existingCt; ++i)
-            {
-                unsigned char* data = nullptr;
-                if (!dtStatusFailed(tileCache_->removeTile(existing[i], &data, nullptr)) && data != nullptr)
-                    dtFree(data);
-            }
+        const dtTileRef tileRef = navMesh_->getTileRefAt(x, z, tilesToRemove[i]->header->layer);
+        tileCache_->removeTile(tileRef, nullptr, nullptr);
+    }
 
-            TileCacheData tiles[MaxLayers];
-            int layerCt = BuildTile(geometryList, x, z, tiles);
-            for (int i = 0; i < layerCt; ++i)
-            {
-                dtCompressedTileRef tileRef;
-                int status = tileCache_->addTile(tiles[i].data, tiles[i].dataSize, DT_COMPRESSEDTILE_FREE_DATA, &tileRef);
-                if (dtStatusFailed((dtStatus)status))
-                {
-                    dtFree(tiles[i].data);
-                    tiles[i].data = nullptr;
-                }
-                else
-                {
-                    tileCache_->buildNavMeshTile(tileRef, navMesh_);
-                    ++numTiles;
-                }
-            }
-        }
+    dtCompressedTileRef existing[MaxLayers];
+    const int existingCt = tileCache_->getTilesAt(x, z, existing, maxLayers_);
+    for (int i = 0; i < existingCt; ++i)
+    {
+        unsigned char* data = nullptr;
+        if (!dtStatusFailed(tileCache_->removeTile(existing[i], &data, nullptr)) && data != nullptr)
+            dtFree(data);
     }
 
-    return numTiles;
+    unsigned numLayers = 0;
+    for (auto& [data, dataSize] : tile.data_)
+    {
+        dtCompressedTileRef tileRef;
+        int status = tileCache_->addTile(data, dataSize, DT_COMPRESSEDTILE_FREE_DATA, &tileRef);
+        if (dtStatusFailed((dtStatus)status))
+            continue;
+
+        // Data is owned by the tile cache now
+        data = nullptr;
+        tileCache_->buildNavMeshTile(tileRef, navMesh_);
+        ++numLayers;
+    }
+    return numLayers;
 }
 
 ea::vector<OffMeshConnection*> DynamicNavigationMesh::CollectOffMeshConnections(const BoundingBox& bounds)
@@ -832,6 +808,8 @@ void DynamicNavigationMesh::UpdateTileCache()
 
 void DynamicNavigationMesh::OnSceneSet(Scene* scene)
 {
+    NavigationMesh::OnSceneSet(scene);
+
     // Subscribe to the scene subsystem update, which will trigger the tile cache to update the nav mesh
     if (scene)
         SubscribeToEvent(scene, E_SCENESUBSYSTEMUPDATE, URHO3D_HANDLER(DynamicNavigationMesh, HandleSceneSubsystemUpdate));
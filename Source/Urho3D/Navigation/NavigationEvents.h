@@ -43,6 +43,15 @@ URHO3D_EVENT(E_NAVIGATION_AREA_REBUILT, NavigationAreaRebuilt)
     URHO3D_PARAM(P_BOUNDSMAX, BoundsMax); // Vector3
 }
 
+/// Progress of building navigation mesh tiles. Sent after each batch of tiles is added to navigation mesh.
+URHO3D_EVENT(E_NAVIGATION_BUILD_PROGRESS, NavigationBuildProgress)
+{
+    URHO3D_PARAM(P_NODE, Node); // Node pointer
+    URHO3D_PARAM(P_MESH, Mesh); // NavigationMesh pointer
+    URHO3D_PARAM(P_NUMBUILTTILES, NumBuiltTiles); // unsigned
+    URHO3D_PARAM(P_NUMTILES, NumTiles); // unsigned
+}
+
 /// Mesh tile is added to navigation mesh.
 URHO3D_EVENT(E_NAVIGATION_TILE_ADDED, NavigationTileAdded)
 {
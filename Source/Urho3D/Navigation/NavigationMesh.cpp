@@ -23,7 +23,10 @@
 #include "../Precompiled.h"
 
 #include "../Core/Context.h"
+#include "../Core/Mutex.h"
 #include "../Core/Profiler.h"
+#include "../Core/Timer.h"
+#include "../Core/WorkQueue.h"
 #include "../Graphics/DebugRenderer.h"
 #include "../Graphics/Drawable.h"
 #include "../Graphics/Geometry.h"
@@ -47,6 +50,7 @@
 #include "../Physics/CollisionShape.h"
 #endif
 #include "../Scene/Scene.h"
+#include "../Scene/SceneEvents.h"
 
 #include <cfloat>
 #include <Detour/DetourNavMesh.h>
@@ -54,8 +58,11 @@
 #include <Detour/DetourNavMeshQuery.h>
 #include <Recast/Recast.h>
 
+#include <EASTL/deque.h>
 #include <EASTL/numeric.h>
 
+#include <atomic>
+
 #include "../DebugNew.h"
 
 namespace Urho3D
@@ -122,8 +129,293 @@ ea::pair<ea::array<Vector3, DT_VERTS_PER_POLYGON>, Vector3> GetPolygonVerticesAn
     return {vertices, center};
 }
 
+/// Asynchronous path request.
+struct PathRequest
+{
+    /// ID of the request.
+    unsigned id_{};
+    /// Start point in world space.
+    Vector3 start_;
+    /// End point in world space.
+    Vector3 end_;
+    /// How far off the navigation mesh the points can be.
+    Vector3 extents_;
+    /// Query filter.
+    const dtQueryFilter* filter_{};
+    /// Callback invoked on completion.
+    NavigationPathCallback callback_;
+
+    /// Start point in local space.
+    Vector3 localStart_;
+    /// End point in local space.
+    Vector3 localEnd_;
+    /// Start polygon.
+    dtPolyRef startRef_{};
+    /// End polygon.
+    dtPolyRef endRef_{};
+    /// Whether the start and end polygons are found.
+    bool resolved_{};
+    /// Whether the corridor is taken from the cache.
+    bool cached_{};
+    /// Whether the sliced search is initialized.
+    bool searchStarted_{};
+    /// Whether the search is continued from one of previous frames.
+    bool continued_{};
+    /// Whether the search should be restarted because the navigation mesh has changed.
+    bool restart_{};
+    /// Whether the search was already restarted once.
+    bool restarted_{};
+    /// Whether the search stopped before reaching the end polygon.
+    bool partial_{};
+
+    /// Polygon corridor from the start to the end polygon.
+    ea::vector<dtPolyRef> corridor_;
+    /// Path points in local space.
+    ea::vector<Vector3> points_;
+    /// Flags of path points.
+    ea::vector<unsigned char> flags_;
+};
+
+/// Key of the cached polygon corridor.
+struct PathCacheKey
+{
+    dtPolyRef startRef_{};
+    dtPolyRef endRef_{};
+    const dtQueryFilter* filter_{};
+
+    bool operator==(const PathCacheKey& rhs) const
+    {
+        return startRef_ == rhs.startRef_ && endRef_ == rhs.endRef_ && filter_ == rhs.filter_;
+    }
+
+    unsigned ToHash() const
+    {
+        unsigned result = 0;
+        CombineHash(result, MakeHash(startRef_));
+        CombineHash(result, MakeHash(endRef_));
+        CombineHash(result, MakeHash(filter_));
+        return result;
+    }
+};
+
+/// Navigation mesh query with temporary data. Used by one thread at a time.
+struct PathQueryContext
+{
+    ~PathQueryContext() { dtFreeNavMeshQuery(query_); }
+
+    /// Detour navigation mesh query. Keeps the state of the sliced search.
+    dtNavMeshQuery* query_{};
+    /// Temporary data for finding a path.
+    FindPathData data_;
+    /// Request with the sliced search in progress.
+    ea::unique_ptr<PathRequest> current_;
+    /// Requests finished in the current frame.
+    ea::vector<ea::unique_ptr<PathRequest>> finished_;
+};
+
 } // namespace
 
+struct NavigationMesh::PathRequestQueue
+{
+    /// Process requests of the batch in the context until the iteration budget is exhausted.
+    void ProcessInContext(PathQueryContext& context, const dtNavMesh* navMesh, const Matrix3x4& inverse, int budget);
+    /// Find start and end polygons of the request and try to take the corridor from the cache. Return true if found.
+    bool ResolveRequest(PathQueryContext& context, PathRequest& request, const dtNavMesh* navMesh, const Matrix3x4& inverse) const;
+    /// Continue sliced search of the request. Return true if the search is finished.
+    bool ContinueSearch(PathQueryContext& context, PathRequest& request, int& budget) const;
+    /// Find straight path along the corridor of the request.
+    void FindStraightPath(PathQueryContext& context, PathRequest& request) const;
+    /// Add corridor to the cache, evicting the oldest ones.
+    void AddToCache(const PathRequest& request, unsigned maxSize);
+    /// Evict the oldest corridors from the cache.
+    void TrimCache(unsigned maxSize);
+
+    /// ID of the next request.
+    unsigned nextRequestId_{1};
+    /// Requests waiting for processing.
+    ea::deque<ea::unique_ptr<PathRequest>> pending_;
+    /// Requests processed in the current frame. Taken by contexts in order.
+    ea::vector<ea::unique_ptr<PathRequest>> batch_;
+    /// Index of the next request in the batch.
+    std::atomic<unsigned> nextBatchIndex_{};
+    /// Completed requests waiting for callbacks.
+    ea::deque<ea::unique_ptr<PathRequest>> completed_;
+    /// Query contexts, one per processing thread.
+    ea::vector<ea::unique_ptr<PathQueryContext>> contexts_;
+    /// Cached polygon corridors.
+    ea::unordered_map<PathCacheKey, ea::vector<dtPolyRef>> cache_;
+    /// Keys of cached corridors, oldest first.
+    ea::deque<PathCacheKey> cacheOrder_;
+};
+
+void NavigationMesh::PathRequestQueue::ProcessInContext(
+    PathQueryContext& context, const dtNavMesh* navMesh, const Matrix3x4& inverse, int budget)
+{
+    if (context.current_)
+    {
+        if (!ContinueSearch(context, *context.current_, budget))
+            return;
+        context.finished_.push_back(ea::move(context.current_));
+    }
+
+    while (budget > 0)
+    {
+        const unsigned index = nextBatchIndex_.fetch_add(1, std::memory_order_relaxed);
+        if (index >= batch_.size())
+            break;
+
+        ea::unique_ptr<PathRequest> request = ea::move(batch_[index]);
+        --budget;
+
+        if (!request->resolved_ && !ResolveRequest(context, *request, navMesh, inverse))
+        {
+            context.finished_.push_back(ea::move(request));
+            continue;
+        }
+
+        if (!request->cached_ && !ContinueSearch(context, *request, budget))
+        {
+            context.current_ = ea::move(request);
+            break;
+        }
+
+        context.finished_.push_back(ea::move(request));
+    }
+}
+
+bool NavigationMesh::PathRequestQueue::ResolveRequest(
+    PathQueryContext& context, PathRequest& request, const dtNavMesh* navMesh, const Matrix3x4& inverse) const
+{
+    request.localStart_ = inverse * request.start_;
+    request.localEnd_ = inverse * request.end_;
+
+    dtNavMeshQuery* query = context.query_;
+    query->findNearestPoly(&request.localStart_.x_, &request.extents_.x_, request.filter_, &request.startRef_, nullptr);
+    query->findNearestPoly(&request.localEnd_.x_, &request.extents_.x_, request.filter_, &request.endRef_, nullptr);
+    if (!request.startRef_ || !request.endRef_)
+        return false;
+
+    request.resolved_ = true;
+
+    // Cached corridor is valid while all its polygons exist
+    const auto iter = cache_.find(PathCacheKey{request.startRef_, request.endRef_, request.filter_});
+    if (iter != cache_.end())
+    {
+        const ea::vector<dtPolyRef>& corridor = iter->second;
+        const auto isValid = [&](dtPolyRef polyRef) { return navMesh->isValidPolyRef(polyRef); };
+        if (ea::all_of(corridor.begin(), corridor.end(), isValid))
+        {
+            request.corridor_ = corridor;
+            request.cached_ = true;
+            FindStraightPath(context, request);
+        }
+    }
+    return true;
+}
+
+bool NavigationMesh::PathRequestQueue::ContinueSearch(PathQueryContext& context, PathRequest& request, int& budget) const
+{
+    dtNavMeshQuery* query = context.query_;
+    if (!request.searchStarted_)
+    {
+        request.searchStarted_ = true;
+        const dtStatus status = query->initSlicedFindPath(request.startRef_, request.endRef_, &request.localStart_.x_,
+            &request.localEnd_.x_, request.filter_);
+        if (dtStatusFailed(status))
+            return true;
+    }
+
+    int numIterations = 0;
+    const dtStatus status = query->updateSlicedFindPath(Max(budget, 1), &numIterations);
+    budget -= numIterations;
+    if (dtStatusInProgress(status))
+        return false;
+
+    if (dtStatusFailed(status))
+    {
+        // Polygons may be removed between frames, search again from scratch
+        request.restart_ = request.continued_ && !request.restarted_;
+        return true;
+    }
+
+    int numPolys = 0;
+    const dtStatus finalStatus = query->finalizeSlicedFindPath(context.data_.polys_, &numPolys, MAX_POLYS);
+    request.partial_ = dtStatusDetail(status | finalStatus, DT_PARTIAL_RESULT);
+    if (numPolys > 0)
+    {
+        request.corridor_.assign(context.data_.polys_, context.data_.polys_ + numPolys);
+        FindStraightPath(context, request);
+    }
+    return true;
+}
+
+void NavigationMesh::PathRequestQueue::FindStraightPath(PathQueryContext& context, PathRequest& request) const
+{
+    Vector3 actualLocalEnd = request.localEnd_;
+
+    // If full path was not found, clamp end point to the end polygon
+    const dtPolyRef lastRef = request.corridor_.back();
+    if (lastRef != request.endRef_)
+        context.query_->closestPointOnPoly(lastRef, &request.localEnd_.x_, &actualLocalEnd.x_, nullptr);
+
+    FindPathData& data = context.data_;
+    int numPathPoints = 0;
+    context.query_->findStraightPath(&request.localStart_.x_, &actualLocalEnd.x_, request.corridor_.data(),
+        static_cast<int>(request.corridor_.size()), &data.pathPoints_[0].x_, data.pathFlags_, data.pathPolys_,
+        &numPathPoints, MAX_POLYS);
+
+    request.points_.assign(data.pathPoints_, data.pathPoints_ + numPathPoints);
+    request.flags_.assign(data.pathFlags_, data.pathFlags_ + numPathPoints);
+}
+
+void NavigationMesh::PathRequestQueue::AddToCache(const PathRequest& request, unsigned maxSize)
+{
+    if (maxSize == 0 || request.cached_ || request.corridor_.empty())
+        return;
+
+    // Partial corridor may become complete once missing tiles are added
+    if (request.partial_ || request.corridor_.back() != request.endRef_)
+        return;
+
+    const PathCacheKey key{request.startRef_, request.endRef_, request.filter_};
+    const auto [iter, inserted] = cache_.emplace(key, request.corridor_);
+    if (!inserted)
+    {
+        iter->second = request.corridor_;
+        return;
+    }
+
+    cacheOrder_.push_back(key);
+    TrimCache(maxSize);
+}
+
+void NavigationMesh::PathRequestQueue::TrimCache(unsigned maxSize)
+{
+    while (cacheOrder_.size() > maxSize)
+    {
+        cache_.erase(cacheOrder_.front());
+        cacheOrder_.pop_front();
+    }
+}
+
+struct NavigationMesh::BackgroundTileQueue
+{
+    /// Whether the navigation mesh is alive. Tasks should not access the navigation mesh otherwise.
+    std::atomic<bool> alive_{true};
+    /// Number of tasks that are accessing the navigation mesh.
+    std::atomic<unsigned> numRunningTasks_{};
+    /// Mutex for built tiles.
+    Mutex mutex_;
+    /// Tiles that are built and not added yet, with serial numbers of the builds.
+    ea::vector<ea::pair<unsigned, ea::shared_ptr<BuiltTile>>> builtTiles_;
+};
+
+NavigationMesh::BuiltTile::~BuiltTile()
+{
+    for (const auto& [data, dataSize] : data_)
+        dtFree(data);
+}
+
 NavigationMesh::NavigationMesh(Context* context) :
     Component(context),
     navMesh_(nullptr),
@@ -147,12 +439,15 @@ NavigationMesh::NavigationMesh(Context* context) :
     partitionType_(NAVMESH_PARTITION_WATERSHED),
     keepInterResults_(false),
     drawOffMeshConnections_(false),
-    drawNavAreas_(false)
+    drawNavAreas_(false),
+    backgroundTiles_(ea::make_shared<BackgroundTileQueue>()),
+    pathRequests_(ea::make_unique<PathRequestQueue>())
 {
 }
 
 NavigationMesh::~NavigationMesh()
 {
+    StopBackgroundTasks();
     ReleaseNavigationMesh();
 }
 
@@ -182,6 +477,10 @@ void NavigationMesh::RegisterObject(Context* context)
     URHO3D_ACCESSOR_ATTRIBUTE("Detail Sample Max Error", GetDetailSampleMaxError, SetDetailSampleMaxError, float,
         DEFAULT_DETAIL_SAMPLE_MAX_ERROR, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Bounding Box Padding", GetPadding, SetPadding, Vector3, Vector3::ONE, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Auto Update", GetAutoUpdate, SetAutoUpdate, bool, false, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Max Tile Update Ms", GetMaxTileUpdateMs, SetMaxTileUpdateMs, int, DefaultMaxTileUpdateMs, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Max Path Iterations", GetMaxPathIterations, SetMaxPathIterations, int, DefaultMaxPathIterations, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Max Path Cache Size", GetMaxPathCacheSize, SetMaxPathCacheSize, unsigned, DefaultMaxPathCacheSize, AM_DEFAULT);
     URHO3D_MIXED_ACCESSOR_ATTRIBUTE("Navigation Data", GetNavigationDataAttr, SetNavigationDataAttr, ea::vector<unsigned char>,
         Variant::emptyBuffer, AM_DEFAULT | AM_NOEDIT);
     URHO3D_ENUM_ACCESSOR_ATTRIBUTE("Partition Type", GetPartitionType, SetPartitionType, NavmeshPartitionType, navmeshPartitionTypeNames,
@@ -457,6 +756,9 @@ bool NavigationMesh::BuildTilesInRegion(const BoundingBox& boundingBox)
     const unsigned numTiles = BuildTilesFromGeometry(geometryList, beginTileIndex, endTileIndex);
     URHO3D_LOGDEBUG("Rebuilt {} tiles of the navigation mesh", numTiles);
 
+    // New tiles may connect polygons that had no path between them
+    ClearPathCache();
+
     for (const IntVector2& tileIndex : IntRect{beginTileIndex, endTileIndex + IntVector2::ONE})
         SendTileAddedEvent(tileIndex);
 
@@ -482,12 +784,38 @@ bool NavigationMesh::BuildTiles(const IntVector2& from, const IntVector2& to)
     unsigned numTiles = BuildTilesFromGeometry(geometryList, from, to);
     URHO3D_LOGDEBUG("Rebuilt {} tiles of the navigation mesh", numTiles);
 
+    ClearPathCache();
+
     for (const IntVector2& tileIndex : IntRect{from, to + IntVector2::ONE})
         SendTileAddedEvent(tileIndex);
 
     return true;
 }
 
+void NavigationMesh::MarkRegionDirty(const BoundingBox& boundingBox)
+{
+    if (!navMesh_ || !boundingBox.Defined())
+        return;
+
+    // Geometry within the border of the tile affects the tile too
+    const float borderSize = GetTileBorderSize();
+    const Vector3 border{borderSize, 0.0f, borderSize};
+    const IntVector2 beginTileIndex = GetTileIndex(boundingBox.min_ - border);
+    const IntVector2 endTileIndex = GetTileIndex(boundingBox.max_ + border);
+
+    for (const IntVector2& tileIndex : IntRect{beginTileIndex, endTileIndex + IntVector2::ONE})
+        dirtyTiles_.insert(tileIndex);
+}
+
+void NavigationMesh::SetAutoUpdate(bool enable)
+{
+    autoUpdate_ = enable;
+
+    // Geometry is collected on the next update
+    if (!autoUpdate_)
+        StopTrackingGeometry();
+}
+
 ea::vector<IntVector2> NavigationMesh::GetAllTileIndices() const
 {
     ea::vector<IntVector2> result;
@@ -515,6 +843,8 @@ ea::vector<unsigned char> NavigationMesh::GetTileData(const IntVector2& tileInde
 
 bool NavigationMesh::AddTile(const ea::vector<unsigned char>& tileData)
 {
+    ClearPathCache();
+
     MemoryBuffer buffer(tileData);
     return ReadTile(buffer, false);
 }
@@ -684,12 +1014,189 @@ void NavigationMesh::FindPath(ea::vector<NavigationPathPoint>& dest, const Vecto
     navMeshQuery_->findStraightPath(&localStart.x_, &actualLocalEnd.x_, pathData_->polys_, numPolys,
         &pathData_->pathPoints_[0].x_, pathData_->pathFlags_, pathData_->pathPolys_, &numPathPoints, MAX_POLYS);
 
-    // Transform path result back to world space
-    for (int i = 0; i < numPathPoints; ++i)
+    ConvertPathPoints(dest, pathData_->pathPoints_, pathData_->pathFlags_, numPathPoints);
+}
+
+unsigned NavigationMesh::RequestPath(const Vector3& start, const Vector3& end, const NavigationPathCallback& callback,
+    const Vector3& extents, const dtQueryFilter* filter)
+{
+    PathRequestQueue& queue = *pathRequests_;
+
+    auto request = ea::make_unique<PathRequest>();
+    request->id_ = queue.nextRequestId_++;
+    if (!queue.nextRequestId_)
+        queue.nextRequestId_ = 1;
+    request->start_ = start;
+    request->end_ = end;
+    request->extents_ = extents;
+    request->filter_ = filter ? filter : queryFilter_.get();
+    request->callback_ = callback;
+
+    const unsigned requestId = request->id_;
+    queue.pending_.push_back(ea::move(request));
+    return requestId;
+}
+
+bool NavigationMesh::CancelPathRequest(unsigned requestId)
+{
+    PathRequestQueue& queue = *pathRequests_;
+    const auto hasId = [&](const ea::unique_ptr<PathRequest>& request) { return request && request->id_ == requestId; };
+
+    const auto pendingIter = ea::find_if(queue.pending_.begin(), queue.pending_.end(), hasId);
+    if (pendingIter != queue.pending_.end())
+    {
+        queue.pending_.erase(pendingIter);
+        return true;
+    }
+
+    const auto completedIter = ea::find_if(queue.completed_.begin(), queue.completed_.end(), hasId);
+    if (completedIter != queue.completed_.end())
+    {
+        queue.completed_.erase(completedIter);
+        return true;
+    }
+
+    // Sliced search state is discarded when the context takes the next request
+    for (const auto& context : queue.contexts_)
+    {
+        if (hasId(context->current_))
+        {
+            context->current_ = nullptr;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void NavigationMesh::ProcessPathRequests()
+{
+    PathRequestQueue& queue = *pathRequests_;
+    const auto isSearching = [](const ea::unique_ptr<PathQueryContext>& context) { return context->current_ != nullptr; };
+    if (queue.pending_.empty() && ea::none_of(queue.contexts_.begin(), queue.contexts_.end(), isSearching))
+        return;
+
+    URHO3D_PROFILE("ProcessPathRequests");
+
+    if (!InitializeQuery())
+    {
+        // There is no navigation data, fail all requests
+        ReleasePathQueries();
+        for (auto& request : queue.pending_)
+            queue.completed_.push_back(ea::move(request));
+        queue.pending_.clear();
+    }
+    else
+    {
+        auto workQueue = GetSubsystem<WorkQueue>();
+        const unsigned numContexts = workQueue ? workQueue->GetNumProcessingThreads() : 1;
+        while (queue.contexts_.size() < numContexts)
+        {
+            auto context = ea::make_unique<PathQueryContext>();
+            context->query_ = dtAllocNavMeshQuery();
+            if (!context->query_ || dtStatusFailed(context->query_->init(navMesh_, MAX_POLYS)))
+            {
+                URHO3D_LOGERROR("Could not init navigation mesh query");
+                return;
+            }
+            queue.contexts_.push_back(ea::move(context));
+        }
+
+        for (auto& request : queue.pending_)
+            queue.batch_.push_back(ea::move(request));
+        queue.pending_.clear();
+        queue.nextBatchIndex_ = 0;
+
+        // Each context keeps its own sliced search, so contexts are processed in parallel
+        const Matrix3x4 inverse = node_->GetWorldTransform().Inverse();
+        const int budget = Max(maxPathIterations_ / static_cast<int>(queue.contexts_.size()), 1);
+        const auto processContexts = [&](unsigned beginIndex, unsigned endIndex, unsigned threadIndex)
+        {
+            for (unsigned i = beginIndex; i < endIndex; ++i)
+                queue.ProcessInContext(*queue.contexts_[i], navMesh_, inverse, budget);
+        };
+        if (queue.contexts_.size() > 1)
+            workQueue->ParallelFor(queue.contexts_.size(), 1, processContexts);
+        else
+            processContexts(0, queue.contexts_.size(), 0);
+
+        // Requests that were not taken by any context stay in the same order
+        const unsigned numTaken = Min<unsigned>(queue.nextBatchIndex_, queue.batch_.size());
+        for (unsigned i = queue.batch_.size(); i > numTaken; --i)
+            queue.pending_.push_front(ea::move(queue.batch_[i - 1]));
+        queue.batch_.clear();
+
+        for (const auto& context : queue.contexts_)
+        {
+            if (context->current_)
+                context->current_->continued_ = true;
+
+            for (auto& request : context->finished_)
+            {
+                if (request->restart_)
+                {
+                    request->resolved_ = false;
+                    request->searchStarted_ = false;
+                    request->continued_ = false;
+                    request->restart_ = false;
+                    request->restarted_ = true;
+                    queue.pending_.push_front(ea::move(request));
+                    continue;
+                }
+
+                queue.AddToCache(*request, maxPathCacheSize_);
+                queue.completed_.push_back(ea::move(request));
+            }
+            context->finished_.clear();
+        }
+    }
+
+    // Callbacks may request or cancel paths
+    ea::vector<NavigationPathPoint> path;
+    while (!queue.completed_.empty())
+    {
+        const ea::unique_ptr<PathRequest> request = ea::move(queue.completed_.front());
+        queue.completed_.pop_front();
+
+        path.clear();
+        ConvertPathPoints(path, request->points_.data(), request->flags_.data(), request->points_.size());
+        if (request->callback_)
+            request->callback_(request->id_, path);
+    }
+}
+
+void NavigationMesh::ClearPathCache()
+{
+    pathRequests_->cache_.clear();
+    pathRequests_->cacheOrder_.clear();
+}
+
+unsigned NavigationMesh::GetNumPathRequests() const
+{
+    const PathRequestQueue& queue = *pathRequests_;
+    const auto isSearching = [](const ea::unique_ptr<PathQueryContext>& context) { return context->current_ != nullptr; };
+    return queue.pending_.size() + queue.completed_.size()
+        + ea::count_if(queue.contexts_.begin(), queue.contexts_.end(), isSearching);
+}
+
+void NavigationMesh::SetMaxPathCacheSize(unsigned size)
+{
+    maxPathCacheSize_ = size;
+    pathRequests_->TrimCache(maxPathCacheSize_);
+}
+
+void NavigationMesh::ConvertPathPoints(
+    ea::vector<NavigationPathPoint>& dest, const Vector3* points, const unsigned char* flags, unsigned numPoints) const
+{
+    if (!numPoints)
+        return;
+
+    const Matrix3x4& transform = node_->GetWorldTransform();
+    for (unsigned i = 0; i < numPoints; ++i)
     {
         NavigationPathPoint pt;
-        pt.position_ = transform * pathData_->pathPoints_[i];
-        pt.flag_ = (NavigationPathPointFlag)pathData_->pathFlags_[i];
+        pt.position_ = transform * points[i];
+        pt.flag_ = (NavigationPathPointFlag)flags[i];
 
         // Walk through all NavAreas and find nearest
         unsigned nearestNavAreaID = 0;       // 0 is the default nav area ID
@@ -1069,7 +1576,24 @@ void NavigationMesh::CollectGeometries(ea::vector<NavigationGeometryInfo>& geome
     }
 }
 
-void NavigationMesh::GetTileGeometry(NavBuildData* build, ea::vector<NavigationGeometryInfo>& geometryList, BoundingBox& box)
+void NavigationMesh::PrepareTileGeometry(const ea::vector<NavigationGeometryInfo>& geometryList)
+{
+    // Transforms and bounding boxes are updated on demand, update them before accessing from multiple threads
+    node_->GetWorldTransform();
+    for (const NavigationGeometryInfo& info : geometryList)
+    {
+        if (auto connection = dynamic_cast<OffMeshConnection*>(info.component_))
+        {
+            connection->GetNode()->GetWorldPosition();
+            if (Node* endPoint = connection->GetEndPoint())
+                endPoint->GetWorldPosition();
+        }
+        else if (auto area = dynamic_cast<NavArea*>(info.component_))
+            area->GetWorldBoundingBox();
+    }
+}
+
+void NavigationMesh::GetTileGeometry(NavBuildData* build, const ea::vector<NavigationGeometryInfo>& geometryList, const BoundingBox& box) const
 {
     Matrix3x4 inverse = node_->GetWorldTransform().Inverse();
 
@@ -1181,7 +1705,7 @@ void NavigationMesh::GetTileGeometry(NavBuildData* build, ea::vector<NavigationG
     }
 }
 
-void NavigationMesh::AddTriMeshGeometry(NavBuildData* build, Geometry* geometry, const Matrix3x4& transform)
+void NavigationMesh::AddTriMeshGeometry(NavBuildData* build, Geometry* geometry, const Matrix3x4& transform) const
 {
     if (!geometry)
         return;
@@ -1274,18 +1798,35 @@ void NavigationMesh::SendTileAddedEvent(const IntVector2& tileIndex)
     SendEvent(E_NAVIGATION_TILE_ADDED, eventData);
 }
 
-bool NavigationMesh::BuildTile(ea::vector<NavigationGeometryInfo>& geometryList, int x, int z)
+float NavigationMesh::GetTileBorderSize() const
 {
-    URHO3D_PROFILE("BuildNavigationMeshTile");
+    return (CeilToInt(agentRadius_ / cellSize_) + 3) * cellSize_;
+}
 
-    // Remove previous tile (if any)
-    navMesh_->removeTile(navMesh_->getTileRefAt(x, z, 0), nullptr, nullptr);
+void NavigationMesh::GatherTileGeometry(
+    BuiltTile& tile, const ea::vector<NavigationGeometryInfo>& geometryList, const IntVector2& tileIndex) const
+{
+    const BoundingBox tileColumn = GetTileBoundingBoxColumn(tileIndex);
+    tile.tileIndex_ = tileIndex;
+    tile.boundingBox_ = IsHeightRangeValid() ? tileColumn : CalculateTileBoundingBox(geometryList, tileColumn);
+    tile.build_ = CreateTileBuildData();
+
+    const float borderSize = GetTileBorderSize();
+    const Vector3 border{borderSize, padding_.y_, borderSize};
+    GetTileGeometry(tile.build_.get(), geometryList, BoundingBox{tile.boundingBox_.min_ - border, tile.boundingBox_.max_ + border});
+}
+
+ea::unique_ptr<NavBuildData> NavigationMesh::CreateTileBuildData() const
+{
+    return ea::make_unique<SimpleNavBuildData>();
+}
 
-    const BoundingBox tileColumn = GetTileBoundingBoxColumn(IntVector2{x, z});
-    const BoundingBox tileBoundingBox =
-        IsHeightRangeValid() ? tileColumn : CalculateTileBoundingBox(geometryList, tileColumn);
+bool NavigationMesh::BuildTile(BuiltTile& tile) const
+{
+    URHO3D_PROFILE("BuildNavigationMeshTile");
 
-    SimpleNavBuildData build;
+    auto& build = static_cast<SimpleNavBuildData&>(*tile.build_);
+    const BoundingBox& tileBoundingBox = tile.boundingBox_;
 
     rcConfig cfg;       // NOLINT(hicpp-member-init)
     memset(&cfg, 0, sizeof(cfg));
@@ -1316,9 +1857,6 @@ bool NavigationMesh::BuildTile(ea::vector<NavigationGeometryInfo>& geometryList,
     cfg.bmax[1] += padding_.y_;
     cfg.bmax[2] += cfg.borderSize * cfg.cs;
 
-    BoundingBox expandedBox(*reinterpret_cast<Vector3*>(cfg.bmin), *reinterpret_cast<Vector3*>(cfg.bmax));
-    GetTileGeometry(&build, geometryList, expandedBox);
-
     if (build.vertices_.empty() || build.indices_.empty())
         return true; // Nothing to do
 
@@ -1441,9 +1979,6 @@ bool NavigationMesh::BuildTile(ea::vector<NavigationGeometryInfo>& geometryList,
             build.polyMesh_->flags[i] = 0x1;
     }
 
-    unsigned char* navData = nullptr;
-    int navDataSize = 0;
-
     dtNavMeshCreateParams params;       // NOLINT(hicpp-member-init)
     memset(&params, 0, sizeof params);
     params.verts = build.polyMesh_->verts;
@@ -1461,8 +1996,8 @@ bool NavigationMesh::BuildTile(ea::vector<NavigationGeometryInfo>& geometryList,
     params.walkableHeight = agentHeight_;
     params.walkableRadius = agentRadius_;
     params.walkableClimb = agentMaxClimb_;
-    params.tileX = x;
-    params.tileY = z;
+    params.tileX = tile.tileIndex_.x_;
+    params.tileY = tile.tileIndex_.y_;
     rcVcopy(params.bmin, build.polyMesh_->bmin);
     rcVcopy(params.bmax, build.polyMesh_->bmax);
     params.cs = cfg.cs;
@@ -1480,45 +2015,134 @@ bool NavigationMesh::BuildTile(ea::vector<NavigationGeometryInfo>& geometryList,
         params.offMeshConDir = &build.offMeshDir_[0];
     }
 
+    unsigned char* navData = nullptr;
+    int navDataSize = 0;
     if (!dtCreateNavMeshData(&params, &navData, &navDataSize))
     {
         URHO3D_LOGERROR("Could not build navigation mesh tile data");
         return false;
     }
 
-    if (dtStatusFailed(navMesh_->addTile(navData, navDataSize, DT_TILE_FREE_DATA, 0, nullptr)))
+    tile.data_.emplace_back(navData, navDataSize);
+    return true;
+}
+
+unsigned NavigationMesh::AddBuiltTile(BuiltTile& tile)
+{
+    // Remove previous tile (if any)
+    navMesh_->removeTile(navMesh_->getTileRefAt(tile.tileIndex_.x_, tile.tileIndex_.y_, 0), nullptr, nullptr);
+
+    for (auto& [data, dataSize] : tile.data_)
     {
-        URHO3D_LOGERROR("Failed to add navigation mesh tile");
-        dtFree(navData);
-        return false;
+        if (dtStatusFailed(navMesh_->addTile(data, dataSize, DT_TILE_FREE_DATA, 0, nullptr)))
+        {
+            URHO3D_LOGERROR("Failed to add navigation mesh tile");
+            return 0;
+        }
+
+        // Data is owned by the navigation mesh now
+        data = nullptr;
     }
 
-    // Send a notification of the rebuild of this tile to anyone interested
+    // Empty tiles are successfully built too
+    return 1;
+}
+
+void NavigationMesh::BuildTilesInBatches(const IntVector2& from, const IntVector2& to,
+    const ea::function<void(unsigned slot, const IntVector2& tileIndex)>& buildTile,
+    const ea::function<void(unsigned slot, const IntVector2& tileIndex)>& addTile)
+{
+    const IntVector2 numTilesXZ = to - from + IntVector2::ONE;
+    if (numTilesXZ.x_ <= 0 || numTilesXZ.y_ <= 0)
+        return;
+
+    const unsigned numTiles = numTilesXZ.x_ * numTilesXZ.y_;
+    const auto getTileIndex = [&](unsigned index) { return from + IntVector2(index % numTilesXZ.x_, index / numTilesXZ.x_); };
+
+    auto workQueue = GetSubsystem<WorkQueue>();
+    const bool isParallel = workQueue && WorkQueue::IsProcessingThread();
+
+    for (unsigned batchBegin = 0; batchBegin < numTiles; batchBegin += TileBuildBatchSize)
     {
-        using namespace NavigationAreaRebuilt;
-        VariantMap& eventData = GetContext()->GetEventDataMap();
-        eventData[P_NODE] = GetNode();
-        eventData[P_MESH] = this;
-        eventData[P_BOUNDSMIN] = Variant(tileBoundingBox.min_);
-        eventData[P_BOUNDSMAX] = Variant(tileBoundingBox.max_);
-        SendEvent(E_NAVIGATION_AREA_REBUILT, eventData);
+        const unsigned batchSize = ea::min(numTiles - batchBegin, TileBuildBatchSize);
+        const auto buildTiles = [&](unsigned begin, unsigned end, unsigned)
+        {
+            for (unsigned slot = begin; slot < end; ++slot)
+                buildTile(slot, getTileIndex(batchBegin + slot));
+        };
+
+        // Tiles are independent and can be built in any order
+        if (isParallel)
+            workQueue->ParallelFor(batchSize, 1, buildTiles);
+        else
+            buildTiles(0, batchSize, 0);
+
+        // Detour structures are not thread-safe, add tiles sequentially
+        for (unsigned slot = 0; slot < batchSize; ++slot)
+            addTile(slot, getTileIndex(batchBegin + slot));
+
+        SendBuildProgressEvent(batchBegin + batchSize, numTiles);
     }
-    return true;
+}
+
+void NavigationMesh::SendAreaRebuiltEvent(const BoundingBox& boundingBox)
+{
+    using namespace NavigationAreaRebuilt;
+    VariantMap& eventData = GetContext()->GetEventDataMap();
+    eventData[P_NODE] = GetNode();
+    eventData[P_MESH] = this;
+    eventData[P_BOUNDSMIN] = Variant(boundingBox.min_);
+    eventData[P_BOUNDSMAX] = Variant(boundingBox.max_);
+    SendEvent(E_NAVIGATION_AREA_REBUILT, eventData);
+}
+
+void NavigationMesh::SendBuildProgressEvent(unsigned numBuiltTiles, unsigned numTiles)
+{
+    using namespace NavigationBuildProgress;
+    VariantMap& eventData = GetContext()->GetEventDataMap();
+    eventData[P_NODE] = GetNode();
+    eventData[P_MESH] = this;
+    eventData[P_NUMBUILTTILES] = numBuiltTiles;
+    eventData[P_NUMTILES] = numTiles;
+    SendEvent(E_NAVIGATION_BUILD_PROGRESS, eventData);
 }
 
 unsigned NavigationMesh::BuildTilesFromGeometry(
     ea::vector<NavigationGeometryInfo>& geometryList, const IntVector2& from, const IntVector2& to)
 {
+    PrepareTileGeometry(geometryList);
+
+    ea::vector<ea::unique_ptr<BuiltTile>> builtTiles(TileBuildBatchSize);
     unsigned numTiles = 0;
 
-    for (int z = from.y_; z <= to.y_; ++z)
+    const auto buildTile = [&](unsigned slot, const IntVector2& tileIndex)
     {
-        for (int x = from.x_; x <= to.x_; ++x)
-        {
-            if (BuildTile(geometryList, x, z))
-                ++numTiles;
-        }
-    }
+        auto tile = ea::make_unique<BuiltTile>();
+        GatherTileGeometry(*tile, geometryList, tileIndex);
+        tile->success_ = BuildTile(*tile);
+        tile->build_ = nullptr;
+        builtTiles[slot] = ea::move(tile);
+    };
+
+    const auto addTile = [&](unsigned slot, const IntVector2& tileIndex)
+    {
+        const ea::unique_ptr<BuiltTile> tile = ea::move(builtTiles[slot]);
+
+        // Tile is up to date, discard background builds
+        dirtyTiles_.erase(tileIndex);
+        pendingTiles_.erase(tileIndex);
+
+        if (!tile->success_)
+            return;
+
+        numTiles += AddBuiltTile(*tile);
+
+        // Send a notification of the rebuild of this tile to anyone interested
+        if (!tile->data_.empty())
+            SendAreaRebuiltEvent(tile->boundingBox_);
+    };
+
+    BuildTilesInBatches(from, to, buildTile, addTile);
     return numTiles;
 }
 
@@ -1546,6 +2170,23 @@ bool NavigationMesh::InitializeQuery()
     return true;
 }
 
+void NavigationMesh::ReleasePathQueries()
+{
+    PathRequestQueue& queue = *pathRequests_;
+    for (const auto& context : queue.contexts_)
+    {
+        if (ea::unique_ptr<PathRequest> request = ea::move(context->current_))
+        {
+            request->resolved_ = false;
+            request->searchStarted_ = false;
+            request->continued_ = false;
+            queue.pending_.push_front(ea::move(request));
+        }
+    }
+    queue.contexts_.clear();
+    ClearPathCache();
+}
+
 void NavigationMesh::ReleaseNavigationMesh()
 {
     dtFreeNavMesh(navMesh_);
@@ -1553,6 +2194,262 @@ void NavigationMesh::ReleaseNavigationMesh()
 
     dtFreeNavMeshQuery(navMeshQuery_);
     navMeshQuery_ = nullptr;
+    ReleasePathQueries();
+
+    // Tiles being built in background are discarded when ready
+    dirtyTiles_.clear();
+    pendingTiles_.clear();
+}
+
+void NavigationMesh::StopBackgroundTasks()
+{
+    // Wait for background tasks that are still using the navigation mesh
+    backgroundTiles_->alive_ = false;
+    while (backgroundTiles_->numRunningTasks_ > 0)
+        Time::Sleep(1);
+}
+
+void NavigationMesh::OnSceneSet(Scene* scene)
+{
+    if (scene)
+        SubscribeToEvent(scene, E_SCENEPOSTUPDATE, URHO3D_HANDLER(NavigationMesh, HandleScenePostUpdate));
+    else
+    {
+        UnsubscribeFromEvent(E_SCENEPOSTUPDATE);
+        StopTrackingGeometry();
+    }
+}
+
+void NavigationMesh::OnMarkedDirty(Node* node)
+{
+    if (trackingGeometry_)
+        changedNodes_.emplace_back(node, WeakPtr<Node>(node));
+}
+
+void NavigationMesh::StartTrackingGeometry()
+{
+    Scene* scene = GetScene();
+    if (!scene)
+        return;
+
+    trackingGeometry_ = true;
+
+    ea::vector<NavigationGeometryInfo> geometryList;
+    CollectGeometries(geometryList);
+    for (const NavigationGeometryInfo& info : geometryList)
+    {
+        // Off-mesh connections and areas are not tracked
+        if (info.component_->IsInstanceOf<OffMeshConnection>() || info.component_->IsInstanceOf<NavArea>())
+            continue;
+
+        Node* node = info.component_->GetNode();
+        TrackedNode& trackedNode = trackedNodes_[node];
+        trackedNode.node_ = node;
+        trackedNode.boundingBox_.Merge(info.boundingBox_);
+        node->AddListener(this);
+    }
+
+    for (StringHash eventType : {E_NODEADDED, E_NODEREMOVED, E_NODEENABLEDCHANGED, E_COMPONENTADDED, E_COMPONENTREMOVED,
+             E_COMPONENTENABLEDCHANGED})
+        SubscribeToEvent(scene, eventType, URHO3D_HANDLER(NavigationMesh, HandleSceneGeometryChanged));
+}
+
+void NavigationMesh::StopTrackingGeometry()
+{
+    if (!trackingGeometry_)
+        return;
+
+    trackingGeometry_ = false;
+
+    for (const auto& [_, trackedNode] : trackedNodes_)
+    {
+        if (Node* node = trackedNode.node_)
+            node->RemoveListener(this);
+    }
+    trackedNodes_.clear();
+    changedNodes_.clear();
+
+    for (StringHash eventType : {E_NODEADDED, E_NODEREMOVED, E_NODEENABLEDCHANGED, E_COMPONENTADDED, E_COMPONENTREMOVED,
+             E_COMPONENTENABLEDCHANGED})
+        UnsubscribeFromEvent(eventType);
+}
+
+void NavigationMesh::MarkNodeChanged(Node* node, bool recursive)
+{
+    changedNodes_.emplace_back(node, WeakPtr<Node>(node));
+    if (recursive)
+    {
+        for (Node* child : node->GetChildren(true))
+            changedNodes_.emplace_back(child, WeakPtr<Node>(child));
+    }
+}
+
+bool NavigationMesh::IsNavigableNode(Node* node) const
+{
+    if (!node_ || (node != node_ && !node->IsChildOf(node_)))
+        return false;
+
+    for (Node* current = node; current; current = current->GetParent())
+    {
+        auto navigable = current->GetComponent<Navigable>();
+        if (navigable && navigable->IsEnabledEffective() && (current == node || navigable->IsRecursive()))
+            return true;
+        if (current == node_)
+            break;
+    }
+    return false;
+}
+
+void NavigationMesh::UpdateChangedNodes()
+{
+    if (changedNodes_.empty())
+        return;
+
+    URHO3D_PROFILE("UpdateNavigationGeometry");
+
+    ea::hash_set<Node*> updatedNodes;
+    for (const auto& [nodeKey, weakNode] : changedNodes_)
+    {
+        if (!updatedNodes.insert(nodeKey).second)
+            continue;
+
+        // Tiles that contained the node before the change should be rebuilt
+        const auto iter = trackedNodes_.find(nodeKey);
+        if (iter != trackedNodes_.end())
+        {
+            MarkRegionDirty(iter->second.boundingBox_);
+            trackedNodes_.erase(iter);
+        }
+
+        Node* node = weakNode.Get();
+        if (!node || !IsNavigableNode(node))
+            continue;
+
+        ea::vector<NavigationGeometryInfo> geometryList;
+        ea::hash_set<Node*> processedNodes;
+        CollectGeometries(geometryList, node, processedNodes, false);
+
+        BoundingBox boundingBox;
+        for (const NavigationGeometryInfo& info : geometryList)
+            boundingBox.Merge(info.boundingBox_);
+
+        if (boundingBox.Defined())
+        {
+            trackedNodes_[node] = TrackedNode{weakNode, boundingBox};
+            node->AddListener(this);
+            MarkRegionDirty(boundingBox);
+        }
+    }
+    changedNodes_.clear();
+}
+
+void NavigationMesh::DispatchDirtyTiles()
+{
+    if (dirtyTiles_.empty() || !navMesh_)
+        return;
+
+    URHO3D_PROFILE("DispatchNavigationMeshTiles");
+
+    // Geometry is gathered in main thread because the scene may change while tiles are being built
+    ea::vector<NavigationGeometryInfo> geometryList;
+    CollectGeometries(geometryList);
+
+    auto workQueue = GetSubsystem<WorkQueue>();
+    for (const IntVector2& tileIndex : dirtyTiles_)
+    {
+        auto tile = ea::make_shared<BuiltTile>();
+        GatherTileGeometry(*tile, geometryList, tileIndex);
+
+        const unsigned serial = nextTileBuildSerial_++;
+        pendingTiles_[tileIndex] = serial;
+
+        const auto buildTile = [this, queue = backgroundTiles_, tile, serial]
+        {
+            ++queue->numRunningTasks_;
+            if (queue->alive_)
+            {
+                tile->success_ = BuildTile(*tile);
+                tile->build_ = nullptr;
+
+                MutexLock lock(queue->mutex_);
+                queue->builtTiles_.emplace_back(serial, tile);
+            }
+            --queue->numRunningTasks_;
+        };
+
+        if (workQueue)
+            workQueue->PostTask(buildTile, TaskPriority::Low);
+        else
+            buildTile();
+    }
+    dirtyTiles_.clear();
+}
+
+void NavigationMesh::AddBackgroundTiles()
+{
+    if (pendingTiles_.empty())
+        return;
+
+    URHO3D_PROFILE("AddNavigationMeshTiles");
+
+    HiresTimer timer;
+    const long long maxTime = maxTileUpdateMs_ * 1000LL;
+    while (timer.GetUSec(false) < maxTime)
+    {
+        ea::pair<unsigned, ea::shared_ptr<BuiltTile>> builtTile;
+        {
+            MutexLock lock(backgroundTiles_->mutex_);
+            if (backgroundTiles_->builtTiles_.empty())
+                break;
+
+            builtTile = ea::move(backgroundTiles_->builtTiles_.back());
+            backgroundTiles_->builtTiles_.pop_back();
+        }
+
+        // Skip outdated tiles, newer version of the tile is being built or the navigation mesh is rebuilt
+        const auto& [serial, tile] = builtTile;
+        const auto iter = pendingTiles_.find(tile->tileIndex_);
+        if (iter == pendingTiles_.end() || iter->second != serial)
+            continue;
+        pendingTiles_.erase(iter);
+
+        // Keep previous tile if the build failed
+        if (!tile->success_)
+            continue;
+
+        AddBuiltTile(*tile);
+        ClearPathCache();
+
+        if (!tile->data_.empty())
+            SendAreaRebuiltEvent(tile->boundingBox_);
+        SendTileAddedEvent(tile->tileIndex_);
+    }
+}
+
+void NavigationMesh::HandleScenePostUpdate(StringHash eventType, VariantMap& eventData)
+{
+    if (autoUpdate_ && !trackingGeometry_)
+        StartTrackingGeometry();
+
+    UpdateChangedNodes();
+    DispatchDirtyTiles();
+    AddBackgroundTiles();
+    ProcessPathRequests();
+}
+
+void NavigationMesh::HandleSceneGeometryChanged(StringHash eventType, VariantMap& eventData)
+{
+    using namespace ComponentAdded;
+
+    auto node = static_cast<Node*>(eventData[P_NODE].GetPtr());
+    if (!node)
+        return;
+
+    // Changes of nodes and Navigable components affect the whole subtree
+    const bool isComponentEvent =
+        eventType == E_COMPONENTADDED || eventType == E_COMPONENTREMOVED || eventType == E_COMPONENTENABLEDCHANGED;
+    const auto component = isComponentEvent ? static_cast<Component*>(eventData[P_COMPONENT].GetPtr()) : nullptr;
+    MarkNodeChanged(node, !isComponentEvent || (component && component->IsInstanceOf<Navigable>()));
 }
 
 void NavigationMesh::SetPartitionType(NavmeshPartitionType partitionType)
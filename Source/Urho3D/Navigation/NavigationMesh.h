@@ -28,7 +28,10 @@
 #include "Urho3D/Navigation/NavigationDefs.h"
 #include "Urho3D/Scene/Component.h"
 
+#include <EASTL/functional.h>
+#include <EASTL/shared_ptr.h>
 #include <EASTL/unique_ptr.h>
+#include <EASTL/unordered_map.h>
 #include <EASTL/unordered_set.h>
 
 class dtNavMesh;
@@ -70,6 +73,9 @@ struct URHO3D_API NavigationPathPoint
     unsigned char areaID_;
 };
 
+/// Callback invoked in the main thread when the asynchronous path request is completed. The path is empty if not found.
+using NavigationPathCallback = ea::function<void(unsigned requestId, const ea::vector<NavigationPathPoint>& path)>;
+
 /// Navigation mesh component. Collects the navigation geometry from child nodes with the Navigable component and responds to path queries.
 class URHO3D_API NavigationMesh : public Component
 {
@@ -84,6 +90,14 @@ public:
     static constexpr int DefaultMaxTiles = 256;
     /// Maximum number of layers in the single tile.
     static constexpr unsigned MaxLayers = 255;
+    /// Number of tiles that are built in parallel before they are added to the navigation mesh.
+    static constexpr unsigned TileBuildBatchSize = 256;
+    /// Default maximum time in milliseconds per frame spent on adding tiles rebuilt in background.
+    static constexpr int DefaultMaxTileUpdateMs = 2;
+    /// Default maximum number of A* iterations per frame spent on asynchronous path requests.
+    static constexpr int DefaultMaxPathIterations = 4096;
+    /// Default maximum number of cached polygon corridors of asynchronous path requests.
+    static constexpr unsigned DefaultMaxPathCacheSize = 256;
 
     /// Construct.
     explicit NavigationMesh(Context* context);
@@ -155,6 +169,50 @@ public:
     bool BuildTiles(const IntVector2& from, const IntVector2& to);
     /// Rebuild the navigation mesh allocating sufficient maximum number of tiles. Return true if successful.
     bool Rebuild();
+    /// Mark tiles affected by geometry within the bounding box as dirty.
+    /// Dirty tiles are rebuilt in background and replace existing tiles over the next frames.
+    void MarkRegionDirty(const BoundingBox& boundingBox);
+
+    /// Set whether to track changes of navigable geometry and rebuild affected tiles in background.
+    /// @property
+    void SetAutoUpdate(bool enable);
+    /// Return whether to track changes of navigable geometry and rebuild affected tiles in background.
+    /// @property
+    bool GetAutoUpdate() const { return autoUpdate_; }
+    /// Set maximum time in milliseconds per frame spent on adding tiles rebuilt in background.
+    /// @property
+    void SetMaxTileUpdateMs(int ms) { maxTileUpdateMs_ = Max(ms, 1); }
+    /// Return maximum time in milliseconds per frame spent on adding tiles rebuilt in background.
+    /// @property
+    int GetMaxTileUpdateMs() const { return maxTileUpdateMs_; }
+    /// Return number of dirty tiles that are not yet rebuilt and added to the navigation mesh.
+    unsigned GetNumDirtyTiles() const { return dirtyTiles_.size() + pendingTiles_.size(); }
+
+    /// Request a path between world space points. The path is found over the next frames and passed to the callback.
+    /// Requests are batched and processed on WorkQueue threads during scene post-update. Return ID of the request.
+    unsigned RequestPath(const Vector3& start, const Vector3& end, const NavigationPathCallback& callback,
+        const Vector3& extents = Vector3::ONE, const dtQueryFilter* filter = nullptr);
+    /// Cancel the path request. Callback is not invoked afterwards. Return true if the request was pending.
+    bool CancelPathRequest(unsigned requestId);
+    /// Process pending path requests within the iteration budget and invoke callbacks of completed ones.
+    /// Called automatically on scene post-update.
+    void ProcessPathRequests();
+    /// Remove all cached polygon corridors. Called automatically when tiles are added or replaced.
+    void ClearPathCache();
+    /// Return number of path requests that are not completed yet.
+    unsigned GetNumPathRequests() const;
+    /// Set maximum number of A* iterations per frame spent on path requests.
+    /// @property
+    void SetMaxPathIterations(int iterations) { maxPathIterations_ = Max(iterations, 1); }
+    /// Return maximum number of A* iterations per frame spent on path requests.
+    /// @property
+    int GetMaxPathIterations() const { return maxPathIterations_; }
+    /// Set maximum number of cached polygon corridors. Zero disables the cache.
+    /// @property
+    void SetMaxPathCacheSize(unsigned size);
+    /// Return maximum number of cached polygon corridors.
+    /// @property
+    unsigned GetMaxPathCacheSize() const { return maxPathCacheSize_; }
 
     /// Enumerate all tiles.
     ea::vector<IntVector2> GetAllTileIndices() const;
@@ -314,6 +372,33 @@ private:
     bool ReadTile(Deserializer& source, bool silent);
 
 protected:
+    /// Tile of the navigation mesh that is built in any thread and then added to the navigation mesh in main thread.
+    struct BuiltTile
+    {
+        /// Destruct. Free data that is not added to the navigation mesh.
+        ~BuiltTile();
+
+        /// Tile index.
+        IntVector2 tileIndex_;
+        /// Bounding box of the tile.
+        BoundingBox boundingBox_;
+        /// Geometry of the tile gathered from the scene. Released when the tile is built.
+        ea::unique_ptr<NavBuildData> build_;
+        /// Whether the tile is successfully built.
+        bool success_{};
+        /// Data of the built tile or tile cache layers, allocated with dtAlloc. Empty if the tile has no geometry.
+        ea::vector<ea::pair<unsigned char*, int>> data_;
+    };
+    /// Queue of tiles built in background. Shared with WorkQueue tasks.
+    struct BackgroundTileQueue;
+    /// Queue of asynchronous path requests with query contexts and cached corridors.
+    struct PathRequestQueue;
+
+    /// Handle scene being assigned.
+    void OnSceneSet(Scene* scene) override;
+    /// Handle scene node transform dirtied.
+    void OnMarkedDirty(Node* node) override;
+
     /// Allocate the navigation mesh without building any tiles. Return true if successful.
     virtual bool AllocateMesh(unsigned maxTiles);
     /// Rebuild the navigation mesh allocating sufficient maximum number of tiles. Return true if successful.
@@ -330,17 +415,63 @@ protected:
     void CollectGeometries(ea::vector<NavigationGeometryInfo>& geometryList);
     /// Visit nodes and collect navigable geometry.
     void CollectGeometries(ea::vector<NavigationGeometryInfo>& geometryList, Node* node, ea::hash_set<Node*>& processedNodes, bool recursive);
+    /// Update cached transforms of the geometry so it can be accessed from multiple threads.
+    void PrepareTileGeometry(const ea::vector<NavigationGeometryInfo>& geometryList);
     /// Get geometry data within a bounding box.
-    void GetTileGeometry(NavBuildData* build, ea::vector<NavigationGeometryInfo>& geometryList, BoundingBox& box);
+    void GetTileGeometry(NavBuildData* build, const ea::vector<NavigationGeometryInfo>& geometryList, const BoundingBox& box) const;
     /// Add a triangle mesh to the geometry data.
-    void AddTriMeshGeometry(NavBuildData* build, Geometry* geometry, const Matrix3x4& transform);
-    /// Build one tile of the navigation mesh. Return true if successful.
-    bool BuildTile(ea::vector<NavigationGeometryInfo>& geometryList, int x, int z);
+    void AddTriMeshGeometry(NavBuildData* build, Geometry* geometry, const Matrix3x4& transform) const;
+    /// Return size of the tile border in world units. Geometry within the border affects the tile.
+    float GetTileBorderSize() const;
+    /// Gather geometry of the tile from the scene.
+    /// Can be called from any thread if PrepareTileGeometry was called and the scene is not modified.
+    void GatherTileGeometry(BuiltTile& tile, const ea::vector<NavigationGeometryInfo>& geometryList, const IntVector2& tileIndex) const;
+    /// Create build data for the tile.
+    virtual ea::unique_ptr<NavBuildData> CreateTileBuildData() const;
+    /// Build the tile from gathered geometry. Can be called from any thread. Return true if successful.
+    virtual bool BuildTile(BuiltTile& tile) const;
+    /// Replace existing tile with the built tile. Return number of added tiles or layers.
+    virtual unsigned AddBuiltTile(BuiltTile& tile);
+    /// Build tiles within the range in batches. Tiles of each batch are built in parallel by buildTile(slot, tileIndex),
+    /// then they are added sequentially by addTile(slot, tileIndex). Slot is an index within the batch.
+    void BuildTilesInBatches(const IntVector2& from, const IntVector2& to,
+        const ea::function<void(unsigned slot, const IntVector2& tileIndex)>& buildTile,
+        const ea::function<void(unsigned slot, const IntVector2& tileIndex)>& addTile);
+    /// Send partial rebuild event.
+    void SendAreaRebuiltEvent(const BoundingBox& boundingBox);
+    /// Send tile building progress event.
+    void SendBuildProgressEvent(unsigned numBuiltTiles, unsigned numTiles);
     /// Ensure that the navigation mesh query is initialized. Return true if successful.
     bool InitializeQuery();
     /// Release the navigation mesh and the query.
     virtual void ReleaseNavigationMesh();
 
+    /// Stop background tasks and wait for running ones. Should be called in destructor before the settings are released.
+    void StopBackgroundTasks();
+    /// Start tracking changes of navigable geometry.
+    void StartTrackingGeometry();
+    /// Stop tracking changes of navigable geometry.
+    void StopTrackingGeometry();
+    /// Mark node and optionally its children as changed.
+    void MarkNodeChanged(Node* node, bool recursive);
+    /// Return whether the geometry of the node is collected for this navigation mesh.
+    bool IsNavigableNode(Node* node) const;
+    /// Update bounding boxes of changed nodes and mark affected tiles as dirty.
+    void UpdateChangedNodes();
+    /// Gather geometry of dirty tiles and start building them in background.
+    void DispatchDirtyTiles();
+    /// Add tiles built in background within the time budget.
+    void AddBackgroundTiles();
+    /// Convert local space path points to world space and assign area IDs.
+    void ConvertPathPoints(ea::vector<NavigationPathPoint>& dest, const Vector3* points, const unsigned char* flags,
+        unsigned numPoints) const;
+    /// Release per-thread queries of path requests and restart searches in progress.
+    void ReleasePathQueries();
+    /// Handle scene post-update.
+    void HandleScenePostUpdate(StringHash eventType, VariantMap& eventData);
+    /// Handle node or component added, removed or enabled state changed.
+    void HandleSceneGeometryChanged(StringHash eventType, VariantMap& eventData);
+
     /// Draw debug geometry for single tile.
     void DrawDebugTileGeometry(DebugRenderer* debug, bool depthTest, int tileIndex);
 
@@ -396,6 +527,40 @@ protected:
     bool drawNavAreas_;
     /// NavAreas for this NavMesh.
     ea::vector<WeakPtr<NavArea> > areas_;
+
+    /// Whether to track changes of navigable geometry.
+    bool autoUpdate_{};
+    /// Maximum time in milliseconds per frame spent on adding tiles rebuilt in background.
+    int maxTileUpdateMs_{DefaultMaxTileUpdateMs};
+    /// Whether the geometry is being tracked.
+    bool trackingGeometry_{};
+    /// Node with navigable geometry tracked for changes.
+    struct TrackedNode
+    {
+        /// Node.
+        WeakPtr<Node> node_;
+        /// Bounding box of the geometry when the node was last updated.
+        BoundingBox boundingBox_;
+    };
+    /// Tracked nodes.
+    ea::unordered_map<Node*, TrackedNode> trackedNodes_;
+    /// Nodes changed since the last update.
+    ea::vector<ea::pair<Node*, WeakPtr<Node>>> changedNodes_;
+    /// Tiles waiting for rebuild.
+    ea::unordered_set<IntVector2> dirtyTiles_;
+    /// Tiles being rebuilt in background. Value is the serial number of the latest build of the tile.
+    ea::unordered_map<IntVector2, unsigned> pendingTiles_;
+    /// Serial number of the next tile build.
+    unsigned nextTileBuildSerial_{};
+    /// Tiles built in background and shared with WorkQueue tasks.
+    ea::shared_ptr<BackgroundTileQueue> backgroundTiles_;
+
+    /// Maximum number of A* iterations per frame spent on path requests.
+    int maxPathIterations_{DefaultMaxPathIterations};
+    /// Maximum number of cached polygon corridors.
+    unsigned maxPathCacheSize_{DefaultMaxPathCacheSize};
+    /// Asynchronous path requests.
+    ea::unique_ptr<PathRequestQueue> pathRequests_;
 };
 
 /// Register Navigation library objects.
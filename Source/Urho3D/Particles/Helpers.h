@@ -23,6 +23,7 @@
 #pragma once
 
 #include "../Core/Context.h"
+#include "../Math/BatchMath.h"
 #include "ParticleGraphEffect.h"
 #include "ParticleGraphLayerInstance.h"
 #include "ParticleGraphNode.h"
@@ -54,6 +55,30 @@ void RunUpdate(const UpdateContext& context, Instance& instance, ParticleGraphPi
     ea::apply(instance, ea::tuple_cat(ea::tie(context), ea::make_tuple(static_cast<unsigned>(context.indices_.size())), spans));
 };
 
+/// Number of float components in values processed by batch math, or zero if values can't be processed.
+template <typename T> inline constexpr unsigned NumBatchComponents = 0;
+template <> inline constexpr unsigned NumBatchComponents<float> = 1;
+template <> inline constexpr unsigned NumBatchComponents<Vector2> = 2;
+template <> inline constexpr unsigned NumBatchComponents<Vector3> = 3;
+template <> inline constexpr unsigned NumBatchComponents<Vector4> = 4;
+template <> inline constexpr unsigned NumBatchComponents<Color> = 4;
+
+/// Whether all values have the same type that can be processed by batch math.
+template <typename Value, typename... Values>
+inline constexpr bool IsBatchOperation = NumBatchComponents<Value> != 0 && (ea::is_same_v<Value, Values> && ...);
+
+/// Return batch math operand for span. Scalar value is repeated for all particles.
+template <typename T> BatchOperand ToBatchOperand(const SparseSpan<T>& span)
+{
+    return BatchOperand{reinterpret_cast<const float*>(&span[0]), span.IsScalar()};
+}
+
+/// Return batch math output for span.
+template <typename T> float* ToBatchOutput(const SparseSpan<T>& span)
+{
+    return reinterpret_cast<float*>(&span[0]);
+}
+
 template <template <typename> typename T, typename ... Args>
 void SelectByVariantType(VariantType variantType, Args... args)
 {
@@ -34,9 +34,18 @@ namespace ParticleGraphNodes
 class ApplyForceInstance final : public ApplyForce::InstanceBase
 {
 public:
+    bool IsElementwise() const override { return true; }
+
     void operator()(const UpdateContext& context, unsigned numParticles, const SparseSpan<Vector3>& vel,
         const SparseSpan<Vector3>& force, const SparseSpan<Vector3>& result) const
     {
+        if (numParticles > 0 && !result.IsScalar())
+        {
+            MultiplyAddVectors(ToBatchOperand(vel), ToBatchOperand(force), context.timeStep_, ToBatchOutput(result),
+                numParticles, NumBatchComponents<Vector3>);
+            return;
+        }
+
         for (unsigned i = 0; i < numParticles; ++i)
         {
             result[i] = vel[i] + force[i] * context.timeStep_;
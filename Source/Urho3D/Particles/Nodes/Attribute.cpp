@@ -46,6 +46,16 @@ template <typename T> struct CopyValues
 
         auto src = context.GetSpan<T>(pin1.GetMemoryReference());
         auto dst = context.GetSpan<T>(pin0.GetMemoryReference());
+        if constexpr (ea::is_trivially_copyable_v<T>)
+        {
+            // Values are stored contiguously unless the source is scalar
+            if (numParticles > 0 && !src.IsScalar() && !dst.IsScalar())
+            {
+                memmove(&dst[0], &src[0], numParticles * sizeof(T));
+                return;
+            }
+        }
+
         for (unsigned i = 0; i < numParticles; ++i)
         {
             dst[i] = src[i];
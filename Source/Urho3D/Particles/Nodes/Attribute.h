@@ -66,6 +66,7 @@ protected:
     {
     public:
         void Update(UpdateContext& context) override {}
+        bool IsElementwise() const override { return true; }
 
         template <typename... Spans>
         void operator()(const UpdateContext& context, unsigned numParticles, Spans... spans)
@@ -110,6 +111,7 @@ class URHO3D_API SetAttribute : public Attribute
     public:
         Instance(SetAttribute* node);
         void Update(UpdateContext& context) override;
+        bool IsElementwise() const override { return true; }
     protected:
         SetAttribute* node_;
     };
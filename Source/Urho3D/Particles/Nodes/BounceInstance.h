@@ -43,6 +43,8 @@ class BounceInstance final : public Bounce::InstanceBase
 public:
     void RayCastAndBounce(
         const UpdateContext& context, Node* node, PhysicsWorld* physics, Vector3& pos, Vector3& velocity);
+    /// Physics queries are not thread-safe.
+    bool IsThreadSafe() const override { return false; }
 
     void operator()(const UpdateContext& context, unsigned numParticles, const SparseSpan<Vector3>& pin0,
         const SparseSpan<Vector3>& pin1, const SparseSpan<Vector3>& pin2, const SparseSpan<Vector3>& pin3)
@@ -54,13 +54,14 @@ public:
     void Generate(Vector3& pos, Vector3& vel) const
     {
         const Box* box = static_cast<Box*>(GetGraphNode());
+        RandomEngine& random = GetLayerInstance()->GetRandom();
 
         switch (static_cast<EmitFrom>(box->GetFrom()))
         {
         case EmitFrom::Edge:
         {
-            const float x = Urho3D::Random(-1.0f, 1.0f);
-            switch (Urho3D::Random(12))
+            const float x = random.GetFloat(-1.0f, 1.0f);
+            switch (random.GetUInt(12))
             {
             case 0: pos = Vector3{x, -1.0f, -1.0f}; break;
             case 1: pos = Vector3{x, -1.0f, +1.0f}; break;
@@ -80,9 +81,9 @@ public:
         }
         case EmitFrom::Surface:
         {
-            const float x = Urho3D::Random(-1.0f, 1.0f);
-            const float y = Urho3D::Random(-1.0f, 1.0f);
-            switch (Urho3D::Random(6))
+            const float x = random.GetFloat(-1.0f, 1.0f);
+            const float y = random.GetFloat(-1.0f, 1.0f);
+            switch (random.GetUInt(6))
             {
             case 0: pos = Vector3{x, y, -1.0f}; break;
             case 1: pos = Vector3{x, y, 1.0f}; break;
@@ -96,7 +97,7 @@ public:
         }
         default:
         {
-            pos = Vector3{Urho3D::Random(-1.0f, 1.0f), Urho3D::Random(-1.0f, 1.0f), Urho3D::Random(-1.0f, 1.0f)};
+            pos = Vector3{random.GetFloat(-1.0f, 1.0f), random.GetFloat(-1.0f, 1.0f), random.GetFloat(-1.0f, 1.0f)};
             vel = pos.Normalized();
             break;
         }
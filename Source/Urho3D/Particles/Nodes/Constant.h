@@ -49,6 +49,7 @@ protected:
     public:
         Instance(Constant* node);
         void Update(UpdateContext& context) override;
+        bool IsElementwise() const override { return true; }
 
     protected:
         Constant* node_;
@@ -43,6 +43,7 @@ public:
     public:
         Instance(Curve* node);
         void Update(UpdateContext& context) override;
+        bool IsElementwise() const override { return true; }
         Curve* GetNodeInstace() { return node_; }
 
         template <typename Out>
@@ -54,8 +54,9 @@ public:
     void Generate(Vector3& pos, Vector3& vel) const
     {
         const Hemisphere* hemisphere = static_cast<Hemisphere*>(GetGraphNode());
+        RandomEngine& random = GetLayerInstance()->GetRandom();
 
-        Vector3 direction(Urho3D::Random(2.0f) - 1.0f, Urho3D::Random(2.0f) - 1.0f, Urho3D::Random(2.0f) - 1.0f);
+        Vector3 direction(random.GetFloat(0.0f, 2.0f) - 1.0f, random.GetFloat(0.0f, 2.0f) - 1.0f, random.GetFloat(0.0f, 2.0f) - 1.0f);
         direction.Normalize();
         direction.z_ = Abs(direction.z_);
 
@@ -65,7 +66,7 @@ public:
 
         if (radiusThickness_ > 0.0f && emitFrom_ != EmitFrom::Surface)
         {
-            r *= 1.0f - Urho3D::Random() * radiusThickness_;
+            r *= 1.0f - random.GetFloat() * radiusThickness_;
         }
         switch (emitFrom_)
         {
@@ -79,7 +80,7 @@ public:
             break;
         default:
             vel = direction;
-            pos = direction * hemisphere->GetRadius() * Pow(Urho3D::Random(), 1.0f / 3.0f) * 0.5f;
+            pos = direction * hemisphere->GetRadius() * Pow(random.GetFloat(), 1.0f / 3.0f) * 0.5f;
             break;
         }
     }
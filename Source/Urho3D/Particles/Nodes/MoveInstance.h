@@ -37,9 +37,18 @@ namespace ParticleGraphNodes
 class MoveInstance final : public Move::InstanceBase
 {
 public:
+    bool IsElementwise() const override { return true; }
+
     void operator()(const UpdateContext& context, unsigned numParticles, const SparseSpan<Vector3>& pin0,
         const SparseSpan<Vector3>& pin1, const SparseSpan<Vector3>& pin2)
     {
+        if (numParticles > 0 && !pin2.IsScalar())
+        {
+            MultiplyAddVectors(ToBatchOperand(pin0), ToBatchOperand(pin1), context.timeStep_, ToBatchOutput(pin2),
+                numParticles, NumBatchComponents<Vector3>);
+            return;
+        }
+
         for (unsigned i = 0; i < numParticles; ++i)
         {
             pin2[i] = pin0[i] + context.timeStep_ * pin1[i];
@@ -33,6 +33,16 @@ template <typename Value0, typename Value1, typename Value2> struct MultiplyInst
     void operator()(const UpdateContext& context, unsigned numParticles, const SparseSpan<Value0>& x,
         const SparseSpan<Value1>& y, const SparseSpan<Value2>& out)
     {
+        if constexpr (IsBatchOperation<Value0, Value1, Value2>)
+        {
+            if (numParticles > 0 && !out.IsScalar())
+            {
+                MultiplyVectors(ToBatchOperand(x), ToBatchOperand(y), ToBatchOutput(out), numParticles,
+                    NumBatchComponents<Value2>);
+                return;
+            }
+        }
+
         for (unsigned i = 0; i < numParticles; ++i)
         {
             out[i] = x[i] * y[i];
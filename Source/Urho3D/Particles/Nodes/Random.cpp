@@ -42,9 +42,10 @@ struct Generate
     void operator()(const UpdateContext& context, const ParticleGraphPin& pin0, const Variant& min, const Variant& max)
     {
         auto span = context.GetSpan<T>(pin0.GetMemoryReference());
+        RandomEngine& random = context.layer_->GetRandom();
         for (unsigned i = 0; i < context.indices_.size(); ++i)
         {
-            span[i] = min.Lerp(max, Urho3D::Random()).Get<T>();
+            span[i] = min.Lerp(max, random.GetFloat()).Get<T>();
         }
     }
 };
@@ -81,10 +81,6 @@ void RenderBillboardInstance::Prepare(unsigned numParticles)
 {
     auto* renderBillboard = static_cast<RenderBillboard*>(GetGraphNode());
 
-    if (!renderBillboard->GetIsWorldspace())
-    {
-        sceneNode_->SetWorldTransform(GetNode()->GetWorldTransform());
-    }
     unsigned numBillboards = billboardSet_->GetNumBillboards();
     //if (numBillboards < numParticles)
     {
@@ -124,6 +120,17 @@ void RenderBillboardInstance::UpdateParticle(
 
 void RenderBillboardInstance::Commit() { billboardSet_->Commit(); }
 
+void RenderBillboardInstance::CommitDrawable()
+{
+    auto* renderBillboard = static_cast<RenderBillboard*>(GetGraphNode());
+
+    if (!renderBillboard->GetIsWorldspace())
+    {
+        sceneNode_->SetWorldTransform(GetNode()->GetWorldTransform());
+    }
+    Commit();
+}
+
 } // namespace ParticleGraphNodes
 
 } // namespace Urho3D
@@ -41,6 +41,7 @@ public:
     void Init(ParticleGraphNode* node, ParticleGraphLayerInstance* layer) override;
     void OnSceneSet(Scene* scene) override;
     void UpdateDrawableAttributes() override;
+    void CommitDrawable() override;
 
     void Prepare(unsigned numParticles);
     void UpdateParticle(unsigned index, const Vector3& pos, const Vector2& size, float frameIndex, Color& color,
@@ -56,7 +57,6 @@ public:
         {
             UpdateParticle(i, pin0[i], pin1[i], frame[i], color[i], rotation[i], direction[i]);
         }
-        Commit();
     }
 
 protected:
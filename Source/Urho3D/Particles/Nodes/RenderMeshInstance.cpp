@@ -114,10 +114,14 @@ RenderMeshInstance::~RenderMeshInstance()
     OnSceneSet(nullptr);
 }
 
+void RenderMeshInstance::CommitDrawable()
+{
+    sceneNode_->SetWorldTransform(GetNode()->GetWorldTransform());
+}
+
 ea::vector<Matrix3x4>& RenderMeshInstance::Prepare(unsigned numParticles)
 {
     drawable_->transforms_.resize(numParticles);
-    sceneNode_->SetWorldTransform(GetNode()->GetWorldTransform());
     // if (node_->material_ != drawable_->GetMaterial(0))
     //    drawable_->SetMaterial(node_->material_);
     return drawable_->transforms_;
@@ -56,6 +56,7 @@ public:
 
     void OnSceneSet(Scene* scene) override;
     void UpdateDrawableAttributes() override;
+    void CommitDrawable() override;
 
     ~RenderMeshInstance() override;
 
@@ -31,6 +31,7 @@
 #include "../Scene/SceneEvents.h"
 #include "ParticleGraphLayer.h"
 #include "ParticleGraphLayerInstance.h"
+#include "ParticleGraphSystem.h"
 
 namespace Urho3D
 {
@@ -39,7 +40,11 @@ ParticleGraphEmitter::ParticleGraphEmitter(Context* context)
 {
 }
 
-ParticleGraphEmitter::~ParticleGraphEmitter() = default;
+ParticleGraphEmitter::~ParticleGraphEmitter()
+{
+    if (system_)
+        system_->RemoveEmitter(this);
+}
 
 void ParticleGraphEmitter::RegisterObject(Context* context)
 {
@@ -54,20 +59,6 @@ void ParticleGraphEmitter::RegisterObject(Context* context)
     URHO3D_ACCESSOR_ATTRIBUTE("Zone Mask", GetZoneMask, SetZoneMask, unsigned, DEFAULT_ZONEMASK, AM_DEFAULT);
 }
 
-void ParticleGraphEmitter::OnSetEnabled()
-{
-    Component::OnSetEnabled();
-
-    Scene* scene = GetScene();
-    if (scene)
-    {
-        if (IsEnabledEffective())
-            SubscribeToEvent(scene, E_SCENEPOSTUPDATE, URHO3D_HANDLER(ParticleGraphEmitter, HandleScenePostUpdate));
-        else
-            UnsubscribeFromEvent(scene, E_SCENEPOSTUPDATE);
-    }
-}
-
 void ParticleGraphEmitter::Reset()
 {
     for (auto& layer : layers_)
@@ -197,10 +188,18 @@ void ParticleGraphEmitter::OnSceneSet(Scene* scene)
 {
     Component::OnSceneSet(scene);
 
-    if (scene && IsEnabledEffective())
-        SubscribeToEvent(scene, E_SCENEPOSTUPDATE, URHO3D_HANDLER(ParticleGraphEmitter, HandleScenePostUpdate));
-    else if (!scene)
-        UnsubscribeFromEvent(E_SCENEPOSTUPDATE);
+    // Emitters are updated by ParticleGraphSystem on scene post-update
+    if (scene)
+    {
+        system_ = GetSubsystem<ParticleGraphSystem>();
+        if (system_)
+            system_->AddEmitter(this);
+    }
+    else if (system_)
+    {
+        system_->RemoveEmitter(this);
+        system_ = nullptr;
+    }
 
     for (unsigned i = 0; i < layers_.size(); ++i)
     {
@@ -219,6 +218,12 @@ bool ParticleGraphEmitter::EmitNewParticle(unsigned layer)
 }
 
 void ParticleGraphEmitter::Tick(float timeStep)
+{
+    UpdateParticles(timeStep);
+    CommitDrawables();
+}
+
+void ParticleGraphEmitter::UpdateParticles(float timeStep)
 {
     for (unsigned i = 0; i < layers_.size(); ++i)
     {
@@ -226,6 +231,24 @@ void ParticleGraphEmitter::Tick(float timeStep)
     }
 }
 
+void ParticleGraphEmitter::CommitDrawables()
+{
+    for (auto& layer : layers_)
+    {
+        layer.CommitDrawables();
+    }
+}
+
+bool ParticleGraphEmitter::IsThreadSafe() const
+{
+    for (const auto& layer : layers_)
+    {
+        if (!layer.IsThreadSafe())
+            return false;
+    }
+    return true;
+}
+
 const ParticleGraphLayerInstance* ParticleGraphEmitter::GetLayer(unsigned layer) const
 {
     if (layer >= layers_.size())
@@ -251,47 +274,6 @@ bool ParticleGraphEmitter::CheckActiveParticles() const
     return false;
 }
 
-void ParticleGraphEmitter::HandleScenePostUpdate(StringHash eventType, VariantMap& eventData)
-{
-    // Store scene's timestep and use it instead of global timestep, as time scale may be other than 1
-    using namespace ScenePostUpdate;
-
-    lastTimeStep_ = eventData[P_TIMESTEP].GetFloat();
-
-
-    Tick(lastTimeStep_);
-
-    //// If no invisible update, check that the billboardset is in view (framenumber has changed)
-    //if ((effect_ && effect_->GetUpdateInvisible()) || viewFrameNumber_ != lastUpdateFrameNumber_)
-    //{
-    //    lastUpdateFrameNumber_ = viewFrameNumber_;
-    //    needUpdate_ = true;
-    //    MarkForUpdate();
-    //}
-
-    //// Send finished event only once all particles are gone
-    //if (node_ && !emitting_ && sendFinishedEvent_ && !CheckActiveParticles())
-    //{
-    //    sendFinishedEvent_ = false;
-
-    //    // Make a weak pointer to self to check for destruction during event handling
-    //    WeakPtr<ParticleGraphEmitter> self(this);
-
-    //    using namespace ParticleEffectFinished;
-
-    //    VariantMap& eventData = GetEventDataMap();
-    //    eventData[P_NODE] = node_;
-    //    eventData[P_EFFECT] = effect_;
-
-    //    node_->SendEvent(E_PARTICLEEFFECTFINISHED, eventData);
-
-    //    if (self.Expired())
-    //        return;
-
-    //    DoAutoRemove(autoRemove_);
-    //}
-}
-
 void ParticleGraphEmitter::HandleEffectReloadFinished(StringHash eventType, VariantMap& eventData)
 {
     // When particle effect file is live-edited, remove existing particles and reapply the effect parameters
@@ -33,6 +33,7 @@ namespace Urho3D
 
 class ParticleGraphLayerInstance;
 class ParticleGraphNodeInstance;
+class ParticleGraphSystem;
 
 /// %Particle graph emitter component.
 class URHO3D_API ParticleGraphEmitter : public Component
@@ -47,9 +48,6 @@ public:
     /// Register object factory.
     static void RegisterObject(Context* context);
 
-    /// Handle enabled/disabled state change.
-    void OnSetEnabled() override;
-
     /// Set particle effect.
     void SetEffect(ParticleGraphEffect* effect);
     /// Reset the particle emitter completely. Removes current particles, sets emitting state on, and resets the
@@ -100,6 +98,12 @@ public:
 
     /// Manually update emitter.
     void Tick(float timeStep);
+    /// Update particles of all layers without touching drawables. May be called from worker thread if thread-safe.
+    void UpdateParticles(float timeStep);
+    /// Apply results of the last particle update to drawables. Should be called from main thread.
+    void CommitDrawables();
+    /// Return whether particles may be updated from worker thread.
+    bool IsThreadSafe() const;
 
     /// Get layer by index.
     const ParticleGraphLayerInstance* GetLayer(unsigned layer) const;
@@ -115,8 +119,6 @@ protected:
     void OnSceneSet(Scene* scene) override;
 
 private:
-    /// Handle scene post-update event.
-    void HandleScenePostUpdate(StringHash eventType, VariantMap& eventData);
     /// Handle live reload of the particle effect.
     void HandleEffectReloadFinished(StringHash eventType, VariantMap& eventData);
     /// Update all drawable attributes.
@@ -136,8 +138,8 @@ private:
     /// Zone mask.
     unsigned zoneMask_{DEFAULT_ZONEMASK};
 
-    /// Last scene timestep.
-    float lastTimeStep_{};
+    /// Particle graph system that updates the emitter.
+    WeakPtr<ParticleGraphSystem> system_;
 
     /// Currently emitting flag.
     bool emitting_{true};
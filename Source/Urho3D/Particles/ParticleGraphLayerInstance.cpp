@@ -28,10 +28,33 @@
 #include "ParticleGraphNodeInstance.h"
 #include "Span.h"
 #include "UpdateContext.h"
+#include "../Core/WorkQueue.h"
+#include "../Math/Random.h"
 
 namespace Urho3D
 {
 
+namespace
+{
+
+/// Return whether all output pins of the node are scalar.
+bool HasOnlyScalarOutputs(const ParticleGraphNode* node)
+{
+    bool hasOutputs = false;
+    for (unsigned i = 0; i < node->GetNumPins(); ++i)
+    {
+        const ParticleGraphPin& pin = node->GetPin(i);
+        if (pin.IsInput())
+            continue;
+        if (pin.GetContainerType() != ParticleGraphContainerType::Scalar)
+            return false;
+        hasOutputs = true;
+    }
+    return hasOutputs;
+}
+
+}
+
 ParticleGraphLayerInstance::ParticleGraphLayerInstance()
     : activeParticles_(0)
     , destructionQueueSize_(0)
@@ -61,6 +84,8 @@ void ParticleGraphLayerInstance::Apply(const SharedPtr<ParticleGraphLayer>& laye
     if (!layer->Commit())
         return;
     layer_ = layer;
+    random_ = RandomEngine(static_cast<unsigned>(Rand()));
+    threadSafe_ = true;
     const auto& layout = layer_->GetAttributeBufferLayout();
     if (layout.attributeBufferSize_ > 0)
         attributes_.resize(layout.attributeBufferSize_);
@@ -196,6 +221,22 @@ void ParticleGraphLayerInstance::UpdateDrawables()
     }
 }
 
+void ParticleGraphLayerInstance::CommitDrawables()
+{
+    for (ParticleGraphNodeInstance* node : initNodeInstances_)
+    {
+        node->CommitDrawable();
+    }
+    for (ParticleGraphNodeInstance* node : emitNodeInstances_)
+    {
+        node->CommitDrawable();
+    }
+    for (ParticleGraphNodeInstance* node : updateNodeInstances_)
+    {
+        node->CommitDrawable();
+    }
+}
+
 void ParticleGraphLayerInstance::SetEmitter(ParticleGraphEmitter* emitter)
 {
     emitter_ = emitter;
@@ -234,12 +275,68 @@ UpdateContext ParticleGraphLayerInstance::MakeUpdateContext(float timeStep)
 
 void ParticleGraphLayerInstance::RunGraph(ea::span<ParticleGraphNodeInstance*>& nodes, UpdateContext& updateContext)
 {
-    for (ParticleGraphNodeInstance* node : nodes)
+    const unsigned numParticles = updateContext.indices_.size();
+    unsigned nodeIndex = 0;
+    while (nodeIndex < nodes.size())
     {
-        node->Update(updateContext);
+        unsigned chainEnd = nodeIndex;
+        while (chainEnd < nodes.size() && nodes[chainEnd]->IsElementwise())
+            ++chainEnd;
+
+        if (chainEnd - nodeIndex < 2 || numParticles <= UpdateBlockSize)
+        {
+            const unsigned nodesEnd = ea::max(chainEnd, nodeIndex + 1);
+            for (; nodeIndex < nodesEnd; ++nodeIndex)
+                nodes[nodeIndex]->Update(updateContext);
+            continue;
+        }
+
+        // Each block passes through the whole chain while its values are still in cache
+        const auto updateBlock = [&](unsigned blockIndex, bool skipUniform)
+        {
+            const unsigned blockBegin = blockIndex * UpdateBlockSize;
+            UpdateContext blockContext = updateContext;
+            blockContext.indices_ =
+                updateContext.indices_.subspan(blockBegin, ea::min(UpdateBlockSize, numParticles - blockBegin));
+            blockContext.spanOffset_ = updateContext.spanOffset_ + blockBegin;
+            for (unsigned i = nodeIndex; i < chainEnd; ++i)
+            {
+                if (!skipUniform || !nodes[i]->IsUniform())
+                    nodes[i]->Update(blockContext);
+            }
+        };
+
+        const unsigned numBlocks = (numParticles + UpdateBlockSize - 1) / UpdateBlockSize;
+        WorkQueue* workQueue = numBlocks > MinBlocksPerTask ? GetWorkQueue() : nullptr;
+        if (workQueue)
+        {
+            // Scalar outputs are evaluated once by the first block and then shared by other blocks
+            updateBlock(0, false);
+            workQueue->ParallelFor(numBlocks - 1, MinBlocksPerTask,
+                [&](unsigned beginIndex, unsigned endIndex, unsigned /*threadIndex*/)
+            {
+                for (unsigned blockIndex = beginIndex + 1; blockIndex <= endIndex; ++blockIndex)
+                    updateBlock(blockIndex, true);
+            });
+        }
+        else
+        {
+            for (unsigned blockIndex = 0; blockIndex < numBlocks; ++blockIndex)
+                updateBlock(blockIndex, false);
+        }
+        nodeIndex = chainEnd;
     }
 }
 
+WorkQueue* ParticleGraphLayerInstance::GetWorkQueue() const
+{
+    if (!emitter_ || !WorkQueue::IsProcessingThread())
+        return nullptr;
+
+    auto* workQueue = emitter_->GetSubsystem<WorkQueue>();
+    return workQueue && workQueue->IsMultithreaded() ? workQueue : nullptr;
+}
+
 ea::span<uint8_t> ParticleGraphLayerInstance::InitNodeInstances(ea::span<uint8_t> nodeInstanceBuffer,
     ea::span<ParticleGraphNodeInstance*>& nodeInstances, const ParticleGraph& graph)
 {
@@ -253,6 +350,8 @@ ea::span<uint8_t> ParticleGraphLayerInstance::InitNodeInstances(ea::span<uint8_t
         nodeInstances[i] = node->CreateInstanceAt(ptr, this);
         assert(nodeInstances[i] == reinterpret_cast<ParticleGraphNodeInstance*>(ptr));
         nodeInstances[i]->Reset();
+        nodeInstances[i]->uniform_ = HasOnlyScalarOutputs(node);
+        threadSafe_ = threadSafe_ && nodeInstances[i]->IsThreadSafe();
         instanceOffset += size;
     }
     if (instanceOffset == nodeInstanceBuffer.size())
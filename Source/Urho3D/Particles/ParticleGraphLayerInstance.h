@@ -24,11 +24,14 @@
 
 #include "ParticleGraphLayer.h"
 #include "ParticleGraphNodeInstance.h"
+#include "../Math/RandomEngine.h"
 #include <EASTL/sort.h>
 
 namespace Urho3D
 {
 
+class WorkQueue;
+
 class URHO3D_API ParicleGraphUniform
 {
 public:
@@ -62,6 +65,11 @@ private:
 class URHO3D_API ParticleGraphLayerInstance
 {
 public:
+    /// Number of particles processed at once by consecutive element-wise nodes, so that intermediate values stay in cache.
+    static constexpr unsigned UpdateBlockSize = 256;
+    /// Minimum number of blocks processed by one worker thread when element-wise nodes are updated in parallel.
+    static constexpr unsigned MinBlocksPerTask = 16;
+
     /// Construct.
     ParticleGraphLayerInstance();
 
@@ -93,7 +101,7 @@ public:
     template <typename ValueType>
     SparseSpan<ValueType> GetSparse(unsigned attributeIndex, const ea::span<unsigned>& indices);
     template <typename ValueType> SparseSpan<ValueType> GetScalar(unsigned pinIndex);
-    template <typename ValueType> SparseSpan<ValueType> GetSpan(unsigned pinIndex);
+    template <typename ValueType> SparseSpan<ValueType> GetSpan(unsigned pinIndex, unsigned offset = 0);
 
     /// Get emitter.
     ParticleGraphEmitter* GetEmitter() const { return emitter_; }
@@ -113,6 +121,13 @@ public:
 
     /// Update all drawable attributes. Executed by ParticleGraphEmitter.
     void UpdateDrawables();
+    /// Apply results of the last update to drawables. Should be called from main thread.
+    void CommitDrawables();
+
+    /// Return whether all nodes may be updated from worker thread.
+    bool IsThreadSafe() const { return threadSafe_; }
+    /// Return random generator of the layer. Layers use separate generators so they can be updated concurrently.
+    RandomEngine& GetRandom() { return random_; }
 
     /// Get effect layer.
     ParticleGraphLayer* GetLayer() const { return layer_; }
@@ -127,12 +142,16 @@ protected:
     /// Initialize update context.
     UpdateContext MakeUpdateContext(float timeStep);
 
-    /// Run graph.
+    /// Run graph. Consecutive element-wise nodes are updated together in blocks of particles.
+    /// Blocks of large layers are distributed between worker threads.
     void RunGraph(ea::span<ParticleGraphNodeInstance*>& nodes, UpdateContext& updateContext);
 
     /// Destroy particles.
     void DestroyParticles();
 
+    /// Return work queue if element-wise nodes may be updated in parallel from current thread.
+    WorkQueue* GetWorkQueue() const;
+
     ea::span<uint8_t> InitNodeInstances(ea::span<uint8_t> nodeInstanceBuffer,
         ea::span<ParticleGraphNodeInstance*>& nodeInstances, const ParticleGraph& particle_graph);
 
@@ -168,6 +187,10 @@ private:
     ParticleGraphEmitter* emitter_{};
     /// Time since emitter start.
     float time_{};
+    /// Random generator.
+    RandomEngine random_;
+    /// Whether all nodes are thread-safe.
+    bool threadSafe_{true};
 
     friend class ParticleGraphEmitter;
 };
@@ -178,10 +201,28 @@ inline void ParticleGraphLayerInstance::DestroyParticles()
         return;
     auto queue = destructionQueue_.subspan(0, destructionQueueSize_);
     ea::sort(queue.begin(), queue.end(), ea::greater<unsigned>());
-    //TODO: Eliminate duplicates.
-    for (unsigned index: queue)
+
+    // Move the last particle in place of each destroyed one, so that attributes of active particles stay contiguous
+    const ParticleGraphAttributeLayout& attributes = layer_->GetAttributeLayout();
+    const unsigned capacity = indices_.size();
+    unsigned previousIndex = M_MAX_UNSIGNED;
+    for (unsigned index : queue)
     {
-        ea::swap(indices_[index], indices_[activeParticles_ - 1]);
+        if (index == previousIndex || index >= activeParticles_)
+            continue;
+        previousIndex = index;
+
+        const unsigned lastIndex = activeParticles_ - 1;
+        if (index != lastIndex)
+        {
+            for (unsigned i = 0; i < attributes.GetNumAttributes(); ++i)
+            {
+                const ParticleGraphSpan span = attributes.GetSpan(i);
+                const unsigned valueSize = span.size_ / capacity;
+                uint8_t* values = attributes_.data() + span.offset_;
+                memcpy(values + index * valueSize, values + lastIndex * valueSize, valueSize);
+            }
+        }
         --activeParticles_;
     }
     destructionQueueSize_ = 0;
@@ -206,14 +247,14 @@ template <typename ValueType> SparseSpan<ValueType> ParticleGraphLayerInstance::
 {
     const auto& attr = layer_->GetIntermediateValues()[pinIndex];
     const auto values = attr.MakeSpan<ValueType>(temp_);
-    return SparseSpan<ValueType>(values, scalarIndices_);
+    return SparseSpan<ValueType>(values, scalarIndices_, ParticleGraphContainerType::Scalar);
 }
 
-template <typename ValueType> SparseSpan<ValueType> ParticleGraphLayerInstance::GetSpan(unsigned pinIndex)
+template <typename ValueType> SparseSpan<ValueType> ParticleGraphLayerInstance::GetSpan(unsigned pinIndex, unsigned offset)
 {
     const auto& attr = layer_->GetIntermediateValues()[pinIndex];
     const auto values = attr.MakeSpan<ValueType>(temp_);
-    return SparseSpan<ValueType>(values, naturalIndices_);
+    return SparseSpan<ValueType>(values.subspan(offset), naturalIndices_, ParticleGraphContainerType::Span);
 }
 
 } // namespace Urho3D
@@ -50,4 +50,7 @@ void ParticleGraphNodeInstance::OnSceneSet(Scene* scene) {}
 /// Handle drawable attribute change.
 void ParticleGraphNodeInstance::UpdateDrawableAttributes() {}
 
+/// Apply results of the update to drawable.
+void ParticleGraphNodeInstance::CommitDrawable() {}
+
 } // namespace Urho3D
@@ -36,15 +36,30 @@ public:
     virtual ~ParticleGraphNodeInstance();
 
     virtual void Update(UpdateContext& context) = 0;
+    /// Return whether each particle is processed independently without side effects.
+    /// Consecutive element-wise nodes are updated together in blocks of particles.
+    virtual bool IsElementwise() const { return false; }
+    /// Return whether the node may be updated from worker thread concurrently with other emitters.
+    virtual bool IsThreadSafe() const { return true; }
+    /// Return whether all outputs of the node are scalar and don't depend on processed range of particles.
+    bool IsUniform() const { return uniform_; }
     /// Handle scene change in instance.
     virtual void OnSceneSet(Scene* scene);
     /// Handle drawable attribute change.
     virtual void UpdateDrawableAttributes();
+    /// Apply results of the update to drawable. Always executed from main thread after update.
+    virtual void CommitDrawable();
 
     virtual void Reset();
 protected:
     /// Copy drawable attributes from emitter.
     void CopyDrawableAttributes(Drawable* drawable, ParticleGraphEmitter* emitter);
+
+private:
+    /// Whether all outputs are scalar.
+    bool uniform_{};
+
+    friend class ParticleGraphLayerInstance;
 };
 
 } // namespace Urho3D
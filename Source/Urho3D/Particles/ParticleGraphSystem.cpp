@@ -26,6 +26,10 @@
 
 #include "ParticleGraphEmitter.h"
 #include "ParticleGraphLayer.h"
+#include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
+#include "../Scene/Scene.h"
+#include "../Scene/SceneEvents.h"
 
 namespace Urho3D
 {
@@ -41,12 +45,87 @@ ParticleGraphSystem::ParticleGraphSystem(Context* context)
     , ObjectReflectionRegistry(context)
 {
     RegisterParticleGraphLibrary(context, this);
+
+    SubscribeToEvent(E_SCENEPOSTUPDATE, URHO3D_HANDLER(ParticleGraphSystem, HandleScenePostUpdate));
 }
 
 ParticleGraphSystem::~ParticleGraphSystem()
 {
 }
 
+void ParticleGraphSystem::AddEmitter(ParticleGraphEmitter* emitter)
+{
+    if (!emitter || emitters_.contains(emitter))
+        return;
+
+    emitters_.push_back(emitter);
+}
+
+void ParticleGraphSystem::RemoveEmitter(ParticleGraphEmitter* emitter)
+{
+    emitters_.erase_first(emitter);
+}
+
+void ParticleGraphSystem::UpdateEmitters(Scene* scene, float timeStep)
+{
+    URHO3D_PROFILE("UpdateParticleGraphEmitters");
+
+    threadSafeEmitters_.clear();
+    mainThreadEmitters_.clear();
+    for (ParticleGraphEmitter* emitter : emitters_)
+    {
+        if (emitter->GetScene() != scene || !emitter->IsEnabledEffective())
+            continue;
+
+        // Evaluate world transform in advance so worker threads only read it
+        emitter->GetNode()->GetWorldTransform();
+
+        if (emitter->IsThreadSafe())
+            threadSafeEmitters_.push_back(emitter);
+        else
+            mainThreadEmitters_.push_back(emitter);
+    }
+
+    auto* workQueue = GetSubsystem<WorkQueue>();
+    if (threadSafeEmitters_.size() > 1 && workQueue->IsMultithreaded() && WorkQueue::IsProcessingThread())
+    {
+        // Notify the scene that a threaded update is going on, so drawables are marked dirty safely
+        scene->BeginThreadedUpdate();
+        workQueue->ParallelFor(threadSafeEmitters_.size(), 1,
+            [&](unsigned beginIndex, unsigned endIndex, unsigned /*threadIndex*/)
+        {
+            for (unsigned i = beginIndex; i < endIndex; ++i)
+                threadSafeEmitters_[i]->UpdateParticles(timeStep);
+        });
+        scene->EndThreadedUpdate();
+    }
+    else
+    {
+        for (ParticleGraphEmitter* emitter : threadSafeEmitters_)
+            emitter->UpdateParticles(timeStep);
+    }
+
+    for (ParticleGraphEmitter* emitter : mainThreadEmitters_)
+        emitter->UpdateParticles(timeStep);
+
+    for (ParticleGraphEmitter* emitter : threadSafeEmitters_)
+        emitter->CommitDrawables();
+    for (ParticleGraphEmitter* emitter : mainThreadEmitters_)
+        emitter->CommitDrawables();
+}
+
+void ParticleGraphSystem::HandleScenePostUpdate(StringHash eventType, VariantMap& eventData)
+{
+    if (emitters_.empty())
+        return;
+
+    // Use scene's timestep instead of global timestep, as time scale may be other than 1
+    using namespace ScenePostUpdate;
+
+    auto* scene = static_cast<Scene*>(eventData[P_SCENE].GetPtr());
+    UpdateEmitters(scene, eventData[P_TIMESTEP].GetFloat());
+}
+
 void RegisterParticleGraphLibrary(Context* context, ParticleGraphSystem* system)
 {
     ParticleGraphEffect::RegisterObject(context);
@@ -28,6 +28,10 @@
 
 namespace Urho3D
 {
+
+class ParticleGraphEmitter;
+class Scene;
+
 /// %Particle graph effect definition.
 class URHO3D_API ParticleGraphSystem : public Object, public ObjectReflectionRegistry
 {
@@ -37,6 +41,25 @@ public:
     ParticleGraphSystem(Context* context);
 
     ~ParticleGraphSystem() override;
+
+    /// Add emitter to be updated on scene post-update.
+    void AddEmitter(ParticleGraphEmitter* emitter);
+    /// Remove emitter.
+    void RemoveEmitter(ParticleGraphEmitter* emitter);
+    /// Update all enabled emitters in the scene. Thread-safe emitters are updated in parallel,
+    /// then drawables of all emitters are committed from main thread.
+    void UpdateEmitters(Scene* scene, float timeStep);
+
+private:
+    /// Handle scene post-update event.
+    void HandleScenePostUpdate(StringHash eventType, VariantMap& eventData);
+
+    /// All emitters in scenes.
+    ea::vector<ParticleGraphEmitter*> emitters_;
+    /// Emitters updated in parallel during current update.
+    ea::vector<ParticleGraphEmitter*> threadSafeEmitters_;
+    /// Emitters updated from main thread during current update.
+    ea::vector<ParticleGraphEmitter*> mainThreadEmitters_;
 };
 
 
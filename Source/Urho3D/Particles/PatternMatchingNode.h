@@ -82,6 +82,8 @@ public:
 
         /// Update particles.
         virtual void Update(UpdateContext& context);
+        /// All patterns process particles independently.
+        bool IsElementwise() const override { return true; }
 
         PatternMatchingNode* node_;
         const NodePattern& pattern_;
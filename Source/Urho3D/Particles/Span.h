@@ -44,19 +44,26 @@ template <typename T> struct SparseSpan
     typedef ea::remove_cv_t<T> value_type;
 
     SparseSpan() = default;
-    SparseSpan(const ea::span<T>& data, const ea::span<unsigned>& indices)
+    SparseSpan(const ea::span<T>& data, const ea::span<unsigned>& indices,
+        ParticleGraphContainerType type = ParticleGraphContainerType::Sparse)
         : data_(data.data())
         , indices_(indices.data())
+        , type_(type)
     {
     }
-    SparseSpan(T* data, unsigned* indices)
+    SparseSpan(T* data, unsigned* indices, ParticleGraphContainerType type = ParticleGraphContainerType::Sparse)
         : data_(data)
         , indices_(indices)
+        , type_(type)
     {
     }
     inline T& operator[](unsigned index) const { return data_[indices_[index]]; }
+    /// Return whether all elements refer to the same value.
+    bool IsScalar() const { return type_ == ParticleGraphContainerType::Scalar; }
     T* data_;
     unsigned* indices_;
+    /// Container type. Particle attributes and intermediate spans are stored contiguously starting from the first element.
+    ParticleGraphContainerType type_{ParticleGraphContainerType::Sparse};
 };
 
 template <typename... Values> struct SpanVariantTuple;
@@ -40,6 +40,8 @@ struct UpdateContext
     ea::span<uint8_t> attributes_;
     ea::span<uint8_t> tempBuffer_;
     ParticleGraphLayerInstance* layer_;
+    /// Offset of the first particle in intermediate spans. Non-zero when the graph is updated in blocks of particles.
+    unsigned spanOffset_{};
 
     template <typename ValueType> SparseSpan<ValueType> GetSpan(const ParticleGraphPinRef& pin) const;
 };
@@ -48,7 +50,7 @@ template <typename ValueType> SparseSpan<ValueType> UpdateContext::GetSpan(const
 {
     switch (pin.type_)
     {
-    case ParticleGraphContainerType::Span: return layer_->GetSpan<ValueType>(pin.index_);
+    case ParticleGraphContainerType::Span: return layer_->GetSpan<ValueType>(pin.index_, spanOffset_);
     case ParticleGraphContainerType::Scalar: return layer_->GetScalar<ValueType>(pin.index_);
     case ParticleGraphContainerType::Sparse: return layer_->GetSparse<ValueType>(pin.index_, indices_);
     default: assert(!"Invalid pin container type"); return layer_->GetSparse<ValueType>(pin.index_, indices_);
@@ -27,6 +27,7 @@
 #include "../Core/Context.h"
 #include "../Core/Mutex.h"
 #include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
 #include "../Graphics/DebugRenderer.h"
 #include "../Graphics/Model.h"
 #include "../IO/Log.h"
@@ -44,65 +45,85 @@
 #include "../Scene/SceneEvents.h"
 
 #include <Bullet/BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
+#include <Bullet/BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
 #include <Bullet/BulletCollision/CollisionDispatch/btDefaultCollisionConfiguration.h>
 #include <Bullet/BulletCollision/CollisionDispatch/btInternalEdgeUtility.h>
 #include <Bullet/BulletCollision/CollisionShapes/btBoxShape.h>
 #include <Bullet/BulletCollision/CollisionShapes/btSphereShape.h>
 #include <Bullet/BulletCollision/Gimpact/btGImpactCollisionAlgorithm.h>
 #include <Bullet/BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolver.h>
+#include <Bullet/BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
 #include <Bullet/BulletDynamics/Dynamics/btDiscreteDynamicsWorld.h>
+#include <Bullet/BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
 #include <BulletCollision/CollisionDispatch/btGhostObject.h>
 
 extern ContactAddedCallback gContactAddedCallback;
 
-ATTRIBUTE_ALIGNED16(class)
-btCustomDiscreteDynamicsWorld : public btDiscreteDynamicsWorld
+#if BT_THREADSAFE
+// Defined in btThreads.cpp but not exposed in headers
+void btPushThreadsAreRunning();
+void btPopThreadsAreRunning();
+#endif
+
+/// Custom stepping shared by single-threaded and multithreaded worlds.
+class btCustomDynamicsWorld
+{
+public:
+    virtual ~btCustomDynamicsWorld() = default;
+
+    virtual void customStepSimulation(unsigned clampedSimulationSteps, btScalar fixedTimeStep, btScalar overtime) = 0;
+    virtual btScalar getLocalTime() const = 0;
+};
+
+template <class T>
+class btCustomDynamicsWorldImpl : public T, public btCustomDynamicsWorld
 {
 public:
-    using btDiscreteDynamicsWorld::btDiscreteDynamicsWorld;
+    using T::T;
 
-    void customStepSimulation(unsigned clampedSimulationSteps, btScalar fixedTimeStep, btScalar overtime)
+    void customStepSimulation(unsigned clampedSimulationSteps, btScalar fixedTimeStep, btScalar overtime) override
     {
-        m_fixedTimeStep = fixedTimeStep;
-        m_localTime = overtime;
+        this->m_fixedTimeStep = fixedTimeStep;
+        this->m_localTime = overtime;
 
-        if (getDebugDrawer())
+        if (this->getDebugDrawer())
         {
-            btIDebugDraw* debugDrawer = getDebugDrawer();
+            btIDebugDraw* debugDrawer = this->getDebugDrawer();
             gDisableDeactivation = (debugDrawer->getDebugMode() & btIDebugDraw::DBG_NoDeactivation) != 0;
         }
 
         if (clampedSimulationSteps > 0)
         {
-            saveKinematicState(fixedTimeStep * clampedSimulationSteps);
+            this->saveKinematicState(fixedTimeStep * clampedSimulationSteps);
 
             for (int i = 0; i < clampedSimulationSteps; i++)
             {
                 // Urho3D: apply gravity on each substep
-                applyGravity();
+                this->applyGravity();
 
-                internalSingleStepSimulation(fixedTimeStep);
-                synchronizeMotionStates();
+                this->internalSingleStepSimulation(fixedTimeStep);
+                this->synchronizeMotionStates();
 
                 // Urho3D: clear forces on each substep
-                clearForces();
+                this->clearForces();
             }
         }
         else
         {
-            synchronizeMotionStates();
+            this->synchronizeMotionStates();
         }
 
-        clearForces();
+        this->clearForces();
     }
 
-    btScalar getLocalTime() const { return m_localTime; }
+    btScalar getLocalTime() const override { return this->m_localTime; }
 };
 
 namespace Urho3D
 {
 
 static const int MAX_SOLVER_ITERATIONS = 256;
+static const unsigned MIN_QUERIES_PER_TASK = 16;
 static const Vector3 DEFAULT_GRAVITY = Vector3(0.0f, -9.81f, 0.0f);
 
 PhysicsWorldConfig PhysicsWorld::config;
@@ -112,6 +133,100 @@ static bool CompareRaycastResults(const PhysicsRaycastResult& lhs, const Physics
     return lhs.distance_ < rhs.distance_;
 }
 
+static bool IsCollisionReported(RigidBody* bodyA, RigidBody* bodyB)
+{
+    if (bodyA->GetMass() == 0.0f && bodyB->GetMass() == 0.0f)
+        return false;
+    if (bodyA->GetCollisionEventMode() == COLLISION_NEVER || bodyB->GetCollisionEventMode() == COLLISION_NEVER)
+        return false;
+    if (bodyA->GetCollisionEventMode() == COLLISION_ACTIVE && bodyB->GetCollisionEventMode() == COLLISION_ACTIVE
+        && !bodyA->IsActive() && !bodyB->IsActive())
+        return false;
+    return true;
+}
+
+static void ResetRaycastResult(PhysicsRaycastResult& result)
+{
+    result.position_ = Vector3::ZERO;
+    result.normal_ = Vector3::ZERO;
+    result.distance_ = M_INFINITY;
+    result.hitFraction_ = 0.0f;
+    result.body_ = nullptr;
+}
+
+static void RaycastSingleImpl(
+    btCollisionWorld* world, PhysicsRaycastResult& result, const Ray& ray, float maxDistance, unsigned collisionMask)
+{
+    btCollisionWorld::ClosestRayResultCallback
+        rayCallback(ToBtVector3(ray.origin_), ToBtVector3(ray.origin_ + maxDistance * ray.direction_));
+    rayCallback.m_collisionFilterGroup = (short)0xffff;
+    rayCallback.m_collisionFilterMask = (short)collisionMask;
+
+    world->rayTest(rayCallback.m_rayFromWorld, rayCallback.m_rayToWorld, rayCallback);
+
+    if (rayCallback.hasHit())
+    {
+        result.position_ = ToVector3(rayCallback.m_hitPointWorld);
+        result.normal_ = ToVector3(rayCallback.m_hitNormalWorld);
+        result.distance_ = (result.position_ - ray.origin_).Length();
+        result.hitFraction_ = rayCallback.m_closestHitFraction;
+        result.body_ = static_cast<RigidBody*>(rayCallback.m_collisionObject->getUserPointer());
+    }
+    else
+        ResetRaycastResult(result);
+}
+
+static void ConvexCastImpl(btCollisionWorld* world, PhysicsRaycastResult& result, btConvexShape* shape,
+    const Vector3& startPos, const Quaternion& startRot, const Vector3& endPos, const Quaternion& endRot,
+    unsigned collisionMask)
+{
+    btCollisionWorld::ClosestConvexResultCallback convexCallback(ToBtVector3(startPos), ToBtVector3(endPos));
+    convexCallback.m_collisionFilterGroup = (short)0xffff;
+    convexCallback.m_collisionFilterMask = (short)collisionMask;
+
+    world->convexSweepTest(shape, btTransform(ToBtQuaternion(startRot), convexCallback.m_convexFromWorld),
+        btTransform(ToBtQuaternion(endRot), convexCallback.m_convexToWorld), convexCallback);
+
+    if (convexCallback.hasHit())
+    {
+        result.body_ = static_cast<RigidBody*>(convexCallback.m_hitCollisionObject->getUserPointer());
+        result.position_ = ToVector3(convexCallback.m_hitPointWorld);
+        result.normal_ = ToVector3(convexCallback.m_hitNormalWorld);
+        result.distance_ = convexCallback.m_closestHitFraction * (endPos - startPos).Length();
+        result.hitFraction_ = convexCallback.m_closestHitFraction;
+    }
+    else
+        ResetRaycastResult(result);
+}
+
+static void SphereCastImpl(btCollisionWorld* world, PhysicsRaycastResult& result, const Ray& ray, float radius,
+    float maxDistance, unsigned collisionMask)
+{
+    btSphereShape shape(radius);
+    const Vector3 endPos = ray.origin_ + maxDistance * ray.direction_;
+    ConvexCastImpl(world, result, &shape, ray.origin_, Quaternion::IDENTITY, endPos, Quaternion::IDENTITY, collisionMask);
+}
+
+template <class T> static void ProcessQueriesInParallel(WorkQueue* workQueue, unsigned numQueries, const T& callback)
+{
+    // Bullet queries are safe to run concurrently only when Bullet keeps per-thread broadphase stacks
+#if BT_THREADSAFE
+    if (numQueries > MIN_QUERIES_PER_TASK && workQueue && workQueue->IsMultithreaded() && WorkQueue::IsProcessingThread())
+    {
+        workQueue->ParallelFor(numQueries, MIN_QUERIES_PER_TASK,
+            [&](unsigned beginIndex, unsigned endIndex, unsigned)
+        {
+            for (unsigned index = beginIndex; index < endIndex; ++index)
+                callback(index);
+        });
+        return;
+    }
+#endif
+
+    for (unsigned index = 0; index < numQueries; ++index)
+        callback(index);
+}
+
 void InternalPreTickCallback(btDynamicsWorld* world, btScalar timeStep)
 {
     static_cast<PhysicsWorld*>(world->getWorldUserInfo())->PreStep(timeStep);
@@ -161,6 +276,110 @@ void CleanupGeometryCacheImpl(CollisionGeometryDataCache& cache)
     }
 }
 
+namespace
+{
+
+#if BT_THREADSAFE
+/// Bullet task scheduler that executes parallel loops in WorkQueue.
+class WorkQueueTaskScheduler : public btITaskScheduler
+{
+public:
+    explicit WorkQueueTaskScheduler(WorkQueue* workQueue)
+        : btITaskScheduler("WorkQueue")
+        , workQueue_(workQueue)
+    {
+    }
+
+    int getMaxNumThreads() const override { return BT_MAX_THREAD_COUNT; }
+    int getNumThreads() const override { return ea::max(1u, WorkQueue::GetThreadIndexCount()); }
+    void setNumThreads(int numThreads) override {}
+
+    void parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) override
+    {
+        if (iBegin >= iEnd)
+            return;
+
+        if (!workQueue_->IsMultithreaded() || !WorkQueue::IsProcessingThread())
+        {
+            body.forLoop(iBegin, iEnd);
+            return;
+        }
+
+        btPushThreadsAreRunning();
+        const auto size = static_cast<unsigned>(iEnd - iBegin);
+        const auto minRange = static_cast<unsigned>(ea::max(grainSize, 1));
+        workQueue_->ParallelFor(size, minRange, [&](unsigned beginIndex, unsigned endIndex, unsigned)
+        { body.forLoop(iBegin + static_cast<int>(beginIndex), iBegin + static_cast<int>(endIndex)); });
+        btPopThreadsAreRunning();
+    }
+
+    btScalar parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) override
+    {
+        if (iBegin >= iEnd)
+            return 0.0f;
+
+        if (!workQueue_->IsMultithreaded() || !WorkQueue::IsProcessingThread())
+            return body.sumLoop(iBegin, iEnd);
+
+        const unsigned numThreads = ea::min(WorkQueue::GetThreadIndexCount(), BT_MAX_THREAD_COUNT);
+        btScalar partialSums[BT_MAX_THREAD_COUNT]{};
+
+        btPushThreadsAreRunning();
+        const auto size = static_cast<unsigned>(iEnd - iBegin);
+        const auto minRange = static_cast<unsigned>(ea::max(grainSize, 1));
+        workQueue_->ParallelFor(size, minRange, [&](unsigned beginIndex, unsigned endIndex, unsigned threadIndex)
+        {
+            partialSums[threadIndex] +=
+                body.sumLoop(iBegin + static_cast<int>(beginIndex), iBegin + static_cast<int>(endIndex));
+        });
+        btPopThreadsAreRunning();
+
+        btScalar sum = 0.0f;
+        for (unsigned i = 0; i < numThreads; ++i)
+            sum += partialSums[i];
+        return sum;
+    }
+
+    /// WorkQueue threads are persistent and keep their Bullet thread indices, don't reset the counter.
+    void activate() override { m_isActive = true; }
+    void deactivate() override { m_isActive = false; }
+
+private:
+    WorkQueue* workQueue_{};
+};
+#endif
+
+/// Set Bullet task scheduler for the lifetime of the object, if any.
+class ScopedTaskScheduler
+{
+public:
+    explicit ScopedTaskScheduler(btITaskScheduler* taskScheduler)
+    {
+#if BT_THREADSAFE
+        if (taskScheduler)
+        {
+            active_ = true;
+            previousTaskScheduler_ = btGetTaskScheduler();
+            btSetTaskScheduler(taskScheduler);
+        }
+#endif
+    }
+
+    ~ScopedTaskScheduler()
+    {
+#if BT_THREADSAFE
+        if (active_)
+            btSetTaskScheduler(previousTaskScheduler_);
+#endif
+    }
+
+private:
+    bool active_{};
+    btITaskScheduler* previousTaskScheduler_{};
+};
+
+} // namespace
+
 /// Callback for physics world queries.
 struct PhysicsQueryCallback : public btCollisionWorld::ContactResultCallback
 {
@@ -202,12 +421,49 @@ PhysicsWorld::PhysicsWorld(Context* context) :
     else
         collisionConfiguration_ = new btDefaultCollisionConfiguration();
 
-    collisionDispatcher_ = ea::make_unique<btCollisionDispatcher>(collisionConfiguration_);
-    btGImpactCollisionAlgorithm::registerAlgorithm(static_cast<btCollisionDispatcher*>(collisionDispatcher_.get()));
+#if BT_THREADSAFE
+    // Main thread should be the first one to get Bullet thread index
+    btGetCurrentThreadIndex();
+
+    if (PhysicsWorld::config.multithreaded_)
+    {
+        auto workQueue = GetSubsystem<WorkQueue>();
+        taskScheduler_ = ea::make_unique<WorkQueueTaskScheduler>(workQueue);
+    }
+#endif
+    ScopedTaskScheduler scopedTaskScheduler(taskScheduler_.get());
 
     broadphase_ = ea::make_unique<btDbvtBroadphase>();
-    solver_ = ea::make_unique<btSequentialImpulseConstraintSolver>();
-    world_ = ea::make_unique<btCustomDiscreteDynamicsWorld>(collisionDispatcher_.get(), broadphase_.get(), solver_.get(), collisionConfiguration_);
+#if BT_THREADSAFE
+    if (taskScheduler_)
+    {
+        collisionDispatcher_ = ea::make_unique<btCollisionDispatcherMt>(collisionConfiguration_);
+        btGImpactCollisionAlgorithm::registerAlgorithm(static_cast<btCollisionDispatcher*>(collisionDispatcher_.get()));
+
+        const unsigned numThreads = GetSubsystem<WorkQueue>()->GetNumProcessingThreads();
+        const unsigned poolSize = PhysicsWorld::config.solverPoolSize_ ? PhysicsWorld::config.solverPoolSize_ : numThreads;
+        auto solverPool = ea::make_unique<btConstraintSolverPoolMt>(static_cast<int>(ea::max(poolSize, 1u)));
+        solver_ = ea::make_unique<btSequentialImpulseConstraintSolverMt>();
+
+        auto world = ea::make_unique<btCustomDynamicsWorldImpl<btDiscreteDynamicsWorldMt>>(
+            collisionDispatcher_.get(), broadphase_.get(), solverPool.get(), solver_.get(), collisionConfiguration_);
+        customWorld_ = world.get();
+        world_ = ea::move(world);
+        solverPool_ = ea::move(solverPool);
+    }
+    else
+#endif
+    {
+        collisionDispatcher_ = ea::make_unique<btCollisionDispatcher>(collisionConfiguration_);
+        btGImpactCollisionAlgorithm::registerAlgorithm(static_cast<btCollisionDispatcher*>(collisionDispatcher_.get()));
+
+        solver_ = ea::make_unique<btSequentialImpulseConstraintSolver>();
+
+        auto world = ea::make_unique<btCustomDynamicsWorldImpl<btDiscreteDynamicsWorld>>(
+            collisionDispatcher_.get(), broadphase_.get(), solver_.get(), collisionConfiguration_);
+        customWorld_ = world.get();
+        world_ = ea::move(world);
+    }
 
     world_->setGravity(ToBtVector3(DEFAULT_GRAVITY));
     world_->getDispatchInfo().m_useContinuous = true;
@@ -215,7 +471,8 @@ PhysicsWorld::PhysicsWorld(Context* context) :
     world_->setDebugDrawer(this);
     world_->setInternalTickCallback(InternalPreTickCallback, static_cast<void*>(this), true);
     world_->setInternalTickCallback(InternalTickCallback, static_cast<void*>(this), false);
-    world_->setSynchronizeAllMotionStates(true);
+    // Sleeping bodies don't move, so don't synchronize them at all
+    world_->setSynchronizeAllMotionStates(false);
 
     // Add ghost pair callback
     ghostPairCallback_ = new btGhostPairCallback();
@@ -237,10 +494,13 @@ PhysicsWorld::~PhysicsWorld()
             (*i)->ReleaseShape();
     }
 
+    customWorld_ = nullptr;
     world_.reset();
+    solverPool_.reset();
     solver_.reset();
     broadphase_.reset();
     collisionDispatcher_.reset();
+    taskScheduler_.reset();
 
     // Delete configuration only if it was the default created by PhysicsWorld
     if (!PhysicsWorld::config.collisionConfig_)
@@ -268,6 +528,7 @@ void PhysicsWorld::RegisterObject(Context* context)
     URHO3D_ATTRIBUTE("Interpolation", bool, interpolation_, true, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Internal Edge Utility", bool, internalEdge_, true, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Split Impulse", GetSplitImpulse, SetSplitImpulse, bool, false, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Collision Events", IsCollisionEventsEnabled, SetCollisionEventsEnabled, bool, true, AM_DEFAULT);
 }
 
 bool PhysicsWorld::isVisible(const btVector3& aabbMin, const btVector3& aabbMax)
@@ -326,23 +587,28 @@ void PhysicsWorld::Update(float timeStep)
         maxSubSteps = Min(maxSubSteps, maxSubSteps_);
 
     delayedWorldTransforms_.clear();
+    pendingWorldTransforms_.clear();
     simulating_ = true;
     PreUpdate(timeStep);
 
-    if (interpolation_)
-        world_->stepSimulation(timeStep, maxSubSteps, internalTimeStep);
-    else
     {
-        timeAcc_ += timeStep;
-        while (timeAcc_ >= internalTimeStep && maxSubSteps > 0)
+        ScopedTaskScheduler scopedTaskScheduler(taskScheduler_.get());
+        if (interpolation_)
+            world_->stepSimulation(timeStep, maxSubSteps, internalTimeStep);
+        else
         {
-            world_->stepSimulation(internalTimeStep, 0, internalTimeStep);
-            timeAcc_ -= internalTimeStep;
-            --maxSubSteps;
+            timeAcc_ += timeStep;
+            while (timeAcc_ >= internalTimeStep && maxSubSteps > 0)
+            {
+                world_->stepSimulation(internalTimeStep, 0, internalTimeStep);
+                timeAcc_ -= internalTimeStep;
+                --maxSubSteps;
+            }
         }
     }
 
-    PostUpdate(timeStep, world_->getLocalTime());
+    ApplyPendingWorldTransforms();
+    PostUpdate(timeStep, customWorld_->getLocalTime());
     simulating_ = false;
     ApplyDelayedWorldTransforms();
 }
@@ -369,19 +635,39 @@ void PhysicsWorld::ApplyDelayedWorldTransforms()
     }
 }
 
+void PhysicsWorld::ApplyPendingWorldTransforms()
+{
+    if (pendingWorldTransforms_.empty())
+        return;
+
+    URHO3D_PROFILE("ApplyPhysicsTransforms");
+
+    SetApplyingTransforms(true);
+    for (const DelayedWorldTransform& transform : pendingWorldTransforms_)
+        transform.rigidBody_->ApplyWorldTransformUnchecked(transform.worldPosition_, transform.worldRotation_);
+    SetApplyingTransforms(false);
+
+    pendingWorldTransforms_.clear();
+}
+
 void PhysicsWorld::CustomUpdate(unsigned numSteps, float fixedTimeStep, float overtime, ea::optional<SynchronizedPhysicsStep> sync)
 {
     URHO3D_PROFILE("UpdatePhysics");
     const float timeStep = numSteps * fixedTimeStep + overtime;
 
     delayedWorldTransforms_.clear();
+    pendingWorldTransforms_.clear();
     simulating_ = true;
     PreUpdate(timeStep);
 
     timeAcc_ = overtime;
     synchronizedStep_ = sync;
-    world_->customStepSimulation(numSteps, fixedTimeStep, overtime);
+    {
+        ScopedTaskScheduler scopedTaskScheduler(taskScheduler_.get());
+        customWorld_->customStepSimulation(numSteps, fixedTimeStep, overtime);
+    }
 
+    ApplyPendingWorldTransforms();
     PostUpdate(timeStep, overtime);
     simulating_ = false;
     ApplyDelayedWorldTransforms();
@@ -389,6 +675,7 @@ void PhysicsWorld::CustomUpdate(unsigned numSteps, float fixedTimeStep, float ov
 
 void PhysicsWorld::UpdateCollisions()
 {
+    ScopedTaskScheduler scopedTaskScheduler(taskScheduler_.get());
     world_->performDiscreteCollisionDetection();
 }
 
@@ -473,29 +760,7 @@ void PhysicsWorld::RaycastSingle(PhysicsRaycastResult& result, const Ray& ray, f
     if (maxDistance >= M_INFINITY)
         URHO3D_LOGWARNING("Infinite maxDistance in physics raycast is not supported");
 
-    btCollisionWorld::ClosestRayResultCallback
-        rayCallback(ToBtVector3(ray.origin_), ToBtVector3(ray.origin_ + maxDistance * ray.direction_));
-    rayCallback.m_collisionFilterGroup = (short)0xffff;
-    rayCallback.m_collisionFilterMask = (short)collisionMask;
-
-    world_->rayTest(rayCallback.m_rayFromWorld, rayCallback.m_rayToWorld, rayCallback);
-
-    if (rayCallback.hasHit())
-    {
-        result.position_ = ToVector3(rayCallback.m_hitPointWorld);
-        result.normal_ = ToVector3(rayCallback.m_hitNormalWorld);
-        result.distance_ = (result.position_ - ray.origin_).Length();
-        result.hitFraction_ = rayCallback.m_closestHitFraction;
-        result.body_ = static_cast<RigidBody*>(rayCallback.m_collisionObject->getUserPointer());
-    }
-    else
-    {
-        result.position_ = Vector3::ZERO;
-        result.normal_ = Vector3::ZERO;
-        result.distance_ = M_INFINITY;
-        result.hitFraction_ = 0.0f;
-        result.body_ = nullptr;
-    }
+    RaycastSingleImpl(world_.get(), result, ray, maxDistance, collisionMask);
 }
 
 void PhysicsWorld::RaycastSingleSegmented(PhysicsRaycastResult& result, const Ray& ray, float maxDistance, float segmentDistance, unsigned collisionMask, float overlapDistance)
@@ -557,33 +822,7 @@ void PhysicsWorld::SphereCast(PhysicsRaycastResult& result, const Ray& ray, floa
     if (maxDistance >= M_INFINITY)
         URHO3D_LOGWARNING("Infinite maxDistance in physics sphere cast is not supported");
 
-    btSphereShape shape(radius);
-    Vector3 endPos = ray.origin_ + maxDistance * ray.direction_;
-
-    btCollisionWorld::ClosestConvexResultCallback
-        convexCallback(ToBtVector3(ray.origin_), ToBtVector3(endPos));
-    convexCallback.m_collisionFilterGroup = (short)0xffff;
-    convexCallback.m_collisionFilterMask = (short)collisionMask;
-
-    world_->convexSweepTest(&shape, btTransform(btQuaternion::getIdentity(), convexCallback.m_convexFromWorld),
-        btTransform(btQuaternion::getIdentity(), convexCallback.m_convexToWorld), convexCallback);
-
-    if (convexCallback.hasHit())
-    {
-        result.body_ = static_cast<RigidBody*>(convexCallback.m_hitCollisionObject->getUserPointer());
-        result.position_ = ToVector3(convexCallback.m_hitPointWorld);
-        result.normal_ = ToVector3(convexCallback.m_hitNormalWorld);
-        result.distance_ = convexCallback.m_closestHitFraction * (endPos - ray.origin_).Length();
-        result.hitFraction_ = convexCallback.m_closestHitFraction;
-    }
-    else
-    {
-        result.body_ = nullptr;
-        result.position_ = Vector3::ZERO;
-        result.normal_ = Vector3::ZERO;
-        result.distance_ = M_INFINITY;
-        result.hitFraction_ = 0.0f;
-    }
+    SphereCastImpl(world_.get(), result, ray, radius, maxDistance, collisionMask);
 }
 
 void PhysicsWorld::ConvexCast(PhysicsRaycastResult& result, CollisionShape* shape, const Vector3& startPos,
@@ -633,51 +872,134 @@ void PhysicsWorld::ConvexCast(PhysicsRaycastResult& result, btCollisionShape* sh
     if (!shape)
     {
         URHO3D_LOGERROR("Null collision shape for convex cast");
-        result.body_ = nullptr;
-        result.position_ = Vector3::ZERO;
-        result.normal_ = Vector3::ZERO;
-        result.distance_ = M_INFINITY;
-        result.hitFraction_ = 0.0f;
+        ResetRaycastResult(result);
         return;
     }
 
     if (!shape->isConvex())
     {
         URHO3D_LOGERROR("Can not use non-convex collision shape for convex cast");
-        result.body_ = nullptr;
-        result.position_ = Vector3::ZERO;
-        result.normal_ = Vector3::ZERO;
-        result.distance_ = M_INFINITY;
-        result.hitFraction_ = 0.0f;
+        ResetRaycastResult(result);
         return;
     }
 
     URHO3D_PROFILE("PhysicsConvexCast");
 
-    btCollisionWorld::ClosestConvexResultCallback convexCallback(ToBtVector3(startPos), ToBtVector3(endPos));
-    convexCallback.m_collisionFilterGroup = (short)0xffff;
-    convexCallback.m_collisionFilterMask = (short)collisionMask;
+    ConvexCastImpl(world_.get(), result, static_cast<btConvexShape*>(shape), startPos, startRot, endPos, endRot, collisionMask);
+}
 
-    world_->convexSweepTest(static_cast<btConvexShape*>(shape), btTransform(ToBtQuaternion(startRot),
-            convexCallback.m_convexFromWorld), btTransform(ToBtQuaternion(endRot), convexCallback.m_convexToWorld),
-        convexCallback);
+void PhysicsWorld::RaycastSingleBatch(
+    ea::span<PhysicsRaycastResult> results, ea::span<const PhysicsRaycastQuery> queries)
+{
+    URHO3D_PROFILE("PhysicsRaycastSingleBatch");
 
-    if (convexCallback.hasHit())
+    if (results.size() < queries.size())
     {
-        result.body_ = static_cast<RigidBody*>(convexCallback.m_hitCollisionObject->getUserPointer());
-        result.position_ = ToVector3(convexCallback.m_hitPointWorld);
-        result.normal_ = ToVector3(convexCallback.m_hitNormalWorld);
-        result.distance_ = convexCallback.m_closestHitFraction * (endPos - startPos).Length();
-        result.hitFraction_ = convexCallback.m_closestHitFraction;
+        URHO3D_LOGERROR("Not enough space for results of batched physics raycast");
+        return;
     }
-    else
+
+    btCollisionWorld* world = world_.get();
+    ProcessQueriesInParallel(GetSubsystem<WorkQueue>(), queries.size(),
+        [&](unsigned index)
     {
-        result.body_ = nullptr;
-        result.position_ = Vector3::ZERO;
-        result.normal_ = Vector3::ZERO;
-        result.distance_ = M_INFINITY;
-        result.hitFraction_ = 0.0f;
+        const PhysicsRaycastQuery& query = queries[index];
+        RaycastSingleImpl(world, results[index], query.ray_, query.maxDistance_, query.collisionMask_);
+    });
+}
+
+void PhysicsWorld::SphereCastBatch(
+    ea::span<PhysicsRaycastResult> results, ea::span<const PhysicsSphereCastQuery> queries)
+{
+    URHO3D_PROFILE("PhysicsSphereCastBatch");
+
+    if (results.size() < queries.size())
+    {
+        URHO3D_LOGERROR("Not enough space for results of batched physics sphere cast");
+        return;
     }
+
+    btCollisionWorld* world = world_.get();
+    ProcessQueriesInParallel(GetSubsystem<WorkQueue>(), queries.size(),
+        [&](unsigned index)
+    {
+        const PhysicsSphereCastQuery& query = queries[index];
+        SphereCastImpl(world, results[index], query.ray_, query.radius_, query.maxDistance_, query.collisionMask_);
+    });
+}
+
+void PhysicsWorld::ConvexCastBatch(
+    ea::span<PhysicsRaycastResult> results, CollisionShape* shape, ea::span<const PhysicsConvexCastQuery> queries)
+{
+    if (!shape || !shape->GetCollisionShape())
+    {
+        URHO3D_LOGERROR("Null collision shape for convex cast");
+        for (PhysicsRaycastResult& result : results.first(ea::min(results.size(), queries.size())))
+            ResetRaycastResult(result);
+        return;
+    }
+
+    // If shape is attached in a rigidbody, set its collision group temporarily to 0 to make sure it is not returned in the sweep result
+    auto* bodyComp = shape->GetComponent<RigidBody>();
+    btRigidBody* body = bodyComp ? bodyComp->GetBody() : nullptr;
+    btBroadphaseProxy* proxy = body ? body->getBroadphaseProxy() : nullptr;
+    short group = 0;
+    if (proxy)
+    {
+        group = proxy->m_collisionFilterGroup;
+        proxy->m_collisionFilterGroup = 0;
+    }
+
+    // Take the shape's offset position & rotation into account
+    Node* shapeNode = shape->GetNode();
+    const Vector3 shapeScale = shapeNode ? shapeNode->GetWorldScale() : Vector3::ONE;
+    ea::vector<PhysicsConvexCastQuery> effectiveQueries(queries.size());
+    for (unsigned i = 0; i < queries.size(); ++i)
+    {
+        const PhysicsConvexCastQuery& query = queries[i];
+        PhysicsConvexCastQuery& effectiveQuery = effectiveQueries[i];
+        effectiveQuery.startPos_ = Matrix3x4(query.startPos_, query.startRot_, shapeScale) * shape->GetPosition();
+        effectiveQuery.endPos_ = Matrix3x4(query.endPos_, query.endRot_, shapeScale) * shape->GetPosition();
+        effectiveQuery.startRot_ = query.startRot_ * shape->GetRotation();
+        effectiveQuery.endRot_ = query.endRot_ * shape->GetRotation();
+        effectiveQuery.collisionMask_ = query.collisionMask_;
+    }
+
+    ConvexCastBatch(results, shape->GetCollisionShape(), effectiveQueries);
+
+    // Restore the collision group
+    if (proxy)
+        proxy->m_collisionFilterGroup = group;
+}
+
+void PhysicsWorld::ConvexCastBatch(
+    ea::span<PhysicsRaycastResult> results, btCollisionShape* shape, ea::span<const PhysicsConvexCastQuery> queries)
+{
+    if (results.size() < queries.size())
+    {
+        URHO3D_LOGERROR("Not enough space for results of batched physics convex cast");
+        return;
+    }
+
+    if (!shape || !shape->isConvex())
+    {
+        URHO3D_LOGERROR(!shape ? "Null collision shape for convex cast" : "Can not use non-convex collision shape for convex cast");
+        for (PhysicsRaycastResult& result : results.first(queries.size()))
+            ResetRaycastResult(result);
+        return;
+    }
+
+    URHO3D_PROFILE("PhysicsConvexCastBatch");
+
+    btCollisionWorld* world = world_.get();
+    auto convexShape = static_cast<btConvexShape*>(shape);
+    ProcessQueriesInParallel(GetSubsystem<WorkQueue>(), queries.size(),
+        [&](unsigned index)
+    {
+        const PhysicsConvexCastQuery& query = queries[index];
+        ConvexCastImpl(world, results[index], convexShape, query.startPos_, query.startRot_, query.endPos_,
+            query.endRot_, query.collisionMask_);
+    });
 }
 
 void PhysicsWorld::RemoveCachedGeometry(Model* model)
@@ -794,6 +1116,7 @@ void PhysicsWorld::RemoveRigidBody(RigidBody* body)
     rigidBodies_.erase_first(body);
     // Remove possible dangling pointer from the delayedWorldTransforms structure
     delayedWorldTransforms_.erase(body);
+    ea::erase_if(pendingWorldTransforms_, [body](const DelayedWorldTransform& transform) { return transform.rigidBody_ == body; });
 }
 
 void PhysicsWorld::AddCollisionShape(CollisionShape* shape)
@@ -894,6 +1217,9 @@ void PhysicsWorld::PostUpdate(float timeStep, float overtime)
 
 void PhysicsWorld::PreStep(float timeStep)
 {
+    // Apply transforms from the previous substep so event handlers see up-to-date nodes
+    ApplyPendingWorldTransforms();
+
     // Send pre-step event
     using namespace PhysicsPreStep;
 
@@ -941,8 +1267,6 @@ void PhysicsWorld::SendCollisionEvents()
 
     if (numManifolds)
     {
-        physicsCollisionData_[PhysicsCollision::P_WORLD] = this;
-
         for (int i = 0; i < numManifolds; ++i)
         {
             btPersistentManifold* contactManifold = collisionDispatcher_->getManifoldByIndexInternal(i);
@@ -960,12 +1284,7 @@ void PhysicsWorld::SendCollisionEvents()
                 continue;
 
             // Skip collision event signaling if both objects are static, or if collision event mode does not match
-            if (bodyA->GetMass() == 0.0f && bodyB->GetMass() == 0.0f)
-                continue;
-            if (bodyA->GetCollisionEventMode() == COLLISION_NEVER || bodyB->GetCollisionEventMode() == COLLISION_NEVER)
-                continue;
-            if (bodyA->GetCollisionEventMode() == COLLISION_ACTIVE && bodyB->GetCollisionEventMode() == COLLISION_ACTIVE &&
-                !bodyA->IsActive() && !bodyB->IsActive())
+            if (!IsCollisionReported(bodyA, bodyB))
                 continue;
 
             WeakPtr<RigidBody> bodyWeakA(bodyA);
@@ -985,6 +1304,14 @@ void PhysicsWorld::SendCollisionEvents()
                 currentCollisions_[bodyPair].flippedManifold_ = contactManifold;
             }
         }
+    }
+
+    UpdateContactStream();
+    NotifyContactListeners();
+
+    if (collisionEventsEnabled_ && !currentCollisions_.empty())
+    {
+        physicsCollisionData_[PhysicsCollision::P_WORLD] = this;
 
         for (auto i = currentCollisions_.begin();
              i != currentCollisions_.end(); ++i)
@@ -1114,6 +1441,7 @@ void PhysicsWorld::SendCollisionEvents()
     }
 
     // Send collision end events as applicable
+    if (collisionEventsEnabled_)
     {
         physicsCollisionData_[PhysicsCollisionEnd::P_WORLD] = this;
 
@@ -1130,12 +1458,7 @@ void PhysicsWorld::SendCollisionEvents()
                 bool trigger = bodyA->IsTrigger() || bodyB->IsTrigger();
 
                 // Skip collision event signaling if both objects are static, or if collision event mode does not match
-                if (bodyA->GetMass() == 0.0f && bodyB->GetMass() == 0.0f)
-                    continue;
-                if (bodyA->GetCollisionEventMode() == COLLISION_NEVER || bodyB->GetCollisionEventMode() == COLLISION_NEVER)
-                    continue;
-                if (bodyA->GetCollisionEventMode() == COLLISION_ACTIVE && bodyB->GetCollisionEventMode() == COLLISION_ACTIVE &&
-                    !bodyA->IsActive() && !bodyB->IsActive())
+                if (!IsCollisionReported(bodyA, bodyB))
                     continue;
 
                 Node* nodeA = bodyA->GetNode();
@@ -1175,6 +1498,136 @@ void PhysicsWorld::SendCollisionEvents()
     previousCollisions_ = currentCollisions_;
 }
 
+void PhysicsWorld::UpdateContactStream()
+{
+    contactPairs_.clear();
+    contactPoints_.clear();
+
+    for (const auto& [bodies, manifolds] : currentCollisions_)
+    {
+        RigidBody* bodyA = bodies.first;
+        RigidBody* bodyB = bodies.second;
+        if (!bodyA || !bodyB)
+            continue;
+
+        PhysicsContactPair& pair = contactPairs_.emplace_back();
+        pair.bodyA_ = bodyA;
+        pair.bodyB_ = bodyB;
+        pair.phase_ = previousCollisions_.contains(bodies) ? PhysicsContactPhase::Stay : PhysicsContactPhase::Begin;
+        pair.trigger_ = bodyA->IsTrigger() || bodyB->IsTrigger();
+        pair.firstPoint_ = contactPoints_.size();
+        WriteContactPoints(manifolds, false);
+        pair.numPoints_ = contactPoints_.size() - pair.firstPoint_;
+    }
+
+    for (const auto& [bodies, manifolds] : previousCollisions_)
+    {
+        RigidBody* bodyA = bodies.first;
+        RigidBody* bodyB = bodies.second;
+        if (!bodyA || !bodyB || currentCollisions_.contains(bodies) || !IsCollisionReported(bodyA, bodyB))
+            continue;
+
+        PhysicsContactPair& pair = contactPairs_.emplace_back();
+        pair.bodyA_ = bodyA;
+        pair.bodyB_ = bodyB;
+        pair.phase_ = PhysicsContactPhase::End;
+        pair.trigger_ = bodyA->IsTrigger() || bodyB->IsTrigger();
+        pair.firstPoint_ = contactPoints_.size();
+    }
+}
+
+void PhysicsWorld::WriteContactPoints(const ManifoldPair& manifolds, bool flipped)
+{
+    // "Pointers not flipped"-manifold, send unmodified normals
+    if (btPersistentManifold* contactManifold = manifolds.manifold_)
+    {
+        for (int j = 0; j < contactManifold->getNumContacts(); ++j)
+        {
+            const btManifoldPoint& point = contactManifold->getContactPoint(j);
+            const Vector3 normal = ToVector3(point.m_normalWorldOnB);
+            const Vector3 position = ToVector3(flipped ? point.m_positionWorldOnA : point.m_positionWorldOnB);
+            contactPoints_.push_back({position, flipped ? -normal : normal, point.m_distance1, point.m_appliedImpulse});
+        }
+    }
+    // "Pointers flipped"-manifold, flip normals also
+    if (btPersistentManifold* contactManifold = manifolds.flippedManifold_)
+    {
+        for (int j = 0; j < contactManifold->getNumContacts(); ++j)
+        {
+            const btManifoldPoint& point = contactManifold->getContactPoint(j);
+            const Vector3 normal = ToVector3(point.m_normalWorldOnB);
+            const Vector3 position = ToVector3(flipped ? point.m_positionWorldOnB : point.m_positionWorldOnA);
+            contactPoints_.push_back({position, flipped ? normal : -normal, point.m_distance1, point.m_appliedImpulse});
+        }
+    }
+}
+
+void PhysicsWorld::NotifyContactListeners()
+{
+    URHO3D_PROFILE("NotifyContactListeners");
+
+    listenerContactPairs_.clear();
+    listenerContactPoints_.clear();
+    listenedBodies_.clear();
+
+    // Copy points so that contacts of each listener are independent from the public contact stream
+    const auto addListenerPair = [this](const PhysicsContactPair& pair, bool flipped)
+    {
+        PhysicsContactPair& listenerPair = listenerContactPairs_.emplace_back(pair);
+        listenerPair.firstPoint_ = listenerContactPoints_.size();
+        for (unsigned j = 0; j < pair.numPoints_; ++j)
+        {
+            PhysicsContactPoint& point = listenerContactPoints_.emplace_back(contactPoints_[pair.firstPoint_ + j]);
+            if (flipped)
+            {
+                point.position_ += point.normal_ * point.distance_;
+                point.normal_ = -point.normal_;
+            }
+        }
+
+        // Present the pair from the perspective of the second body
+        if (flipped)
+            ea::swap(listenerPair.bodyA_, listenerPair.bodyB_);
+    };
+
+    for (const PhysicsContactPair& pair : contactPairs_)
+    {
+        if (pair.bodyA_->GetContactListener())
+            addListenerPair(pair, false);
+        if (pair.bodyB_->GetContactListener())
+            addListenerPair(pair, true);
+    }
+
+    if (listenerContactPairs_.empty())
+        return;
+
+    ea::stable_sort(listenerContactPairs_.begin(), listenerContactPairs_.end(),
+        [](const PhysicsContactPair& lhs, const PhysicsContactPair& rhs) { return lhs.bodyA_ < rhs.bodyA_; });
+
+    // Remember bodies in advance, listeners may remove bodies
+    const unsigned numListenerPairs = listenerContactPairs_.size();
+    for (unsigned i = 0; i < numListenerPairs; ++i)
+    {
+        RigidBody* body = listenerContactPairs_[i].bodyA_;
+        if (i + 1 == numListenerPairs || listenerContactPairs_[i + 1].bodyA_ != body)
+            listenedBodies_.emplace_back(WeakPtr<RigidBody>(body), i + 1);
+    }
+
+    const ea::span<const PhysicsContactPair> allContacts = listenerContactPairs_;
+    unsigned beginIndex = 0;
+    for (const auto& [body, endIndex] : listenedBodies_)
+    {
+        const ea::span<const PhysicsContactPair> contacts = allContacts.subspan(beginIndex, endIndex - beginIndex);
+        beginIndex = endIndex;
+
+        if (!body)
+            continue;
+
+        if (PhysicsContactListener* listener = body->GetContactListener())
+            listener->OnPhysicsContacts(this, body, contacts, listenerContactPoints_);
+    }
+}
+
 void RegisterPhysicsLibrary(Context* context)
 {
     CollisionShape::RegisterObject(context);
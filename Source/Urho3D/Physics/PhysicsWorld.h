@@ -22,10 +22,12 @@
 
 #pragma once
 
+#include <EASTL/span.h>
 #include <EASTL/unique_ptr.h>
 
 #include "../IO/VectorBuffer.h"
 #include "../Math/BoundingBox.h"
+#include "../Math/Ray.h"
 #include "../Math/Sphere.h"
 #include "../Math/Vector3.h"
 #include "../Replica/NetworkId.h"
@@ -47,11 +49,12 @@ class btCollisionShape;
 class btBroadphaseInterface;
 class btConstraintSolver;
 class btDiscreteDynamicsWorld;
-class btCustomDiscreteDynamicsWorld;
+class btCustomDynamicsWorld;
 class btDispatcher;
 class btDynamicsWorld;
 class btPersistentManifold;
 class btGhostPairCallback;
+class btITaskScheduler;
 
 namespace Urho3D
 {
@@ -61,7 +64,7 @@ class Deserializer;
 class Constraint;
 class Model;
 class Node;
-class Ray;
+class PhysicsWorld;
 class RigidBody;
 class Scene;
 class Serializer;
@@ -96,12 +99,105 @@ struct URHO3D_API PhysicsRaycastResult
     RigidBody* body_{};
 };
 
-/// Delayed world transform assignment for parented rigidbodies.
+/// Physics raycast query for batched raycasts.
+struct URHO3D_API PhysicsRaycastQuery
+{
+    /// Worldspace ray.
+    Ray ray_;
+    /// Maximum distance along the ray.
+    float maxDistance_{};
+    /// Collision mask.
+    unsigned collisionMask_{M_MAX_UNSIGNED};
+};
+
+/// Physics swept sphere query for batched sphere casts.
+struct URHO3D_API PhysicsSphereCastQuery
+{
+    /// Worldspace ray.
+    Ray ray_;
+    /// Sphere radius.
+    float radius_{};
+    /// Maximum distance along the ray.
+    float maxDistance_{};
+    /// Collision mask.
+    unsigned collisionMask_{M_MAX_UNSIGNED};
+};
+
+/// Physics swept convex query for batched convex casts.
+struct URHO3D_API PhysicsConvexCastQuery
+{
+    /// Worldspace start position.
+    Vector3 startPos_;
+    /// Worldspace start rotation.
+    Quaternion startRot_;
+    /// Worldspace end position.
+    Vector3 endPos_;
+    /// Worldspace end rotation.
+    Quaternion endRot_;
+    /// Collision mask.
+    unsigned collisionMask_{M_MAX_UNSIGNED};
+};
+
+/// Phase of contact between two rigid bodies.
+enum class PhysicsContactPhase
+{
+    /// Bodies started touching on this step.
+    Begin,
+    /// Bodies kept touching on this step.
+    Stay,
+    /// Bodies stopped touching on this step.
+    End
+};
+
+/// Contact point in physics contact stream.
+struct PhysicsContactPoint
+{
+    /// Worldspace position on the second body of the pair.
+    Vector3 position_;
+    /// Worldspace normal on the second body of the pair, pointing towards the first body.
+    Vector3 normal_;
+    /// Distance between bodies, negative if penetrating.
+    float distance_{};
+    /// Impulse applied by the solver.
+    float impulse_{};
+};
+
+/// Contact between two rigid bodies in physics contact stream.
+struct PhysicsContactPair
+{
+    /// First rigid body.
+    RigidBody* bodyA_{};
+    /// Second rigid body.
+    RigidBody* bodyB_{};
+    /// Phase of contact.
+    PhysicsContactPhase phase_{};
+    /// Whether either body is trigger.
+    bool trigger_{};
+    /// Index of first contact point in the contact stream. End contacts have no points.
+    unsigned firstPoint_{};
+    /// Number of contact points.
+    unsigned numPoints_{};
+};
+
+/// Listener of contacts of specific rigid bodies, see RigidBody::SetContactListener.
+class URHO3D_API PhysicsContactListener
+{
+public:
+    virtual ~PhysicsContactListener() = default;
+
+    /// Process all contacts of the body on current physics update. Called before collision events are sent.
+    /// First body of each contact pair is the listened body, contact normals point towards it.
+    /// Contact points of the pairs are stored in `points` rather than in the contact stream of PhysicsWorld.
+    virtual void OnPhysicsContacts(PhysicsWorld* physicsWorld, RigidBody* body,
+        ea::span<const PhysicsContactPair> contacts, ea::span<const PhysicsContactPoint> points) = 0;
+};
+
+/// Delayed world transform assignment for moved rigidbodies.
 struct DelayedWorldTransform
 {
     /// Rigid body.
     RigidBody* rigidBody_;
-    /// Parent rigid body.
+    /// Parent rigid body. Null if rigid body is not parented to another rigid body.
     RigidBody* parentRigidBody_;
     /// New world position.
     Vector3 worldPosition_;
@@ -129,12 +225,19 @@ struct ManifoldPair
 struct PhysicsWorldConfig
 {
     PhysicsWorldConfig() :
-        collisionConfig_(nullptr)
+        collisionConfig_(nullptr),
+        multithreaded_(false),
+        solverPoolSize_(0)
     {
     }
 
     /// Override for the collision configuration (default btDefaultCollisionConfiguration).
     btCollisionConfiguration* collisionConfig_;
+    /// Whether to use multithreaded narrowphase and island solving backed by WorkQueue.
+    /// Ignored if Bullet is built without BT_THREADSAFE.
+    bool multithreaded_;
+    /// Number of constraint solvers in multithreaded mode. Zero means number of WorkQueue threads.
+    unsigned solverPoolSize_;
 };
 
 static const int DEFAULT_FPS = 60;
@@ -213,6 +316,9 @@ public:
     void SetSplitImpulse(bool enable);
     /// Set maximum angular velocity for network replication.
     void SetMaxNetworkAngularVelocity(float velocity);
+    /// Set whether to send collision events. Contact stream and contact listeners are not affected. Enabled by default.
+    /// @property
+    void SetCollisionEventsEnabled(bool enable) { collisionEventsEnabled_ = enable; }
     /// Perform a physics world raycast and return all hits.
     void Raycast
         (ea::vector<PhysicsRaycastResult>& result, const Ray& ray, float maxDistance, unsigned collisionMask = M_MAX_UNSIGNED);
@@ -230,6 +336,15 @@ public:
     /// Perform a physics world swept convex test using a user-supplied Bullet collision shape and return the first hit.
     void ConvexCast(PhysicsRaycastResult& result, btCollisionShape* shape, const Vector3& startPos, const Quaternion& startRot,
         const Vector3& endPos, const Quaternion& endRot, unsigned collisionMask = M_MAX_UNSIGNED);
+    /// Perform physics world raycasts in parallel and return the closest hit for each ray.
+    /// Result of each query is stored at the same index, results should have space for all queries.
+    void RaycastSingleBatch(ea::span<PhysicsRaycastResult> results, ea::span<const PhysicsRaycastQuery> queries);
+    /// Perform physics world swept sphere tests in parallel and return the closest hit for each sweep.
+    void SphereCastBatch(ea::span<PhysicsRaycastResult> results, ea::span<const PhysicsSphereCastQuery> queries);
+    /// Perform physics world swept convex tests in parallel using a user-supplied collision shape and return the first hit for each sweep.
+    void ConvexCastBatch(ea::span<PhysicsRaycastResult> results, CollisionShape* shape, ea::span<const PhysicsConvexCastQuery> queries);
+    /// Perform physics world swept convex tests in parallel using a user-supplied Bullet collision shape and return the first hit for each sweep.
+    void ConvexCastBatch(ea::span<PhysicsRaycastResult> results, btCollisionShape* shape, ea::span<const PhysicsConvexCastQuery> queries);
     /// Invalidate cached collision geometry for a model.
     void RemoveCachedGeometry(Model* model);
     /// Return rigid bodies by a sphere query.
@@ -241,6 +356,17 @@ public:
     /// Return rigid bodies that have been in collision with the specified body on the last simulation step. Only returns collisions that were sent as events (depends on collision event mode) and excludes e.g. static-static collisions.
     void GetCollidingBodies(ea::vector<RigidBody*>& result, const RigidBody* body);
 
+    /// Return all contacts of the last physics update, including begin, stay and end contacts.
+    /// Contacts are filtered by collision event mode. Bodies are not guarded and may be removed by user code.
+    ea::span<const PhysicsContactPair> GetContactPairs() const { return contactPairs_; }
+    /// Return contact points of the contact stream.
+    ea::span<const PhysicsContactPoint> GetContactPoints() const { return contactPoints_; }
+    /// Return contact points of the contact pair.
+    ea::span<const PhysicsContactPoint> GetContactPoints(const PhysicsContactPair& pair) const
+    {
+        return ea::span<const PhysicsContactPoint>(contactPoints_).subspan(pair.firstPoint_, pair.numPoints_);
+    }
+
     /// Return gravity.
     /// @property
     Vector3 GetGravity() const;
@@ -269,6 +395,10 @@ public:
     /// @property
     bool GetSplitImpulse() const;
 
+    /// Return whether to send collision events.
+    /// @property
+    bool IsCollisionEventsEnabled() const { return collisionEventsEnabled_; }
+
     /// Return simulation steps per second.
     /// @property
     int GetFps() const { return fps_; }
@@ -290,6 +420,8 @@ public:
     void RemoveConstraint(Constraint* constraint);
     /// Add a delayed world transform assignment. Called by RigidBody.
     void AddDelayedWorldTransform(const DelayedWorldTransform& transform);
+    /// Add a world transform assignment of not parented rigid body, applied in batch after the step. Called by RigidBody.
+    void AddPendingWorldTransform(const DelayedWorldTransform& transform) { pendingWorldTransforms_.push_back(transform); }
     /// Add debug geometry to the debug renderer.
     void DrawDebugGeometry(bool depthTest);
     /// Set debug renderer to use. Called both by PhysicsWorld itself and physics components.
@@ -299,6 +431,8 @@ public:
 
     /// Return the Bullet physics world.
     btDiscreteDynamicsWorld* GetWorld() const;
+    /// Return whether the world uses multithreaded narrowphase and island solving.
+    bool IsMultithreaded() const { return taskScheduler_ != nullptr; }
 
     /// Clean up the geometry cache.
     void CleanupGeometryCache();
@@ -341,7 +475,15 @@ private:
     void PostStep(float timeStep);
     /// Send accumulated collision events.
     void SendCollisionEvents();
+    /// Fill contact stream from current and previous collisions.
+    void UpdateContactStream();
+    /// Write contact points of the manifold pair to the contact stream.
+    void WriteContactPoints(const ManifoldPair& manifolds, bool flipped);
+    /// Send contacts to contact listeners of rigid bodies.
+    void NotifyContactListeners();
     void ApplyDelayedWorldTransforms();
+    /// Apply world transforms of moved rigid bodies in one pass.
+    void ApplyPendingWorldTransforms();
 
     /// Bullet collision configuration.
     btCollisionConfiguration* collisionConfiguration_{};
@@ -351,8 +493,14 @@ private:
     ea::unique_ptr<btBroadphaseInterface> broadphase_;
     /// Bullet constraint solver.
     ea::unique_ptr<btConstraintSolver> solver_;
+    /// Bullet constraint solver pool used for islands in multithreaded mode.
+    ea::unique_ptr<btConstraintSolver> solverPool_;
+    /// Bullet task scheduler backed by WorkQueue, used in multithreaded mode.
+    ea::unique_ptr<btITaskScheduler> taskScheduler_;
     /// Bullet physics world.
-    ea::unique_ptr<btCustomDiscreteDynamicsWorld> world_;
+    ea::unique_ptr<btDiscreteDynamicsWorld> world_;
+    /// Custom stepping interface of the physics world.
+    btCustomDynamicsWorld* customWorld_{};
     /// Extra weak pointer to scene to allow for cleanup in case the world is destroyed before other components.
     WeakPtr<Scene> scene_;
     /// Rigid bodies in the world.
@@ -367,6 +515,8 @@ private:
     ea::unordered_map<ea::pair<WeakPtr<RigidBody>, WeakPtr<RigidBody> >, ManifoldPair> previousCollisions_;
     /// Delayed (parented) world transform assignments.
     ea::unordered_map<RigidBody*, DelayedWorldTransform> delayedWorldTransforms_;
+    /// World transform assignments of moved rigid bodies on current step.
+    ea::vector<DelayedWorldTransform> pendingWorldTransforms_;
     /// Cache for trimesh geometry data by model and LOD level.
     CollisionGeometryDataCache triMeshCache_;
     /// Cache for convex geometry data by model and LOD level.
@@ -379,6 +529,16 @@ private:
     VariantMap nodeCollisionData_;
     /// Preallocated buffer for physics collision contact data.
     VectorBuffer contacts_;
+    /// Contact stream pairs on this frame.
+    ea::vector<PhysicsContactPair> contactPairs_;
+    /// Contact stream points on this frame.
+    ea::vector<PhysicsContactPoint> contactPoints_;
+    /// Contact pairs grouped by listened body, as seen by that body.
+    ea::vector<PhysicsContactPair> listenerContactPairs_;
+    /// Contact points of listenerContactPairs_, as seen by listened body.
+    ea::vector<PhysicsContactPoint> listenerContactPoints_;
+    /// Listened bodies and ends of their ranges in listenerContactPairs_.
+    ea::vector<ea::pair<WeakPtr<RigidBody>, unsigned>> listenedBodies_;
     /// Simulation substeps per second.
     unsigned fps_{DEFAULT_FPS};
     /// Maximum number of simulation substeps per frame. 0 (default) unlimited, or negative values for adaptive timestep.
@@ -393,6 +553,8 @@ private:
     bool updateEnabled_{true};
     /// Interpolation flag.
     bool interpolation_{true};
+    /// Collision events flag.
+    bool collisionEventsEnabled_{true};
     /// Use internal edge utility flag.
     bool internalEdge_{true};
     /// Applying transforms flag.
@@ -165,25 +165,24 @@ void RigidBody::setWorldTransform(const btTransform& worldTrans)
 
     // It is possible that the RigidBody component has been kept alive via a shared pointer,
     // while its scene node has already been destroyed
-    if (node_)
+    if (node_ && physicsWorld_)
     {
         // If the rigid body is parented to another rigid body, can not set the transform immediately.
-        // In that case store it to PhysicsWorld for delayed assignment
+        // In that case store it to PhysicsWorld for delayed assignment.
+        // Otherwise store it to PhysicsWorld for batched assignment, unless the body has not moved at all.
         Node* parent = node_->GetParent();
         if (parent != GetScene() && parent)
             parentRigidBody = parent->GetComponent<RigidBody>();
 
-        if (!parentRigidBody)
-            ApplyWorldTransform(newWorldPosition, newWorldRotation);
-        else
-        {
-            DelayedWorldTransform delayed;
-            delayed.rigidBody_ = this;
-            delayed.parentRigidBody_ = parentRigidBody;
-            delayed.worldPosition_ = newWorldPosition;
-            delayed.worldRotation_ = newWorldRotation;
+        DelayedWorldTransform delayed;
+        delayed.rigidBody_ = this;
+        delayed.parentRigidBody_ = parentRigidBody;
+        delayed.worldPosition_ = newWorldPosition;
+        delayed.worldRotation_ = newWorldRotation;
+        if (parentRigidBody)
             physicsWorld_->AddDelayedWorldTransform(delayed);
-        }
+        else if (newWorldPosition != lastPosition_ || newWorldRotation != lastRotation_)
+            physicsWorld_->AddPendingWorldTransform(delayed);
     }
 
     hasSimulated_ = true;
@@ -682,15 +681,19 @@ void RigidBody::ApplyWorldTransform(const Vector3& newWorldPosition, const Quate
         return;
 
     physicsWorld_->SetApplyingTransforms(true);
-
-    node_->SetWorldPosition(newWorldPosition);
-    node_->SetWorldRotation(newWorldRotation);
-    lastPosition_ = node_->GetWorldPosition();
-    lastRotation_ = node_->GetWorldRotation();
-
+    ApplyWorldTransformUnchecked(newWorldPosition, newWorldRotation);
     physicsWorld_->SetApplyingTransforms(false);
 }
 
+void RigidBody::ApplyWorldTransformUnchecked(const Vector3& newWorldPosition, const Quaternion& newWorldRotation)
+{
+    // Don't read the transform back from the node: it would force world transform update
+    // and the node would be marked dirty again on the next assignment
+    node_->SetWorldTransform(newWorldPosition, newWorldRotation);
+    lastPosition_ = newWorldPosition;
+    lastRotation_ = newWorldRotation;
+}
+
 void RigidBody::UpdateMass()
 {
     if (!body_ || !enableMassUpdate_)
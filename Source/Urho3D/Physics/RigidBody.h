@@ -37,6 +37,7 @@ namespace Urho3D
 
 class CollisionShape;
 class Constraint;
+class PhysicsContactListener;
 class PhysicsWorld;
 
 /// Rigid body collision event signaling mode.
@@ -153,6 +154,9 @@ public:
     /// Set collision event signaling mode. Default is to signal when rigid bodies are active.
     /// @property
     void SetCollisionEventMode(CollisionEventMode mode);
+    /// Set listener of contacts of this body. Listener is not owned and should be reset before it's destroyed.
+    /// Contacts are filtered by collision event mode the same way as collision events.
+    void SetContactListener(PhysicsContactListener* listener) { contactListener_ = listener; }
     /// Apply force to center of mass.
     void ApplyForce(const Vector3& force);
     /// Apply force at local position.
@@ -278,12 +282,16 @@ public:
     /// Return collision event signaling mode.
     /// @property
     CollisionEventMode GetCollisionEventMode() const { return collisionEventMode_; }
+    /// Return listener of contacts of this body.
+    PhysicsContactListener* GetContactListener() const { return contactListener_; }
 
     /// Return colliding rigid bodies from the last simulation step. Only returns collisions that were sent as events (depends on collision event mode) and excludes e.g. static-static collisions.
     void GetCollidingBodies(ea::vector<RigidBody*>& result) const;
 
     /// Apply new world transform after a simulation step. Called internally.
     void ApplyWorldTransform(const Vector3& newWorldPosition, const Quaternion& newWorldRotation);
+    /// Apply new world transform without notifying PhysicsWorld. Node must exist. Called internally for batched assignment.
+    void ApplyWorldTransformUnchecked(const Vector3& newWorldPosition, const Quaternion& newWorldRotation);
     /// Update mass and inertia to the Bullet rigid body. Readd body to world if necessary: if was in world and the Bullet collision shape to use changed.
     void UpdateMass();
     /// Update gravity parameters to the Bullet rigid body.
@@ -333,6 +341,8 @@ private:
     unsigned collisionMask_;
     /// Collision event signaling mode.
     CollisionEventMode collisionEventMode_;
+    /// Listener of contacts.
+    PhysicsContactListener* contactListener_{};
     /// Last interpolated position from the simulation.
     mutable Vector3 lastPosition_;
     /// Last interpolated rotation from the simulation.
@@ -22,6 +22,7 @@
 
 #include "../Precompiled.h"
 
+#include "../Core/FrameArena.h"
 #include "../Core/WorkQueue.h"
 #include "../Graphics/Drawable.h"
 #include "../Graphics/GlobalIllumination.h"
@@ -33,11 +34,13 @@
 #include "../Graphics/TextureCube.h"
 #include "../Graphics/Zone.h"
 #include "../IO/Log.h"
+#include "../Math/BatchMath.h"
 #include "../RenderPipeline/DrawableProcessor.h"
 #include "../RenderPipeline/LightProcessor.h"
 #include "../RenderPipeline/RenderPipelineDefs.h"
 #include "../Scene/Scene.h"
 
+#include <EASTL/array.h>
 #include <EASTL/sort.h>
 
 #include "../DebugNew.h"
@@ -286,24 +289,56 @@ void DrawableProcessor::ProcessVisibleDrawables(const ea::vector<Drawable*>& dra
 {
     URHO3D_PROFILE("ProcessVisibleDrawables");
 
-    ForEachParallel(workQueue_, drawables,
-        [&](unsigned /*index*/, Drawable* drawable)
+    if (occlusionBuffers.empty())
+    {
+        ForEachParallel(workQueue_, drawables,
+            [&](unsigned /*index*/, Drawable* drawable)
+        {
+            ProcessVisibleDrawable(drawable);
+        });
+    }
+    else
     {
-        // do occlusion test for occludees if possible
-        if (!occlusionBuffers.empty() && drawable->IsOccludee())
+        static const unsigned occlusionBatchSize = 64;
+        ForEachParallel(workQueue_, occlusionBatchSize, drawables.size(),
+            [&](unsigned beginIndex, unsigned endIndex)
         {
-            // check for visible
-            bool anyPass = false;
-            // may have multiple buffers in stereo and possibly for other cases such as lightspace shadowcaster occlusion, likely not applicable here
-            for (auto o : occlusionBuffers)
-                anyPass |= o->IsVisible(drawable->GetWorldBoundingBox());
+            // Test occludees in batches. Drawable is visible if it passes any of the buffers
+            // (may have multiple buffers in stereo and possibly for other cases such as lightspace shadowcaster occlusion)
+            ea::array<Drawable*, occlusionBatchSize> occludees;
+            ea::array<BoundingBox, occlusionBatchSize> boundingBoxes;
+            ea::array<bool, occlusionBatchSize> isVisible;
+            ea::array<bool, occlusionBatchSize> isVisibleInBuffer;
+
+            unsigned numOccludees = 0;
+            for (unsigned i = beginIndex; i < endIndex; ++i)
+            {
+                Drawable* drawable = drawables[i];
+                if (!drawable->IsOccludee())
+                    ProcessVisibleDrawable(drawable);
+                else
+                {
+                    occludees[numOccludees] = drawable;
+                    boundingBoxes[numOccludees] = drawable->GetWorldBoundingBox();
+                    ++numOccludees;
+                }
+            }
 
-            if (!anyPass)
-                return;
-        }
+            ea::fill_n(isVisible.begin(), numOccludees, false);
+            for (OcclusionBuffer* buffer : occlusionBuffers)
+            {
+                buffer->IsVisible(boundingBoxes.data(), isVisibleInBuffer.data(), numOccludees);
+                for (unsigned i = 0; i < numOccludees; ++i)
+                    isVisible[i] |= isVisibleInBuffer[i];
+            }
 
-        ProcessVisibleDrawable(drawable);
-    });
+            for (unsigned i = 0; i < numOccludees; ++i)
+            {
+                if (isVisible[i])
+                    ProcessVisibleDrawable(occludees[i]);
+            }
+        });
+    }
 
     // Sort lights by component ID for stability
     lights_.resize(lightsTemp_.Size());
@@ -718,14 +753,30 @@ void DrawableProcessor::PreprocessShadowCasters(ea::vector<Drawable*>& shadowCas
     if (lightSpaceFrustum.vertices_[0] == lightSpaceFrustum.vertices_[4])
         return;
 
-    for (Drawable* drawable : candidates)
+    // Transform and test bounding boxes in batch
+    const unsigned numCandidates = candidates.size();
+    FrameVector<BoundingBox> lightSpaceBoundingBoxes(numCandidates);
+    for (unsigned i = 0; i < numCandidates; ++i)
+        lightSpaceBoundingBoxes[i] = candidates[i]->GetWorldBoundingBox();
+
+    FrameVector<bool> isInsideShadowCamera;
+    if (lightType == LIGHT_POINT)
     {
         // For point light, check that this drawable is inside the split shadow camera frustum
-        if (lightType == LIGHT_POINT && shadowCameraFrustum.IsInsideFast(drawable->GetWorldBoundingBox()) == OUTSIDE)
+        isInsideShadowCamera.resize(numCandidates);
+        TestBoundingBoxes(shadowCameraFrustum, lightSpaceBoundingBoxes.data(), isInsideShadowCamera.data(), numCandidates);
+    }
+
+    TransformBoundingBoxes(worldToLightSpace, lightSpaceBoundingBoxes.data(), lightSpaceBoundingBoxes.data(), numCandidates);
+
+    for (unsigned i = 0; i < numCandidates; ++i)
+    {
+        Drawable* drawable = candidates[i];
+        if (lightType == LIGHT_POINT && !isInsideShadowCamera[i])
             continue;
 
         // Queue shadow caster if it's visible
-        const BoundingBox lightSpaceBoundingBox = drawable->GetWorldBoundingBox().Transformed(worldToLightSpace);
+        const BoundingBox& lightSpaceBoundingBox = lightSpaceBoundingBoxes[i];
         const bool isDrawableVisible = !!(geometryFlags_[drawable->GetDrawableIndex()] & GeometryRenderFlag::VisibleInCullCamera);
         if (isDrawableVisible
             || IsShadowCasterVisible(lightSpaceBoundingBox, shadowCamera, lightSpaceFrustum, lightSpaceFrustumBoundingBox))
@@ -229,6 +229,22 @@ ea::optional<NetworkObjectRelevance> BehaviorNetworkObject::GetRelevanceForClien
     return ea::nullopt;
 }
 
+ea::optional<float> BehaviorNetworkObject::GetInterestDistance()
+{
+    if (callbackMask_.Test(NetworkCallbackMask::GetInterestDistance))
+    {
+        for (const auto& connectedBehavior : behaviors_)
+        {
+            if (connectedBehavior.callbackMask_.Test(NetworkCallbackMask::GetInterestDistance))
+            {
+                if (const auto distance = connectedBehavior.component_->GetInterestDistance())
+                    return distance;
+            }
+        }
+    }
+    return ea::nullopt;
+}
+
 void BehaviorNetworkObject::UpdateTransformOnServer()
 {
     BaseClassName::UpdateTransformOnServer();
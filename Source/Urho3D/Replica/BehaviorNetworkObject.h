@@ -99,6 +99,7 @@ public:
     void InitializeFromSnapshot(NetworkFrame frame, Deserializer& src, bool isOwned) override;
 
     ea::optional<NetworkObjectRelevance> GetRelevanceForClient(AbstractConnection* connection) override;
+    ea::optional<float> GetInterestDistance() override;
     void UpdateTransformOnServer() override;
     void InterpolateState(float replicaTimeStep, float inputTimeStep, const NetworkTime& replicaTime, const NetworkTime& inputTime) override;
 
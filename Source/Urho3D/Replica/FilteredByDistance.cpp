@@ -81,4 +81,12 @@ ea::optional<NetworkObjectRelevance> FilteredByDistance::GetRelevanceForClient(A
     return static_cast<NetworkObjectRelevance>(ea::min(updatePeriod_, maxPeriod));
 }
 
+ea::optional<float> FilteredByDistance::GetInterestDistance()
+{
+    // Objects that are relevant at any distance cannot be culled by the grid
+    if (isRelevant_)
+        return ea::nullopt;
+    return distance_;
+}
+
 }
@@ -32,12 +32,14 @@ namespace Urho3D
 /// Behavior that filters NetworkObject by the minimum distance to the client.
 /// If the distance is less than the threshold, no relevance is reported.
 /// If the distance is greater than the threshold, specified relevance or irrelevance is reported.
+/// Irrelevant objects are managed by the interest grid of ServerReplicator if it is enabled.
 class URHO3D_API FilteredByDistance : public NetworkBehavior
 {
     URHO3D_OBJECT(FilteredByDistance, NetworkBehavior);
 
 public:
-    static constexpr NetworkCallbackFlags CallbackMask = NetworkCallbackMask::GetRelevanceForClient;
+    static constexpr NetworkCallbackFlags CallbackMask =
+        NetworkCallbackMask::GetRelevanceForClient | NetworkCallbackMask::GetInterestDistance;
     static constexpr float DefaultDistance = 100.0f;
 
     explicit FilteredByDistance(Context* context);
@@ -58,6 +60,7 @@ public:
     /// Implement NetworkBehavior.
     /// @{
     ea::optional<NetworkObjectRelevance> GetRelevanceForClient(AbstractConnection* connection) override;
+    ea::optional<float> GetInterestDistance() override;
     /// @}
 
 private:
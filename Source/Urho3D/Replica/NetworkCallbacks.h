@@ -48,6 +48,7 @@ enum class NetworkCallbackMask
     /// @{
     GetRelevanceForClient   = 1 << 0,
     UpdateTransformOnServer = 1 << 1,
+    GetInterestDistance     = 1 << 8,
     /// @}
 
     /// Client callbacks
@@ -78,6 +79,10 @@ public:
     /// Return whether the component should be replicated for specified client connection, and how frequently.
     /// The first reported valid relevance is used.
     virtual ea::optional<NetworkObjectRelevance> GetRelevanceForClient(AbstractConnection* connection) { return ea::nullopt; }
+    /// Return distance to the objects owned by the client within which the object is relevant for the client.
+    /// If interest grid is enabled on the server, this is used instead of GetRelevanceForClient.
+    /// The first reported valid distance is used.
+    virtual ea::optional<float> GetInterestDistance() { return ea::nullopt; }
     /// Called when world transform or parent of the object is updated in Server mode.
     virtual void UpdateTransformOnServer() {}
 
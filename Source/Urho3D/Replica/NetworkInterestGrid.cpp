@@ -0,0 +1,148 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Precompiled.h"
+
+#include "../Core/Assert.h"
+#include "../Replica/NetworkInterestGrid.h"
+
+namespace Urho3D
+{
+
+void NetworkInterestGrid::Configure(float cellSize, float hysteresis, unsigned maxUpdatePeriod)
+{
+    hysteresis_ = ea::max(0.0f, hysteresis);
+    maxUpdatePeriod_ = ea::max(1u, maxUpdatePeriod);
+
+    cellSize = ea::max(0.0f, cellSize);
+    if (cellSize_ != cellSize)
+    {
+        cellSize_ = cellSize;
+        objects_.clear();
+        numObjects_ = 0;
+        cells_.clear();
+        dirtyCells_.clear();
+        maxInterestDistance_ = 0.0f;
+    }
+}
+
+void NetworkInterestGrid::BeginUpdate()
+{
+    for (const IntVector3& cellIndex : dirtyCells_)
+    {
+        const auto iter = cells_.find(cellIndex);
+        if (iter != cells_.end())
+            iter->second.dirty_ = false;
+    }
+    dirtyCells_.clear();
+    maxInterestDistance_ = 0.0f;
+}
+
+void NetworkInterestGrid::UpdateObject(unsigned index, const Vector3& position, float interestDistance)
+{
+    URHO3D_ASSERT(IsEnabled());
+
+    if (index >= objects_.size())
+        objects_.resize(index + 1);
+
+    maxInterestDistance_ = ea::max(maxInterestDistance_, interestDistance);
+
+    ObjectData& data = objects_[index];
+    const IntVector3 cellIndex = GetCell(position);
+    if (!data.inGrid_)
+    {
+        data.inGrid_ = true;
+        data.position_ = position;
+        data.interestDistance_ = interestDistance;
+        ++numObjects_;
+        AddToCell(index, cellIndex);
+    }
+    else if (data.cell_ != cellIndex)
+    {
+        data.position_ = position;
+        data.interestDistance_ = interestDistance;
+        RemoveFromCell(index);
+        AddToCell(index, cellIndex);
+    }
+    else if (data.position_ != position || data.interestDistance_ != interestDistance)
+    {
+        data.position_ = position;
+        data.interestDistance_ = interestDistance;
+        MarkCellDirty(cellIndex, cells_[cellIndex]);
+    }
+}
+
+void NetworkInterestGrid::RemoveObject(unsigned index)
+{
+    if (!HasObject(index))
+        return;
+
+    RemoveFromCell(index);
+    objects_[index].inGrid_ = false;
+    --numObjects_;
+}
+
+IntVector3 NetworkInterestGrid::GetCell(const Vector3& position) const
+{
+    return VectorFloorToInt(position / cellSize_);
+}
+
+void NetworkInterestGrid::AddToCell(unsigned index, const IntVector3& cellIndex)
+{
+    Cell& cell = cells_[cellIndex];
+    ObjectData& data = objects_[index];
+    data.cell_ = cellIndex;
+    data.indexInCell_ = cell.objects_.size();
+    cell.objects_.push_back(index);
+    MarkCellDirty(cellIndex, cell);
+}
+
+void NetworkInterestGrid::RemoveFromCell(unsigned index)
+{
+    const ObjectData& data = objects_[index];
+    const auto iter = cells_.find(data.cell_);
+    URHO3D_ASSERT(iter != cells_.end());
+
+    // Swap with the last object to keep removal O(1)
+    Cell& cell = iter->second;
+    const unsigned lastIndex = cell.objects_.back();
+    cell.objects_[data.indexInCell_] = lastIndex;
+    objects_[lastIndex].indexInCell_ = data.indexInCell_;
+    cell.objects_.pop_back();
+
+    // Don't keep empty cells around, there is nothing to report from them
+    if (cell.objects_.empty())
+        cells_.erase(iter);
+    else
+        MarkCellDirty(data.cell_, cell);
+}
+
+void NetworkInterestGrid::MarkCellDirty(const IntVector3& cellIndex, Cell& cell)
+{
+    if (!cell.dirty_)
+    {
+        cell.dirty_ = true;
+        dirtyCells_.push_back(cellIndex);
+    }
+}
+
+} // namespace Urho3D
@@ -0,0 +1,150 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/// \file
+
+#pragma once
+
+#include "../Math/Vector3.h"
+
+#include <EASTL/unordered_map.h>
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+/// Spatial hash of NetworkObjects used by ServerReplicator to find objects that may be relevant for the client.
+/// Objects are identified by the index of their NetworkId.
+/// Cells are marked dirty for one update if objects in them are added, removed or moved.
+class URHO3D_API NetworkInterestGrid
+{
+public:
+    /// Set cell size and other parameters. All objects are removed if cell size is changed.
+    void Configure(float cellSize, float hysteresis, unsigned maxUpdatePeriod);
+    /// Reset dirty cells. Called before objects are updated.
+    void BeginUpdate();
+    /// Add object to the grid or update existing object.
+    void UpdateObject(unsigned index, const Vector3& position, float interestDistance);
+    /// Remove object from the grid if present.
+    void RemoveObject(unsigned index);
+
+    /// Call callback for each object in the cells that may contain objects close enough to the position.
+    /// If onlyDirty is set, cells without changes since the last update are skipped.
+    /// Callback signature is `void(unsigned index, const Vector3& position, float interestDistance)`.
+    template <class T> void ForEachObjectInRange(const Vector3& position, bool onlyDirty, const T& callback) const;
+
+    /// Return properties.
+    /// @{
+    bool IsEnabled() const { return cellSize_ > 0.0f; }
+    float GetCellSize() const { return cellSize_; }
+    float GetHysteresis() const { return hysteresis_; }
+    unsigned GetMaxUpdatePeriod() const { return maxUpdatePeriod_; }
+    unsigned GetNumObjects() const { return numObjects_; }
+    unsigned GetNumCells() const { return cells_.size(); }
+    bool HasObject(unsigned index) const { return index < objects_.size() && objects_[index].inGrid_; }
+    const Vector3& GetObjectPosition(unsigned index) const { return objects_[index].position_; }
+    float GetObjectInterestDistance(unsigned index) const { return objects_[index].interestDistance_; }
+    /// @}
+
+private:
+    struct ObjectData
+    {
+        bool inGrid_{};
+        IntVector3 cell_;
+        unsigned indexInCell_{};
+        Vector3 position_;
+        float interestDistance_{};
+    };
+
+    struct Cell
+    {
+        ea::vector<unsigned> objects_;
+        bool dirty_{};
+    };
+
+    IntVector3 GetCell(const Vector3& position) const;
+    void AddToCell(unsigned index, const IntVector3& cellIndex);
+    void RemoveFromCell(unsigned index);
+    void MarkCellDirty(const IntVector3& cellIndex, Cell& cell);
+    template <class T> void ForEachObjectInCell(const Cell& cell, bool onlyDirty, const T& callback) const;
+
+    float cellSize_{};
+    float hysteresis_{};
+    unsigned maxUpdatePeriod_{1};
+
+    ea::vector<ObjectData> objects_;
+    unsigned numObjects_{};
+    ea::unordered_map<IntVector3, Cell> cells_;
+    ea::vector<IntVector3> dirtyCells_;
+
+    /// Max interest distance of objects updated since the last BeginUpdate.
+    float maxInterestDistance_{};
+};
+
+template <class T>
+void NetworkInterestGrid::ForEachObjectInCell(const Cell& cell, bool onlyDirty, const T& callback) const
+{
+    if (onlyDirty && !cell.dirty_)
+        return;
+
+    for (unsigned index : cell.objects_)
+    {
+        const ObjectData& data = objects_[index];
+        callback(index, data.position_, data.interestDistance_);
+    }
+}
+
+template <class T>
+void NetworkInterestGrid::ForEachObjectInRange(const Vector3& position, bool onlyDirty, const T& callback) const
+{
+    const IntVector3 beginCell = GetCell(position - Vector3::ONE * maxInterestDistance_);
+    const IntVector3 endCell = GetCell(position + Vector3::ONE * maxInterestDistance_);
+
+    // Iterate over existing cells instead if the range is too big
+    const IntVector3 rangeSize = endCell - beginCell + IntVector3::ONE;
+    const auto numCellsInRange = static_cast<unsigned long long>(rangeSize.x_) * rangeSize.y_ * rangeSize.z_;
+    if (numCellsInRange > cells_.size())
+    {
+        for (const auto& [cellIndex, cell] : cells_)
+        {
+            if (cellIndex.x_ >= beginCell.x_ && cellIndex.y_ >= beginCell.y_ && cellIndex.z_ >= beginCell.z_
+                && cellIndex.x_ <= endCell.x_ && cellIndex.y_ <= endCell.y_ && cellIndex.z_ <= endCell.z_)
+                ForEachObjectInCell(cell, onlyDirty, callback);
+        }
+        return;
+    }
+
+    for (int z = beginCell.z_; z <= endCell.z_; ++z)
+    {
+        for (int y = beginCell.y_; y <= endCell.y_; ++y)
+        {
+            for (int x = beginCell.x_; x <= endCell.x_; ++x)
+            {
+                const auto iter = cells_.find(IntVector3{x, y, z});
+                if (iter != cells_.end())
+                    ForEachObjectInCell(iter->second, onlyDirty, callback);
+            }
+        }
+    }
+}
+
+} // namespace Urho3D
@@ -105,6 +105,14 @@ URHO3D_NETWORK_SETTING(InputBufferingMax, unsigned, 8);
 URHO3D_NETWORK_SETTING(RelevanceTimeout, float, 5.0f);
 /// Duration in seconds of value tracking on server. Used for lag compensation.
 URHO3D_NETWORK_SETTING(ServerTracingDuration, float, 5.0f);
+/// Size of the cell of the interest grid. Interest grid is used for objects that report interest distance.
+/// Interest grid is disabled if zero.
+URHO3D_NETWORK_SETTING(InterestGridCellSize, float, 0.0f);
+/// Relative margin of interest distance. Relevant objects are not removed until they are this much further away.
+URHO3D_NETWORK_SETTING(InterestHysteresis, float, 0.1f);
+/// Maximum period of unreliable updates for the objects in the interest grid.
+/// Period is increased linearly from 1 to this value as objects get further from the client.
+URHO3D_NETWORK_SETTING(InterestMaxUpdatePeriod, unsigned, 1);
 
 /// @}
 
@@ -75,6 +75,8 @@ void SharedReplicationState::OnNetworkObjectRemoved(NetworkObject* networkObject
     if (recentlyAddedObjects_.erase(networkObject->GetNetworkId()) == 0)
         recentlyRemovedObjects_.insert(networkObject->GetNetworkId());
 
+    interestGrid_.RemoveObject(GetIndex(networkObject->GetNetworkId()));
+
     if (AbstractConnection* ownerConnection = networkObject->GetOwnerConnection())
     {
         auto& ownedObjects = ownedObjectsByConnection_[ownerConnection];
@@ -84,6 +86,11 @@ void SharedReplicationState::OnNetworkObjectRemoved(NetworkObject* networkObject
     }
 }
 
+void SharedReplicationState::ConfigureInterestGrid(float cellSize, float hysteresis, unsigned maxUpdatePeriod)
+{
+    interestGrid_.Configure(cellSize, hysteresis, maxUpdatePeriod);
+}
+
 void SharedReplicationState::PrepareForUpdate()
 {
     ResetFrameBuffers();
@@ -91,6 +98,38 @@ void SharedReplicationState::PrepareForUpdate()
 
     objectRegistry_->UpdateNetworkObjects();
     objectRegistry_->GetSortedNetworkObjects(sortedNetworkObjects_);
+
+    UpdateInterestGrid();
+}
+
+void SharedReplicationState::UpdateInterestGrid()
+{
+    sortedObjectsOutsideGrid_.clear();
+    if (!interestGrid_.IsEnabled())
+        return;
+
+    sortedPositions_.clear();
+    sortedPositions_.resize(GetIndexUpperBound(), M_MAX_UNSIGNED);
+
+    // Update the grid once for all clients
+    interestGrid_.BeginUpdate();
+    for (unsigned sortedPosition = 0; sortedPosition < sortedNetworkObjects_.size(); ++sortedPosition)
+    {
+        NetworkObject* networkObject = sortedNetworkObjects_[sortedPosition];
+        const unsigned index = GetIndex(networkObject->GetNetworkId());
+        sortedPositions_[index] = sortedPosition;
+
+        // Children are always evaluated after their parents, so keep them out of the grid
+        const bool isRoot = networkObject->GetParentNetworkId() == NetworkId::None;
+        const auto interestDistance = isRoot ? networkObject->GetInterestDistance() : ea::nullopt;
+        if (interestDistance)
+            interestGrid_.UpdateObject(index, networkObject->GetNode()->GetWorldPosition(), *interestDistance);
+        else
+        {
+            interestGrid_.RemoveObject(index);
+            sortedObjectsOutsideGrid_.push_back(sortedPosition);
+        }
+    }
 }
 
 void SharedReplicationState::ResetFrameBuffers()
@@ -557,54 +596,212 @@ void ClientReplicationState::UpdateNetworkObjects(SharedReplicationState& shared
     }
 
     // Process active components
-    for (NetworkObject* networkObject : sharedState.GetSortedObjects())
+    const NetworkInterestGrid* interestGrid = sharedState.GetInterestGrid();
+    if (!interestGrid)
     {
-        const NetworkId networkId = networkObject->GetNetworkId();
-        const NetworkId parentNetworkId = networkObject->GetParentNetworkId();
-        const unsigned index = GetIndex(networkId);
+        // Keep track of relevant objects in case the grid is enabled later
+        interestPositions_.clear();
+        relevantObjects_.clear();
+        for (NetworkObject* networkObject : sharedState.GetSortedObjects())
+        {
+            UpdateNetworkObject(sharedState, networkObject, timeStep, relevanceTimeout);
+
+            const unsigned index = GetIndex(networkObject->GetNetworkId());
+            if (objectsRelevance_[index] != NetworkObjectRelevance::Irrelevant)
+                relevantObjects_.push_back(index);
+        }
+        return;
+    }
 
-        const bool wasRelevant = objectsRelevance_[index] != NetworkObjectRelevance::Irrelevant;
-        const bool isParentRelevant = parentNetworkId == NetworkId::None
-            || objectsRelevance_[GetIndex(parentNetworkId)] != NetworkObjectRelevance::Irrelevant;
+    // Process only objects that are not in the grid and objects from the grid that may be relevant
+    CollectObjectsOfInterest(sharedState, *interestGrid);
+    relevantObjects_.clear();
 
-        if (!wasRelevant && isParentRelevant)
+    const auto& sortedObjects = sharedState.GetSortedObjects();
+    for (unsigned sortedPosition : objectsOfInterest_)
+    {
+        NetworkObject* networkObject = sortedObjects[sortedPosition];
+        const unsigned index = GetIndex(networkObject->GetNetworkId());
+        if (interestGrid->HasObject(index))
+            UpdateNetworkObjectInGrid(sharedState, *interestGrid, networkObject, timeStep, relevanceTimeout);
+        else
+            UpdateNetworkObject(sharedState, networkObject, timeStep, relevanceTimeout);
+
+        if (objectsRelevance_[index] != NetworkObjectRelevance::Irrelevant)
+            relevantObjects_.push_back(index);
+    }
+}
+
+void ClientReplicationState::UpdateNetworkObject(
+    SharedReplicationState& sharedState, NetworkObject* networkObject, float timeStep, float relevanceTimeout)
+{
+    const NetworkId networkId = networkObject->GetNetworkId();
+    const NetworkId parentNetworkId = networkObject->GetParentNetworkId();
+    const unsigned index = GetIndex(networkId);
+
+    const bool wasRelevant = objectsRelevance_[index] != NetworkObjectRelevance::Irrelevant;
+    const bool isParentRelevant = parentNetworkId == NetworkId::None
+        || objectsRelevance_[GetIndex(parentNetworkId)] != NetworkObjectRelevance::Irrelevant;
+
+    if (!wasRelevant && isParentRelevant)
+    {
+        // Begin replication of the object if both the object and its parent are relevant
+        objectsRelevance_[index] =
+            networkObject->GetRelevanceForClient(connection_).value_or(NetworkObjectRelevance::NormalUpdates);
+        if (objectsRelevance_[index] != NetworkObjectRelevance::Irrelevant)
         {
-            // Begin replication of the object if both the object and its parent are relevant
-            objectsRelevance_[index] =
-                networkObject->GetRelevanceForClient(connection_).value_or(NetworkObjectRelevance::NormalUpdates);
-            if (objectsRelevance_[index] != NetworkObjectRelevance::Irrelevant)
-            {
-                objectsRelevanceTimeouts_[index] = relevanceTimeout;
-                pendingUpdatedObjects_.push_back({networkObject, true});
-            }
+            objectsRelevanceTimeouts_[index] = relevanceTimeout;
+            pendingUpdatedObjects_.push_back({networkObject, true});
         }
-        else if (wasRelevant)
+    }
+    else if (wasRelevant)
+    {
+        // If replicating, check periodically (abort replication immediately if parent is removed)
+        objectsRelevanceTimeouts_[index] -= timeStep;
+        if (objectsRelevanceTimeouts_[index] < 0.0f || !isParentRelevant)
         {
-            // If replicating, check periodically (abort replication immediately if parent is removed)
-            objectsRelevanceTimeouts_[index] -= timeStep;
-            if (objectsRelevanceTimeouts_[index] < 0.0f || !isParentRelevant)
+            objectsRelevance_[index] = isParentRelevant
+                ? networkObject->GetRelevanceForClient(connection_).value_or(NetworkObjectRelevance::NormalUpdates)
+                : NetworkObjectRelevance::Irrelevant;
+
+            if (objectsRelevance_[index] == NetworkObjectRelevance::Irrelevant)
             {
-                objectsRelevance_[index] = isParentRelevant
-                    ? networkObject->GetRelevanceForClient(connection_).value_or(NetworkObjectRelevance::NormalUpdates)
-                    : NetworkObjectRelevance::Irrelevant;
-
-                if (objectsRelevance_[index] == NetworkObjectRelevance::Irrelevant)
-                {
-                    // Remove irrelevant component
-                    pendingRemovedObjects_.push_back(networkId);
-                    continue;
-                }
-
-                objectsRelevanceTimeouts_[index] = relevanceTimeout;
+                // Remove irrelevant component
+                pendingRemovedObjects_.push_back(networkId);
+                return;
             }
 
-            // Queue non-snapshot update
-            sharedState.QueueDeltaUpdate(networkObject);
-            pendingUpdatedObjects_.push_back({networkObject, false});
+            objectsRelevanceTimeouts_[index] = relevanceTimeout;
         }
+
+        // Queue non-snapshot update
+        sharedState.QueueDeltaUpdate(networkObject);
+        pendingUpdatedObjects_.push_back({networkObject, false});
     }
 }
 
+void ClientReplicationState::UpdateNetworkObjectInGrid(SharedReplicationState& sharedState,
+    const NetworkInterestGrid& interestGrid, NetworkObject* networkObject, float timeStep, float relevanceTimeout)
+{
+    const NetworkId networkId = networkObject->GetNetworkId();
+    const unsigned index = GetIndex(networkId);
+
+    // Objects in the grid are evaluated on every update, but only when they are in range
+    const bool wasRelevant = objectsRelevance_[index] != NetworkObjectRelevance::Irrelevant;
+    const NetworkObjectRelevance relevance = GetRelevanceInGrid(interestGrid, networkObject, wasRelevant);
+
+    if (relevance != NetworkObjectRelevance::Irrelevant)
+    {
+        objectsRelevance_[index] = relevance;
+        objectsRelevanceTimeouts_[index] = relevanceTimeout;
+    }
+    else if (wasRelevant)
+    {
+        // Keep replicating for a while after the object is out of range
+        objectsRelevanceTimeouts_[index] -= timeStep;
+        if (objectsRelevanceTimeouts_[index] < 0.0f)
+        {
+            objectsRelevance_[index] = NetworkObjectRelevance::Irrelevant;
+            pendingRemovedObjects_.push_back(networkId);
+            return;
+        }
+    }
+
+    if (!wasRelevant && relevance != NetworkObjectRelevance::Irrelevant)
+        pendingUpdatedObjects_.push_back({networkObject, true});
+    else if (wasRelevant)
+    {
+        sharedState.QueueDeltaUpdate(networkObject);
+        pendingUpdatedObjects_.push_back({networkObject, false});
+    }
+}
+
+NetworkObjectRelevance ClientReplicationState::GetRelevanceInGrid(
+    const NetworkInterestGrid& interestGrid, NetworkObject* networkObject, bool wasRelevant) const
+{
+    // Never filter owned objects
+    if (networkObject->GetOwnerConnection() == connection_)
+        return NetworkObjectRelevance::NormalUpdates;
+
+    const unsigned index = GetIndex(networkObject->GetNetworkId());
+    const Vector3& position = interestGrid.GetObjectPosition(index);
+    const float interestDistance = interestGrid.GetObjectInterestDistance(index);
+
+    float distance = M_LARGE_VALUE;
+    for (const Vector3& interestPosition : interestPositions_)
+        distance = ea::min(distance, (position - interestPosition).Length());
+
+    // Relevant objects are kept a bit longer to avoid flickering at the border
+    const float maxDistance = wasRelevant ? interestDistance * (1.0f + interestGrid.GetHysteresis()) : interestDistance;
+    if (distance >= maxDistance)
+        return NetworkObjectRelevance::Irrelevant;
+    if (distance >= interestDistance)
+        return objectsRelevance_[index];
+
+    // Grid only replaces distance check, other behaviors may still filter the object or override update period
+    static constexpr auto maxAllowedPeriod = static_cast<unsigned>(NetworkObjectRelevance::MaxPeriod);
+    const unsigned maxPeriod = ea::min(interestGrid.GetMaxUpdatePeriod(), maxAllowedPeriod);
+    const float distanceFactor = interestDistance > 0.0f ? ea::min(distance / interestDistance, 1.0f) : 0.0f;
+    const unsigned period = 1 + FloorToInt(distanceFactor * (maxPeriod - 1));
+    const auto defaultRelevance = static_cast<NetworkObjectRelevance>(ea::min(period, maxPeriod));
+    return networkObject->GetRelevanceForClient(connection_).value_or(defaultRelevance);
+}
+
+void ClientReplicationState::CollectObjectsOfInterest(
+    const SharedReplicationState& sharedState, const NetworkInterestGrid& interestGrid)
+{
+    ea::swap(interestPositions_, previousInterestPositions_);
+    interestPositions_.clear();
+    for (NetworkObject* ownedObject : sharedState.GetOwnedObjectsByConnection(connection_))
+        interestPositions_.push_back(ownedObject->GetNode()->GetWorldPosition());
+
+    // If the client hasn't moved, only objects in changed cells may become relevant
+    const bool onlyDirtyCells = interestPositions_ == previousInterestPositions_;
+
+    objectsOfInterest_ = sharedState.GetSortedObjectsOutsideGrid();
+    isObjectOfInterest_.resize(objectsRelevance_.size());
+
+    const auto addObjectInGrid = [&](unsigned index)
+    {
+        if (!isObjectOfInterest_[index])
+        {
+            isObjectOfInterest_[index] = true;
+            objectsOfInterest_.push_back(sharedState.GetSortedPosition(index));
+        }
+    };
+
+    // Keep processing relevant objects until they are removed
+    for (unsigned index : relevantObjects_)
+    {
+        if (objectsRelevance_[index] != NetworkObjectRelevance::Irrelevant && interestGrid.HasObject(index))
+            addObjectInGrid(index);
+    }
+
+    for (const Vector3& interestPosition : interestPositions_)
+    {
+        interestGrid.ForEachObjectInRange(interestPosition, onlyDirtyCells,
+            [&](unsigned index, const Vector3& position, float interestDistance)
+        {
+            if ((position - interestPosition).LengthSquared() < interestDistance * interestDistance)
+                addObjectInGrid(index);
+        });
+    }
+
+    // Owned objects are always relevant
+    for (NetworkObject* ownedObject : sharedState.GetOwnedObjectsByConnection(connection_))
+    {
+        const unsigned index = GetIndex(ownedObject->GetNetworkId());
+        if (interestGrid.HasObject(index))
+            addObjectInGrid(index);
+    }
+
+    for (unsigned sortedPosition : objectsOfInterest_)
+        isObjectOfInterest_[GetIndex(sharedState.GetSortedObjects()[sortedPosition]->GetNetworkId())] = false;
+
+    // Parents should be processed before children
+    ea::sort(objectsOfInterest_.begin(), objectsOfInterest_.end());
+}
+
 ServerReplicator::ServerReplicator(Scene* scene)
     : Object(scene->GetContext())
     , network_(GetSubsystem<Network>())
@@ -670,6 +867,9 @@ void ServerReplicator::OnNetworkUpdate()
     eventData[P_FRAME] = static_cast<long long>(currentFrame_);
     network_->SendEvent(E_ENDSERVERNETWORKFRAME, eventData);
 
+    sharedState_->ConfigureInterestGrid(GetSetting(NetworkSettings::InterestGridCellSize).GetFloat(),
+        GetSetting(NetworkSettings::InterestHysteresis).GetFloat(),
+        GetSetting(NetworkSettings::InterestMaxUpdatePeriod).GetUInt());
     sharedState_->PrepareForUpdate();
     for (auto& [connection, clientState] : connections_)
         clientState->UpdateNetworkObjects(*sharedState_);
@@ -740,6 +940,11 @@ void ServerReplicator::SetCurrentFrame(NetworkFrame frame)
     currentFrame_ = frame;
 }
 
+void ServerReplicator::SetSetting(const NetworkSetting& setting, const Variant& value)
+{
+    SetNetworkSetting(settings_, setting, value);
+}
+
 ClientReplicationState* ServerReplicator::GetClientState(AbstractConnection* connection) const
 {
     auto iter = connections_.find(connection);
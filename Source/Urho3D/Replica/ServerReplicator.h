@@ -31,6 +31,7 @@
 #include "../Network/ClockSynchronizer.h"
 #include "../Replica/ClientInputStatistics.h"
 #include "../Replica/NetworkId.h"
+#include "../Replica/NetworkInterestGrid.h"
 #include "../Replica/TickSynchronizer.h"
 #include "../Replica/ProtocolMessages.h"
 
@@ -55,6 +56,8 @@ class SharedReplicationState : public RefCounted
 public:
     explicit SharedReplicationState(NetworkObjectRegistry* objectRegistry);
 
+    /// Configure interest grid. Grid is disabled if cell size is zero.
+    void ConfigureInterestGrid(float cellSize, float hysteresis, unsigned maxUpdatePeriod);
     /// Initial preparation for network update.
     void PrepareForUpdate();
     /// Request delta update to be prepared for specified object.
@@ -66,6 +69,9 @@ public:
     /// @{
     const ea::unordered_set<NetworkId>& GetRecentlyRemovedObjects() const { return recentlyRemovedObjects_; }
     const ea::vector<NetworkObject*>& GetSortedObjects() const { return sortedNetworkObjects_; }
+    const NetworkInterestGrid* GetInterestGrid() const { return interestGrid_.IsEnabled() ? &interestGrid_ : nullptr; }
+    const ea::vector<unsigned>& GetSortedObjectsOutsideGrid() const { return sortedObjectsOutsideGrid_; }
+    unsigned GetSortedPosition(unsigned index) const { return sortedPositions_[index]; }
     unsigned GetIndexUpperBound() const;
     const ea::unordered_set<NetworkObject*>& GetOwnedObjectsByConnection(AbstractConnection* connection) const;
     ea::optional<ConstByteSpan> GetReliableUpdateByIndex(unsigned index) const;
@@ -85,6 +91,7 @@ private:
 
     void ResetFrameBuffers();
     void InitializeNewObjects();
+    void UpdateInterestGrid();
 
     ConstByteSpan GetSpanData(const DeltaBufferSpan& span) const;
 
@@ -95,6 +102,13 @@ private:
 
     ea::vector<NetworkObject*> sortedNetworkObjects_;
 
+    /// Interest grid is only used for root objects that report interest distance.
+    /// @{
+    NetworkInterestGrid interestGrid_;
+    ea::vector<unsigned> sortedPositions_;
+    ea::vector<unsigned> sortedObjectsOutsideGrid_;
+    /// @}
+
     ea::vector<bool> isDeltaUpdateQueued_;
     ea::vector<bool> needReliableDeltaUpdate_;
     ea::vector<bool> needUnreliableDeltaUpdate_;
@@ -191,9 +205,26 @@ private:
     void SendUpdateObjectsReliable(const SharedReplicationState& sharedState);
     void SendUpdateObjectsUnreliable(NetworkFrame currentFrame, const SharedReplicationState& sharedState);
 
+    void UpdateNetworkObject(
+        SharedReplicationState& sharedState, NetworkObject* networkObject, float timeStep, float relevanceTimeout);
+    void UpdateNetworkObjectInGrid(SharedReplicationState& sharedState, const NetworkInterestGrid& interestGrid,
+        NetworkObject* networkObject, float timeStep, float relevanceTimeout);
+    NetworkObjectRelevance GetRelevanceInGrid(
+        const NetworkInterestGrid& interestGrid, NetworkObject* networkObject, bool wasRelevant) const;
+    void CollectObjectsOfInterest(const SharedReplicationState& sharedState, const NetworkInterestGrid& interestGrid);
+
     ea::vector<NetworkObjectRelevance> objectsRelevance_;
     ea::vector<float> objectsRelevanceTimeouts_;
 
+    /// Interest grid state.
+    /// @{
+    ea::vector<Vector3> interestPositions_;
+    ea::vector<Vector3> previousInterestPositions_;
+    ea::vector<unsigned> relevantObjects_;
+    ea::vector<unsigned> objectsOfInterest_;
+    ea::vector<bool> isObjectOfInterest_;
+    /// @}
+
     ea::vector<NetworkId> pendingRemovedObjects_;
     ea::vector<ea::pair<NetworkObject*, bool>> pendingUpdatedObjects_;
 
@@ -218,6 +249,8 @@ public:
     void ReportInputLoss(AbstractConnection* connection, float percentLoss);
 
     void SetCurrentFrame(NetworkFrame frame);
+    /// Set server setting. Settings sent to clients are only applied to connections added afterwards.
+    void SetSetting(const NetworkSetting& setting, const Variant& value);
 
     /// Return current state of the replicator.
     /// @{
@@ -23,6 +23,7 @@
 #include "../Precompiled.h"
 
 #include "../Core/Context.h"
+#include "../Core/FrameArena.h"
 #include "../Graphics/AnimatedModel.h"
 #include "../Network/NetworkEvents.h"
 #include "../Replica/TrackedAnimatedModel.h"
@@ -136,10 +137,7 @@ void TrackedAnimatedModel::ProcessTemporalRayQuery(const NetworkTime& time, cons
     const auto bonePositions = bonePositionsTrace_.SampleValid(time);
     const auto boneRotations = boneRotationsTrace_.SampleValid(time);
 
-    thread_local ea::vector<Matrix3x4> boneTransformsStorage;
-    auto& boneTransforms = boneTransformsStorage;
-    auto boneTransforms11 = boneTransformsStorage;
-    boneTransforms.resize(numBones);
+    FrameVector<Matrix3x4> boneTransforms(numBones);
     for (unsigned i = 0; i < numBones; ++i)
     {
         const Vector3 position = bonePositions[i];
@@ -26,6 +26,7 @@
 
 #include "../Core/Context.h"
 #include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
 #include "../IO/Log.h"
 #include "../Resource/BackgroundLoader.h"
 #include "../Resource/ResourceCache.h"
@@ -43,6 +44,17 @@ BackgroundLoader::BackgroundLoader(ResourceCache* owner) :
 
 BackgroundLoader::~BackgroundLoader()
 {
+    // Loading thread and tasks reference queue items, wait for them before clearing the queue
+    Stop();
+
+    {
+        MutexLock lock(backgroundLoadMutex_);
+        shuttingDown_ = true;
+    }
+
+    while (numDispatched_ > 0)
+        Time::Sleep(1);
+
     MutexLock lock(backgroundLoadMutex_);
 
     backgroundLoadQueue_.clear();
@@ -57,16 +69,8 @@ void BackgroundLoader::ThreadFunction()
         backgroundLoadMutex_.Acquire();
 
         // Search for a queued resource that has not been loaded yet
-        auto i = backgroundLoadQueue_.begin();
-        while (i != backgroundLoadQueue_.end())
-        {
-            if (i->second.resource_->GetAsyncLoadState() == ASYNC_QUEUED)
-                break;
-            else
-                ++i;
-        }
-
-        if (i == backgroundLoadQueue_.end())
+        BackgroundLoadItem* item = FindQueuedResource();
+        if (!item)
         {
             // No resources to load found
             backgroundLoadMutex_.Release();
@@ -74,43 +78,16 @@ void BackgroundLoader::ThreadFunction()
         }
         else
         {
-            BackgroundLoadItem& item = i->second;
-            Resource* resource = item.resource_;
-            // We can be sure that the item is not removed from the queue as long as it is in the
-            // "queued" or "loading" state
+            // We can be sure that the item is not removed from the queue as long as it is in the "loading" state
+            item->resource_->SetAsyncLoadState(ASYNC_LOADING);
             backgroundLoadMutex_.Release();
 
-            bool success = false;
-            AbstractFilePtr file = owner_->GetFile(resource->GetName(), item.sendEventOnFailure_);
-            if (file)
-            {
-                resource->SetAsyncLoadState(ASYNC_LOADING);
-                success = resource->BeginLoad(*file);
-            }
-
-            // Process dependencies now
-            // Need to lock the queue again when manipulating other entries
-            ea::pair<StringHash, StringHash> key = ea::make_pair(resource->GetType(), resource->GetNameHash());
-            backgroundLoadMutex_.Acquire();
-            if (item.dependents_.size())
-            {
-                for (auto i = item.dependents_.begin(); i != item.dependents_.end(); ++i)
-                {
-                    auto j = backgroundLoadQueue_.find(*i);
-                    if (j != backgroundLoadQueue_.end())
-                        j->second.dependencies_.erase(key);
-                }
-
-                item.dependents_.clear();
-            }
-
-            resource->SetAsyncLoadState(success ? ASYNC_SUCCESS : ASYNC_FAIL);
-            backgroundLoadMutex_.Release();
+            LoadResource(*item);
         }
     }
 }
 
-bool BackgroundLoader::QueueResource(StringHash type, const ea::string& name, bool sendEventOnFailure, Resource* caller)
+bool BackgroundLoader::QueueResource(StringHash type, const ea::string& name, bool sendEventOnFailure, Resource* caller, int priority)
 {
     StringHash nameHash(name);
     ea::pair<StringHash, StringHash> key = ea::make_pair(type, nameHash);
@@ -123,6 +100,7 @@ bool BackgroundLoader::QueueResource(StringHash type, const ea::string& name, bo
 
     BackgroundLoadItem& item = backgroundLoadQueue_[key];
     item.sendEventOnFailure_ = sendEventOnFailure;
+    item.priority_ = priority;
 
     // Make sure the pointer is non-null and is a Resource subclass
     item.resource_ = DynamicCast<Resource>(owner_->GetContext()->CreateObject(type));
@@ -158,6 +136,7 @@ bool BackgroundLoader::QueueResource(StringHash type, const ea::string& name, bo
         {
             BackgroundLoadItem& callerItem = j->second;
             item.dependents_.insert(callerKey);
+            item.priority_ = ea::max(item.priority_, callerItem.priority_);
             callerItem.dependencies_.insert(key);
         }
         else
@@ -165,13 +144,52 @@ bool BackgroundLoader::QueueResource(StringHash type, const ea::string& name, bo
                        " requested for a background loaded resource but was not in the background load queue");
     }
 
+    if (IsUsingWorkQueue())
+    {
+        // Tasks posted from other threads are delayed anyway, dispatch them in FinishResources instead
+        if (WorkQueue::IsProcessingThread())
+            DispatchResources();
+    }
     // Start the background loader thread now
-    if (!IsStarted())
+    else if (!IsStarted())
         Run();
 
     return true;
 }
 
+bool BackgroundLoader::CancelResource(StringHash type, StringHash nameHash)
+{
+    ea::pair<StringHash, StringHash> key = ea::make_pair(type, nameHash);
+
+    MutexLock lock(backgroundLoadMutex_);
+
+    auto i = backgroundLoadQueue_.find(key);
+    if (i == backgroundLoadQueue_.end())
+        return false;
+
+    BackgroundLoadItem& item = i->second;
+    if (item.resource_->GetAsyncLoadState() != ASYNC_QUEUED)
+    {
+        // Resource is being loaded, discard it later
+        item.cancelled_ = true;
+        return true;
+    }
+
+    for (const auto& dependentKey : item.dependents_)
+    {
+        auto j = backgroundLoadQueue_.find(dependentKey);
+        if (j != backgroundLoadQueue_.end())
+            j->second.dependencies_.erase(key);
+    }
+
+    // Dispatched task will find nothing to load
+    URHO3D_LOGDEBUG("Cancelled background loading of resource " + item.resource_->GetName());
+    item.resource_->SetAsyncLoadState(ASYNC_DONE);
+    ++statistics_[type].numCancelled_;
+    backgroundLoadQueue_.erase(i);
+    return true;
+}
+
 void BackgroundLoader::WaitForResource(StringHash type, StringHash nameHash)
 {
     backgroundLoadMutex_.Acquire();
@@ -181,18 +199,46 @@ void BackgroundLoader::WaitForResource(StringHash type, StringHash nameHash)
     auto i = backgroundLoadQueue_.find(key);
     if (i != backgroundLoadQueue_.end())
     {
+        // Resource is requested explicitly and should not be discarded
+        BackgroundLoadItem& item = i->second;
+        item.cancelled_ = false;
         backgroundLoadMutex_.Release();
 
         {
-            Resource* resource = i->second.resource_;
+            Resource* resource = item.resource_;
             HiresTimer waitTimer;
             bool didWait = false;
 
             for (;;)
             {
-                unsigned numDeps = i->second.dependencies_.size();
+                backgroundLoadMutex_.Acquire();
+
+                // Load the resource and its dependencies in this thread if nobody started to load them yet
+                BackgroundLoadItem* itemToLoad = nullptr;
+                if (resource->GetAsyncLoadState() == ASYNC_QUEUED)
+                    itemToLoad = &item;
+                else
+                {
+                    for (const auto& dependencyKey : item.dependencies_)
+                    {
+                        auto j = backgroundLoadQueue_.find(dependencyKey);
+                        if (j != backgroundLoadQueue_.end() && j->second.resource_->GetAsyncLoadState() == ASYNC_QUEUED)
+                        {
+                            itemToLoad = &j->second;
+                            break;
+                        }
+                    }
+                }
+
+                unsigned numDeps = item.dependencies_.size();
                 AsyncLoadState state = resource->GetAsyncLoadState();
-                if (numDeps > 0 || state == ASYNC_QUEUED || state == ASYNC_LOADING)
+                if (itemToLoad)
+                    itemToLoad->resource_->SetAsyncLoadState(ASYNC_LOADING);
+                backgroundLoadMutex_.Release();
+
+                if (itemToLoad)
+                    LoadResource(*itemToLoad);
+                else if (numDeps > 0 || state == ASYNC_QUEUED || state == ASYNC_LOADING)
                 {
                     didWait = true;
                     Time::Sleep(1);
@@ -207,7 +253,7 @@ void BackgroundLoader::WaitForResource(StringHash type, StringHash nameHash)
         }
 
         // This may take a long time and may potentially wait on other resources, so it is important we do not hold the mutex during this
-        FinishBackgroundLoading(i->second);
+        FinishBackgroundLoading(item);
 
         backgroundLoadMutex_.Acquire();
         // Erasing by key since queue may change since iterator been acquired.
@@ -220,38 +266,46 @@ void BackgroundLoader::WaitForResource(StringHash type, StringHash nameHash)
 
 void BackgroundLoader::FinishResources(int maxMs)
 {
-    if (IsStarted())
-    {
-        HiresTimer timer;
+    HiresTimer timer;
 
-        backgroundLoadMutex_.Acquire();
+    MutexLock lock(backgroundLoadMutex_);
 
-        for (auto i = backgroundLoadQueue_.begin(); i != backgroundLoadQueue_.end();
-             i = backgroundLoadQueue_.begin())
-        {
-            const auto key = i->first;
-            Resource* resource = i->second.resource_;
-            unsigned numDeps = i->second.dependencies_.size();
-            AsyncLoadState state = resource->GetAsyncLoadState();
-            if (numDeps > 0 || state == ASYNC_QUEUED || state == ASYNC_LOADING)
-                ++i;
-            else
-            {
-                // Finishing a resource may need it to wait for other resources to load, in which case we can not
-                // hold on to the mutex
-                backgroundLoadMutex_.Release();
-                FinishBackgroundLoading(i->second);
-                backgroundLoadMutex_.Acquire();
-                // Erasing by key because the queue may change since last time
-                backgroundLoadQueue_.erase(key);
-            }
+    if (backgroundLoadQueue_.empty())
+        return;
 
-            // Break when the time limit passed so that we keep sufficient FPS
-            if (timer.GetUSec(false) >= maxMs * 1000LL)
-                break;
-        }
+    // Dispatch resources queued from other threads
+    if (IsUsingWorkQueue())
+        DispatchResources();
+
+    // Collect resources that are ready to finish, most important first
+    ea::vector<ea::pair<int, ea::pair<StringHash, StringHash>>> readyResources;
+    for (const auto& [key, item] : backgroundLoadQueue_)
+    {
+        AsyncLoadState state = item.resource_->GetAsyncLoadState();
+        if (item.dependencies_.empty() && (state == ASYNC_SUCCESS || state == ASYNC_FAIL))
+            readyResources.emplace_back(item.priority_, key);
+    }
+    ea::stable_sort(readyResources.begin(), readyResources.end(),
+        [](const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
 
+    for (const auto& [priority, key] : readyResources)
+    {
+        // Finishing another resource may have finished this one already
+        auto i = backgroundLoadQueue_.find(key);
+        if (i == backgroundLoadQueue_.end())
+            continue;
+
+        // Finishing a resource may need it to wait for other resources to load, in which case we can not
+        // hold on to the mutex
         backgroundLoadMutex_.Release();
+        FinishBackgroundLoading(i->second);
+        backgroundLoadMutex_.Acquire();
+        // Erasing by key because the queue may change since last time
+        backgroundLoadQueue_.erase(key);
+
+        // Break when the time limit passed so that we keep sufficient FPS
+        if (timer.GetUSec(false) >= maxMs * 1000LL)
+            break;
     }
 }
 
@@ -261,10 +315,133 @@ unsigned BackgroundLoader::GetNumQueuedResources() const
     return backgroundLoadQueue_.size();
 }
 
+ea::unordered_map<StringHash, BackgroundLoadStatistics> BackgroundLoader::GetStatistics() const
+{
+    MutexLock lock(backgroundLoadMutex_);
+    return statistics_;
+}
+
+bool BackgroundLoader::IsUsingWorkQueue() const
+{
+    const auto workQueue = owner_->GetSubsystem<WorkQueue>();
+    return workQueue && workQueue->IsMultithreaded();
+}
+
+void BackgroundLoader::DispatchResources()
+{
+    auto workQueue = owner_->GetSubsystem<WorkQueue>();
+    const unsigned maxConcurrentLoads = ea::max(1u, workQueue->GetNumProcessingThreads() - 1);
+    if (shuttingDown_ || numDispatched_ >= maxConcurrentLoads)
+        return;
+
+    // Loading more resources than there are worker threads won't make it faster, keep the rest prioritized
+    ea::vector<ea::pair<int, ea::pair<StringHash, StringHash>>> queuedResources;
+    for (const auto& [key, item] : backgroundLoadQueue_)
+    {
+        if (!item.dispatched_ && item.resource_->GetAsyncLoadState() == ASYNC_QUEUED)
+            queuedResources.emplace_back(item.priority_, key);
+    }
+    ea::stable_sort(queuedResources.begin(), queuedResources.end(),
+        [](const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
+
+    for (const auto& [priority, key] : queuedResources)
+    {
+        if (numDispatched_ >= maxConcurrentLoads)
+            break;
+
+        backgroundLoadQueue_[key].dispatched_ = true;
+        ++numDispatched_;
+        workQueue->PostTask([this, key = key] { ProcessDispatchedResource(key); }, TaskPriority::Low);
+    }
+}
+
+void BackgroundLoader::ProcessDispatchedResource(const ea::pair<StringHash, StringHash>& key)
+{
+    URHO3D_PROFILE("BackgroundLoadResource");
+
+    BackgroundLoadItem* item = nullptr;
+    {
+        MutexLock lock(backgroundLoadMutex_);
+
+        // Resource may be cancelled or loaded by another thread meanwhile
+        auto i = backgroundLoadQueue_.find(key);
+        if (!shuttingDown_ && i != backgroundLoadQueue_.end() && i->second.resource_->GetAsyncLoadState() == ASYNC_QUEUED)
+        {
+            item = &i->second;
+            item->resource_->SetAsyncLoadState(ASYNC_LOADING);
+        }
+    }
+
+    if (item)
+        LoadResource(*item);
+
+    // Start loading next resource
+    MutexLock lock(backgroundLoadMutex_);
+    --numDispatched_;
+    DispatchResources();
+}
+
+BackgroundLoadItem* BackgroundLoader::FindQueuedResource()
+{
+    BackgroundLoadItem* bestItem = nullptr;
+    for (auto& [key, item] : backgroundLoadQueue_)
+    {
+        if (item.resource_->GetAsyncLoadState() != ASYNC_QUEUED)
+            continue;
+
+        if (!bestItem || item.priority_ > bestItem->priority_)
+            bestItem = &item;
+    }
+    return bestItem;
+}
+
+void BackgroundLoader::LoadResource(BackgroundLoadItem& item)
+{
+    Resource* resource = item.resource_;
+
+    HiresTimer loadTimer;
+    bool success = false;
+    AbstractFilePtr file = owner_->GetFile(resource->GetName(), item.sendEventOnFailure_);
+    if (file)
+        success = resource->BeginLoad(*file);
+    const long long beginLoadTime = loadTimer.GetUSec(false);
+
+    // Process dependencies now
+    // Need to lock the queue again when manipulating other entries
+    ea::pair<StringHash, StringHash> key = ea::make_pair(resource->GetType(), resource->GetNameHash());
+    MutexLock lock(backgroundLoadMutex_);
+    if (item.dependents_.size())
+    {
+        for (auto i = item.dependents_.begin(); i != item.dependents_.end(); ++i)
+        {
+            auto j = backgroundLoadQueue_.find(*i);
+            if (j != backgroundLoadQueue_.end())
+                j->second.dependencies_.erase(key);
+        }
+
+        item.dependents_.clear();
+    }
+
+    item.beginLoadTime_ = beginLoadTime;
+    resource->SetAsyncLoadState(success ? ASYNC_SUCCESS : ASYNC_FAIL);
+}
+
 void BackgroundLoader::FinishBackgroundLoading(BackgroundLoadItem& item)
 {
     Resource* resource = item.resource_;
 
+    // Cancelled resource is just dropped
+    if (item.cancelled_)
+    {
+        URHO3D_LOGDEBUG("Discarded cancelled background loaded resource " + resource->GetName());
+        resource->SetAsyncLoadState(ASYNC_DONE);
+
+        MutexLock lock(backgroundLoadMutex_);
+        ++statistics_[resource->GetType()].numCancelled_;
+        return;
+    }
+
+    HiresTimer endLoadTimer;
     bool success = resource->GetAsyncLoadState() == ASYNC_SUCCESS;
     // If BeginLoad() phase was successful, call EndLoad() and get the final success/failure result
     if (success)
@@ -276,6 +453,17 @@ void BackgroundLoader::FinishBackgroundLoading(BackgroundLoadItem& item)
     }
     resource->SetAsyncLoadState(ASYNC_DONE);
 
+    {
+        MutexLock lock(backgroundLoadMutex_);
+        BackgroundLoadStatistics& statistics = statistics_[resource->GetType()];
+        if (success)
+            ++statistics.numLoaded_;
+        else
+            ++statistics.numFailed_;
+        statistics.beginLoadTime_ += item.beginLoadTime_;
+        statistics.endLoadTime_ += endLoadTimer.GetUSec(false);
+    }
+
     if (!success && item.sendEventOnFailure_)
     {
         using namespace LoadFailed;
@@ -29,12 +29,14 @@
 #include "../Container/Ptr.h"
 #include "../Core/Thread.h"
 #include "../Math/StringHash.h"
+#include "../Resource/ResourceCache.h"
+
+#include <atomic>
 
 namespace Urho3D
 {
 
 class Resource;
-class ResourceCache;
 
 /// Queue item for background loading of a resource.
 struct URHO3D_API BackgroundLoadItem
@@ -47,9 +49,18 @@ struct URHO3D_API BackgroundLoadItem
     ea::hash_set<ea::pair<StringHash, StringHash> > dependents_;
     /// Whether to send failure event.
     bool sendEventOnFailure_;
+    /// Loading priority. Resources with higher priority are loaded first.
+    int priority_{};
+    /// Whether the loading task is posted to WorkQueue.
+    bool dispatched_{};
+    /// Whether the loading is cancelled. Resource is discarded without finishing as soon as BeginLoad() is complete.
+    bool cancelled_{};
+    /// Time spent in BeginLoad() in microseconds.
+    long long beginLoadTime_{};
 };
 
 /// Background loader of resources. Owned by the ResourceCache.
+/// BeginLoad() of queued resources is performed on WorkQueue threads if available, or on a dedicated thread otherwise.
 /// @nobind
 class URHO3D_API BackgroundLoader : public RefCounted, public Thread
 {
@@ -57,14 +68,18 @@ public:
     /// Construct.
     explicit BackgroundLoader(ResourceCache* owner);
 
-    /// Destruct. Forcibly clear the load queue.
+    /// Destruct. Wait for resources being loaded and forcibly clear the load queue.
     ~BackgroundLoader() override;
 
-    /// Resource background loading loop.
+    /// Resource background loading loop. Used only if WorkQueue has no worker threads.
     void ThreadFunction() override;
 
     /// Queue loading of a resource. The name must be sanitated to ensure consistent format. Return true if queued (not a duplicate and resource was a known type).
-    bool QueueResource(StringHash type, const ea::string& name, bool sendEventOnFailure, Resource* caller);
+    /// Dependencies of the caller inherit its priority if it is higher.
+    bool QueueResource(StringHash type, const ea::string& name, bool sendEventOnFailure, Resource* caller, int priority = 0);
+    /// Cancel loading of a resource. Resource that is already being loaded is discarded when BeginLoad() is finished.
+    /// Return true if the resource was in the load queue.
+    bool CancelResource(StringHash type, StringHash nameHash);
     /// Wait and finish possible loading of a resource when being requested from the cache.
     void WaitForResource(StringHash type, StringHash nameHash);
     /// Process resources that are ready to finish.
@@ -72,8 +87,20 @@ public:
 
     /// Return amount of resources in the load queue.
     unsigned GetNumQueuedResources() const;
+    /// Return load time statistics per resource type.
+    ea::unordered_map<StringHash, BackgroundLoadStatistics> GetStatistics() const;
 
 private:
+    /// Return whether loading is performed on WorkQueue threads.
+    bool IsUsingWorkQueue() const;
+    /// Post loading tasks for queued resources in the order of priority. Mutex should be locked.
+    void DispatchResources();
+    /// Load dispatched resource. Called from WorkQueue thread.
+    void ProcessDispatchedResource(const ea::pair<StringHash, StringHash>& key);
+    /// Find queued resource with highest priority. Mutex should be locked.
+    BackgroundLoadItem* FindQueuedResource();
+    /// Call BeginLoad() for the resource. Resource should be in the "loading" state. Mutex should not be locked.
+    void LoadResource(BackgroundLoadItem& item);
     /// Finish one background loaded resource.
     void FinishBackgroundLoading(BackgroundLoadItem& item);
 
@@ -83,6 +110,12 @@ private:
     mutable Mutex backgroundLoadMutex_;
     /// Resources that are queued for background loading.
     ea::unordered_map<ea::pair<StringHash, StringHash>, BackgroundLoadItem> backgroundLoadQueue_;
+    /// Load time statistics per resource type.
+    ea::unordered_map<StringHash, BackgroundLoadStatistics> statistics_;
+    /// Number of loading tasks posted to WorkQueue and not finished yet.
+    std::atomic<unsigned> numDispatched_{};
+    /// Whether the loader is being destroyed.
+    bool shuttingDown_{};
 };
 
 }
@@ -27,6 +27,7 @@
 #include "../IO/File.h"
 #include "../IO/FileSystem.h"
 #include "../IO/Log.h"
+#include "../IO/MemoryBuffer.h"
 #include "../IO/VirtualFileSystem.h"
 #include "../Resource/Decompress.h"
 
@@ -840,17 +841,23 @@ bool Image::BeginLoad(Deserializer& source)
             return false;
         }
 
-        // Read the file to buffer.
+        // Read the file to buffer, unless it is already in memory.
         size_t dataSize(source.GetSize());
-        ea::shared_array<uint8_t> data(new uint8_t[dataSize]);
-
-        memset(data.get(), 0, sizeof(uint8_t) * dataSize);
-        source.Seek(0);
-        source.Read(data.get(), dataSize);
+        ByteVector fileData;
+        const uint8_t* data = nullptr;
+        if (auto memoryBuffer = dynamic_cast<MemoryBuffer*>(&source))
+            data = memoryBuffer->GetData();
+        else
+        {
+            fileData.resize(dataSize);
+            source.Seek(0);
+            source.Read(fileData.data(), dataSize);
+            data = fileData.data();
+        }
 
         WebPBitstreamFeatures features;
 
-        if (WebPGetFeatures(data.get(), dataSize, &features) != VP8_STATUS_OK)
+        if (WebPGetFeatures(data, dataSize, &features) != VP8_STATUS_OK)
         {
             URHO3D_LOGERROR("Error reading WebP image: " + source.GetName());
             return false;
@@ -862,11 +869,11 @@ bool Image::BeginLoad(Deserializer& source)
         bool decodeError(false);
         if (features.has_alpha)
         {
-            decodeError = WebPDecodeRGBAInto(data.get(), dataSize, pixelData.get(), imgSize, 4 * features.width) == nullptr;
+            decodeError = WebPDecodeRGBAInto(data, dataSize, pixelData.get(), imgSize, 4 * features.width) == nullptr;
         }
         else
         {
-            decodeError = WebPDecodeRGBInto(data.get(), dataSize, pixelData.get(), imgSize, 3 * features.width) == nullptr;
+            decodeError = WebPDecodeRGBInto(data, dataSize, pixelData.get(), imgSize, 3 * features.width) == nullptr;
         }
         if (decodeError)
         {
@@ -2453,6 +2460,15 @@ unsigned char* Image::GetImageData(Deserializer& source, int& width, int& height
 {
     unsigned dataSize = source.GetSize();
 
+    // Decode directly from memory if possible, e.g. from memory mapped file
+    if (auto memoryBuffer = dynamic_cast<MemoryBuffer*>(&source))
+    {
+        const unsigned position = memoryBuffer->GetPosition();
+        memoryBuffer->Seek(dataSize);
+        return stbi_load_from_memory(
+            memoryBuffer->GetData() + position, dataSize - position, &width, &height, (int*)&components, 0);
+    }
+
     ea::shared_array<unsigned char> buffer(new unsigned char[dataSize]);
     source.Read(buffer.get(), dataSize);
     return stbi_load_from_memory(buffer.get(), dataSize, &width, &height, (int*)&components, 0);
@@ -525,7 +525,7 @@ Resource* ResourceCache::GetResource(StringHash type, const ea::string& name, bo
     return resource;
 }
 
-bool ResourceCache::BackgroundLoadResource(StringHash type, const ea::string& name, bool sendEventOnFailure, Resource* caller)
+bool ResourceCache::BackgroundLoadResource(StringHash type, const ea::string& name, bool sendEventOnFailure, Resource* caller, int priority)
 {
 #ifdef URHO3D_THREADING
     // If empty name, fail immediately
@@ -538,7 +538,7 @@ bool ResourceCache::BackgroundLoadResource(StringHash type, const ea::string& na
     if (FindResource(type, nameHash) != noResource)
         return false;
 
-    return backgroundLoader_->QueueResource(type, sanitatedName, sendEventOnFailure, caller);
+    return backgroundLoader_->QueueResource(type, sanitatedName, sendEventOnFailure, caller, priority);
 #else
     // When threading not supported, fall back to synchronous loading
     return GetResource(type, name, sendEventOnFailure);
@@ -599,6 +599,15 @@ SharedPtr<Resource> ResourceCache::GetTempResource(StringHash type, const ea::st
     return resource;
 }
 
+bool ResourceCache::CancelBackgroundLoadResource(StringHash type, const ea::string& name)
+{
+#ifdef URHO3D_THREADING
+    return backgroundLoader_->CancelResource(type, StringHash(SanitateResourceName(name)));
+#else
+    return false;
+#endif
+}
+
 unsigned ResourceCache::GetNumBackgroundLoadResources() const
 {
 #ifdef URHO3D_THREADING
@@ -608,6 +617,15 @@ unsigned ResourceCache::GetNumBackgroundLoadResources() const
 #endif
 }
 
+ea::unordered_map<StringHash, BackgroundLoadStatistics> ResourceCache::GetBackgroundLoadStatistics() const
+{
+#ifdef URHO3D_THREADING
+    return backgroundLoader_->GetStatistics();
+#else
+    return {};
+#endif
+}
+
 void ResourceCache::GetResources(ea::vector<Resource*>& result, StringHash type) const
 {
     result.clear();
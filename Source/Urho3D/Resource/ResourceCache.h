@@ -62,6 +62,20 @@ struct ResourceGroup
     ea::unordered_map<StringHash, SharedPtr<Resource> > resources_;
 };
 
+/// Background loading statistics for resource type.
+struct BackgroundLoadStatistics
+{
+    /// Number of successfully loaded resources.
+    unsigned numLoaded_{};
+    /// Number of resources failed to load.
+    unsigned numFailed_{};
+    /// Number of cancelled resources.
+    unsigned numCancelled_{};
+    /// Total time spent in BeginLoad() on background threads, in microseconds.
+    long long beginLoadTime_{};
+    /// Total time spent in EndLoad() on main thread, in microseconds.
+    long long endLoadTime_{};
+};
 
 /// Optional resource request processor.
 /// Can deny requests, re-route resource file names, or perform other processing per request.
@@ -137,10 +151,15 @@ public:
     /// Load a resource without storing it in the resource cache. Return null if not found or if fails. Can be called from outside the main thread if the resource itself is safe to load completely (it does not possess for example GPU data).
     SharedPtr<Resource> GetTempResource(StringHash type, const ea::string& name, bool sendEventOnFailure = true);
     /// Background load a resource. An event will be sent when complete. Return true if successfully stored to the load queue, false if eg. already exists. Can be called from outside the main thread.
-    bool BackgroundLoadResource(StringHash type, const ea::string& name, bool sendEventOnFailure = true, Resource* caller = nullptr);
+    /// Resources with higher priority are loaded first.
+    bool BackgroundLoadResource(StringHash type, const ea::string& name, bool sendEventOnFailure = true, Resource* caller = nullptr, int priority = 0);
+    /// Cancel background loading of a resource. No events are sent for cancelled resource. Return true if the resource was queued.
+    bool CancelBackgroundLoadResource(StringHash type, const ea::string& name);
     /// Return number of pending background-loaded resources.
     /// @property
     unsigned GetNumBackgroundLoadResources() const;
+    /// Return background loading time statistics per resource type.
+    ea::unordered_map<StringHash, BackgroundLoadStatistics> GetBackgroundLoadStatistics() const;
     /// Return all loaded resources of a specific type.
     void GetResources(ea::vector<Resource*>& result, StringHash type) const;
     /// Return an already loaded resource of specific type & name, or null if not found. Will not load if does not exist. Specifying zero type will search all types.
@@ -158,7 +177,7 @@ public:
     /// Template version of releasing a resource by name.
     template <class T> void ReleaseResource(const ea::string& resourceName, bool force = false);
     /// Template version of queueing a resource background load.
-    template <class T> bool BackgroundLoadResource(const ea::string& name, bool sendEventOnFailure = true, Resource* caller = nullptr);
+    template <class T> bool BackgroundLoadResource(const ea::string& name, bool sendEventOnFailure = true, Resource* caller = nullptr, int priority = 0);
     /// Template version of returning loaded resources of a specific type.
     template <class T> void GetResources(ea::vector<T*>& result) const;
     /// Return whether a file exists in the resource directories or package files. Does not check manually added in-memory resources.
@@ -279,10 +298,10 @@ template <class T> SharedPtr<T> ResourceCache::GetTempResource(const ea::string&
     return StaticCast<T>(GetTempResource(type, name, sendEventOnFailure));
 }
 
-template <class T> bool ResourceCache::BackgroundLoadResource(const ea::string& name, bool sendEventOnFailure, Resource* caller)
+template <class T> bool ResourceCache::BackgroundLoadResource(const ea::string& name, bool sendEventOnFailure, Resource* caller, int priority)
 {
     StringHash type = T::GetTypeStatic();
-    return BackgroundLoadResource(type, name, sendEventOnFailure, caller);
+    return BackgroundLoadResource(type, name, sendEventOnFailure, caller, priority);
 }
 
 template <class T> void ResourceCache::GetResources(ea::vector<T*>& result) const
@@ -85,11 +85,23 @@ bool XMLFile::BeginLoad(Deserializer& source)
         return false;
     }
 
-    ea::shared_array<char> buffer(new char[dataSize]);
-    if (source.Read(buffer.get(), dataSize) != dataSize)
-        return false;
+    // Parse directly from memory if possible, e.g. from memory mapped file. Parser makes its own copy anyway.
+    ea::shared_array<char> buffer;
+    const void* data = nullptr;
+    if (auto memoryBuffer = dynamic_cast<MemoryBuffer*>(&source); memoryBuffer && memoryBuffer->GetPosition() == 0)
+    {
+        data = memoryBuffer->GetData();
+        memoryBuffer->Seek(dataSize);
+    }
+    else
+    {
+        buffer.reset(new char[dataSize]);
+        if (source.Read(buffer.get(), dataSize) != dataSize)
+            return false;
+        data = buffer.get();
+    }
 
-    if (!document_->load_buffer(buffer.get(), dataSize))
+    if (!document_->load_buffer(data, dataSize))
     {
         URHO3D_LOGERROR("Could not parse XML data from " + source.GetName());
         document_->reset();
@@ -103,8 +103,11 @@ void LogicComponent::OnSceneSet(Scene* scene)
         UpdateEventSubscription();
     else
     {
+        UnsubscribeFromSceneEvent(subscribedScene_, GetUpdateEvent());
+        UnsubscribeFromSceneEvent(subscribedScene_, GetPostUpdateEvent());
         UnsubscribeFromEvent(GetUpdateEvent());
         UnsubscribeFromEvent(GetPostUpdateEvent());
+        subscribedScene_ = nullptr;
 #if defined(URHO3D_PHYSICS) || defined(URHO3D_PHYSICS2D)
         UnsubscribeFromEvent(E_PHYSICSPRESTEP);
         UnsubscribeFromEvent(E_PHYSICSPOSTSTEP);
@@ -119,29 +122,38 @@ void LogicComponent::UpdateEventSubscription()
     if (!scene)
         return;
 
+    // Typed update events are owned by the scene, drop subscriptions from the previous one
+    if (subscribedScene_.Get() != scene)
+    {
+        UnsubscribeFromSceneEvent(subscribedScene_, GetUpdateEvent());
+        UnsubscribeFromSceneEvent(subscribedScene_, GetPostUpdateEvent());
+        currentEventMask_ &= ~(USE_UPDATE | USE_POSTUPDATE);
+        subscribedScene_ = scene;
+    }
+
     bool enabled = IsEnabledEffective();
 
     bool needUpdate = enabled && ((updateEventMask_ & USE_UPDATE) || !delayedStartCalled_);
     if (needUpdate && !(currentEventMask_ & USE_UPDATE))
     {
-        SubscribeToEvent(scene, GetUpdateEvent(), URHO3D_HANDLER(LogicComponent, HandleSceneUpdate));
+        SubscribeToSceneEvent(scene, GetUpdateEvent(), &LogicComponent::HandleSceneUpdate);
         currentEventMask_ |= USE_UPDATE;
     }
     else if (!needUpdate && (currentEventMask_ & USE_UPDATE))
     {
-        UnsubscribeFromEvent(scene, GetUpdateEvent());
+        UnsubscribeFromSceneEvent(scene, GetUpdateEvent());
         currentEventMask_ &= ~USE_UPDATE;
     }
 
     bool needPostUpdate = enabled && (updateEventMask_ & USE_POSTUPDATE);
     if (needPostUpdate && !(currentEventMask_ & USE_POSTUPDATE))
     {
-        SubscribeToEvent(scene, GetPostUpdateEvent(), URHO3D_HANDLER(LogicComponent, HandleScenePostUpdate));
+        SubscribeToSceneEvent(scene, GetPostUpdateEvent(), &LogicComponent::HandleScenePostUpdate);
         currentEventMask_ |= USE_POSTUPDATE;
     }
     else if (!needPostUpdate && (currentEventMask_ & USE_POSTUPDATE))
     {
-        UnsubscribeFromEvent(scene, GetPostUpdateEvent());
+        UnsubscribeFromSceneEvent(scene, GetPostUpdateEvent());
         currentEventMask_ &= ~USE_POSTUPDATE;
     }
 
@@ -176,10 +188,32 @@ void LogicComponent::UpdateEventSubscription()
 #endif
 }
 
-void LogicComponent::HandleSceneUpdate(StringHash eventType, VariantMap& eventData)
+void LogicComponent::SubscribeToSceneEvent(
+    Scene* scene, StringHash eventType, void (LogicComponent::*handler)(SceneUpdateEventData&))
+{
+    if (SceneUpdateEvent* typedEvent = scene->GetTypedUpdateEvent(eventType))
+        typedEvent->Subscribe(this, handler);
+    else
+    {
+        SubscribeToEvent(scene, eventType,
+            [this, handler](VariantMap& eventData)
+        {
+            SceneUpdateEventData typedEventData;
+            typedEventData.FromEventData(eventData);
+            (this->*handler)(typedEventData);
+        });
+    }
+}
+
+void LogicComponent::UnsubscribeFromSceneEvent(Scene* scene, StringHash eventType)
 {
-    using namespace SceneUpdate;
+    // Typed subscriptions are removed the same way
+    if (scene)
+        UnsubscribeFromEvent(scene, eventType);
+}
 
+void LogicComponent::HandleSceneUpdate(SceneUpdateEventData& eventData)
+{
     // Execute user-defined delayed start function before first update
     if (!delayedStartCalled_)
     {
@@ -189,22 +223,20 @@ void LogicComponent::HandleSceneUpdate(StringHash eventType, VariantMap& eventDa
         // If did not need actual update events, unsubscribe now
         if (!(updateEventMask_ & USE_UPDATE))
         {
-            UnsubscribeFromEvent(GetScene(), GetUpdateEvent());
+            UnsubscribeFromSceneEvent(subscribedScene_, GetUpdateEvent());
             currentEventMask_ &= ~USE_UPDATE;
             return;
         }
     }
 
     // Then execute user-defined update function
-    Update(eventData[P_TIMESTEP].GetFloat());
+    Update(eventData.timeStep_);
 }
 
-void LogicComponent::HandleScenePostUpdate(StringHash eventType, VariantMap& eventData)
+void LogicComponent::HandleScenePostUpdate(SceneUpdateEventData& eventData)
 {
-    using namespace ScenePostUpdate;
-
     // Execute user-defined post-update function
-    PostUpdate(eventData[P_TIMESTEP].GetFloat());
+    PostUpdate(eventData.timeStep_);
 }
 
 #if defined(URHO3D_PHYSICS) || defined(URHO3D_PHYSICS2D)
@@ -26,6 +26,7 @@
 
 #include "../Container/FlagSet.h"
 #include "../Scene/Component.h"
+#include "../Scene/Scene.h"
 
 namespace Urho3D
 {
@@ -46,6 +47,8 @@ enum UpdateEvent : unsigned
 URHO3D_FLAGSET(UpdateEvent, UpdateEventFlags);
 
 /// Helper base class for user-defined game logic components that hooks up to update events and forwards them to virtual functions similar to ScriptInstance class.
+/// Scene update events are received via Scene typed channels, so Update and PostUpdate are called before
+/// handlers subscribed to the same events via Object::SubscribeToEvent.
 class URHO3D_API LogicComponent : public Component
 {
     URHO3D_OBJECT(LogicComponent, Component);
@@ -101,10 +104,14 @@ protected:
 private:
     /// Subscribe/unsubscribe to update events based on current enabled state and update event mask.
     void UpdateEventSubscription();
+    /// Subscribe to scene update event, via typed channel if possible.
+    void SubscribeToSceneEvent(Scene* scene, StringHash eventType, void (LogicComponent::*handler)(SceneUpdateEventData&));
+    /// Unsubscribe from scene update event.
+    void UnsubscribeFromSceneEvent(Scene* scene, StringHash eventType);
     /// Handle scene update event.
-    void HandleSceneUpdate(StringHash eventType, VariantMap& eventData);
+    void HandleSceneUpdate(SceneUpdateEventData& eventData);
     /// Handle scene post-update event.
-    void HandleScenePostUpdate(StringHash eventType, VariantMap& eventData);
+    void HandleScenePostUpdate(SceneUpdateEventData& eventData);
 #if defined(URHO3D_PHYSICS) || defined(URHO3D_PHYSICS2D)
     /// Handle physics pre-step event.
     void HandlePhysicsPreStep(StringHash eventType, VariantMap& eventData);
@@ -115,6 +122,8 @@ private:
     UpdateEventFlags updateEventMask_;
     /// Current event subscription mask.
     UpdateEventFlags currentEventMask_;
+    /// Scene that owns current update event subscriptions.
+    WeakPtr<Scene> subscribedScene_;
     /// Flag for delayed start.
     bool delayedStartCalled_;
 };
@@ -711,8 +711,11 @@ void Node::SetWorldScale(const Vector3& scale)
 
 void Node::SetWorldTransform(const Vector3& position, const Quaternion& rotation)
 {
-    SetWorldPosition(position);
-    SetWorldRotation(rotation);
+    // Mark dirty only once instead of doing it for position and rotation separately
+    if (IsTransformHierarchyRoot())
+        SetTransform(position, rotation);
+    else
+        SetTransform(parent_->GetWorldTransform().Inverse() * position, parent_->GetWorldRotation().Inverse() * rotation);
 }
 
 void Node::SetWorldTransform(const Vector3& position, const Quaternion& rotation, float scale)
@@ -930,6 +933,9 @@ void Node::SetEnabledRecursive(bool enable)
 
 void Node::MarkDirty()
 {
+    if (scene_ && !dirty_)
+        scene_->MarkTransformsDirty(this);
+
     Node *cur = this;
     for (;;)
     {
@@ -1029,6 +1035,8 @@ void Node::AddChild(Node* node, unsigned index)
     // Add to the child vector, then add to the scene if not added yet
     children_.insert_at(index, nodeShared);
     node->parent_ = this;
+    if (scene_)
+        scene_->MarkTransformHierarchyDirty(node);
 
     if (scene_ && node->GetScene() != scene_)
         scene_->NodeAdded(node);
@@ -2111,7 +2119,10 @@ void Node::RemoveChild(ea::vector<SharedPtr<Node> >::iterator i)
     child->parent_ = nullptr;
     child->MarkDirty();
     if (scene_)
+    {
         scene_->NodeRemoved(child.Get());
+        scene_->MarkTransformHierarchyDirty(child);
+    }
 
     children_.erase(i);
 }
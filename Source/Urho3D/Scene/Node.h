@@ -110,6 +110,7 @@ class URHO3D_API Node : public Serializable
     URHO3D_OBJECT(Node, Serializable);
 
     friend class Connection;
+    friend class TransformStore;
 
 public:
     /// Construct.
@@ -852,6 +853,8 @@ private:
     Vector3 scale_;
     /// World-space rotation.
     mutable Quaternion worldRotation_;
+    /// Index in the scene transform store, M_MAX_UNSIGNED if not stored.
+    unsigned transformStoreIndex_{M_MAX_UNSIGNED};
     /// Components.
     ea::vector<SharedPtr<Component> > components_;
     /// Child scene nodes.
@@ -53,6 +53,18 @@
 namespace Urho3D
 {
 
+void SceneUpdateEventData::ToEventData(VariantMap& eventData) const
+{
+    eventData[SceneUpdate::P_SCENE] = scene_;
+    eventData[SceneUpdate::P_TIMESTEP] = timeStep_;
+}
+
+void SceneUpdateEventData::FromEventData(VariantMap& eventData)
+{
+    scene_ = static_cast<Scene*>(eventData[SceneUpdate::P_SCENE].GetPtr());
+    timeStep_ = eventData[SceneUpdate::P_TIMESTEP].GetFloat();
+}
+
 const StringVector Scene::DefaultUpdateEvents = {
     "@SceneForcedUpdate", // E_SCENEFORCEDUPDATE
     "SceneUpdate", // E_SCENEUPDATE
@@ -305,6 +317,16 @@ Texture2D* Scene::GetLightmapTexture(unsigned index) const
     return index < lightmapTextures_.size() ? lightmapTextures_[index] : nullptr;
 }
 
+SceneUpdateEvent* Scene::GetTypedUpdateEvent(StringHash eventType) const
+{
+    for (const CookedUpdateEvent& event : cookedUpdateEvents_)
+    {
+        if (event.eventType_ == eventType)
+            return event.typedEvent_;
+    }
+    return nullptr;
+}
+
 void Scene::SetUpdateEvents(const StringVector& events)
 {
     updateEvents_ = events;
@@ -317,7 +339,13 @@ void Scene::SetUpdateEvents(const StringVector& events)
 
         const bool isForced = event[0] == '@';
         const ea::string_view eventName = isForced ? ea::string_view{event}.substr(1) : event;
-        cookedUpdateEvents_.emplace_back(StringHash{eventName}, isForced);
+        const StringHash eventType{eventName};
+
+        auto& typedEvent = typedUpdateEvents_[eventType];
+        if (!typedEvent)
+            typedEvent = ea::make_unique<SceneUpdateEvent>(this, eventType);
+
+        cookedUpdateEvents_.push_back(CookedUpdateEvent{eventType, isForced, typedEvent.get()});
     }
 }
 
@@ -831,16 +859,15 @@ void Scene::Update(float timeStep)
 
     timeStep *= timeScale_;
 
-    VariantMap& eventData = GetEventDataMap();
-    eventData[SceneUpdate::P_SCENE] = this;
-    eventData[SceneUpdate::P_TIMESTEP] = timeStep;
-
-    for (const auto& [eventId, isForced] : cookedUpdateEvents_)
+    SceneUpdateEventData eventData{this, timeStep};
+    for (const CookedUpdateEvent& event : cookedUpdateEvents_)
     {
-        if (updateEnabled_ || isForced)
-            SendEvent(eventId, eventData);
+        if (updateEnabled_ || event.isForced_)
+            event.typedEvent_->Send(eventData);
     }
 
+    UpdateWorldTransforms();
+
     if (updateEnabled_)
     {
         // Note: using a float for elapsed time accumulation is inherently inaccurate. The purpose of this value is
@@ -875,6 +902,39 @@ void Scene::EndThreadedUpdate()
     }
 }
 
+void Scene::SetTransformStoreEnabled(bool enabled)
+{
+    if (enabled == IsTransformStoreEnabled())
+        return;
+
+    if (enabled)
+        transformStore_ = ea::make_unique<TransformStore>(this);
+    else
+        transformStore_ = nullptr;
+}
+
+void Scene::MarkTransformHierarchyDirty(Node* node)
+{
+    if (!transformStore_)
+        return;
+
+    if (node->GetParent())
+        transformStore_->AddNode(node);
+    else
+        transformStore_->RemoveNode(node);
+}
+
+void Scene::UpdateWorldTransforms()
+{
+    if (!transformStore_)
+        return;
+
+    URHO3D_PROFILE("UpdateWorldTransforms");
+
+    auto workQueue = GetSubsystem<WorkQueue>();
+    transformStore_->Update(workQueue && workQueue->IsMultithreaded() ? workQueue : nullptr);
+}
+
 void Scene::DelayedMarkedDirty(Component* component)
 {
     MutexLock lock(sceneMutex_);
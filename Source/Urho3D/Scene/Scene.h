@@ -25,10 +25,12 @@
 #pragma once
 
 #include "../Core/Mutex.h"
+#include "../Core/TypedEvent.h"
 #include "../Resource/JSONFile.h"
 #include "../Resource/XMLElement.h"
 #include "../Scene/Node.h"
 #include "../Scene/SceneResolver.h"
+#include "../Scene/TransformStore.h"
 
 #include <EASTL/span.h>
 #include <EASTL/unique_ptr.h>
@@ -86,6 +88,23 @@ struct AsyncProgress
     unsigned totalNodes_;
 };
 
+/// Payload of scene update events, see SceneEvents.h.
+struct URHO3D_API SceneUpdateEventData
+{
+    /// Scene being updated.
+    Scene* scene_{};
+    /// Scaled time step.
+    float timeStep_{};
+
+    /// Convert to VariantMap for receivers subscribed via Object::SubscribeToEvent.
+    void ToEventData(VariantMap& eventData) const;
+    /// Convert from VariantMap if the event is sent via Object::SendEvent.
+    void FromEventData(VariantMap& eventData);
+};
+
+/// Typed scene update event.
+using SceneUpdateEvent = TypedEvent<SceneUpdateEventData>;
+
 /// Index of components in the Scene.
 using SceneComponentIndex = ea::hash_set<Component*>;
 
@@ -148,6 +167,8 @@ public:
     void SetUpdateEvents(const StringVector& events);
     /// Return update events.
     const StringVector& GetUpdateEvents() const { return updateEvents_; }
+    /// Return typed channel of update event. Return null if the event is not sent by the scene.
+    SceneUpdateEvent* GetTypedUpdateEvent(StringHash eventType) const;
 
     /// Load from an XML file. Return true if successful.
     bool LoadXML(Deserializer& source);
@@ -271,6 +292,24 @@ public:
     /// Return threaded update flag.
     bool IsThreadedUpdate() const { return threadedUpdate_; }
 
+    /// Enable or disable transform store. When enabled, world transforms of dirty nodes are recalculated in batch
+    /// at the end of Update, using worker threads. Recommended for scenes with a lot of moving nodes.
+    void SetTransformStoreEnabled(bool enabled);
+    /// Return whether transform store is enabled.
+    bool IsTransformStoreEnabled() const { return transformStore_ != nullptr; }
+    /// Return transform store if enabled.
+    TransformStore* GetTransformStore() const { return transformStore_.get(); }
+    /// Recalculate world transforms of dirty nodes if transform store is enabled.
+    void UpdateWorldTransforms();
+    /// Notify transform store that node transform has changed. Is thread-safe.
+    void MarkTransformsDirty(Node* node)
+    {
+        if (transformStore_)
+            transformStore_->MarkNodeDirty(node);
+    }
+    /// Notify transform store that node was added, removed or reparented.
+    void MarkTransformHierarchyDirty(Node* node);
+
     /// Get free node ID.
     unsigned GetFreeNodeID();
     /// Get free component ID.
@@ -355,6 +394,8 @@ private:
     bool asyncLoading_;
     /// Threaded update flag.
     bool threadedUpdate_;
+    /// Batch storage of node world transforms.
+    ea::unique_ptr<TransformStore> transformStore_;
 
     /// Lightmap textures names.
     ResourceRefList lightmaps_;
@@ -363,7 +404,15 @@ private:
 
     /// Update events to be sent on every update.
     StringVector updateEvents_;
-    ea::vector<ea::pair<StringHash, bool>> cookedUpdateEvents_;
+    struct CookedUpdateEvent
+    {
+        StringHash eventType_;
+        bool isForced_{};
+        SceneUpdateEvent* typedEvent_{};
+    };
+    ea::vector<CookedUpdateEvent> cookedUpdateEvents_;
+    /// Typed channels of update events. Never removed so that receivers can keep pointers.
+    ea::unordered_map<StringHash, ea::unique_ptr<SceneUpdateEvent>> typedUpdateEvents_;
 };
 
 /// Register Scene library objects.
@@ -43,6 +43,9 @@ URHO3D_EVENT(E_SCENEUPDATESCHANGED, SceneUpdateChanged)
     }
 
 /// Scene update events. They are all sent with the same parameters in the same order as listed.
+/// Scene sends them through TypedEvent channels (see Scene::GetTypedUpdateEvent).
+/// Receivers subscribed to the channel directly (e.g. LogicComponent) and via Object::SubscribeToEvent
+/// get the event in the order of subscription, same as for any other event.
 /// @{
 
 URHO3D_SCENE_UPDATE_EVENT(E_SCENEFORCEDUPDATE, SceneForcedUpdate); // Sent even for paused scenes!
@@ -0,0 +1,275 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Scene/TransformStore.h"
+
+#include "Urho3D/Core/WorkQueue.h"
+#include "Urho3D/Scene/Scene.h"
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+TransformStore::TransformStore(Scene* scene)
+    : scene_(scene)
+{
+    for (Node* child : scene_->GetChildren())
+        AddNode(child);
+}
+
+TransformStore::~TransformStore()
+{
+    for (Node* node : nodes_)
+    {
+        if (node)
+            node->transformStoreIndex_ = M_MAX_UNSIGNED;
+    }
+}
+
+void TransformStore::AddNode(Node* node)
+{
+    Node* parent = node->GetParent();
+    const unsigned parentIndex = parent == scene_ ? M_MAX_UNSIGNED : parent->transformStoreIndex_;
+    const unsigned depth = parentIndex == M_MAX_UNSIGNED ? 0 : depths_[parentIndex] + 1;
+
+    const unsigned index = node->transformStoreIndex_;
+    if (index == M_MAX_UNSIGNED)
+        AddNodeRecursive(node, parentIndex, depth);
+    else
+    {
+        // Node is reparented within the scene, children keep their indices
+        parentIndices_[index] = parentIndex;
+        if (depths_[index] != depth)
+        {
+            SetDepthRecursive(node, depth);
+            TrimLevels();
+        }
+    }
+
+    MarkNodeDirty(node);
+}
+
+void TransformStore::RemoveNode(Node* node)
+{
+    if (node->transformStoreIndex_ == M_MAX_UNSIGNED)
+        return;
+
+    RemoveNodeRecursive(node);
+    TrimLevels();
+}
+
+void TransformStore::MarkNodeDirty(Node* node)
+{
+    const unsigned index = node->transformStoreIndex_;
+    if (index == M_MAX_UNSIGNED)
+        return;
+
+    MutexLock<SpinLockMutex> lock(dirtyNodesMutex_);
+    dirtyNodes_.push_back(index);
+}
+
+void TransformStore::AddNodeRecursive(Node* node, unsigned parentIndex, unsigned depth)
+{
+    unsigned index{};
+    if (!freeIndices_.empty())
+    {
+        index = freeIndices_.back();
+        freeIndices_.pop_back();
+    }
+    else
+    {
+        index = nodes_.size();
+        nodes_.push_back(nullptr);
+        parentIndices_.push_back(M_MAX_UNSIGNED);
+        depths_.push_back(0);
+        stamps_.push_back(0);
+        worldTransforms_.push_back(Matrix3x4::IDENTITY);
+        worldRotations_.push_back(Quaternion::IDENTITY);
+    }
+
+    nodes_[index] = node;
+    parentIndices_[index] = parentIndex;
+    depths_[index] = depth;
+    stamps_[index] = 0;
+    node->transformStoreIndex_ = index;
+
+    if (levelSizes_.size() <= depth)
+        levelSizes_.resize(depth + 1, 0);
+    ++levelSizes_[depth];
+
+    for (Node* child : node->GetChildren())
+        AddNodeRecursive(child, index, depth + 1);
+}
+
+void TransformStore::RemoveNodeRecursive(Node* node)
+{
+    const unsigned index = node->transformStoreIndex_;
+    --levelSizes_[depths_[index]];
+    nodes_[index] = nullptr;
+    freeIndices_.push_back(index);
+    node->transformStoreIndex_ = M_MAX_UNSIGNED;
+
+    for (Node* child : node->GetChildren())
+        RemoveNodeRecursive(child);
+}
+
+void TransformStore::SetDepthRecursive(Node* node, unsigned depth)
+{
+    const unsigned index = node->transformStoreIndex_;
+    --levelSizes_[depths_[index]];
+    if (levelSizes_.size() <= depth)
+        levelSizes_.resize(depth + 1, 0);
+    ++levelSizes_[depth];
+    depths_[index] = depth;
+
+    for (Node* child : node->GetChildren())
+        SetDepthRecursive(child, depth + 1);
+}
+
+void TransformStore::TrimLevels()
+{
+    while (!levelSizes_.empty() && levelSizes_.back() == 0)
+        levelSizes_.pop_back();
+}
+
+unsigned TransformStore::GetNodeIndex(const Node* node) const
+{
+    return node->transformStoreIndex_;
+}
+
+void TransformStore::Update(WorkQueue* workQueue)
+{
+    numUpdatedNodes_ = 0;
+
+    updateRoots_.clear();
+    {
+        MutexLock<SpinLockMutex> lock(dirtyNodesMutex_);
+        ea::swap(updateRoots_, dirtyNodes_);
+    }
+
+    if (updateRoots_.empty())
+        return;
+
+    // Each update uses two unique stamps: for dirty roots and for already collected nodes
+    if (updateStamp_ >= M_MAX_UNSIGNED - 2)
+    {
+        ea::fill(stamps_.begin(), stamps_.end(), 0u);
+        updateStamp_ = 0;
+    }
+    const unsigned rootStamp = ++updateStamp_;
+    const unsigned subtreeStamp = ++updateStamp_;
+
+    for (unsigned index : updateRoots_)
+    {
+        if (nodes_[index])
+            stamps_[index] = rootStamp;
+    }
+
+    for (ea::vector<unsigned>& level : updateLevels_)
+        level.clear();
+    if (updateLevels_.size() < levelSizes_.size())
+        updateLevels_.resize(levelSizes_.size());
+
+    // Skip nodes that are already collected or will be collected as part of parent subtree
+    for (unsigned index : updateRoots_)
+    {
+        if (!nodes_[index] || stamps_[index] == subtreeStamp)
+            continue;
+        if (IsAnyParentMarked(index, rootStamp, subtreeStamp))
+            continue;
+        CollectSubtree(index, subtreeStamp);
+    }
+
+    for (const ea::vector<unsigned>& level : updateLevels_)
+    {
+        if (level.empty())
+            continue;
+
+        numUpdatedNodes_ += level.size();
+        if (workQueue)
+        {
+            workQueue->ParallelFor(level.size(), MinNodesPerTask,
+                [&](unsigned beginIndex, unsigned endIndex, unsigned threadIndex)
+            { UpdateNodes({level.data() + beginIndex, level.data() + endIndex}); });
+        }
+        else
+            UpdateNodes(level);
+    }
+}
+
+bool TransformStore::IsAnyParentMarked(unsigned index, unsigned rootStamp, unsigned subtreeStamp) const
+{
+    for (unsigned parentIndex = parentIndices_[index]; parentIndex != M_MAX_UNSIGNED;
+         parentIndex = parentIndices_[parentIndex])
+    {
+        const unsigned stamp = stamps_[parentIndex];
+        if (stamp == rootStamp || stamp == subtreeStamp)
+            return true;
+    }
+    return false;
+}
+
+void TransformStore::CollectSubtree(unsigned index, unsigned subtreeStamp)
+{
+    traversalStack_.clear();
+    traversalStack_.push_back(index);
+    while (!traversalStack_.empty())
+    {
+        const unsigned nodeIndex = traversalStack_.back();
+        traversalStack_.pop_back();
+
+        stamps_[nodeIndex] = subtreeStamp;
+        updateLevels_[depths_[nodeIndex]].push_back(nodeIndex);
+
+        for (Node* child : nodes_[nodeIndex]->GetChildren())
+            traversalStack_.push_back(child->transformStoreIndex_);
+    }
+}
+
+void TransformStore::UpdateNodes(ea::span<const unsigned> indices)
+{
+    for (unsigned index : indices)
+    {
+        Node* node = nodes_[index];
+
+        const unsigned parentIndex = parentIndices_[index];
+        if (parentIndex == M_MAX_UNSIGNED)
+        {
+            worldTransforms_[index] = node->GetTransformMatrix();
+            worldRotations_[index] = node->rotation_;
+        }
+        else
+        {
+            worldTransforms_[index] = worldTransforms_[parentIndex] * node->GetTransformMatrix();
+            worldRotations_[index] = worldRotations_[parentIndex] * node->rotation_;
+        }
+
+        node->worldTransform_ = worldTransforms_[index];
+        node->worldRotation_ = worldRotations_[index];
+        node->dirty_ = false;
+    }
+}
+
+}
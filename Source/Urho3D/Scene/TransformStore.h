@@ -0,0 +1,125 @@
+//
+// Copyright (c) 2024-2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "Urho3D/Core/Mutex.h"
+#include "Urho3D/Core/NonCopyable.h"
+#include "Urho3D/Math/Matrix3x4.h"
+#include "Urho3D/Math/Quaternion.h"
+
+#include <Urho3D/Urho3D.h>
+
+#include <EASTL/span.h>
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+class Node;
+class Scene;
+class WorkQueue;
+
+/// Flat storage of scene node hierarchy used to recalculate world transforms in batches.
+/// Each node keeps its index in the store, indices of removed nodes are reused.
+/// Only subtrees of the nodes marked dirty since the last update are recalculated.
+/// Dirty nodes are sorted by depth so that each depth level can be processed in parallel.
+/// Node getters stay valid and keep using cached world transforms, which are filled by the store.
+class URHO3D_API TransformStore : public NonCopyable
+{
+public:
+    /// Min number of nodes processed by one task.
+    static constexpr unsigned MinNodesPerTask = 256;
+
+    explicit TransformStore(Scene* scene);
+    ~TransformStore();
+
+    /// Add node with children to the store, or update the parent of the node that is already stored.
+    void AddNode(Node* node);
+    /// Remove node with children from the store.
+    void RemoveNode(Node* node);
+    /// Mark node transform with children as changed. Thread-safe.
+    void MarkNodeDirty(Node* node);
+    /// Recalculate world transforms of dirty nodes. Use worker threads if work queue is provided.
+    void Update(WorkQueue* workQueue);
+
+    /// Return index of the node in the store, M_MAX_UNSIGNED if not stored.
+    unsigned GetNodeIndex(const Node* node) const;
+    /// Return nodes by index. Elements of removed nodes are null.
+    ea::span<Node* const> GetNodes() const { return nodes_; }
+    /// Return world transforms of nodes by index. Valid after update.
+    ea::span<const Matrix3x4> GetWorldTransforms() const { return worldTransforms_; }
+    /// Return world rotations of nodes by index. Valid after update.
+    ea::span<const Quaternion> GetWorldRotations() const { return worldRotations_; }
+    /// Return number of stored nodes.
+    unsigned GetNumNodes() const { return nodes_.size() - freeIndices_.size(); }
+    /// Return number of depth levels.
+    unsigned GetNumLevels() const { return levelSizes_.size(); }
+    /// Return number of nodes recalculated by the last update.
+    unsigned GetNumUpdatedNodes() const { return numUpdatedNodes_; }
+
+private:
+    /// Add node with children to the store.
+    void AddNodeRecursive(Node* node, unsigned parentIndex, unsigned depth);
+    /// Remove node with children from the store.
+    void RemoveNodeRecursive(Node* node);
+    /// Update depth of node with children.
+    void SetDepthRecursive(Node* node, unsigned depth);
+    /// Remove empty levels at the end.
+    void TrimLevels();
+    /// Return whether any parent of the node is marked with the stamp.
+    bool IsAnyParentMarked(unsigned index, unsigned rootStamp, unsigned subtreeStamp) const;
+    /// Append node with children to the dirty nodes sorted by depth.
+    void CollectSubtree(unsigned index, unsigned subtreeStamp);
+    /// Update world transforms of nodes. Parents should be up to date.
+    void UpdateNodes(ea::span<const unsigned> indices);
+
+    Scene* scene_{};
+
+    /// Node data by index.
+    /// @{
+    ea::vector<Node*> nodes_;
+    ea::vector<unsigned> parentIndices_;
+    ea::vector<unsigned> depths_;
+    ea::vector<unsigned> stamps_;
+    ea::vector<Matrix3x4> worldTransforms_;
+    ea::vector<Quaternion> worldRotations_;
+    /// @}
+    ea::vector<unsigned> freeIndices_;
+    /// Number of nodes on each depth level.
+    ea::vector<unsigned> levelSizes_;
+
+    /// Nodes marked dirty since the last update, possibly with duplicates and nested subtrees.
+    ea::vector<unsigned> dirtyNodes_;
+    SpinLockMutex dirtyNodesMutex_;
+
+    /// Temporary buffers used by update.
+    /// @{
+    ea::vector<unsigned> updateRoots_;
+    ea::vector<ea::vector<unsigned>> updateLevels_;
+    ea::vector<unsigned> traversalStack_;
+    unsigned updateStamp_{};
+    unsigned numUpdatedNodes_{};
+    /// @}
+};
+
+}